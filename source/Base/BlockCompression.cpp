@@ -0,0 +1,403 @@
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+#ifdef ALIEN_ZSTD
+#include <zstd.h>
+#endif
+
+#include "ThreadPool.h"
+
+namespace
+{
+    unsigned char const GzipId1 = 0x1f;
+    unsigned char const GzipId2 = 0x8b;
+    unsigned char const GzipDeflateMethod = 8;
+    unsigned char const GzipFlagHeaderCrc = 0x02;
+    unsigned char const GzipFlagExtra = 0x04;
+    unsigned char const GzipFlagName = 0x08;
+    unsigned char const GzipFlagComment = 0x10;
+    unsigned char const GzipOsUnknown = 0xff;
+    int const GzipHeaderSize = 10;
+    int const GzipTrailerSize = 8;
+
+    //subfield in gzip extra field containing the block index
+    char const BlockIndexId1 = 'A';
+    char const BlockIndexId2 = 'L';
+    int const MaxSubfieldSize = 0xffff - 4;
+    int const MaxNumBlocks = (MaxSubfieldSize - 4) / 4;
+
+    unsigned char const ZstdMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+    int const ZlibLevel = Z_DEFAULT_COMPRESSION;
+    int const ZstdLevel = 3;
+
+    void appendUint16(std::string& target, uint32_t value)
+    {
+        target.push_back(static_cast<char>(value & 0xff));
+        target.push_back(static_cast<char>((value >> 8) & 0xff));
+    }
+
+    void appendUint32(std::string& target, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) {
+            target.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+    }
+
+    uint32_t readUint16(std::string const& source, size_t pos)
+    {
+        auto bytes = reinterpret_cast<unsigned char const*>(source.data() + pos);
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8);
+    }
+
+    uint32_t readUint32(std::string const& source, size_t pos)
+    {
+        auto bytes = reinterpret_cast<unsigned char const*>(source.data() + pos);
+        uint32_t result = 0;
+        for (int i = 0; i < 4; ++i) {
+            result |= static_cast<uint32_t>(bytes[i]) << (i * 8);
+        }
+        return result;
+    }
+
+    struct BlockPartition
+    {
+        size_t blockSize;
+        int numBlocks;
+
+        size_t getBegin(int block) const { return blockSize * block; }
+    };
+
+    BlockPartition getBlockPartition(size_t dataSize, int blockSize, int maxNumBlocks)
+    {
+        BlockPartition result;
+        result.blockSize = std::max(static_cast<size_t>(std::max(1, blockSize)), (dataSize + maxNumBlocks - 1) / maxNumBlocks);
+        result.numBlocks = std::max(1, static_cast<int>((dataSize + result.blockSize - 1) / result.blockSize));
+        return result;
+    }
+
+    void parallelForBlocks(int numBlocks, std::function<void(int)> const& func)
+    {
+        ThreadPool::getInstance().parallelFor(
+            0,
+            numBlocks,
+            [&](int startBlock, int endBlock) {
+                for (int block = startBlock; block < endBlock; ++block) {
+                    func(block);
+                }
+            },
+            1);
+    }
+
+    //raw deflate of one block, non-final blocks end on a byte boundary due to Z_SYNC_FLUSH
+    std::string deflateBlock(char const* data, size_t size, bool isFinalBlock)
+    {
+        z_stream stream = {};
+        if (deflateInit2(&stream, ZlibLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("Could not initialize compression.");
+        }
+        std::string result(deflateBound(&stream, static_cast<uLong>(size)) + 16, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        stream.avail_in = static_cast<uInt>(size);
+        stream.next_out = reinterpret_cast<Bytef*>(result.data());
+        stream.avail_out = static_cast<uInt>(result.size());
+        auto deflateResult = deflate(&stream, isFinalBlock ? Z_FINISH : Z_SYNC_FLUSH);
+        auto success = isFinalBlock ? deflateResult == Z_STREAM_END : deflateResult == Z_OK && stream.avail_in == 0;
+        result.resize(result.size() - stream.avail_out);
+        deflateEnd(&stream);
+        if (!success) {
+            throw std::runtime_error("Compression failed.");
+        }
+        return result;
+    }
+
+    void inflateBlock(char const* data, size_t size, char* target, size_t targetSize)
+    {
+        z_stream stream = {};
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("Could not initialize decompression.");
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        stream.avail_in = static_cast<uInt>(size);
+        stream.next_out = reinterpret_cast<Bytef*>(target);
+        stream.avail_out = static_cast<uInt>(targetSize);
+        auto inflateResult = inflate(&stream, Z_SYNC_FLUSH);
+        auto success = (inflateResult == Z_OK || inflateResult == Z_STREAM_END || inflateResult == Z_BUF_ERROR) && stream.avail_out == 0
+            && stream.avail_in == 0;
+        inflateEnd(&stream);
+        if (!success) {
+            throw std::runtime_error("Compressed block is corrupted.");
+        }
+    }
+
+    std::string compressZlib(std::string const& data, int blockSize)
+    {
+        //block sizes are limited by 32 bit fields in the block index
+        auto partition = getBlockPartition(data.size(), std::min(blockSize, 1 << 30), MaxNumBlocks);
+
+        std::vector<std::string> compressedBlocks(partition.numBlocks);
+        std::vector<uLong> crcs(partition.numBlocks);
+        parallelForBlocks(partition.numBlocks, [&](int block) {
+            auto begin = partition.getBegin(block);
+            auto size = std::min(partition.blockSize, data.size() - std::min(begin, data.size()));
+            compressedBlocks.at(block) = deflateBlock(data.data() + begin, size, block == partition.numBlocks - 1);
+            crcs.at(block) = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<Bytef const*>(data.data() + begin), static_cast<uInt>(size));
+        });
+
+        size_t totalSize = GzipHeaderSize + 2 + 4 + 4 + 4 * partition.numBlocks + GzipTrailerSize;
+        for (auto const& compressedBlock : compressedBlocks) {
+            totalSize += compressedBlock.size();
+        }
+
+        std::string result;
+        result.reserve(totalSize);
+        result.push_back(static_cast<char>(GzipId1));
+        result.push_back(static_cast<char>(GzipId2));
+        result.push_back(static_cast<char>(GzipDeflateMethod));
+        result.push_back(static_cast<char>(GzipFlagExtra));
+        appendUint32(result, 0);    //modification time
+        result.push_back(0);
+        result.push_back(static_cast<char>(GzipOsUnknown));
+
+        auto subfieldSize = 4 + 4 * partition.numBlocks;
+        appendUint16(result, 4 + subfieldSize);
+        result.push_back(BlockIndexId1);
+        result.push_back(BlockIndexId2);
+        appendUint16(result, subfieldSize);
+        appendUint32(result, static_cast<uint32_t>(partition.blockSize));
+        for (auto const& compressedBlock : compressedBlocks) {
+            appendUint32(result, static_cast<uint32_t>(compressedBlock.size()));
+        }
+
+        auto crc = crcs.front();
+        for (int block = 1; block < partition.numBlocks; ++block) {
+            auto begin = partition.getBegin(block);
+            auto size = std::min(partition.blockSize, data.size() - begin);
+            crc = crc32_combine(crc, crcs.at(block), static_cast<z_off_t>(size));
+        }
+        for (auto const& compressedBlock : compressedBlocks) {
+            result.append(compressedBlock);
+        }
+        appendUint32(result, static_cast<uint32_t>(crc));
+        appendUint32(result, static_cast<uint32_t>(data.size() & 0xffffffff));
+        return result;
+    }
+
+    //returns std::nullopt for streams without block index
+    std::optional<std::string> decompressIndexedGzip(std::string const& data)
+    {
+        if (data.size() < GzipHeaderSize + GzipTrailerSize || static_cast<unsigned char>(data[0]) != GzipId1
+            || static_cast<unsigned char>(data[1]) != GzipId2 || static_cast<unsigned char>(data[2]) != GzipDeflateMethod) {
+            return std::nullopt;
+        }
+        auto flags = static_cast<unsigned char>(data[3]);
+        if ((flags & GzipFlagExtra) == 0 || (flags & (GzipFlagName | GzipFlagComment | GzipFlagHeaderCrc)) != 0) {
+            return std::nullopt;
+        }
+        auto extraSize = readUint16(data, GzipHeaderSize);
+        auto extraBegin = GzipHeaderSize + 2;
+        auto dataBegin = static_cast<size_t>(extraBegin + extraSize);
+        if (dataBegin + GzipTrailerSize > data.size()) {
+            return std::nullopt;
+        }
+
+        //find block index in extra field
+        std::optional<size_t> indexPos;
+        uint32_t indexSize = 0;
+        for (size_t pos = extraBegin; pos + 4 <= dataBegin;) {
+            auto subfieldSize = readUint16(data, pos + 2);
+            if (data[pos] == BlockIndexId1 && data[pos + 1] == BlockIndexId2) {
+                indexPos = pos + 4;
+                indexSize = subfieldSize;
+                break;
+            }
+            pos += 4 + subfieldSize;
+        }
+        if (!indexPos || indexSize < 8 || indexSize % 4 != 0 || *indexPos + indexSize > dataBegin) {
+            return std::nullopt;
+        }
+
+        size_t blockSize = readUint32(data, *indexPos);
+        auto numBlocks = static_cast<int>((indexSize - 4) / 4);
+        std::vector<size_t> compressedBegins(numBlocks + 1);
+        compressedBegins.front() = dataBegin;
+        for (int block = 0; block < numBlocks; ++block) {
+            compressedBegins.at(block + 1) = compressedBegins.at(block) + readUint32(data, *indexPos + 4 + block * 4);
+        }
+        if (blockSize == 0 || compressedBegins.back() + GzipTrailerSize != data.size()) {
+            return std::nullopt;
+        }
+
+        //uncompressed size modulo 2^32 is stored in trailer, the last block is not larger than the others
+        auto expectedCrc = readUint32(data, data.size() - 8);
+        auto sizeMod32 = readUint32(data, data.size() - 4);
+        auto sizeOfFullBlocks = blockSize * (numBlocks - 1);
+        auto lastBlockSize = static_cast<size_t>(static_cast<uint32_t>(sizeMod32 - static_cast<uint32_t>(sizeOfFullBlocks & 0xffffffff)));
+        if (lastBlockSize > blockSize) {
+            throw std::runtime_error("Compressed data is corrupted.");
+        }
+
+        std::string result(sizeOfFullBlocks + lastBlockSize, '\0');
+        std::vector<uLong> crcs(numBlocks);
+        parallelForBlocks(numBlocks, [&](int block) {
+            auto begin = blockSize * block;
+            auto size = block == numBlocks - 1 ? lastBlockSize : blockSize;
+            auto compressedBegin = compressedBegins.at(block);
+            inflateBlock(data.data() + compressedBegin, compressedBegins.at(block + 1) - compressedBegin, result.data() + begin, size);
+            crcs.at(block) = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<Bytef const*>(result.data() + begin), static_cast<uInt>(size));
+        });
+
+        auto crc = crcs.front();
+        for (int block = 1; block < numBlocks; ++block) {
+            auto size = block == numBlocks - 1 ? lastBlockSize : blockSize;
+            crc = crc32_combine(crc, crcs.at(block), static_cast<z_off_t>(size));
+        }
+        if (static_cast<uint32_t>(crc) != expectedCrc) {
+            throw std::runtime_error("Compressed data is corrupted.");
+        }
+        return result;
+    }
+
+    //sequential decompression of arbitrary gzip or zlib streams
+    std::string decompressZlibSequentially(std::string const& data)
+    {
+        z_stream stream = {};
+        if (inflateInit2(&stream, MAX_WBITS + 32) != Z_OK) {
+            throw std::runtime_error("Could not initialize decompression.");
+        }
+        std::string result;
+        std::vector<char> buffer(BlockCompression::DefaultBlockSize);
+        size_t pos = 0;
+        int inflateResult = Z_OK;
+        while (inflateResult != Z_STREAM_END) {
+            if (stream.avail_in == 0) {
+                auto size = std::min(data.size() - pos, static_cast<size_t>(1 << 30));
+                if (size == 0) {
+                    break;
+                }
+                stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + pos));
+                stream.avail_in = static_cast<uInt>(size);
+                pos += size;
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+            stream.avail_out = static_cast<uInt>(buffer.size());
+            inflateResult = inflate(&stream, Z_NO_FLUSH);
+            if (inflateResult != Z_OK && inflateResult != Z_STREAM_END) {
+                break;
+            }
+            result.append(buffer.data(), buffer.size() - stream.avail_out);
+        }
+        inflateEnd(&stream);
+        if (inflateResult != Z_STREAM_END) {
+            throw std::runtime_error("Compressed data is corrupted.");
+        }
+        return result;
+    }
+
+    bool isZstdStream(std::string const& data)
+    {
+        return data.size() >= 4 && std::equal(ZstdMagic, ZstdMagic + 4, reinterpret_cast<unsigned char const*>(data.data()));
+    }
+
+#ifdef ALIEN_ZSTD
+    std::string compressZstd(std::string const& data, int blockSize)
+    {
+        auto partition = getBlockPartition(data.size(), blockSize, std::numeric_limits<int>::max());
+
+        std::vector<std::string> compressedBlocks(partition.numBlocks);
+        parallelForBlocks(partition.numBlocks, [&](int block) {
+            auto begin = partition.getBegin(block);
+            auto size = std::min(partition.blockSize, data.size() - std::min(begin, data.size()));
+            auto& compressedBlock = compressedBlocks.at(block);
+            compressedBlock.resize(ZSTD_compressBound(size));
+            auto compressedSize = ZSTD_compress(compressedBlock.data(), compressedBlock.size(), data.data() + begin, size, ZstdLevel);
+            if (ZSTD_isError(compressedSize)) {
+                throw std::runtime_error("Compression failed.");
+            }
+            compressedBlock.resize(compressedSize);
+        });
+
+        std::string result;
+        for (auto const& compressedBlock : compressedBlocks) {
+            result.append(compressedBlock);
+        }
+        return result;
+    }
+
+    std::string decompressZstd(std::string const& data)
+    {
+        //locate frames
+        std::vector<size_t> compressedBegins{0};
+        std::vector<size_t> begins{0};
+        while (compressedBegins.back() < data.size()) {
+            auto frame = data.data() + compressedBegins.back();
+            auto remainingSize = data.size() - compressedBegins.back();
+            auto compressedSize = ZSTD_findFrameCompressedSize(frame, remainingSize);
+            auto size = ZSTD_getFrameContentSize(frame, remainingSize);
+            if (ZSTD_isError(compressedSize) || size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN) {
+                throw std::runtime_error("Compressed data is corrupted.");
+            }
+            compressedBegins.emplace_back(compressedBegins.back() + compressedSize);
+            begins.emplace_back(begins.back() + size);
+        }
+
+        std::string result(begins.back(), '\0');
+        auto numFrames = static_cast<int>(begins.size()) - 1;
+        parallelForBlocks(numFrames, [&](int frame) {
+            auto size = begins.at(frame + 1) - begins.at(frame);
+            auto decompressedSize = ZSTD_decompress(
+                result.data() + begins.at(frame),
+                size,
+                data.data() + compressedBegins.at(frame),
+                compressedBegins.at(frame + 1) - compressedBegins.at(frame));
+            if (ZSTD_isError(decompressedSize) || decompressedSize != size) {
+                throw std::runtime_error("Compressed data is corrupted.");
+            }
+        });
+        return result;
+    }
+#endif
+}
+
+bool BlockCompression::isCodecAvailable(CompressionCodec codec)
+{
+#ifdef ALIEN_ZSTD
+    return true;
+#else
+    return codec == CompressionCodec::Zlib;
+#endif
+}
+
+std::string BlockCompression::compress(std::string const& data, CompressionCodec codec, int blockSize)
+{
+    if (codec == CompressionCodec::Zstd) {
+#ifdef ALIEN_ZSTD
+        return compressZstd(data, blockSize);
+#else
+        throw std::runtime_error("Zstd compression is not available.");
+#endif
+    }
+    return compressZlib(data, blockSize);
+}
+
+std::string BlockCompression::decompress(std::string const& data)
+{
+    if (isZstdStream(data)) {
+#ifdef ALIEN_ZSTD
+        return decompressZstd(data);
+#else
+        throw std::runtime_error("Zstd decompression is not available.");
+#endif
+    }
+    if (auto result = decompressIndexedGzip(data)) {
+        return std::move(*result);
+    }
+    return decompressZlibSequentially(data);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+enum class CompressionCodec
+{
+    Zlib,
+    Zstd    //only available if built with zstd support
+};
+
+/**
+ * Compression of large buffers in independent blocks which are processed in parallel.
+ * Zlib output is a standard gzip stream (readable by any gzip decoder) carrying a block index in the header extra field.
+ * Zstd output consists of one standard frame per block.
+ */
+class BlockCompression
+{
+public:
+    static int const DefaultBlockSize = 1 << 20;
+
+    static bool isCodecAvailable(CompressionCodec codec);
+
+    //throws std::runtime_error on failure
+    static std::string compress(std::string const& data, CompressionCodec codec = CompressionCodec::Zlib, int blockSize = DefaultBlockSize);
+
+    //accepts gzip, zlib and zstd streams, streams produced by compress are decompressed in parallel
+    //throws std::runtime_error on failure
+    static std::string decompress(std::string const& data);
+};
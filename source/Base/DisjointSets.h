@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Union-find over dense indices with path halving, the smallest index of a set is its representative.
+ */
+class DisjointSets
+{
+public:
+    DisjointSets(int size)
+        : _parents(size)
+    {
+        for (int i = 0; i < size; ++i) {
+            _parents[i] = i;
+        }
+    }
+
+    int find(int index)
+    {
+        while (_parents[index] != index) {
+            _parents[index] = _parents[_parents[index]];
+            index = _parents[index];
+        }
+        return index;
+    }
+
+    void unite(int index1, int index2)
+    {
+        auto root1 = find(index1);
+        auto root2 = find(index2);
+        if (root1 < root2) {
+            _parents[root2] = root1;
+        } else if (root2 < root1) {
+            _parents[root1] = root2;
+        }
+    }
+
+private:
+    std::vector<int> _parents;
+};
@@ -0,0 +1,93 @@
+#include "InternedString.h"
+
+#include <array>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    int const NumShards = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, std::weak_ptr<std::string const>> valueByView;  //views refer to the interned values
+    };
+
+    //intentionally never destroyed since interned values may be released during static destruction
+    std::array<Shard, NumShards>& getShards()
+    {
+        static auto shards = new std::array<Shard, NumShards>();
+        return *shards;
+    }
+
+    std::string const EmptyString;
+}
+
+InternedString::InternedString(std::string const& value)
+    : _value(intern(value))
+{}
+
+InternedString::InternedString(char const* value)
+    : _value(intern(value))
+{}
+
+InternedString& InternedString::operator=(std::string const& value)
+{
+    _value = intern(value);
+    return *this;
+}
+
+InternedString& InternedString::operator=(char const* value)
+{
+    _value = intern(value);
+    return *this;
+}
+
+std::string const& InternedString::str() const
+{
+    return _value ? *_value : EmptyString;
+}
+
+int InternedString::getNumInternedValues()
+{
+    int result = 0;
+    for (auto& shard : getShards()) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result += static_cast<int>(shard.valueByView.size());
+    }
+    return result;
+}
+
+std::shared_ptr<std::string const> InternedString::intern(std::string const& value)
+{
+    if (value.empty()) {
+        return nullptr;
+    }
+    auto& shard = getShards()[std::hash<std::string_view>()(value) % NumShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto findResult = shard.valueByView.find(value);
+    if (findResult != shard.valueByView.end()) {
+        if (auto result = findResult->second.lock()) {
+            return result;
+        }
+
+        //expired value whose deleter has not run yet: replace entry since its key refers to the expired value
+        shard.valueByView.erase(findResult);
+    }
+
+    std::shared_ptr<std::string const> result(new std::string(value), [&shard](std::string const* value) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto findResult = shard.valueByView.find(*value);
+            if (findResult != shard.valueByView.end() && findResult->second.expired()) {
+                shard.valueByView.erase(findResult);
+            }
+        }
+        delete value;
+    });
+    shard.valueByView.emplace(*result, result);
+    return result;
+}
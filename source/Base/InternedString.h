@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+/**
+ * Immutable string whose content is shared by all instances with the same value (thread-safe).
+ * Empty strings do not allocate, hence the memory footprint is a single pointer for empty values.
+ * Interned values are released when the last instance referring to them is destroyed.
+ */
+class InternedString
+{
+public:
+    InternedString() = default;
+    InternedString(std::string const& value);
+    InternedString(char const* value);
+
+    InternedString& operator=(std::string const& value);
+    InternedString& operator=(char const* value);
+
+    std::string const& str() const;
+    operator std::string const&() const { return str(); }
+
+    bool empty() const { return !_value; }
+    size_t size() const { return _value ? _value->size() : 0; }
+    void clear() { _value.reset(); }
+
+    //equal values are always represented by the same instance
+    bool operator==(InternedString const& other) const { return _value == other._value; }
+    bool operator!=(InternedString const& other) const { return !operator==(other); }
+    bool operator==(std::string const& other) const { return str() == other; }
+    bool operator!=(std::string const& other) const { return !operator==(other); }
+
+    static int getNumInternedValues();
+
+private:
+    static std::shared_ptr<std::string const> intern(std::string const& value);
+
+    std::shared_ptr<std::string const> _value;  //nullptr for empty strings
+};
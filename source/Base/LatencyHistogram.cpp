@@ -0,0 +1,61 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+
+double LatencyHistogramData::getPercentileMicroseconds(double percentile) const
+{
+    if (numSamples == 0) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::max(1.0, std::min(100.0, percentile) / 100 * numSamples + 0.5));
+    uint64_t accumulatedCount = 0;
+    for (int i = 0; i < toInt(counts.size()); ++i) {
+        accumulatedCount += counts.at(i);
+        if (accumulatedCount >= rank) {
+            return std::min(static_cast<double>(uint64_t(2) << i), maxMicroseconds);
+        }
+    }
+    return maxMicroseconds;
+}
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration const& duration)
+{
+    auto nanoseconds = static_cast<uint64_t>(std::max(int64_t(0), std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    auto microseconds = nanoseconds / 1000;
+
+    int bucket = 0;
+    while (microseconds > 1 && bucket < NumBuckets - 1) {
+        microseconds >>= 1;
+        ++bucket;
+    }
+    _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    _sumNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    auto maxNanoseconds = _maxNanoseconds.load(std::memory_order_relaxed);
+    while (nanoseconds > maxNanoseconds && !_maxNanoseconds.compare_exchange_weak(maxNanoseconds, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogramData LatencyHistogram::getData() const
+{
+    LatencyHistogramData result;
+    result.counts.reserve(NumBuckets);
+    for (auto const& count : _counts) {
+        result.counts.emplace_back(count.load(std::memory_order_relaxed));
+        result.numSamples += result.counts.back();
+    }
+    if (result.numSamples > 0) {
+        result.meanMicroseconds = static_cast<double>(_sumNanoseconds.load(std::memory_order_relaxed)) / 1000 / result.numSamples;
+    }
+    result.maxMicroseconds = static_cast<double>(_maxNanoseconds.load(std::memory_order_relaxed)) / 1000;
+    return result;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& count : _counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    _sumNanoseconds.store(0, std::memory_order_relaxed);
+    _maxNanoseconds.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "Definitions.h"
+
+struct LatencyHistogramData
+{
+    //bucket 0: [0, 2) microseconds, bucket i > 0: [2^i, 2^(i+1)) microseconds
+    std::vector<uint64_t> counts;
+    uint64_t numSamples = 0;
+    double meanMicroseconds = 0;
+    double maxMicroseconds = 0;
+
+    //upper bound of the bucket containing the given percentile (0 <= percentile <= 100)
+    double getPercentileMicroseconds(double percentile) const;
+};
+
+/**
+ * Thread-safe histogram of durations with logarithmic buckets.
+ * Recording is wait-free and can be performed from arbitrary threads.
+ */
+class LatencyHistogram
+{
+public:
+    static int constexpr NumBuckets = 32;
+
+    void record(std::chrono::steady_clock::duration const& duration);
+
+    LatencyHistogramData getData() const;
+    void reset();
+
+private:
+    std::array<std::atomic<uint64_t>, NumBuckets> _counts = {};
+    std::atomic<uint64_t> _sumNanoseconds{0};
+    std::atomic<uint64_t> _maxNanoseconds{0};
+};
@@ -1,26 +1,27 @@
-#include <sstream>
-#include <thread>
+#include <optional>
 #include <random>
 
 #include "NumberGenerator.h"
+#include "RandomStream.h"
 
 namespace
 {
-    double const RandMax = 4294967296.0;
+    int const IdBlockSize = 1024;
+
+    struct IdBlock
+    {
+        uint64_t nextId = 0;
+        uint64_t endId = 0;
+    };
+    thread_local IdBlock threadIdBlock;
+    thread_local std::optional<RandomStream> threadRandomStream;
 }
 
 NumberGenerator::NumberGenerator()
 {
     _threadId = static_cast<uint64_t>(1) << 48;
-    _arrayOfRandomNumbers.reserve(1323781);
-    _runningNumber = 0;
-    std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<> distrib(0);
-
-    for (uint32_t i = 0; i < 1323781; ++i) {
-        _arrayOfRandomNumbers.emplace_back(distrib(gen));
-    }
+    std::random_device rd;
+    _seed = (static_cast<uint64_t>(rd()) << 32) | rd();
 }
 
 NumberGenerator::~NumberGenerator()
@@ -35,47 +36,53 @@ NumberGenerator& NumberGenerator::getInstance()
 
 uint32_t NumberGenerator::getRandomInt()
 {
-	return getNumberFromArray();
+    return getRandomStream().getRandomInt();
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+    return getRandomStream().getRandomInt(range);
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t min, uint32_t max)
 {
-    auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
-}
-
-uint32_t NumberGenerator::getLargeRandomInt(uint32_t range)
-{
-	return getNumberFromArray() % (range + 1);
+    return getRandomStream().getRandomInt(min, max);
 }
 
 double NumberGenerator::getRandomReal(double min, double max)
 {
-	return static_cast<double>(getLargeRandomInt(static_cast<int>((max - min) * 1000)) / 1000.0 + min);
+    return getRandomStream().getRandomReal(min, max);
 }
 
 float NumberGenerator::getRandomFloat(float min, float max)
 {
-    return toFloat(getRandomReal(min, max));
+    return getRandomStream().getRandomFloat(min, max);
 }
 
 double NumberGenerator::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / RandMax;
+    return getRandomStream().getRandomReal();
 }
 
 uint64_t NumberGenerator::getId()
 {
-	return _threadId | ++_runningNumber;
+    auto& idBlock = threadIdBlock;
+    if (idBlock.nextId == idBlock.endId) {
+        idBlock.nextId = _runningNumber.fetch_add(IdBlockSize) + 1;
+        idBlock.endId = idBlock.nextId + IdBlockSize;
+    }
+    return _threadId | idBlock.nextId++;
 }
 
-uint32_t NumberGenerator::getNumberFromArray()
+uint64_t NumberGenerator::reserveIds(int count)
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+    return _threadId | (_runningNumber.fetch_add(count) + 1);
+}
+
+RandomStream& NumberGenerator::getRandomStream()
+{
+    if (!threadRandomStream) {
+        threadRandomStream.emplace(_seed, _numRandomStreams++);
+    }
+    return *threadRandomStream;
 }
@@ -1,7 +1,16 @@
 #pragma once
 
+#include <atomic>
+
 #include "Definitions.h"
 
+class RandomStream;
+
+/**
+ * Thread-safe source of ids and random numbers.
+ * Every thread draws random numbers from an own stream and ids from an own block of the global id range, hence calls do not contend.
+ * Use RandomStream directly for reproducible results.
+ */
 class NumberGenerator
 {
 public:
@@ -15,21 +24,20 @@ public:
     float getRandomFloat(float min, float max);
 
 	uint64_t getId();
+    uint64_t reserveIds(int count);  //returns the first of count consecutive ids
 
 public:
     NumberGenerator(NumberGenerator const&) = delete;
     void operator=(NumberGenerator const&) = delete;
 
-	uint32_t getLargeRandomInt(uint32_t range);
-    uint32_t getNumberFromArray();
-
 private:
     NumberGenerator();
     ~NumberGenerator();
 
-	int _index = 0;
-	std::vector<uint32_t> _arrayOfRandomNumbers;
-	uint64_t _runningNumber = 0;
+    RandomStream& getRandomStream();
+
+    uint64_t _seed = 0;
+    std::atomic<uint64_t> _numRandomStreams{0};
+	std::atomic<uint64_t> _runningNumber{0};
 	uint64_t _threadId = 0;
 };
-
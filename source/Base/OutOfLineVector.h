@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Vector whose storage is allocated only when elements are present.
+ * Its footprint in the containing object is a single pointer, which pays off for rarely used element lists.
+ */
+template <typename T>
+class OutOfLineVector
+{
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    OutOfLineVector() = default;
+    OutOfLineVector(std::vector<T> const& values) { *this = values; }
+    OutOfLineVector(OutOfLineVector const& other) { *this = other; }
+    OutOfLineVector(OutOfLineVector&& other) noexcept = default;
+
+    OutOfLineVector& operator=(OutOfLineVector const& other)
+    {
+        if (this != &other) {
+            _values = other._values ? std::make_unique<std::vector<T>>(*other._values) : nullptr;
+        }
+        return *this;
+    }
+    OutOfLineVector& operator=(OutOfLineVector&& other) noexcept = default;
+    OutOfLineVector& operator=(std::vector<T> const& values)
+    {
+        _values = values.empty() ? nullptr : std::make_unique<std::vector<T>>(values);
+        return *this;
+    }
+
+    bool operator==(OutOfLineVector const& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+    bool operator!=(OutOfLineVector const& other) const { return !operator==(other); }
+
+    size_t size() const { return _values ? _values->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { return _values ? _values->data() : nullptr; }
+    iterator end() { return begin() + size(); }
+    const_iterator begin() const { return _values ? _values->data() : nullptr; }
+    const_iterator end() const { return begin() + size(); }
+
+    T& operator[](size_t index) { return (*_values)[index]; }
+    T const& operator[](size_t index) const { return (*_values)[index]; }
+    T& at(size_t index) { return getValues().at(index); }
+    T const& at(size_t index) const { return getValues().at(index); }
+    T& front() { return _values->front(); }
+    T const& front() const { return _values->front(); }
+    T& back() { return _values->back(); }
+    T const& back() const { return _values->back(); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (!_values) {
+            _values = std::make_unique<std::vector<T>>();
+        }
+        return _values->emplace_back(std::forward<Args>(args)...);
+    }
+    void push_back(T const& value) { emplace_back(value); }
+
+    iterator insert(const_iterator pos, T const& value)
+    {
+        auto index = pos - begin();
+        if (!_values) {
+            _values = std::make_unique<std::vector<T>>();
+        }
+        _values->insert(_values->begin() + index, value);
+        return begin() + index;
+    }
+    iterator erase(const_iterator pos)
+    {
+        auto index = pos - begin();
+        _values->erase(_values->begin() + index);
+        if (_values->empty()) {
+            _values.reset();
+            return nullptr;
+        }
+        return begin() + index;
+    }
+    void clear() { _values.reset(); }
+
+    std::vector<T> toVector() const { return _values ? *_values : std::vector<T>(); }
+
+private:
+    std::vector<T> const& getValues() const
+    {
+        if (!_values) {
+            throw std::out_of_range("OutOfLineVector::at");
+        }
+        return *_values;
+    }
+    std::vector<T>& getValues()
+    {
+        if (!_values) {
+            throw std::out_of_range("OutOfLineVector::at");
+        }
+        return *_values;
+    }
+
+    std::unique_ptr<std::vector<T>> _values;  //nullptr if empty
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counter-based random number generator (splitmix64).
+ * The sequence only depends on the seed and the stream indices, hence independent streams can be evaluated in parallel and in any order
+ * with reproducible results.
+ */
+class RandomStream
+{
+public:
+    RandomStream(uint64_t seed, uint64_t streamIndex = 0, uint64_t subStreamIndex = 0)
+        : _state(mix(seed) ^ (streamIndex * 0x9e3779b97f4a7c15ull) ^ (subStreamIndex * 0xc2b2ae3d27d4eb4full))
+    {}
+
+    uint64_t getRandomUInt64()
+    {
+        _state += 0x9e3779b97f4a7c15ull;
+        return mix(_state);
+    }
+    uint32_t getRandomInt() { return static_cast<uint32_t>(getRandomUInt64() >> 32); }
+    uint32_t getRandomInt(uint32_t range) { return static_cast<uint32_t>((uint64_t(getRandomInt()) * range) >> 32); }  //result in [0, range)
+    uint32_t getRandomInt(uint32_t min, uint32_t max) { return min + getRandomInt(max - min + 1); }                     //result in [min, max]
+    double getRandomReal() { return double(getRandomUInt64() >> 11) / double(1ull << 53); }                               //result in [0, 1)
+    double getRandomReal(double min, double max) { return min + (max - min) * getRandomReal(); }
+    float getRandomFloat(float min, float max) { return static_cast<float>(getRandomReal(min, max)); }
+
+private:
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t _state;
+};
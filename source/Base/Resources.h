@@ -8,7 +8,9 @@ namespace Const
 
     auto const LogFilename = "log.txt";
     auto const AutosaveFile = BasePath + "autosave.sim";
+    auto const AutosaveSnapshotFile = BasePath + "autosave-snapshot.bin";  //must not share its stem with AutosaveFile (settings files)
     auto const SettingsFilename = BasePath + "settings.json";
+    auto const StatisticsLogFile = BasePath + "statistics.log";
 
     auto const SimulationFragmentShader = BasePath + "shader.fs";
     auto const SimulationVertexShader = BasePath + "shader.vs";
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "Definitions.h"
+
+/**
+ * Publishes values of a trivially copyable type from a single writer to arbitrary many readers.
+ * Neither the writer nor the readers block each other: readers retry if a write happened during their read.
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() { store(T()); }
+
+    //must only be called from one thread at a time
+    void store(T const& value)
+    {
+        std::array<uint64_t, NumWords> words = {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        auto sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);  //odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < NumWords; ++i) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T load() const
+    {
+        std::array<uint64_t, NumWords> words;
+        while (true) {
+            auto sequenceBefore = _sequence.load(std::memory_order_acquire);
+            if (sequenceBefore % 2 == 0) {
+                for (int i = 0; i < NumWords; ++i) {
+                    words[i] = _words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+        T result;
+        std::memcpy(&result, words.data(), sizeof(T));
+        return result;
+    }
+
+private:
+    static int constexpr NumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> _sequence{0};
+    std::array<std::atomic<uint64_t>, NumWords> _words = {};
+};
@@ -0,0 +1,165 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace
+{
+    thread_local int currentWorkerIndex = -1;
+
+    int const ChunksPerThread = 4;
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::ThreadPool()
+{
+    auto numWorkers = std::max(1, toInt(std::thread::hardware_concurrency())) - 1;
+    for (int i = 0; i < std::max(1, numWorkers); ++i) {
+        _queues.emplace_back(std::make_unique<TaskQueue>());
+    }
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this, i] { runWorker(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutexForWakeup);
+        _isShutdown = true;
+    }
+    _wakeup.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return toInt(_workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(int begin, int end, std::function<void(int, int)> const& func, int grainSize)
+{
+    auto size = end - begin;
+    if (size <= 0) {
+        return;
+    }
+    if (grainSize <= 0) {
+        grainSize = std::max(1, size / (getNumThreads() * ChunksPerThread));
+    }
+    auto numChunks = (size + grainSize - 1) / grainSize;
+    if (numChunks == 1 || _workers.empty()) {
+        func(begin, end);
+        return;
+    }
+
+    std::atomic<int> remainingChunks{numChunks};
+    std::mutex mutexForException;
+    std::exception_ptr exception;
+
+    auto numQueues = toInt(_queues.size());
+    auto startQueueIndex = std::max(0, currentWorkerIndex);
+    for (int i = 0; i < numChunks; ++i) {
+        auto chunkBegin = begin + i * grainSize;
+        auto chunkEnd = std::min(end, chunkBegin + grainSize);
+        pushTask((startQueueIndex + i) % numQueues, [&, chunkBegin, chunkEnd] {
+            try {
+                func(chunkBegin, chunkEnd);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutexForException);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+            --remainingChunks;
+        });
+    }
+    _wakeup.notify_all();
+
+    //calling thread helps until all chunks of this call are processed
+    while (remainingChunks.load() > 0) {
+        if (!tryRunTask(startQueueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::parallelForThreads(std::function<void(int)> const& func)
+{
+    parallelFor(
+        0,
+        getNumThreads(),
+        [&](int startIndex, int endIndex) {
+            for (int i = startIndex; i < endIndex; ++i) {
+                func(i);
+            }
+        },
+        1);
+}
+
+void ThreadPool::runWorker(int workerIndex)
+{
+    currentWorkerIndex = workerIndex;
+    while (true) {
+        if (tryRunTask(workerIndex)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_mutexForWakeup);
+        _wakeup.wait(lock, [this] { return _isShutdown.load() || _numQueuedTasks.load() > 0; });
+        if (_isShutdown) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::pushTask(int queueIndex, Task&& task)
+{
+    auto& queue = *_queues.at(queueIndex);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutexForWakeup);
+        ++_numQueuedTasks;
+    }
+}
+
+bool ThreadPool::tryRunTask(int preferredQueueIndex)
+{
+    auto numQueues = toInt(_queues.size());
+    for (int i = 0; i < numQueues; ++i) {
+        auto queueIndex = (preferredQueueIndex + i) % numQueues;
+        auto& queue = *_queues.at(queueIndex);
+
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+
+            //own queue is processed in FIFO order, foreign queues are robbed from the back
+            if (i == 0) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            } else {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+        }
+        --_numQueuedTasks;
+        task();
+        return true;
+    }
+    return false;
+}
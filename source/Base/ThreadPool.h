@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Definitions.h"
+
+/**
+ * Work-stealing thread pool for host-side data parallelism.
+ * Every worker owns a task queue and steals from the queues of other workers when idle.
+ * The calling thread of parallelFor participates in processing, hence nested calls are allowed.
+ */
+class ThreadPool
+{
+public:
+    static ThreadPool& getInstance();
+
+    int getNumThreads() const;  //including calling thread
+
+    //calls func(startIndex, endIndex) for disjoint chunks of [begin, end) and waits until all chunks are processed
+    //grainSize = 0: chunk size is chosen automatically
+    void parallelFor(int begin, int end, std::function<void(int, int)> const& func, int grainSize = 0);
+
+    //runs func(threadIndex) once per thread, threadIndex is in [0, getNumThreads())
+    void parallelForThreads(std::function<void(int)> const& func);
+
+public:
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+
+    using Task = std::function<void()>;
+
+    void runWorker(int workerIndex);
+    void pushTask(int queueIndex, Task&& task);
+    bool tryRunTask(int preferredQueueIndex);
+
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutexForWakeup;
+    std::condition_variable _wakeup;
+    std::atomic<int> _numQueuedTasks{0};
+    std::atomic<bool> _isShutdown{false};
+};
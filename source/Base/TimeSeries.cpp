@@ -0,0 +1,124 @@
+#include "TimeSeries.h"
+
+#include <algorithm>
+
+#include "Definitions.h"
+
+TimeSeriesRingBuffer::TimeSeriesRingBuffer(int numColumns, int capacity)
+    : _numColumns(numColumns)
+    , _capacity(capacity)
+    , _times(capacity * 2)
+    , _values(numColumns * capacity * 2)
+{}
+
+void TimeSeriesRingBuffer::add(float time, float const* values)
+{
+    int index;
+    if (_size < _capacity) {
+        index = (_start + _size) % _capacity;
+        ++_size;
+    } else {
+        index = _start;
+        _start = (_start + 1) % _capacity;
+    }
+    _times[index] = time;
+    _times[index + _capacity] = time;
+    for (int column = 0; column < _numColumns; ++column) {
+        auto columnValues = &_values[column * _capacity * 2];
+        columnValues[index] = values[column];
+        columnValues[index + _capacity] = values[column];
+    }
+}
+
+void TimeSeriesRingBuffer::clear()
+{
+    _start = 0;
+    _size = 0;
+}
+
+float TimeSeriesRingBuffer::getLastTime() const
+{
+    return _size > 0 ? getTimes()[_size - 1] : 0.0f;
+}
+
+float TimeSeriesRingBuffer::getLastValue(int column) const
+{
+    return _size > 0 ? getValues(column)[_size - 1] : 0.0f;
+}
+
+DownsampledTimeSeries::DownsampledTimeSeries(int numColumns, int maxBuckets)
+    : _numColumns(numColumns)
+    , _maxBuckets(maxBuckets + maxBuckets % 2)
+    , _means(numColumns)
+    , _mins(numColumns)
+    , _maxs(numColumns)
+{
+    _times.reserve(_maxBuckets);
+    for (int column = 0; column < numColumns; ++column) {
+        _means[column].reserve(_maxBuckets);
+        _mins[column].reserve(_maxBuckets);
+        _maxs[column].reserve(_maxBuckets);
+    }
+}
+
+void DownsampledTimeSeries::add(float time, float const* values)
+{
+    if (!_times.empty() && _samplesInLastBucket < _samplesPerBucket) {
+        auto numSamples = toFloat(_samplesInLastBucket);
+        for (int column = 0; column < _numColumns; ++column) {
+            auto& mean = _means[column].back();
+            mean = (mean * numSamples + values[column]) / (numSamples + 1.0f);
+            _mins[column].back() = std::min(_mins[column].back(), values[column]);
+            _maxs[column].back() = std::max(_maxs[column].back(), values[column]);
+        }
+        ++_samplesInLastBucket;
+        return;
+    }
+
+    if (getSize() == _maxBuckets) {
+        mergeBuckets();
+    }
+    _times.emplace_back(time);
+    for (int column = 0; column < _numColumns; ++column) {
+        _means[column].emplace_back(values[column]);
+        _mins[column].emplace_back(values[column]);
+        _maxs[column].emplace_back(values[column]);
+    }
+    _samplesInLastBucket = 1;
+}
+
+void DownsampledTimeSeries::clear()
+{
+    _samplesPerBucket = 1;
+    _samplesInLastBucket = 0;
+    _times.clear();
+    for (int column = 0; column < _numColumns; ++column) {
+        _means[column].clear();
+        _mins[column].clear();
+        _maxs[column].clear();
+    }
+}
+
+//all buckets are full at this point, hence pairs of buckets have equal weights
+void DownsampledTimeSeries::mergeBuckets()
+{
+    auto numMergedBuckets = getSize() / 2;
+    for (int i = 0; i < numMergedBuckets; ++i) {
+        _times[i] = _times[i * 2];
+    }
+    _times.resize(numMergedBuckets);
+    for (int column = 0; column < _numColumns; ++column) {
+        auto& means = _means[column];
+        auto& mins = _mins[column];
+        auto& maxs = _maxs[column];
+        for (int i = 0; i < numMergedBuckets; ++i) {
+            means[i] = (means[i * 2] + means[i * 2 + 1]) / 2;
+            mins[i] = std::min(mins[i * 2], mins[i * 2 + 1]);
+            maxs[i] = std::max(maxs[i * 2], maxs[i * 2 + 1]);
+        }
+        means.resize(numMergedBuckets);
+        mins.resize(numMergedBuckets);
+        maxs.resize(numMergedBuckets);
+    }
+    _samplesPerBucket *= 2;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Columnar time series of fixed capacity where new values overwrite the oldest ones.
+ * Every value is stored twice (at i and i + capacity), hence the values of a column are always contiguous
+ * in chronological order and can be passed to plotting functions without copying.
+ */
+class TimeSeriesRingBuffer
+{
+public:
+    TimeSeriesRingBuffer(int numColumns, int capacity);
+
+    void add(float time, float const* values);  //values contains one entry per column
+    void clear();
+
+    int getSize() const { return _size; }
+    int getCapacity() const { return _capacity; }
+    bool isEmpty() const { return _size == 0; }
+
+    float const* getTimes() const { return &_times[_start]; }
+    float const* getValues(int column) const { return &_values[column * _capacity * 2 + _start]; }
+    float getLastTime() const;
+    float getLastValue(int column) const;
+
+private:
+    int _numColumns;
+    int _capacity;
+    int _start = 0;
+    int _size = 0;
+    std::vector<float> _times;
+    std::vector<float> _values;
+};
+
+/**
+ * Columnar time series with bounded memory covering all values ever added.
+ * Values are aggregated in buckets providing mean, minimum and maximum. When all buckets are in use, adjacent buckets
+ * are merged pairwise so that the resolution halves and new values can be added at constant amortized cost.
+ */
+class DownsampledTimeSeries
+{
+public:
+    DownsampledTimeSeries(int numColumns, int maxBuckets);  //maxBuckets is rounded up to an even number
+
+    void add(float time, float const* values);
+    void clear();
+
+    int getSize() const { return static_cast<int>(_times.size()); }
+    int getMaxBuckets() const { return _maxBuckets; }
+    int getSamplesPerBucket() const { return _samplesPerBucket; }
+    bool isEmpty() const { return _times.empty(); }
+
+    float const* getTimes() const { return _times.data(); }  //time of the first value in each bucket
+    float const* getMeans(int column) const { return _means[column].data(); }
+    float const* getMins(int column) const { return _mins[column].data(); }
+    float const* getMaxs(int column) const { return _maxs[column].data(); }
+
+private:
+    void mergeBuckets();
+
+    int _numColumns;
+    int _maxBuckets;
+    int _samplesPerBucket = 1;
+    int _samplesInLastBucket = 0;
+    std::vector<float> _times;
+    std::vector<std::vector<float>> _means;
+    std::vector<std::vector<float>> _mins;
+    std::vector<std::vector<float>> _maxs;
+};
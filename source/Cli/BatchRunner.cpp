@@ -0,0 +1,159 @@
+#include "BatchRunner.h"
+
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#include "Base/LoggingService.h"
+#include "EngineInterface/BulkDataDescription.h"
+#include "EngineInterface/MonitorDataFormatter.h"
+#include "EngineInterface/Serializer.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/TimestepProfile.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+namespace
+{
+    std::chrono::milliseconds const PollInterval(10);
+}
+
+BatchRunner::BatchRunner(BatchRunnerSettings const& settings)
+    : _settings(settings)
+{}
+
+void BatchRunner::run()
+{
+    DeserializedSimulation simulation;
+    if (!Serializer::deserializeSimulationFromFiles(simulation, _settings.simulationFilename)) {
+        throw std::runtime_error("The simulation file '" + _settings.simulationFilename + "' could not be loaded.");
+    }
+    simulation.settings.backend = _settings.cpuBackend ? SimulationBackend::Cpu : SimulationBackend::Cuda;
+    if (_settings.cpuBackend) {
+        checkCpuBackendSupport(simulation.content);
+    }
+
+    std::filesystem::create_directories(_settings.outputDirectory);
+    auto statisticsFilename = (std::filesystem::path(_settings.outputDirectory) / "statistics.csv").string();
+    _statisticsFile.open(statisticsFilename, std::ios_base::out);
+    if (!_statisticsFile) {
+        throw std::runtime_error("The statistics file '" + statisticsFilename + "' could not be created.");
+    }
+    _statisticsFile << MonitorDataFormatter::getCsvHeader() << std::endl;
+
+    _simController = std::make_shared<_SimulationControllerImpl>();
+    if (!_settings.cpuBackend) {
+        _simController->initCuda();
+    }
+    _simController->newSimulation(simulation.timestep, simulation.settings, simulation.symbolMap);
+    _simController->setClusteredSimulationData(simulation.content);
+    _simController->setTpsRestriction(std::nullopt);
+    _simController->setTimestepProfilingEnabled(_settings.profile);
+    simulation.content = ClusteredDataDescription();
+    sampleStatistics();
+
+    auto startTimestep = _simController->getCurrentTimestep();
+    auto endTimestep = startTimestep + _settings.numTimesteps;
+    auto nextSnapshotTimestep = _settings.snapshotInterval > 0 ? startTimestep + _settings.snapshotInterval : endTimestep;
+    std::chrono::duration<double> simulationTime(0);
+
+    while (_simController->getCurrentTimestep() < endTimestep) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        _simController->runSimulationUntil(std::min(nextSnapshotTimestep, endTimestep));
+        while (_simController->isSimulationRunning()) {
+            std::this_thread::sleep_for(PollInterval);
+            sampleStatistics();
+        }
+        simulationTime += std::chrono::steady_clock::now() - startTimepoint;
+        sampleStatistics();
+
+        if (_simController->getCurrentTimestep() >= nextSnapshotTimestep && nextSnapshotTimestep < endTimestep) {
+            writeSnapshot();
+            nextSnapshotTimestep += _settings.snapshotInterval;
+        }
+    }
+    writeSnapshot();
+    _statisticsFile.close();
+    if (_settings.profile) {
+        writeProfile();
+    }
+
+    printThroughput(_simController->getCurrentTimestep() - startTimestep, simulationTime);
+    _simController->closeSimulation();
+}
+
+void BatchRunner::checkCpuBackendSupport(ClusteredDataDescription const& content) const
+{
+    int numCellsWithFunctions = 0;
+    int numTokens = 0;
+    for (auto const& cluster : content.clusters) {
+        for (auto const& cell : cluster.cells) {
+            if (cell.cellFeature.getType() != Enums::CellFunction_Computation) {
+                ++numCellsWithFunctions;
+            }
+            numTokens += toInt(cell.tokens.size());
+        }
+    }
+    if (numCellsWithFunctions == 0 && numTokens == 0) {
+        return;
+    }
+    auto message = "The simulation contains " + std::to_string(numCellsWithFunctions) + " cells with cell functions and " + std::to_string(numTokens)
+        + " tokens, which the CPU backend does not execute.";
+    if (!_settings.ignoreCellFunctions) {
+        throw std::runtime_error(message + " Use --ignore-cell-functions to run it anyway.");
+    }
+    log(Priority::Important, "warning: " + message);
+}
+
+void BatchRunner::sampleStatistics()
+{
+    auto statistics = _simController->getStatistics();
+    if (_lastStatisticsTimestep && statistics.timeStep < *_lastStatisticsTimestep + _settings.statisticsInterval) {
+        return;
+    }
+    _lastStatisticsTimestep = statistics.timeStep;
+
+    int numCells = 0;
+    for (auto const& numCellsOfColor : statistics.numCellsByColor) {
+        numCells += numCellsOfColor;
+    }
+    _accumulatedNumCells += numCells;
+    ++_numStatisticsSamples;
+
+    _statisticsFile << MonitorDataFormatter::getCsvRow(statistics) << std::endl;
+}
+
+void BatchRunner::writeSnapshot()
+{
+    DeserializedSimulation simulation;
+    simulation.timestep = _simController->getCurrentTimestep();
+    simulation.settings = _simController->getSettings();
+    simulation.symbolMap = _simController->getSymbolMap();
+
+    auto filename = (std::filesystem::path(_settings.outputDirectory) / ("timestep" + std::to_string(simulation.timestep) + ".sim")).string();
+    if (!Serializer::serializeSimulationToFiles(filename, simulation, _simController->getBulkSimulationData())) {
+        throw std::runtime_error("The snapshot '" + filename + "' could not be written.");
+    }
+    log(Priority::Important, "snapshot written to " + filename);
+}
+
+void BatchRunner::writeProfile()
+{
+    auto filename = (std::filesystem::path(_settings.outputDirectory) / "profile.json").string();
+    std::ofstream file(filename, std::ios_base::out);
+    if (!file) {
+        throw std::runtime_error("The profile file '" + filename + "' could not be created.");
+    }
+    file << TimestepProfileHelper::toChromeTrace(_simController->getTimestepProfiles());
+    log(Priority::Important, "profile of the last time steps written to " + filename);
+}
+
+void BatchRunner::printThroughput(uint64_t numTimesteps, std::chrono::duration<double> simulationTime) const
+{
+    auto seconds = std::max(simulationTime.count(), 1e-9);
+    auto averageNumCells = _numStatisticsSamples > 0 ? static_cast<double>(_accumulatedNumCells) / _numStatisticsSamples : 0.0;
+    std::cout << "time steps: " << numTimesteps << std::endl
+              << "simulation time (without snapshots): " << seconds << "s" << std::endl
+              << "time steps per second: " << numTimesteps / seconds << std::endl
+              << "average number of cells: " << averageNumCells << std::endl
+              << "cell updates per second: " << averageNumCells * numTimesteps / seconds << std::endl;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/MonitorData.h"
+
+struct BatchRunnerSettings
+{
+    std::string simulationFilename;
+    std::string outputDirectory = ".";
+    uint64_t numTimesteps = 0;
+    uint64_t snapshotInterval = 0;    //in time steps, 0 = only final snapshot
+    uint64_t statisticsInterval = 100;  //minimal number of time steps between two rows of the statistics file
+    bool cpuBackend = false;
+    bool ignoreCellFunctions = false;  //run worlds with cell functions or tokens on the CPU backend, which does not execute them
+    bool profile = false;  //write the stages of the last time steps as trace events to profile.json
+};
+
+/**
+ * Runs a simulation without GUI for a given number of time steps at maximum speed.
+ * Snapshots are written as simulation files and monitor data as comma-separated values to the output directory.
+ */
+class BatchRunner
+{
+public:
+    BatchRunner(BatchRunnerSettings const& settings);
+
+    void run();
+
+private:
+    void checkCpuBackendSupport(ClusteredDataDescription const& content) const;
+    void sampleStatistics();
+    void writeSnapshot();
+    void writeProfile();
+    void printThroughput(uint64_t numTimesteps, std::chrono::duration<double> simulationTime) const;
+
+    BatchRunnerSettings _settings;
+    SimulationController _simController;
+
+    std::ofstream _statisticsFile;
+    std::optional<uint64_t> _lastStatisticsTimestep;
+    uint64_t _accumulatedNumCells = 0;
+    uint64_t _numStatisticsSamples = 0;
+};
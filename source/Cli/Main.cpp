@@ -0,0 +1,92 @@
+#include <iostream>
+
+#include "Base/LoggingService.h"
+
+#include "BatchRunner.h"
+
+namespace
+{
+    class ConsoleLogger : public LoggingCallBack
+    {
+    public:
+        ConsoleLogger() { LoggingService::getInstance().registerCallBack(this); }
+        ~ConsoleLogger() { LoggingService::getInstance().unregisterCallBack(this); }
+
+        void newLogMessage(Priority priority, std::string const& message) override
+        {
+            if (priority == Priority::Important) {
+                std::cerr << message << std::endl;
+            }
+        }
+    };
+
+    void printUsage()
+    {
+        std::cerr << "usage: alien-cli <simulation file> --timesteps <number> [options]" << std::endl
+                  << "options:" << std::endl
+                  << "  --output <directory>            directory for snapshots and statistics.csv (default: current directory)" << std::endl
+                  << "  --snapshot-interval <number>    time steps between two snapshots (default: only final snapshot)" << std::endl
+                  << "  --statistics-interval <number>  minimal time steps between two statistics entries (default: 100)" << std::endl
+                  << "  --cpu                           use the CPU reference backend instead of CUDA" << std::endl
+                  << "  --ignore-cell-functions         run worlds with cell functions or tokens on the CPU backend without executing them" << std::endl
+                  << "  --profile                       write the stage durations of the last time steps to profile.json" << std::endl;
+    }
+
+    std::optional<BatchRunnerSettings> parseArguments(int argc, char** argv)
+    {
+        BatchRunnerSettings result;
+        std::optional<uint64_t> numTimesteps;
+        for (int i = 1; i < argc; ++i) {
+            std::string argument = argv[i];
+            auto hasValue = i + 1 < argc;
+            if (argument == "--timesteps" && hasValue) {
+                numTimesteps = std::stoull(argv[++i]);
+            } else if (argument == "--output" && hasValue) {
+                result.outputDirectory = argv[++i];
+            } else if (argument == "--snapshot-interval" && hasValue) {
+                result.snapshotInterval = std::stoull(argv[++i]);
+            } else if (argument == "--statistics-interval" && hasValue) {
+                result.statisticsInterval = std::stoull(argv[++i]);
+            } else if (argument == "--cpu") {
+                result.cpuBackend = true;
+            } else if (argument == "--ignore-cell-functions") {
+                result.ignoreCellFunctions = true;
+            } else if (argument == "--profile") {
+                result.profile = true;
+            } else if (result.simulationFilename.empty() && argument.rfind("--", 0) != 0) {
+                result.simulationFilename = argument;
+            } else {
+                return std::nullopt;
+            }
+        }
+        if (result.simulationFilename.empty() || !numTimesteps) {
+            return std::nullopt;
+        }
+        result.numTimesteps = *numTimesteps;
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ConsoleLogger logger;
+
+    std::optional<BatchRunnerSettings> settings;
+    try {
+        settings = parseArguments(argc, argv);
+    } catch (std::exception const&) {
+    }
+    if (!settings) {
+        printUsage();
+        return 2;
+    }
+
+    try {
+        BatchRunner runner(*settings);
+        runner.run();
+    } catch (std::exception const& e) {
+        std::cerr << "The following exception occurred: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,6 +1,18 @@
 #pragma once
 
+#if defined(ALIEN_CUDA) || defined(__CUDACC__)
 #include <cuda_runtime.h>
+#else
+//vector types with the layout of the CUDA runtime for builds without the CUDA toolkit
+struct alignas(8) float2
+{
+    float x, y;
+};
+struct alignas(8) int2
+{
+    int x, y;
+};
+#endif
 #include <stdint.h>
 
 #define MAX_STRING_BYTES 50000000
@@ -11,83 +11,134 @@ class CudaMonitorData
 public:
     __host__ void init()
     {
-        CudaMemoryManager::getInstance().acquireMemory<NumCellsByColor>(1, _numCellsByColor);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numConnections);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numTokens);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numParticles);
-        CudaMemoryManager::getInstance().acquireMemory<double>(1, _internalEnergy);
-
-        CHECK_FOR_CUDA_ERROR(cudaMemset(_numCellsByColor, 0, sizeof(NumCellsByColor)));
-        CHECK_FOR_CUDA_ERROR(cudaMemset(_numConnections, 0, sizeof(int)));
-        CHECK_FOR_CUDA_ERROR(cudaMemset(_numTokens, 0, sizeof(int)));
-        CHECK_FOR_CUDA_ERROR(cudaMemset(_numParticles, 0, sizeof(int)));
-
-        double zero = 0.0;
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_internalEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
+        CudaMemoryManager::getInstance().acquireMemory<EntityData>(1, _entityData);
+        CudaMemoryManager::getInstance().acquireMemory<ClusterData>(1, _clusterData);
 
+        //all bits zero also represents 0.0 for the energies
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_entityData, 0, sizeof(EntityData)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_clusterData, 0, sizeof(ClusterData)));
     }
 
     __host__ void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_numCellsByColor);
-        CudaMemoryManager::getInstance().freeMemory(_numConnections);
-        CudaMemoryManager::getInstance().freeMemory(_numTokens);
-        CudaMemoryManager::getInstance().freeMemory(_numParticles);
-        CudaMemoryManager::getInstance().freeMemory(_internalEnergy);
+        CudaMemoryManager::getInstance().freeMemory(_entityData);
+        CudaMemoryManager::getInstance().freeMemory(_clusterData);
     }
 
-    using NumCellsByColor = int[7];
-    struct MonitorData
+    //both structures are transferred with a single copy each
+    struct EntityData
+    {
+        int numCellsByColor[7];
+        int numConnections;
+        int numParticles;
+        int numTokens;
+        double totalInternalEnergy;
+        double cellEnergyByColor[7];
+        int numCellsByFunction[Enums::CellFunction_Count];
+        int tokenEnergyHistogram[MonitorHistogramSize];
+    };
+    struct ClusterData
     {
-        uint64_t timeStep = 0;
-        NumCellsByColor numCellsByColor;
-        int numConnections = 0;
-        int numParticles = 0;
-        int numTokens = 0;
-        double totalInternalEnergy = 0.0;
+        int numClusters;
+        int clusterSizeHistogram[MonitorHistogramSize];
     };
-    __host__ MonitorData getMonitorData(uint64_t timeStep)
+
+    __host__ void getEntityMonitorData(MonitorData& data)
+    {
+        EntityData entityData;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&entityData, _entityData, sizeof(EntityData), cudaMemcpyDeviceToHost));
+        for (int i = 0; i < 7; ++i) {
+            data.numCellsByColor[i] = entityData.numCellsByColor[i];
+            data.cellEnergyByColor[i] = entityData.cellEnergyByColor[i];
+        }
+        data.numConnections = entityData.numConnections;
+        data.numParticles = entityData.numParticles;
+        data.numTokens = entityData.numTokens;
+        data.totalInternalEnergy = entityData.totalInternalEnergy;
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            data.numCellsByFunction[i] = entityData.numCellsByFunction[i];
+        }
+        for (int i = 0; i < MonitorHistogramSize; ++i) {
+            data.tokenEnergyHistogram[i] = entityData.tokenEnergyHistogram[i];
+        }
+    }
+
+    __host__ void getClusterMonitorData(MonitorData& data)
     {
-        MonitorData result;
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numCellsByColor, _numCellsByColor, sizeof(NumCellsByColor), cudaMemcpyDeviceToHost));
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numConnections, _numConnections, sizeof(int), cudaMemcpyDeviceToHost));
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numParticles, _numParticles, sizeof(int), cudaMemcpyDeviceToHost));
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numTokens, _numTokens, sizeof(int), cudaMemcpyDeviceToHost));
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.totalInternalEnergy, _internalEnergy, sizeof(double), cudaMemcpyDeviceToHost));
-        result.timeStep = timeStep;
-        return result;
+        ClusterData clusterData;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&clusterData, _clusterData, sizeof(ClusterData), cudaMemcpyDeviceToHost));
+        data.numClusters = clusterData.numClusters;
+        for (int i = 0; i < MonitorHistogramSize; ++i) {
+            data.clusterSizeHistogram[i] = clusterData.clusterSizeHistogram[i];
+        }
     }
 
-    __inline__ __device__ void reset()
+    __inline__ __device__ void resetEntityData()
     {
         for (int i = 0; i < 7; ++i) {
-            (*_numCellsByColor)[i] = 0;
+            _entityData->numCellsByColor[i] = 0;
+            _entityData->cellEnergyByColor[i] = 0.0;
+        }
+        _entityData->numConnections = 0;
+        _entityData->numTokens = 0;
+        _entityData->numParticles = 0;
+        _entityData->totalInternalEnergy = 0.0;
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            _entityData->numCellsByFunction[i] = 0;
+        }
+        for (int i = 0; i < MonitorHistogramSize; ++i) {
+            _entityData->tokenEnergyHistogram[i] = 0;
+        }
+    }
+
+    __inline__ __device__ void resetClusterData()
+    {
+        _clusterData->numClusters = 0;
+        for (int i = 0; i < MonitorHistogramSize; ++i) {
+            _clusterData->clusterSizeHistogram[i] = 0;
         }
-        *_numConnections = 0;
-        *_numTokens = 0;
-        *_numParticles = 0;
-        *_internalEnergy = 0.0f;
     }
 
-    __inline__ __device__ void incNumCell(int color) { atomicAdd(&(*_numCellsByColor)[color], 1); }
-    __inline__ __device__ void incNumConnections(int numConnections) { atomicAdd(_numConnections, numConnections); }
-    __inline__ __device__ void setNumParticles(int value) { *_numParticles = value; }
-    __inline__ __device__ void setNumTokens(int value) { *_numTokens = value; }
-    __inline__ __device__ void halveNumConnections() { *_numConnections /= 2; }
+    //the following functions are called once per block with partial results accumulated in shared memory
+    __inline__ __device__ void addNumCells(int color, int value) { atomicAdd(&_entityData->numCellsByColor[color], value); }
+    __inline__ __device__ void addCellEnergy(int color, float value) { atomicAddDouble(&_entityData->cellEnergyByColor[color], value); }
+    __inline__ __device__ void addNumCellsByFunction(int function, int value) { atomicAdd(&_entityData->numCellsByFunction[function], value); }
+    __inline__ __device__ void addNumConnections(int value) { atomicAdd(&_entityData->numConnections, value); }
+    __inline__ __device__ void addInternalEnergy(float value) { atomicAddDouble(&_entityData->totalInternalEnergy, value); }
+    __inline__ __device__ void addTokenEnergyHistogram(int bin, int value) { atomicAdd(&_entityData->tokenEnergyHistogram[bin], value); }
+    __inline__ __device__ void addNumClusters(int value) { atomicAdd(&_clusterData->numClusters, value); }
+    __inline__ __device__ void addClusterSizeHistogram(int bin, int value) { atomicAdd(&_clusterData->clusterSizeHistogram[bin], value); }
 
+    __inline__ __device__ void setNumParticles(int value) { _entityData->numParticles = value; }
+    __inline__ __device__ void setNumTokens(int value) { _entityData->numTokens = value; }
 
-/*
-    __inline__ __device__ void incInternalEnergy(float changeValue)
+    //called by a single thread after all partial results have been added
+    __inline__ __device__ void finishEntityData()
     {
-        atomicAdd(_internalEnergy, static_cast<double>(changeValue));
+        _entityData->numConnections /= 2;
+        for (int i = 0; i < 7; ++i) {
+            _entityData->totalInternalEnergy += _entityData->cellEnergyByColor[i];
+        }
     }
-*/
 
 private:
-    NumCellsByColor* _numCellsByColor;
-    int* _numConnections;
-    int* _numTokens;
-    int* _numParticles;
-    double* _internalEnergy;
+    //atomicAdd for doubles is only available from compute capability 6.0 on
+    __inline__ __device__ static void atomicAddDouble(double* address, double value)
+    {
+#if !defined(__CUDA_ARCH__) || __CUDA_ARCH__ >= 600
+        atomicAdd(address, value);
+#else
+        auto addressAsInt = reinterpret_cast<unsigned long long int*>(address);
+        auto old = *addressAsInt;
+        unsigned long long int assumed;
+        do {
+            assumed = old;
+            old = atomicCAS(addressAsInt, assumed, __double_as_longlong(value + __longlong_as_double(assumed)));
+        } while (assumed != old);
+#endif
+    }
+
+    EntityData* _entityData;
+    ClusterData* _clusterData;
 };
 
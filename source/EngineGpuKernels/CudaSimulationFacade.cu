@@ -4,6 +4,10 @@
 #include <iostream>
 #include <list>
 
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#endif
 #include <cuda_runtime.h>
 #include <cuda_gl_interop.h>
 
@@ -23,6 +27,7 @@
 #include "ConstantMemory.cuh"
 #include "CudaMemoryManager.cuh"
 #include "CudaMonitorData.cuh"
+#include "CudaTimestepProfiler.cuh"
 #include "Entities.cuh"
 #include "Map.cuh"
 #include "MonitorKernels.cuh"
@@ -142,6 +147,7 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     _renderingKernels = std::make_shared<_RenderingKernelsLauncher>();
     _editKernels = std::make_shared<_EditKernelsLauncher>();
     _monitorKernels = std::make_shared<_MonitorKernelsLauncher>();
+    _timestepProfiler = std::make_shared<_CudaTimestepProfiler>();
 
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numCells);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numParticles);
@@ -172,7 +178,7 @@ _CudaSimulationFacade::~_CudaSimulationFacade()
     log(Priority::Important, "close simulation");
 }
 
-void* _CudaSimulationFacade::registerImageResource(GLuint image)
+void* _CudaSimulationFacade::registerImageResource(unsigned int image)
 {
     cudaGraphicsResource* cudaResource;
 
@@ -182,11 +188,20 @@ void* _CudaSimulationFacade::registerImageResource(GLuint image)
     return reinterpret_cast<void*>(cudaResource);
 }
 
-void _CudaSimulationFacade::calcTimestep()
+void _CudaSimulationFacade::calcTimestep(TimestepProfile* profile)
 {
-    _simulationKernels->calcTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult);
+    _simulationKernels->calcTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult, profile ? _timestepProfiler.get() : nullptr);
     syncAndCheck();
 
+    if (profile) {
+        _timestepProfiler->finish(profile->stages);
+
+        //the pointer arrays have just been compacted by the garbage collector
+        profile->numCells = _cudaSimulationData->entities.cellPointers.getNumEntries_host();
+        profile->numParticles = _cudaSimulationData->entities.particlePointers.getNumEntries_host();
+        profile->numTokens = _cudaSimulationData->entities.tokenPointers.getNumEntries_host();
+    }
+
     automaticResizeArrays();
     ++_currentTimestep;
 }
@@ -405,28 +420,30 @@ auto _CudaSimulationFacade::getArraySizes() const -> ArraySizes
         _cudaSimulationData->entities.tokens.getSize_host()};
 }
 
-MonitorData _CudaSimulationFacade::getMonitorData()
+void _CudaSimulationFacade::getEntityMonitorData(MonitorData& data)
 {
-    _monitorKernels->getMonitorData(_settings.gpuSettings, *_cudaSimulationData, *_cudaMonitorData);
+    _monitorKernels->getEntityMonitorData(_settings.gpuSettings, *_cudaSimulationData, *_cudaMonitorData);
     syncAndCheck();
-    
-    MonitorData result;
-    auto monitorData = _cudaMonitorData->getMonitorData(getCurrentTimestep());
-    result.timeStep = monitorData.timeStep;
-    for (int i = 0; i < 7; ++i) {
-        result.numCellsByColor[i] = monitorData.numCellsByColor[i];
-    }
-    result.numConnections = monitorData.numConnections;
-    result.numParticles = monitorData.numParticles;
-    result.numTokens = monitorData.numTokens;
-    result.totalInternalEnergy = monitorData.totalInternalEnergy;
 
+    _cudaMonitorData->getEntityMonitorData(data);
+}
+
+void _CudaSimulationFacade::getProcessMonitorData(MonitorData& data)
+{
     auto processStatistics = _cudaSimulationResult->getProcessMonitorData();
-    result.numCreatedCells = processStatistics.createdCells;
-    result.numSuccessfulAttacks = processStatistics.sucessfulAttacks;
-    result.numFailedAttacks = processStatistics.failedAttacks;
-    result.numMuscleActivities = processStatistics.muscleActivities;
-    return result;
+    data.numCreatedCells = processStatistics.createdCells;
+    data.numSuccessfulAttacks = processStatistics.sucessfulAttacks;
+    data.numFailedAttacks = processStatistics.failedAttacks;
+    data.numMuscleActivities = processStatistics.muscleActivities;
+    data.garbageCollectionTime = _simulationKernels->getGarbageCollector()->getAndResetMeanTimestepCleanupDuration();
+}
+
+void _CudaSimulationFacade::getClusterMonitorData(MonitorData& data)
+{
+    _monitorKernels->getClusterMonitorData(_settings.gpuSettings, *_cudaSimulationData, *_cudaMonitorData);
+    syncAndCheck();
+
+    _cudaMonitorData->getClusterMonitorData(data);
 }
 
 uint64_t _CudaSimulationFacade::getCurrentTimestep() const
@@ -4,71 +4,63 @@
 #include <atomic>
 #include <vector>
 
-#if defined(_WIN32)
-#define NOMINMAX
-#include <windows.h>
-#endif
-#include <GL/gl.h>
-
-#include "EngineInterface/MonitorData.h"
-#include "EngineInterface/Settings.h"
-#include "EngineInterface/SelectionShallowData.h"
-#include "EngineInterface/ShallowUpdateSelectionData.h"
-
 #include "Definitions.cuh"
+#include "SimulationFacade.cuh"
 
-class _CudaSimulationFacade
+class _CudaSimulationFacade : public _SimulationFacade
 {
 public:
     static void initCuda();
 
     _CudaSimulationFacade(uint64_t timestep, Settings const& settings);
-    ~_CudaSimulationFacade();
-
-    void* registerImageResource(GLuint image);
-
-    void calcTimestep();
-
-    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom);
-    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
-    void getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO);
-    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO);
-    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
-    void addAndSelectSimulationData(DataAccessTO const& dataTO);
-    void setSimulationData(DataAccessTO const& dataTO);
-    void removeSelectedEntities(bool includeClusters);
-    void relaxSelectedEntities(bool includeClusters);
-    void uniformVelocitiesForSelectedEntities(bool includeClusters);
-    void makeSticky(bool includeClusters);
-    void removeStickiness(bool includeClusters);
-    void setBarrier(bool value, bool includeClusters);
-    void changeInspectedSimulationData(DataAccessTO const& changeDataTO);
-
-    void applyForce(ApplyForceData const& applyData);
-    void switchSelection(PointSelectionData const& switchData);
-    void swapSelection(PointSelectionData const& selectionData);
-    void setSelection(AreaSelectionData const& selectionData);
-    SelectionShallowData getSelectionShallowData();
-    void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData);
-    void removeSelection();
-    void updateSelection();
-    void colorSelectedEntities(unsigned char color, bool includeClusters);
-    void reconnectSelectedEntities();
-
-    void setGpuConstants(GpuSettings const& cudaConstants);
-    void setSimulationParameters(SimulationParameters const& parameters);
-    void setSimulationParametersSpots(SimulationParametersSpots const& spots);
-    void setFlowFieldSettings(FlowFieldSettings const& settings);
-
-    ArraySizes getArraySizes() const;
-
-    MonitorData getMonitorData();
-    uint64_t getCurrentTimestep() const;
-    void setCurrentTimestep(uint64_t timestep);
-
-    void clear();
-
-    void resizeArraysIfNecessary(ArraySizes const& additionals);
+    ~_CudaSimulationFacade() override;
+
+    void* registerImageResource(unsigned int image) override;
+
+    void calcTimestep(TimestepProfile* profile) override;
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) override;
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) override;
+    void getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO) override;
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO) override;
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) override;
+    void addAndSelectSimulationData(DataAccessTO const& dataTO) override;
+    void setSimulationData(DataAccessTO const& dataTO) override;
+    void removeSelectedEntities(bool includeClusters) override;
+    void relaxSelectedEntities(bool includeClusters) override;
+    void uniformVelocitiesForSelectedEntities(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void changeInspectedSimulationData(DataAccessTO const& changeDataTO) override;
+
+    void applyForce(ApplyForceData const& applyData) override;
+    void switchSelection(PointSelectionData const& switchData) override;
+    void swapSelection(PointSelectionData const& selectionData) override;
+    void setSelection(AreaSelectionData const& selectionData) override;
+    SelectionShallowData getSelectionShallowData() override;
+    void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData) override;
+    void removeSelection() override;
+    void updateSelection() override;
+    void colorSelectedEntities(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedEntities() override;
+
+    void setGpuConstants(GpuSettings const& cudaConstants) override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+    void setSimulationParametersSpots(SimulationParametersSpots const& spots) override;
+    void setFlowFieldSettings(FlowFieldSettings const& settings) override;
+
+    ArraySizes getArraySizes() const override;
+
+    void getEntityMonitorData(MonitorData& data) override;
+    void getProcessMonitorData(MonitorData& data) override;
+    void getClusterMonitorData(MonitorData& data) override;
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t timestep) override;
+
+    void clear() override;
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals) override;
 
 private:
     void syncAndCheck();
@@ -93,4 +85,5 @@ private:
     RenderingKernelsLauncher _renderingKernels;
     EditKernelsLauncher _editKernels;
     MonitorKernelsLauncher _monitorKernels;
+    CudaTimestepProfiler _timestepProfiler;
 };
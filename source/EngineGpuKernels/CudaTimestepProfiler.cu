@@ -0,0 +1,53 @@
+﻿#include "CudaTimestepProfiler.cuh"
+
+#include "Base/Definitions.h"
+
+#include "Macros.cuh"
+
+_CudaTimestepProfiler::~_CudaTimestepProfiler()
+{
+    for (auto const& event : _events) {
+        cudaEventDestroy(event);
+    }
+}
+
+void _CudaTimestepProfiler::begin()
+{
+    _numRecordedEvents = 0;
+    _stageNames.clear();
+    recordEvent();
+}
+
+void _CudaTimestepProfiler::endStage(char const* name)
+{
+    _stageNames.emplace_back(name);
+    recordEvent();
+}
+
+void _CudaTimestepProfiler::finish(std::vector<TimestepStage>& stages)
+{
+    stages.clear();
+    if (_numRecordedEvents == 0) {
+        return;
+    }
+    CHECK_FOR_CUDA_ERROR(cudaEventSynchronize(_events.at(_numRecordedEvents - 1)));
+
+    float startTime = 0;
+    for (int i = 0; i < toInt(_stageNames.size()); ++i) {
+        float duration;  //in milliseconds
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&duration, _events.at(i), _events.at(i + 1)));
+        stages.emplace_back(TimestepStage{_stageNames.at(i), startTime, duration * 1000.0f});
+        startTime += duration * 1000.0f;
+    }
+}
+
+void _CudaTimestepProfiler::recordEvent()
+{
+    if (_numRecordedEvents == toInt(_events.size())) {
+        cudaEvent_t event;
+        CHECK_FOR_CUDA_ERROR(cudaEventCreate(&event));
+        _events.emplace_back(event);
+    }
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_events.at(_numRecordedEvents)));
+    ++_numRecordedEvents;
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "EngineInterface/TimestepProfile.h"
+
+#include "Definitions.cuh"
+
+/**
+ * Measures the durations of the stages of a time step on the GPU. An event is recorded after each stage,
+ * hence the durations cover the execution of the kernels and not only their launches.
+ */
+class _CudaTimestepProfiler
+{
+public:
+    ~_CudaTimestepProfiler();
+
+    void begin();
+    void endStage(char const* name);  //the stage lasts from the previous event until now
+
+    //waits until the last stage is completed
+    void finish(std::vector<TimestepStage>& stages);
+
+private:
+    void recordEvent();
+
+    std::vector<cudaEvent_t> _events;  //created on demand and reused in subsequent time steps
+    std::vector<char const*> _stageNames;
+    int _numRecordedEvents = 0;
+};
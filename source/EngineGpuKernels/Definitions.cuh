@@ -36,6 +36,9 @@ using EditKernelsLauncher = std::shared_ptr<_EditKernelsLauncher>;
 class _MonitorKernelsLauncher;
 using MonitorKernelsLauncher = std::shared_ptr<_MonitorKernelsLauncher>;
 
+class _CudaTimestepProfiler;
+using CudaTimestepProfiler = std::shared_ptr<_CudaTimestepProfiler>;
+
 struct ApplyForceData
 {
     float2 startPos;
@@ -2,5 +2,8 @@
 
 #include <memory>
 
+class _SimulationFacade;
+using SimulationFacade = std::shared_ptr<_SimulationFacade>;
+
 class _CudaSimulationFacade;
 using CudaSimulationFacade = std::shared_ptr<_CudaSimulationFacade>;
@@ -0,0 +1,43 @@
+#include "GarbageCollectionPolicy.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+GarbageCollectionPolicy::GarbageCollectionPolicy(GarbageCollectionParameters const& parameters)
+    : _parameters(parameters)
+{}
+
+CompactionFlags GarbageCollectionPolicy::calcCompactions(ArrayUsages const& usages) const
+{
+    CompactionFlags result;
+    std::pair<ArrayUsage const*, bool*> arrays[] = {
+        {&usages.particles, &result.particles},
+        {&usages.cells, &result.cells},
+        {&usages.tokens, &result.tokens},
+        {&usages.stringBytes, &result.stringBytes}};
+
+    std::vector<std::pair<ArrayUsage const*, bool*>> fragmentedArrays;
+    for (auto const& [usage, compact] : arrays) {
+        if (usage->getFillLevel() > _parameters.maxFillLevel) {
+            *compact = true;
+        } else if (usage->getDeadRatio() > _parameters.maxDeadRatio && usage->getDeadLevel() >= _parameters.minDeadLevel) {
+            fragmentedArrays.emplace_back(usage, compact);
+        }
+    }
+
+    std::stable_sort(fragmentedArrays.begin(), fragmentedArrays.end(), [](auto const& array1, auto const& array2) {
+        return array1.first->getDeadRatio() > array2.first->getDeadRatio();
+    });
+    auto numCompactions = std::min(static_cast<int>(fragmentedArrays.size()), _parameters.maxFragmentationCompactions);
+    for (int i = 0; i < numCompactions; ++i) {
+        *fragmentedArrays.at(i).second = true;
+    }
+    return result;
+}
+
+bool GarbageCollectionPolicy::isLiveEntriesCountNeeded(ArrayUsage const& usage) const
+{
+    //dead entries cannot exceed the occupied entries
+    return usage.getFillLevel() >= _parameters.minDeadLevel;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+struct ArrayUsage
+{
+    int numEntries = 0;      //occupied entries including dead ones, in bytes for the string memory
+    int numLiveEntries = 0;
+    int size = 0;
+
+    float getFillLevel() const { return size > 0 ? static_cast<float>(numEntries) / size : 0.0f; }
+    float getDeadLevel() const { return size > 0 ? static_cast<float>(numEntries - numLiveEntries) / size : 0.0f; }
+    float getDeadRatio() const { return numEntries > 0 ? static_cast<float>(numEntries - numLiveEntries) / numEntries : 0.0f; }
+};
+
+//usages of the arrays which are compacted by the garbage collector, written by the device
+struct ArrayUsages
+{
+    ArrayUsage particles;
+    ArrayUsage cells;
+    ArrayUsage tokens;
+    ArrayUsage stringBytes;
+};
+
+struct CompactionFlags
+{
+    bool particles = false;
+    bool cells = false;
+    bool tokens = false;
+    bool stringBytes = false;
+
+    bool any() const { return particles || cells || tokens || stringBytes; }
+};
+
+struct GarbageCollectionParameters
+{
+    float maxFillLevel = 2.0f / 3.0f;  //arrays beyond this fill level are compacted immediately
+    float maxDeadRatio = 0.5f;         //arrays with a higher ratio of dead entries are compacted to restore locality...
+    float minDeadLevel = 0.1f;         //...if the dead entries occupy at least this fraction of the array
+    int maxFragmentationCompactions = 1;  //per time step, further fragmented arrays are compacted in the next time steps
+};
+
+/**
+ * Decides which arrays are compacted after a time step. Arrays reaching their fill level have to be compacted before
+ * they overflow. Compactions which only reduce fragmentation are spread over several time steps, most fragmented array first.
+ */
+class GarbageCollectionPolicy
+{
+public:
+    GarbageCollectionPolicy(GarbageCollectionParameters const& parameters = GarbageCollectionParameters());
+
+    CompactionFlags calcCompactions(ArrayUsages const& usages) const;
+
+    //counting the live entries of an array can be skipped if its dead entries cannot trigger a compaction
+    bool isLiveEntriesCountNeeded(ArrayUsage const& usage) const;
+
+private:
+    GarbageCollectionParameters _parameters;
+};
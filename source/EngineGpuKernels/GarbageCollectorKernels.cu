@@ -82,6 +82,9 @@ __global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newT
 
 namespace
 {
+    //same alignment as in RawMemory::getArray
+    __device__ int calcNumOccupiedBytes(int numBytes) { return numBytes > 0 ? numBytes + 16 - (numBytes % 16) : 0; }
+
     __device__ void copyString(char*& string, int numBytes, RawMemory& stringBytes)
     {
         if (numBytes > 0) {
@@ -153,13 +156,45 @@ __global__ void cudaCleanupParticles(Array<Particle*> particlePointers, Array<Pa
     }
 }
 
-__global__ void cudaCheckIfCleanupIsNecessary(SimulationData data, bool* result)
+__global__ void cudaSwapCompactedArrays(SimulationData data, CompactionFlags flags)
+{
+    if (flags.cells) {
+        data.entities.cells.swapContent(data.entitiesForCleanup.cells);
+    }
+    if (flags.tokens) {
+        data.entities.tokens.swapContent(data.entitiesForCleanup.tokens);
+    }
+    if (flags.particles) {
+        data.entities.particles.swapContent(data.entitiesForCleanup.particles);
+    }
+    if (flags.stringBytes) {
+        data.entities.stringBytes.swapContent(data.entitiesForCleanup.stringBytes);
+    }
+}
+
+__global__ void cudaGetArrayUsages(SimulationData data, ArrayUsages* usages, bool countLiveStringBytes)
 {
-    if (data.entities.particles.getNumEntries() > data.entities.particles.getSize() * Const::ArrayFillLevelFactor
-        || data.entities.cells.getNumEntries() > data.entities.cells.getSize() * Const::ArrayFillLevelFactor
-        || data.entities.tokens.getNumEntries() > data.entities.tokens.getSize() * Const::ArrayFillLevelFactor) {
-        *result = true;
-    } else {
-        *result = false;
+    //assumes that the pointer arrays are already cleaned up
+    auto& entities = data.entities;
+    usages->particles = {entities.particles.getNumEntries(), entities.particlePointers.getNumEntries(), entities.particles.getSize()};
+    usages->cells = {entities.cells.getNumEntries(), entities.cellPointers.getNumEntries(), entities.cells.getSize()};
+    usages->tokens = {entities.tokens.getNumEntries(), entities.tokenPointers.getNumEntries(), entities.tokens.getSize()};
+
+    auto numBytes = entities.stringBytes.getNumBytes();
+    usages->stringBytes = {numBytes, countLiveStringBytes ? 0 : numBytes, static_cast<int>(entities.stringBytes.getSize())};
+}
+
+__global__ void cudaCountLiveStringBytes(Array<Cell*> cellPointers, ArrayUsages* usages)
+{
+    auto const partition = calcAllThreadsPartition(cellPointers.getNumEntries());
+
+    int numBytes = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& metadata = cellPointers.at(index)->metadata;
+        numBytes += calcNumOccupiedBytes(metadata.nameLen) + calcNumOccupiedBytes(metadata.descriptionLen)
+            + calcNumOccupiedBytes(metadata.sourceCodeLen);
+    }
+    if (numBytes > 0) {
+        atomicAdd(&usages->stringBytes.numLiveEntries, numBytes);
     }
 }
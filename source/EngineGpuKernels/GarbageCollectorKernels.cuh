@@ -3,6 +3,7 @@
 #include "cuda_runtime_api.h"
 #include "sm_60_atomic_functions.h"
 
+#include "GarbageCollectionPolicy.h"
 #include "SimulationData.cuh"
 #include "Cell.cuh"
 #include "Token.cuh"
@@ -57,4 +58,6 @@ __global__ void cudaCleanupCellMap(SimulationData data);
 __global__ void cudaCleanupParticleMap(SimulationData data);
 __global__ void cudaSwapPointerArrays(SimulationData data);
 __global__ void cudaSwapArrays(SimulationData data);
-__global__ void cudaCheckIfCleanupIsNecessary(SimulationData data, bool* result);
+__global__ void cudaSwapCompactedArrays(SimulationData data, CompactionFlags flags);
+__global__ void cudaGetArrayUsages(SimulationData data, ArrayUsages* usages, bool countLiveStringBytes);
+__global__ void cudaCountLiveStringBytes(Array<Cell*> cellPointers, ArrayUsages* usages);
@@ -1,17 +1,36 @@
 ﻿#include "GarbageCollectorKernelsLauncher.cuh"
 
+namespace
+{
+    GarbageCollectionParameters getGarbageCollectionParameters()
+    {
+        GarbageCollectionParameters result;
+
+        //arrays beyond this fill level would be resized at the beginning of the next time step
+        result.maxFillLevel = Const::ArrayFillLevelFactor;
+        return result;
+    }
+}
+
 _GarbageCollectorKernelsLauncher::_GarbageCollectorKernelsLauncher()
+    : _policy(getGarbageCollectionParameters())
 {
-    CudaMemoryManager::getInstance().acquireMemory<bool>(1, _cudaBool);
+    CudaMemoryManager::getInstance().acquireMemory<ArrayUsages>(1, _cudaArrayUsages);
+    CHECK_FOR_CUDA_ERROR(cudaEventCreate(&_startEvent));
+    CHECK_FOR_CUDA_ERROR(cudaEventCreate(&_endEvent));
 }
 
 _GarbageCollectorKernelsLauncher::~_GarbageCollectorKernelsLauncher()
 {
-    CudaMemoryManager::getInstance().freeMemory(_cudaBool);
+    CudaMemoryManager::getInstance().freeMemory(_cudaArrayUsages);
+    cudaEventDestroy(_startEvent);
+    cudaEventDestroy(_endEvent);
 }
 
 void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& data)
 {
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_startEvent));
+
     KERNEL_CALL(cudaCleanupCellMap, data);
     KERNEL_CALL(cudaCleanupParticleMap, data);
 
@@ -21,16 +40,40 @@ void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& g
     KERNEL_CALL(cudaCleanupPointerArray<Token*>, data.entities.tokenPointers, data.entitiesForCleanup.tokenPointers);
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
 
-    KERNEL_CALL_1_1(cudaCheckIfCleanupIsNecessary, data, _cudaBool);
+    //live string bytes are only counted if their number is relevant since this requires a pass over all cells
+    auto countLiveStringBytes = _policy.isLiveEntriesCountNeeded(_lastArrayUsages.stringBytes);
+    KERNEL_CALL_1_1(cudaGetArrayUsages, data, _cudaArrayUsages, countLiveStringBytes);
+    if (countLiveStringBytes) {
+        KERNEL_CALL(cudaCountLiveStringBytes, data.entities.cellPointers, _cudaArrayUsages);
+    }
     cudaDeviceSynchronize();
-    if (copyToHost(_cudaBool)) {
+    _lastArrayUsages = copyToHost(_cudaArrayUsages);
+
+    auto compactions = _policy.calcCompactions(_lastArrayUsages);
+    if (compactions.any()) {
         KERNEL_CALL_1_1(cudaPrepareArraysForCleanup, data);
-        KERNEL_CALL(cudaCleanupParticles, data.entities.particlePointers, data.entitiesForCleanup.particles);
-        KERNEL_CALL(cudaCleanupCellsStep1, data.entities.cellPointers, data.entitiesForCleanup.cells);
-        KERNEL_CALL(cudaCleanupCellsStep2, data.entities.tokenPointers, data.entitiesForCleanup.cells);
-        KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens);
-        KERNEL_CALL_1_1(cudaSwapArrays, data);
+        if (compactions.particles) {
+            KERNEL_CALL(cudaCleanupParticles, data.entities.particlePointers, data.entitiesForCleanup.particles);
+        }
+        if (compactions.cells) {
+            KERNEL_CALL(cudaCleanupCellsStep1, data.entities.cellPointers, data.entitiesForCleanup.cells);
+            KERNEL_CALL(cudaCleanupCellsStep2, data.entities.tokenPointers, data.entitiesForCleanup.cells);
+        }
+        if (compactions.tokens) {
+            KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens);
+        }
+        if (compactions.stringBytes) {
+            KERNEL_CALL(cudaCleanupStringBytes, data.entities.cellPointers, data.entitiesForCleanup.stringBytes);
+        }
+        KERNEL_CALL_1_1(cudaSwapCompactedArrays, data, compactions);
     }
+
+    CHECK_FOR_CUDA_ERROR(cudaEventRecord(_endEvent));
+    CHECK_FOR_CUDA_ERROR(cudaEventSynchronize(_endEvent));
+    float duration;  //in milliseconds
+    CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&duration, _startEvent, _endEvent));
+    _accumulatedDuration += duration * 1000.0;
+    ++_numTimestepCleanups;
 }
 
 void _GarbageCollectorKernelsLauncher::cleanupAfterDataManipulation(GpuSettings const& gpuSettings, SimulationData const& data)
@@ -70,3 +113,11 @@ void _GarbageCollectorKernelsLauncher::swapArrays(GpuSettings const& gpuSettings
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
     KERNEL_CALL_1_1(cudaSwapArrays, data);
 }
+
+double _GarbageCollectorKernelsLauncher::getAndResetMeanTimestepCleanupDuration()
+{
+    auto result = _numTimestepCleanups > 0 ? _accumulatedDuration / _numTimestepCleanups : 0.0;
+    _accumulatedDuration = 0;
+    _numTimestepCleanups = 0;
+    return result;
+}
@@ -13,12 +13,25 @@ public:
     _GarbageCollectorKernelsLauncher();
     ~_GarbageCollectorKernelsLauncher();
 
+    //compacts only the arrays selected by the garbage collection policy
     void cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void cleanupAfterDataManipulation(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void copyArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void swapArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
 
+    //mean duration of cleanupAfterTimestep in microseconds since the last call
+    double getAndResetMeanTimestepCleanupDuration();
+
 private:
+    GarbageCollectionPolicy _policy;
+    ArrayUsages _lastArrayUsages;
+
+    //measurements of cleanupAfterTimestep
+    cudaEvent_t _startEvent;
+    cudaEvent_t _endEvent;
+    double _accumulatedDuration = 0;
+    int _numTimestepCleanups = 0;
+
     //gpu memory
-    bool* _cudaBool;
+    ArrayUsages* _cudaArrayUsages;
 };
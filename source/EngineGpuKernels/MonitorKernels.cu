@@ -2,66 +2,170 @@
 
 #include "Token.cuh"
 
-namespace
+__global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitorData monitorData)
+{
+    monitorData.resetEntityData();
+
+    monitorData.setNumParticles(data.entities.particlePointers.getNumEntries());
+    monitorData.setNumTokens(data.entities.tokenPointers.getNumEntries());
+}
+
+//the following kernels accumulate partial results of a block in shared memory first
+//=> only one global atomic operation per block and metric
+__global__ void cudaGetCudaMonitorData_substep2(SimulationData data, CudaMonitorData monitorData)
 {
-/*
-    __global__ void getEnergyForMonitorData(SimulationData data, CudaMonitorData monitorData)
+    __shared__ int numCellsByColor[7];
+    __shared__ float cellEnergyByColor[7];
+    __shared__ int numCellsByFunction[Enums::CellFunction_Count];
+    __shared__ int numConnections;
+    for (int i = threadIdx.x; i < 7; i += blockDim.x) {
+        numCellsByColor[i] = 0;
+        cellEnergyByColor[i] = 0;
+    }
+    for (int i = threadIdx.x; i < Enums::CellFunction_Count; i += blockDim.x) {
+        numCellsByFunction[i] = 0;
+    }
+    if (threadIdx.x == 0) {
+        numConnections = 0;
+    }
+    __syncthreads();
+
+    auto& cells = data.entities.cellPointers;
+    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+
+    int threadNumConnections = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& cell = cells.at(index);
+        auto color = calcMod(cell->metadata.color, 7);
+        atomicAdd(&numCellsByColor[color], 1);
+        atomicAdd(&cellEnergyByColor[color], cell->energy);
+        atomicAdd(&numCellsByFunction[calcMod(cell->cellFunctionType, Enums::CellFunction_Count)], 1);
+        threadNumConnections += cell->numConnections;
+    }
+    if (threadNumConnections > 0) {
+        atomicAdd(&numConnections, threadNumConnections);
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < 7; i += blockDim.x) {
+        if (numCellsByColor[i] > 0) {
+            monitorData.addNumCells(i, numCellsByColor[i]);
+            monitorData.addCellEnergy(i, cellEnergyByColor[i]);
+        }
+    }
+    for (int i = threadIdx.x; i < Enums::CellFunction_Count; i += blockDim.x) {
+        if (numCellsByFunction[i] > 0) {
+            monitorData.addNumCellsByFunction(i, numCellsByFunction[i]);
+        }
+    }
+    if (threadIdx.x == 0 && numConnections > 0) {
+        monitorData.addNumConnections(numConnections);
+    }
+}
+
+__global__ void cudaGetCudaMonitorData_substep3(SimulationData data, CudaMonitorData monitorData)
+{
+    __shared__ float internalEnergy;
+    __shared__ int tokenEnergyHistogram[MonitorHistogramSize];
+    for (int i = threadIdx.x; i < MonitorHistogramSize; i += blockDim.x) {
+        tokenEnergyHistogram[i] = 0;
+    }
+    if (threadIdx.x == 0) {
+        internalEnergy = 0;
+    }
+    __syncthreads();
+
+    float threadInternalEnergy = 0;
     {
-        {
-            auto& cells = data.entities.cellPointers;
-            auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-
-            for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-                auto& cell = cells.at(index);
-                monitorData.incInternalEnergy(cell->energy);
-            }
+        auto& particles = data.entities.particlePointers;
+        auto const partition = calcAllThreadsPartition(particles.getNumEntries());
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            threadInternalEnergy += particles.at(index)->energy;
         }
-        {
-            auto& particles = data.entities.particlePointers;
-            auto const partition = calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-
-            for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-                auto& particle = particles.at(index);
-                monitorData.incInternalEnergy(particle->energy);
-            }
+    }
+    {
+        auto& tokens = data.entities.tokenPointers;
+        auto const partition = calcAllThreadsPartition(tokens.getNumEntries());
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& token = tokens.at(index);
+            threadInternalEnergy += token->energy;
+            atomicAdd(&tokenEnergyHistogram[calcMonitorHistogramBin(token->energy)], 1);
         }
-        {
-            auto& tokens = data.entities.tokenPointers;
-            auto const partition = calcPartition(tokens.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-
-            for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-                auto& token = tokens.at(index);
-                monitorData.incInternalEnergy(token->energy);
-            }
+    }
+    if (threadInternalEnergy != 0) {
+        atomicAdd(&internalEnergy, threadInternalEnergy);
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < MonitorHistogramSize; i += blockDim.x) {
+        if (tokenEnergyHistogram[i] > 0) {
+            monitorData.addTokenEnergyHistogram(i, tokenEnergyHistogram[i]);
         }
     }
-*/
+    if (threadIdx.x == 0 && internalEnergy != 0) {
+        monitorData.addInternalEnergy(internalEnergy);
+    }
 }
 
-__global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitorData monitorData)
+__global__ void cudaGetCudaMonitorData_substep4(SimulationData data, CudaMonitorData monitorData)
 {
-    monitorData.reset();
-
-    monitorData.setNumParticles(data.entities.particlePointers.getNumEntries());
-    monitorData.setNumTokens(data.entities.tokenPointers.getNumEntries());
-    monitorData.setNumTokens(data.entities.tokenPointers.getNumEntries());
+    monitorData.finishEntityData();
+}
 
-    //    KERNEL_CALL(getEnergyForMonitorData, data, monitorData);
+__global__ void cudaGetClusterMonitorData_substep1(SimulationData data, CudaMonitorData monitorData)
+{
+    monitorData.resetClusterData();
 }
 
-__global__ void cudaGetCudaMonitorData_substep2(SimulationData data, CudaMonitorData monitorData)
+//requires cluster indices from ClusterProcessor
+__global__ void cudaGetClusterMonitorData_substep2(SimulationData data, CudaMonitorData monitorData)
 {
     auto& cells = data.entities.cellPointers;
-    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        monitorData.incNumCell(calcMod(cell->metadata.color, 7));
-        monitorData.incNumConnections(cell->numConnections);
+        atomicAdd(&cells.at(cell->clusterIndex)->numCellsInCluster, 1);
     }
 }
 
-__global__ void cudaGetCudaMonitorData_substep3(SimulationData data, CudaMonitorData monitorData)
+__global__ void cudaGetClusterMonitorData_substep3(SimulationData data, CudaMonitorData monitorData)
 {
-    monitorData.halveNumConnections();
+    __shared__ int numClusters;
+    __shared__ int clusterSizeHistogram[MonitorHistogramSize];
+    for (int i = threadIdx.x; i < MonitorHistogramSize; i += blockDim.x) {
+        clusterSizeHistogram[i] = 0;
+    }
+    if (threadIdx.x == 0) {
+        numClusters = 0;
+    }
+    __syncthreads();
+
+    auto& cells = data.entities.cellPointers;
+    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+
+    //each cluster is represented by the cell whose index is the cluster index
+    int threadNumClusters = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& cell = cells.at(index);
+        if (cell->clusterIndex == index) {
+            ++threadNumClusters;
+            atomicAdd(&clusterSizeHistogram[calcMonitorHistogramBin(static_cast<float>(cell->numCellsInCluster))], 1);
+        }
+    }
+    if (threadNumClusters > 0) {
+        atomicAdd(&numClusters, threadNumClusters);
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < MonitorHistogramSize; i += blockDim.x) {
+        if (clusterSizeHistogram[i] > 0) {
+            monitorData.addClusterSizeHistogram(i, clusterSizeHistogram[i]);
+        }
+    }
+    if (threadIdx.x == 0 && numClusters > 0) {
+        monitorData.addNumClusters(numClusters);
+    }
 }
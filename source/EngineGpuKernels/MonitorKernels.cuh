@@ -9,3 +9,8 @@
 __global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitorData monitorData);
 __global__ void cudaGetCudaMonitorData_substep2(SimulationData data, CudaMonitorData monitorData);
 __global__ void cudaGetCudaMonitorData_substep3(SimulationData data, CudaMonitorData monitorData);
+__global__ void cudaGetCudaMonitorData_substep4(SimulationData data, CudaMonitorData monitorData);
+
+__global__ void cudaGetClusterMonitorData_substep1(SimulationData data, CudaMonitorData monitorData);
+__global__ void cudaGetClusterMonitorData_substep2(SimulationData data, CudaMonitorData monitorData);
+__global__ void cudaGetClusterMonitorData_substep3(SimulationData data, CudaMonitorData monitorData);
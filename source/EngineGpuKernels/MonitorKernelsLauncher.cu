@@ -1,10 +1,25 @@
 ﻿#include "MonitorKernelsLauncher.cuh"
 
 #include "MonitorKernels.cuh"
+#include "SimulationKernels.cuh"
 
-void _MonitorKernelsLauncher::getMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData)
+void _MonitorKernelsLauncher::getEntityMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData)
 {
     KERNEL_CALL_1_1(cudaGetCudaMonitorData_substep1, data, monitorData);
     KERNEL_CALL(cudaGetCudaMonitorData_substep2, data, monitorData);
-    KERNEL_CALL_1_1(cudaGetCudaMonitorData_substep3, data, monitorData);
+    KERNEL_CALL(cudaGetCudaMonitorData_substep3, data, monitorData);
+    KERNEL_CALL_1_1(cudaGetCudaMonitorData_substep4, data, monitorData);
+}
+
+void _MonitorKernelsLauncher::getClusterMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData)
+{
+    KERNEL_CALL_1_1(cudaGetClusterMonitorData_substep1, data, monitorData);
+
+    //same approximation of the connected cells as for the rigidity update
+    KERNEL_CALL(cudaInitClusterData, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaGetClusterMonitorData_substep2, data, monitorData);
+    KERNEL_CALL(cudaGetClusterMonitorData_substep3, data, monitorData);
 }
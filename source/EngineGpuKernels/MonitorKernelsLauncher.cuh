@@ -9,7 +9,8 @@
 class _MonitorKernelsLauncher
 {
 public:
-    void getMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData);
+    void getEntityMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData);
+    void getClusterMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData);
 
 private:
 };
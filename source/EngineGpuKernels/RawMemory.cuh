@@ -42,7 +42,7 @@ public:
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_data, &data, sizeof(unsigned char*), cudaMemcpyHostToDevice));
     }
 
-    uint64_t getSize() const { return _size; }
+    __host__ __device__ uint64_t getSize() const { return _size; }
 
     __host__ __inline__ void free()
     {
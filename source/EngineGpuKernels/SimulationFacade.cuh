@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EngineInterface/MonitorData.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/TimestepProfile.h"
+
+#include "Definitions.cuh"
+
+/**
+ * Common interface of the simulation backends (CUDA and CPU reference implementation).
+ */
+class _SimulationFacade
+{
+public:
+    virtual ~_SimulationFacade() = default;
+
+    virtual void* registerImageResource(unsigned int image) = 0;  //image: OpenGL texture name
+
+    //profile is optional: if set, the stages, their durations and the numbers of entities are recorded
+    virtual void calcTimestep(TimestepProfile* profile) = 0;
+
+    virtual void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) = 0;
+    virtual void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) = 0;
+    virtual void getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO) = 0;
+    virtual void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO) = 0;
+    virtual void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) = 0;
+    virtual void addAndSelectSimulationData(DataAccessTO const& dataTO) = 0;
+    virtual void setSimulationData(DataAccessTO const& dataTO) = 0;
+    virtual void removeSelectedEntities(bool includeClusters) = 0;
+    virtual void relaxSelectedEntities(bool includeClusters) = 0;
+    virtual void uniformVelocitiesForSelectedEntities(bool includeClusters) = 0;
+    virtual void makeSticky(bool includeClusters) = 0;
+    virtual void removeStickiness(bool includeClusters) = 0;
+    virtual void setBarrier(bool value, bool includeClusters) = 0;
+    virtual void changeInspectedSimulationData(DataAccessTO const& changeDataTO) = 0;
+
+    virtual void applyForce(ApplyForceData const& applyData) = 0;
+    virtual void switchSelection(PointSelectionData const& switchData) = 0;
+    virtual void swapSelection(PointSelectionData const& selectionData) = 0;
+    virtual void setSelection(AreaSelectionData const& selectionData) = 0;
+    virtual SelectionShallowData getSelectionShallowData() = 0;
+    virtual void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData) = 0;
+    virtual void removeSelection() = 0;
+    virtual void updateSelection() = 0;
+    virtual void colorSelectedEntities(unsigned char color, bool includeClusters) = 0;
+    virtual void reconnectSelectedEntities() = 0;
+
+    virtual void setGpuConstants(GpuSettings const& cudaConstants) = 0;
+    virtual void setSimulationParameters(SimulationParameters const& parameters) = 0;
+    virtual void setSimulationParametersSpots(SimulationParametersSpots const& spots) = 0;
+    virtual void setFlowFieldSettings(FlowFieldSettings const& settings) = 0;
+
+    virtual ArraySizes getArraySizes() const = 0;
+
+    //fill the respective fields of data
+    virtual void getEntityMonitorData(MonitorData& data) = 0;
+    virtual void getProcessMonitorData(MonitorData& data) = 0;
+    virtual void getClusterMonitorData(MonitorData& data) = 0;
+    virtual uint64_t getCurrentTimestep() const = 0;
+    virtual void setCurrentTimestep(uint64_t timestep) = 0;
+
+    virtual void clear() = 0;
+
+    virtual void resizeArraysIfNecessary(ArraySizes const& additionals) = 0;
+};
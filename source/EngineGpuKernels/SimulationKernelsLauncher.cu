@@ -3,31 +3,52 @@
 #include "SimulationKernels.cuh"
 #include "FlowFieldKernels.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
+#include "CudaTimestepProfiler.cuh"
 
 _SimulationKernelsLauncher::_SimulationKernelsLauncher()
 {
     _garbageCollector = std::make_shared<_GarbageCollectorKernelsLauncher>();
 }
 
-void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationResult const& result)
+void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationResult const& result, _CudaTimestepProfiler* profiler)
 {
+    auto endStage = [&](char const* name) {
+        if (profiler) {
+            profiler->endStage(name);
+        }
+    };
+    if (profiler) {
+        profiler->begin();
+    }
+
     auto const gpuSettings = settings.gpuSettings;
     KERNEL_CALL_1_1(cudaPrepareNextTimestep, data, result);
     if (settings.flowFieldSettings.active) {
         KERNEL_CALL(cudaApplyFlowFieldSettings, data);
     }
+    endStage("preparation");
     KERNEL_CALL(cudaNextTimestep_substep1, data);
+    endStage("substep 1: radiation, maps");
     KERNEL_CALL(cudaNextTimestep_substep2, data);
+    endStage("substep 2: collisions");
     KERNEL_CALL(cudaNextTimestep_substep3, data);
+    endStage("substep 3: velocities, mutations, particles");
     KERNEL_CALL(cudaNextTimestep_substep4, data);
+    endStage("substep 4: connection forces, token movement");
     KERNEL_CALL(cudaNextTimestep_substep5, data);
+    endStage("substep 5: positions, connections");
     KERNEL_CALL(cudaNextTimestep_substep6, data, result);
+    endStage("substep 6: connection forces, read-only cell functions");
     KERNEL_CALL(cudaNextTimestep_substep7, data);
+    endStage("substep 7: sensors, velocities");
     KERNEL_CALL(cudaNextTimestep_substep8, data, result);
+    endStage("substep 8: modifying cell functions");
     if (_counter == 0) {
         KERNEL_CALL(cudaNextTimestep_substep9, data);
+        endStage("substep 9: inner friction");
     }
     KERNEL_CALL(cudaNextTimestep_substep10, data);
+    endStage("substep 10: friction, decay");
 
     if (isRigidityUpdateEnabled(settings)) {
         if (_counter == 0) {  //execute rigidity update only every 3rd time step for performance reasons
@@ -35,18 +56,24 @@ void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, Simulati
             KERNEL_CALL(cudaFindClusterIteration, data);  //3 iterations should provide a good approximation
             KERNEL_CALL(cudaFindClusterIteration, data);
             KERNEL_CALL(cudaFindClusterIteration, data);
+            endStage("rigidity: cluster search");
             KERNEL_CALL(cudaFindClusterBoundaries, data);
             KERNEL_CALL(cudaAccumulateClusterPosAndVel, data);
             KERNEL_CALL(cudaAccumulateClusterAngularProp, data);
             KERNEL_CALL(cudaApplyClusterData, data);
+            endStage("rigidity: cluster update");
         }
     }
     KERNEL_CALL_1_1(cudaNextTimestep_substep11, data);
     KERNEL_CALL(cudaNextTimestep_substep12, data);
+    endStage("substep 11-12: connection operations");
     KERNEL_CALL(cudaNextTimestep_substep13, data);
+    endStage("substep 13: particle transformation, cell deletion");
     KERNEL_CALL(cudaNextTimestep_substep14, data);
+    endStage("substep 14: token deletion");
 
     _garbageCollector->cleanupAfterTimestep(settings.gpuSettings, data);
+    endStage("garbage collection");
     if (++_counter == 3) {
         _counter = 0;
     }
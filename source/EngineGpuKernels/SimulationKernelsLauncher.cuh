@@ -11,7 +11,10 @@ class _SimulationKernelsLauncher
 public:
     _SimulationKernelsLauncher();
 
-    void calcTimestep(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result);
+    //profiler is optional: if set, the durations of the stages are measured
+    void calcTimestep(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result, _CudaTimestepProfiler* profiler);
+
+    GarbageCollectorKernelsLauncher const& getGarbageCollector() const { return _garbageCollector; }
 
 private:
     bool isRigidityUpdateEnabled(Settings const& settings) const;
@@ -1,92 +1,177 @@
 #include "AccessDataTOCache.h"
 
-_AccessDataTOCache::_AccessDataTOCache(GpuSettings const& gpuConstants)
-    : _gpuConstants(gpuConstants)
-{}
+#include <algorithm>
+#include <limits>
 
-_AccessDataTOCache::~_AccessDataTOCache()
+#include "Base/LoggingService.h"
+
+namespace
 {
-    for (DataAccessTO const& dataTO : _freeDataTOs) {
-        deleteDataTO(dataTO);
-    }
-    for (DataAccessTO const& dataTO : _usedDataTOs) {
-        deleteDataTO(dataTO);
+    int const MinCapacity = 64;
+    int const NumCounters = 4;
+    std::chrono::seconds const IdleDuration(10);
+    std::chrono::seconds const IdleCheckInterval(1);
+
+    //sizes are rounded up to multiples of a quarter of the next lower power of two, i.e. at most 25% are wasted
+    int calcCapacity(int size)
+    {
+        if (size <= MinCapacity) {
+            return MinCapacity;
+        }
+        int64_t powerOfTwo = 1;
+        while (powerOfTwo * 2 <= size) {
+            powerOfTwo *= 2;
+        }
+        auto step = powerOfTwo / 4;
+        return static_cast<int>(std::min(int64_t(std::numeric_limits<int>::max()), (size + step - 1) / step * step));
     }
 }
 
-DataAccessTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
+template <typename T>
+_AccessDataTOCache::BufferPool<T>::~BufferPool()
 {
-    if (!_arraySizes || *_arraySizes != arraySizes) {
-        for (DataAccessTO const& dataTO : _freeDataTOs) {
-            deleteDataTO(dataTO);
+    for (auto const& [capacity, freeBuffers] : _freeBuffersByCapacity) {
+        for (auto const& freeBuffer : freeBuffers) {
+            delete[] freeBuffer.buffer;
         }
-        for (DataAccessTO const& dataTO : _usedDataTOs) {
-            deleteDataTO(dataTO);
-        }
-        _freeDataTOs.clear();
-        _usedDataTOs.clear();
-        _arraySizes = arraySizes;
     }
+}
 
-    auto clear = [](auto& result) {
-            *result.numCells = 0;
-            *result.numParticles = 0;
-            *result.numTokens = 0;
-            *result.numStringBytes = 0;
-    };
+template <typename T>
+T* _AccessDataTOCache::BufferPool<T>::acquire(int size, int& capacity, Statistics& statistics)
+{
+    capacity = calcCapacity(size);
 
-    DataAccessTO result;
-    if (!_freeDataTOs.empty()) {
-        result = *_freeDataTOs.begin();
-        _freeDataTOs.erase(_freeDataTOs.begin());
-        _usedDataTOs.emplace_back(result);
+    //larger buffers are only reused if they do not waste too much memory
+    auto findResult = _freeBuffersByCapacity.lower_bound(capacity);
+    if (findResult != _freeBuffersByCapacity.end() && int64_t(findResult->first) <= int64_t(capacity) * 2) {
+        auto& freeBuffers = findResult->second;
+        auto result = freeBuffers.back().buffer;
+        capacity = findResult->first;
+        freeBuffers.pop_back();
+        if (freeBuffers.empty()) {
+            _freeBuffersByCapacity.erase(findResult);
+        }
+        ++statistics.hits;
+        statistics.pooledBytes -= sizeof(T) * capacity;
+        statistics.usedBytes += sizeof(T) * capacity;
+        return result;
+    }
 
-        clear(result);
+    try {
+        auto result = new T[capacity];
+        ++statistics.misses;
+        statistics.usedBytes += sizeof(T) * capacity;
         return result;
+    } catch (std::bad_alloc const&) {
+        throw BugReportException("There is not sufficient CPU memory available.");
     }
-    result = getNewDataTO();
-    _usedDataTOs.emplace_back(result);
-    clear(result);
+}
+
+template <typename T>
+void _AccessDataTOCache::BufferPool<T>::release(T* buffer, int capacity, Statistics& statistics)
+{
+    _freeBuffersByCapacity[capacity].emplace_back(FreeBuffer{buffer, std::chrono::steady_clock::now()});
+    statistics.usedBytes -= sizeof(T) * capacity;
+    statistics.pooledBytes += sizeof(T) * capacity;
+}
+
+template <typename T>
+void _AccessDataTOCache::BufferPool<T>::freeIdleBuffers(std::chrono::steady_clock::time_point const& idleSince, Statistics& statistics)
+{
+    for (auto it = _freeBuffersByCapacity.begin(); it != _freeBuffersByCapacity.end();) {
+        auto const& capacity = it->first;
+        auto& freeBuffers = it->second;
+        auto isIdle = [&](FreeBuffer const& freeBuffer) { return freeBuffer.releaseTimepoint < idleSince; };
+        for (auto const& freeBuffer : freeBuffers) {
+            if (isIdle(freeBuffer)) {
+                delete[] freeBuffer.buffer;
+                ++statistics.numFreedIdleBuffers;
+                statistics.pooledBytes -= sizeof(T) * capacity;
+            }
+        }
+        freeBuffers.erase(std::remove_if(freeBuffers.begin(), freeBuffers.end(), isIdle), freeBuffers.end());
+        it = freeBuffers.empty() ? _freeBuffersByCapacity.erase(it) : std::next(it);
+    }
+}
+
+_AccessDataTOCache::_AccessDataTOCache(GpuSettings const& gpuConstants)
+    : _gpuConstants(gpuConstants)
+    , _lastIdleCheck(std::chrono::steady_clock::now())
+{}
+
+_AccessDataTOCache::~_AccessDataTOCache()
+{
+    while (!_usedDataTOs.empty()) {
+        releaseDataTO(_usedDataTOs.back().dataTO);
+    }
+}
+
+DataAccessTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
+{
+    UsedDataTO usedDataTO;
+    auto& result = usedDataTO.dataTO;
+    auto& capacities = usedDataTO.capacities;
+
+    auto counters = _counterPool.acquire(NumCounters, usedDataTO.counterCapacity, _statistics);
+    result.numCells = counters;
+    result.numParticles = counters + 1;
+    result.numTokens = counters + 2;
+    result.numStringBytes = counters + 3;
+    result.cells = _cellPool.acquire(arraySizes.cellArraySize, capacities.cellArraySize, _statistics);
+    result.particles = _particlePool.acquire(arraySizes.particleArraySize, capacities.particleArraySize, _statistics);
+    result.tokens = _tokenPool.acquire(arraySizes.tokenArraySize, capacities.tokenArraySize, _statistics);
+    result.stringBytes = _stringBytesPool.acquire(MAX_STRING_BYTES, usedDataTO.stringBytesCapacity, _statistics);
+    _usedDataTOs.emplace_back(usedDataTO);
+
+    *result.numCells = 0;
+    *result.numParticles = 0;
+    *result.numTokens = 0;
+    *result.numStringBytes = 0;
     return result;
 }
 
 void _AccessDataTOCache::releaseDataTO(DataAccessTO const& dataTO)
 {
-    auto usedDataTO = std::find_if(_usedDataTOs.begin(), _usedDataTOs.end(), [&dataTO](DataAccessTO const& usedDataTO) {
-        return usedDataTO == dataTO;
+    auto usedDataTO = std::find_if(_usedDataTOs.begin(), _usedDataTOs.end(), [&dataTO](UsedDataTO const& usedDataTO) {
+        return usedDataTO.dataTO == dataTO;
     });
     if (usedDataTO != _usedDataTOs.end()) {
-        _freeDataTOs.emplace_back(*usedDataTO);
+        auto const& capacities = usedDataTO->capacities;
+        _counterPool.release(dataTO.numCells, usedDataTO->counterCapacity, _statistics);
+        _cellPool.release(dataTO.cells, capacities.cellArraySize, _statistics);
+        _particlePool.release(dataTO.particles, capacities.particleArraySize, _statistics);
+        _tokenPool.release(dataTO.tokens, capacities.tokenArraySize, _statistics);
+        _stringBytesPool.release(dataTO.stringBytes, usedDataTO->stringBytesCapacity, _statistics);
         _usedDataTOs.erase(usedDataTO);
     }
 }
 
-DataAccessTO _AccessDataTOCache::getNewDataTO()
+void _AccessDataTOCache::freeIdleBuffers()
 {
-    try {
-        DataAccessTO result;
-        result.numCells = new int;
-        result.numParticles = new int;
-        result.numTokens = new int;
-        result.numStringBytes = new int;
-        result.cells = new CellAccessTO[_arraySizes->cellArraySize];
-        result.particles = new ParticleAccessTO[_arraySizes->particleArraySize];
-        result.tokens = new TokenAccessTO[_arraySizes->tokenArraySize];
-        result.stringBytes = new char[MAX_STRING_BYTES];
-        return result;
-    } catch (std::bad_alloc const&) {
-        throw BugReportException("There is not sufficient CPU memory available.");
+    auto now = std::chrono::steady_clock::now();
+    if (now - _lastIdleCheck < IdleCheckInterval) {
+        return;
+    }
+    _lastIdleCheck = now;
+
+    auto idleSince = now - IdleDuration;
+    auto origNumFreedIdleBuffers = _statistics.numFreedIdleBuffers;
+    _counterPool.freeIdleBuffers(idleSince, _statistics);
+    _cellPool.freeIdleBuffers(idleSince, _statistics);
+    _particlePool.freeIdleBuffers(idleSince, _statistics);
+    _tokenPool.freeIdleBuffers(idleSince, _statistics);
+    _stringBytesPool.freeIdleBuffers(idleSince, _statistics);
+
+    if (_statistics.numFreedIdleBuffers != origNumFreedIdleBuffers) {
+        log(Priority::Unimportant,
+            "access TO cache: " + std::to_string(_statistics.hits) + " hits, " + std::to_string(_statistics.misses) + " misses, "
+                + std::to_string(_statistics.numFreedIdleBuffers - origNumFreedIdleBuffers) + " idle buffers freed, "
+                + std::to_string(_statistics.pooledBytes / (1024 * 1024)) + " MB pooled");
     }
 }
 
-void _AccessDataTOCache::deleteDataTO(DataAccessTO const& dataTO)
+auto _AccessDataTOCache::getStatistics() const -> Statistics
 {
-    delete dataTO.numCells;
-    delete dataTO.numParticles;
-    delete dataTO.numTokens;
-    delete dataTO.numStringBytes;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.tokens;
-    delete[] dataTO.stringBytes;
+    return _statistics;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <map>
+
 #include "Base/Definitions.h"
 
 #include "EngineInterface/GpuSettings.h"
@@ -7,6 +10,11 @@
 
 #include "Definitions.h"
 
+/**
+ * Pool of host-side access TOs. The arrays of a TO are taken from size-class pools, i.e. buffers are reused for requests
+ * of similar sizes and small requests (e.g. for overlays or inspected entities) are served with small buffers.
+ * Buffers which have not been used for some time are freed.
+ */
 class _AccessDataTOCache
 {
 public:
@@ -27,16 +35,57 @@ public:
 
         bool operator!=(ArraySizes const& other) const { return !operator==(other); };
     };
-    DataAccessTO getDataTO(ArraySizes const& arraySizes);
+    DataAccessTO getDataTO(ArraySizes const& arraySizes);  //arrays have at least the given sizes
     void releaseDataTO(DataAccessTO const& dataTO);
 
+    void freeIdleBuffers();  //should be called regularly, checks are performed at most once per second
+
+    struct Statistics
+    {
+        uint64_t hits = 0;  //buffer requests served from the pool
+        uint64_t misses = 0;
+        uint64_t numFreedIdleBuffers = 0;
+        uint64_t pooledBytes = 0;  //bytes of buffers which are currently not in use
+        uint64_t usedBytes = 0;
+    };
+    Statistics getStatistics() const;
+
 private:
-    DataAccessTO getNewDataTO();
-    void deleteDataTO(DataAccessTO const& dataTO);
+    template <typename T>
+    class BufferPool
+    {
+    public:
+        ~BufferPool();
+
+        T* acquire(int size, int& capacity, Statistics& statistics);
+        void release(T* buffer, int capacity, Statistics& statistics);
+        void freeIdleBuffers(std::chrono::steady_clock::time_point const& idleSince, Statistics& statistics);
+
+    private:
+        struct FreeBuffer
+        {
+            T* buffer;
+            std::chrono::steady_clock::time_point releaseTimepoint;
+        };
+        std::map<int, std::vector<FreeBuffer>> _freeBuffersByCapacity;
+    };
+
+    struct UsedDataTO
+    {
+        DataAccessTO dataTO;
+        ArraySizes capacities;
+        int counterCapacity;
+        int stringBytesCapacity;
+    };
 
     GpuSettings _gpuConstants;
-    std::vector<DataAccessTO> _freeDataTOs;
-    std::vector<DataAccessTO> _usedDataTOs;
-    std::optional<ArraySizes> _arraySizes;
-};
+    Statistics _statistics;
+    std::chrono::steady_clock::time_point _lastIdleCheck;
 
+    BufferPool<int> _counterPool;  //numCells, numParticles, numTokens and numStringBytes are stored in one buffer
+    BufferPool<CellAccessTO> _cellPool;
+    BufferPool<ParticleAccessTO> _particlePool;
+    BufferPool<TokenAccessTO> _tokenPool;
+    BufferPool<char> _stringBytesPool;
+    std::vector<UsedDataTO> _usedDataTOs;
+};
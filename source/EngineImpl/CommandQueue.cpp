@@ -0,0 +1,169 @@
+#include "CommandQueue.h"
+
+#include <future>
+#include <memory>
+
+namespace
+{
+    enum class CommandStatus
+    {
+        Pending,
+        Running,
+        Cancelled
+    };
+
+    bool tryStart(std::atomic<CommandStatus>& status)
+    {
+        auto expected = CommandStatus::Pending;
+        return status.compare_exchange_strong(expected, CommandStatus::Running);
+    }
+
+    bool tryCancel(std::atomic<CommandStatus>& status)
+    {
+        auto expected = CommandStatus::Pending;
+        return status.compare_exchange_strong(expected, CommandStatus::Cancelled);
+    }
+}
+
+CommandQueue::CommandQueue()
+    : _tail(new Node)
+{
+    _head.store(_tail);
+}
+
+CommandQueue::~CommandQueue()
+{
+    clear();
+    delete _tail;
+}
+
+void CommandQueue::post(std::function<void()>&& func)
+{
+    auto node = new Node;
+    node->func = std::move(func);
+    node->enqueueTimepoint = std::chrono::steady_clock::now();
+    push(node);
+}
+
+bool CommandQueue::execute(std::function<void()> const& func, std::chrono::microseconds const& maxWaitForStart)
+{
+    struct State
+    {
+        std::atomic<CommandStatus> status{CommandStatus::Pending};
+        std::promise<void> finished;
+    };
+    auto state = std::make_shared<State>();
+    auto finished = state->finished.get_future();
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+
+    //func is only accessed if the command has been started, in which case the caller waits for its completion
+    post([state, &func] {
+        if (!tryStart(state->status)) {
+            return;
+        }
+        try {
+            func();
+            state->finished.set_value();
+        } catch (...) {
+            state->finished.set_exception(std::current_exception());
+        }
+    });
+
+    if (finished.wait_for(maxWaitForStart) == std::future_status::timeout && tryCancel(state->status)) {
+        return false;
+    }
+    finished.wait();
+    _roundTripLatencies.record(std::chrono::steady_clock::now() - startTimepoint);
+
+    finished.get();
+    return true;
+}
+
+bool CommandQueue::executeExclusively(std::function<void()> const& func, std::chrono::microseconds const& maxWaitForStart)
+{
+    struct State
+    {
+        std::atomic<CommandStatus> status{CommandStatus::Pending};
+        std::promise<void> started;
+        std::promise<void> released;
+    };
+    auto state = std::make_shared<State>();
+    auto started = state->started.get_future();
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+
+    post([state] {
+        if (!tryStart(state->status)) {
+            return;
+        }
+        auto released = state->released.get_future();
+        state->started.set_value();
+        released.wait();
+    });
+
+    if (started.wait_for(maxWaitForStart) == std::future_status::timeout && tryCancel(state->status)) {
+        return false;
+    }
+    started.wait();
+
+    try {
+        func();
+    } catch (...) {
+        state->released.set_value();
+        throw;
+    }
+    state->released.set_value();
+    _roundTripLatencies.record(std::chrono::steady_clock::now() - startTimepoint);
+
+    return true;
+}
+
+int CommandQueue::processCommands()
+{
+    int result = 0;
+    while (auto node = pop()) {
+        _queueingLatencies.record(std::chrono::steady_clock::now() - node->enqueueTimepoint);
+
+        //node remains in the queue as stub
+        auto func = std::move(node->func);
+        node->func = nullptr;
+        func();
+        ++result;
+    }
+    return result;
+}
+
+void CommandQueue::clear()
+{
+    while (auto node = pop()) {
+        node->func = nullptr;
+    }
+}
+
+LatencyHistogramData CommandQueue::getRoundTripLatencies() const
+{
+    return _roundTripLatencies.getData();
+}
+
+LatencyHistogramData CommandQueue::getQueueingLatencies() const
+{
+    return _queueingLatencies.getData();
+}
+
+void CommandQueue::push(Node* node)
+{
+    auto prevNode = _head.exchange(node, std::memory_order_acq_rel);
+    prevNode->next.store(node, std::memory_order_release);
+}
+
+auto CommandQueue::pop() -> Node*
+{
+    auto node = _tail->next.load(std::memory_order_acquire);
+    if (!node) {
+        return nullptr;
+    }
+    delete _tail;
+    _tail = node;
+    return node;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "Base/LatencyHistogram.h"
+
+/**
+ * Lock-free multi-producer single-consumer queue of commands which are executed by the consumer thread.
+ * Producers either post commands or wait for their execution (with the possibility to time out).
+ * Latencies of command round-trips and of the queueing delay are recorded.
+ */
+class CommandQueue
+{
+public:
+    CommandQueue();
+    ~CommandQueue();
+
+    CommandQueue(CommandQueue const&) = delete;
+    void operator=(CommandQueue const&) = delete;
+
+    //producer side
+    void post(std::function<void()>&& func);
+
+    //func is executed on the consumer thread, exceptions thrown by func are rethrown
+    //returns false if the execution has not been started within maxWaitForStart (func will not be executed then)
+    bool execute(std::function<void()> const& func, std::chrono::microseconds const& maxWaitForStart);
+
+    //func is executed on the calling thread while the consumer thread is blocked (e.g. for graphics interop which is bound to the calling thread)
+    //returns false if the consumer has not reached the command within maxWaitForStart (func will not be executed then)
+    bool executeExclusively(std::function<void()> const& func, std::chrono::microseconds const& maxWaitForStart);
+
+    //consumer side
+    int processCommands();  //returns number of processed commands
+    void clear();           //drops pending commands
+
+    LatencyHistogramData getRoundTripLatencies() const;  //for commands whose execution is awaited
+    LatencyHistogramData getQueueingLatencies() const;   //time between enqueuing and start for all commands
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        std::function<void()> func;
+        std::chrono::steady_clock::time_point enqueueTimepoint;
+    };
+    void push(Node* node);
+    Node* pop();  //returned node becomes the new stub
+
+    std::atomic<Node*> _head;  //last enqueued node, modified by producers
+    Node* _tail;               //stub node whose successor is the next command, accessed by the consumer only
+
+    LatencyHistogram _roundTripLatencies;
+    LatencyHistogram _queueingLatencies;
+};
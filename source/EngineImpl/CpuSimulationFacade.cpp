@@ -0,0 +1,1333 @@
+#include "CpuSimulationFacade.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#include "Base/DisjointSets.h"
+#include "Base/LoggingService.h"
+#include "Base/Math.h"
+#include "Base/ThreadPool.h"
+#include "EngineInterface/Enums.h"
+#include "EngineInterface/InspectedEntityIds.h"
+
+namespace
+{
+    float2 operator+(float2 const& p, float2 const& q) { return {p.x + q.x, p.y + q.y}; }
+    float2 operator-(float2 const& p, float2 const& q) { return {p.x - q.x, p.y - q.y}; }
+    float2 operator*(float2 const& p, float factor) { return {p.x * factor, p.y * factor}; }
+    float2 operator/(float2 const& p, float divisor) { return {p.x / divisor, p.y / divisor}; }
+
+    float length(float2 const& v) { return sqrtf(v.x * v.x + v.y * v.y); }
+    float dot(float2 const& p, float2 const& q) { return p.x * q.x + p.y * q.y; }
+    float2 normalized(float2 const& v)
+    {
+        auto l = length(v);
+        return l > FLOATINGPOINT_HIGH_PRECISION ? v / l : float2{0, 0};
+    }
+    float angleOfVector(float2 const& v)
+    {
+        if (length(v) < FLOATINGPOINT_HIGH_PRECISION) {
+            return 0;
+        }
+        return Math::angleOfVector(RealVector2D{v.x, v.y});
+    }
+    float subtractAngle(float angleMinuend, float angleSubtrahend)
+    {
+        auto angleDiff = angleMinuend - angleSubtrahend;
+        if (angleDiff > 360.0f) {
+            angleDiff -= 360.0f;
+        }
+        if (angleDiff < 0.0f) {
+            angleDiff += 360.0f;
+        }
+        return angleDiff;
+    }
+
+    float calcDistanceToLineSegment(float2 const& startSegment, float2 const& endSegment, float2 const& pos, float boundary)
+    {
+        auto relPos = pos - startSegment;
+        auto segmentDirection = endSegment - startSegment;
+        auto segmentLength = length(segmentDirection);
+        if (segmentLength < FLOATINGPOINT_HIGH_PRECISION) {
+            return boundary + 1.0f;
+        }
+        segmentDirection = segmentDirection / segmentLength;
+        float2 normal{segmentDirection.y, -segmentDirection.x};
+        auto signedDistanceFromLine = dot(relPos, normal);
+        if (std::abs(signedDistanceFromLine) > boundary) {
+            return boundary + 1.0f;
+        }
+        auto signedDistanceFromStart = dot(relPos, segmentDirection);
+        if (signedDistanceFromStart < 0 || signedDistanceFromStart > segmentLength) {
+            return boundary + 1.0f;
+        }
+        return std::abs(signedDistanceFromLine);
+    }
+
+    template <typename T>
+    bool isContainedInRect(T const& rectUpperLeft, T const& rectLowerRight, float2 const& pos)
+    {
+        return pos.x >= rectUpperLeft.x && pos.x <= rectLowerRight.x && pos.y >= rectUpperLeft.y && pos.y <= rectLowerRight.y;
+    }
+
+    //clamped to both bounds since corrected positions may still be rounded to the world size
+    int getGridCoordinate(float coordinate, float gridCellSize, int gridSize)
+    {
+        if (!(coordinate >= 0)) {
+            return 0;
+        }
+        return toInt(std::min(toFloat(gridSize - 1), coordinate / gridCellSize));
+    }
+
+    void parallelFor(int numElements, std::function<void(int)> const& func)
+    {
+        ThreadPool::getInstance().parallelFor(0, numElements, [&](int startIndex, int endIndex) {
+            for (int index = startIndex; index < endIndex; ++index) {
+                func(index);
+            }
+        });
+    }
+
+    class StageTimer
+    {
+    public:
+        StageTimer(TimestepProfile* profile)
+            : _profile(profile)
+        {
+            if (_profile) {
+                _profile->stages.clear();
+                _startTimepoint = _lastTimepoint = std::chrono::steady_clock::now();
+            }
+        }
+
+        void endStage(char const* name)
+        {
+            if (!_profile) {
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            auto toMicroseconds = [](auto const& duration) { return std::chrono::duration<float, std::micro>(duration).count(); };
+            _profile->stages.emplace_back(TimestepStage{name, toMicroseconds(_lastTimepoint - _startTimepoint), toMicroseconds(now - _lastTimepoint)});
+            _lastTimepoint = now;
+        }
+
+    private:
+        TimestepProfile* _profile;
+        std::chrono::steady_clock::time_point _startTimepoint;
+        std::chrono::steady_clock::time_point _lastTimepoint;
+    };
+
+    ArraySizes const DefaultArraySizes{100000, 100000, 10000};
+    float const InnerFriction = 0.3f;
+}
+
+_CpuSimulationFacade::_CpuSimulationFacade(uint64_t timestep, Settings const& settings)
+{
+    log(Priority::Important, "initialize simulation on CPU");
+
+    _currentTimestep.store(timestep);
+    _settings = settings;
+    _arraySizes = DefaultArraySizes;
+}
+
+void* _CpuSimulationFacade::registerImageResource(unsigned int image)
+{
+    return nullptr;
+}
+
+void _CpuSimulationFacade::calcTimestep(TimestepProfile* profile)
+{
+    auto const& parameters = _settings.simulationParameters;
+    auto const timestepSize = parameters.timestepSize;
+    auto const numCells = toInt(_cells.size());
+    StageTimer stageTimer(profile);
+
+    updateCellGrid();
+    stageTimer.endStage("cell grid");
+
+    //collisions
+    std::vector<float2> forces(numCells, float2{0, 0});
+    calcCollisionForces(forces);
+    parallelFor(numCells, [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        cell.vel = cell.vel + forces[index];
+        if (length(cell.vel) > parameters.cellMaxVel) {
+            cell.vel = normalized(cell.vel) * parameters.cellMaxVel;
+        }
+    });
+    stageTimer.endStage("collisions");
+
+    //particle movement
+    parallelFor(toInt(_particles.size()), [&](int index) {
+        auto& particle = _particles[index];
+        particle.pos = getCorrectedPosition(particle.pos + particle.vel * timestepSize);
+    });
+    stageTimer.endStage("particle movement");
+
+    //velocity verlet integration of bond forces
+    std::vector<float2> prevForces(numCells, float2{0, 0});
+    calcConnectionForces(prevForces);
+    parallelFor(numCells, [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        cell.pos = getCorrectedPosition(cell.pos + cell.vel * timestepSize + prevForces[index] * timestepSize * timestepSize / 2);
+    });
+    removeOverstretchedConnections();
+    stageTimer.endStage("positions, connections");
+
+    std::fill(forces.begin(), forces.end(), float2{0, 0});
+    calcConnectionForces(forces);
+    parallelFor(numCells, [&](int index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            cell.vel = {0, 0};
+        } else {
+            cell.vel = cell.vel + (prevForces[index] + forces[index]) / 2 * timestepSize;
+        }
+    });
+    stageTimer.endStage("connection forces, velocities");
+
+    if (_counter == 0) {
+        applyInnerFriction();
+    }
+    auto friction = parameters.spotValues.friction;
+    parallelFor(numCells, [&](int index) {
+        auto& cell = _cells[index];
+        if (!cell.barrier) {
+            cell.vel = cell.vel * (1.0f - friction);
+        }
+    });
+    stageTimer.endStage("friction");
+
+    if (++_counter == 3) {
+        _counter = 0;
+    }
+    ++_currentTimestep;
+
+    if (profile) {
+        profile->numCells = numCells;
+        profile->numParticles = toInt(_particles.size());
+        profile->numTokens = toInt(_tokens.size());
+    }
+}
+
+void _CpuSimulationFacade::drawVectorGraphics(
+    float2 const& rectUpperLeft,
+    float2 const& rectLowerRight,
+    void* cudaResource,
+    int2 const& imageSize,
+    double zoom)
+{
+    //rendering is not supported by the CPU backend
+}
+
+void _CpuSimulationFacade::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+{
+    std::vector<bool> cellFilter(_cells.size());
+    for (int i = 0; i < _cells.size(); ++i) {
+        cellFilter[i] = isContainedInRect(rectUpperLeft, rectLowerRight, getCorrectedPosition(_cells[i].pos));
+    }
+    std::vector<bool> particleFilter(_particles.size());
+    for (int i = 0; i < _particles.size(); ++i) {
+        particleFilter[i] = isContainedInRect(rectUpperLeft, rectLowerRight, getCorrectedPosition(_particles[i].pos));
+    }
+    getDataIntern(cellFilter, particleFilter, dataTO);
+}
+
+void _CpuSimulationFacade::getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO)
+{
+    std::vector<bool> cellFilter(_cells.size());
+    for (int i = 0; i < _cells.size(); ++i) {
+        cellFilter[i] = isSelected(_cells[i], includeClusters);
+    }
+    std::vector<bool> particleFilter(_particles.size());
+    for (int i = 0; i < _particles.size(); ++i) {
+        particleFilter[i] = _particles[i].selected != 0;
+    }
+    getDataIntern(cellFilter, particleFilter, dataTO);
+}
+
+void _CpuSimulationFacade::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO)
+{
+    if (entityIds.size() > Const::MaxInspectedEntities) {
+        return;
+    }
+    std::unordered_set<uint64_t> ids(entityIds.begin(), entityIds.end());
+    std::vector<bool> cellFilter(_cells.size());
+    for (int i = 0; i < _cells.size(); ++i) {
+        cellFilter[i] = ids.find(_cells[i].id) != ids.end();
+    }
+    std::vector<bool> particleFilter(_particles.size());
+    for (int i = 0; i < _particles.size(); ++i) {
+        particleFilter[i] = ids.find(_particles[i].id) != ids.end();
+    }
+    getDataIntern(cellFilter, particleFilter, dataTO);
+}
+
+void _CpuSimulationFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+{
+    *dataTO.numCells = 0;
+    *dataTO.numParticles = 0;
+    for (auto const& cell : _cells) {
+        if (!isContainedInRect(rectUpperLeft, rectLowerRight, getCorrectedPosition(cell.pos))) {
+            continue;
+        }
+        auto& cellTO = dataTO.cells[(*dataTO.numCells)++];
+        cellTO.id = cell.id;
+        cellTO.pos = cell.pos;
+        cellTO.cellFunctionType = cell.cellFunctionType;
+        cellTO.selected = cell.selected;
+        cellTO.branchNumber = cell.branchNumber;
+    }
+    for (auto const& particle : _particles) {
+        if (!isContainedInRect(rectUpperLeft, rectLowerRight, getCorrectedPosition(particle.pos))) {
+            continue;
+        }
+        auto& particleTO = dataTO.particles[(*dataTO.numParticles)++];
+        particleTO.id = particle.id;
+        particleTO.pos = particle.pos;
+        particleTO.selected = particle.selected;
+    }
+}
+
+void _CpuSimulationFacade::addAndSelectSimulationData(DataAccessTO const& dataTO)
+{
+    removeSelection();
+    addData(dataTO, true, true);
+}
+
+void _CpuSimulationFacade::setSimulationData(DataAccessTO const& dataTO)
+{
+    clear();
+    addData(dataTO, false, false);
+}
+
+void _CpuSimulationFacade::removeSelectedEntities(bool includeClusters)
+{
+    std::vector<bool> cellsToRemove(_cells.size());
+    for (int i = 0; i < _cells.size(); ++i) {
+        cellsToRemove[i] = isSelected(_cells[i], includeClusters);
+    }
+    removeCells(cellsToRemove);
+
+    _particles.erase(
+        std::remove_if(_particles.begin(), _particles.end(), [](auto const& particle) { return particle.selected == 1; }), _particles.end());
+}
+
+void _CpuSimulationFacade::relaxSelectedEntities(bool includeClusters)
+{
+    for (auto& cell : _cells) {
+        if (!isSelected(cell, includeClusters)) {
+            continue;
+        }
+        auto const numConnections = cell.numConnections;
+        for (int i = 0; i < numConnections; ++i) {
+            auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+            if (isSelected(connectedCell, includeClusters)) {
+                cell.connections[i].distance = length(getCorrectedDirection(connectedCell.pos - cell.pos));
+            }
+        }
+        if (numConnections > 1) {
+            for (int i = 0; i < numConnections; ++i) {
+                auto const& prevConnectedCell = _cells[cell.connections[(i + numConnections - 1) % numConnections].cellIndex];
+                auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+                if (!isSelected(connectedCell, includeClusters) || !isSelected(prevConnectedCell, includeClusters)) {
+                    continue;
+                }
+                auto prevAngle = angleOfVector(getCorrectedDirection(prevConnectedCell.pos - cell.pos));
+                auto angle = angleOfVector(getCorrectedDirection(connectedCell.pos - cell.pos));
+                auto actualAngleFromPrevious = subtractAngle(angle, prevAngle);
+                auto angleDiff = actualAngleFromPrevious - cell.connections[i].angleFromPrevious;
+
+                auto& nextConnection = cell.connections[(i + 1) % numConnections];
+                if (nextConnection.angleFromPrevious - angleDiff >= 0) {
+                    cell.connections[i].angleFromPrevious = actualAngleFromPrevious;
+                    nextConnection.angleFromPrevious -= angleDiff;
+                }
+            }
+        }
+    }
+}
+
+void _CpuSimulationFacade::uniformVelocitiesForSelectedEntities(bool includeClusters)
+{
+    float2 velocity{0, 0};
+    int numEntities = 0;
+    for (auto const& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            velocity = velocity + cell.vel;
+            ++numEntities;
+        }
+    }
+    for (auto const& particle : _particles) {
+        if (particle.selected != 0) {
+            velocity = velocity + particle.vel;
+            ++numEntities;
+        }
+    }
+    if (numEntities == 0) {
+        return;
+    }
+    velocity = velocity / toFloat(numEntities);
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.vel = velocity;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            particle.vel = velocity;
+        }
+    }
+}
+
+void _CpuSimulationFacade::makeSticky(bool includeClusters)
+{
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.maxConnections = _settings.simulationParameters.cellMaxBonds;
+        }
+    }
+}
+
+void _CpuSimulationFacade::removeStickiness(bool includeClusters)
+{
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.maxConnections = cell.numConnections;
+        }
+    }
+}
+
+void _CpuSimulationFacade::setBarrier(bool value, bool includeClusters)
+{
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.barrier = value;
+        }
+    }
+}
+
+void _CpuSimulationFacade::changeInspectedSimulationData(DataAccessTO const& changeDataTO)
+{
+    if (*changeDataTO.numCells == 1) {
+        auto const& cellTO = changeDataTO.cells[0];
+        auto cellIter = std::find_if(_cells.begin(), _cells.end(), [&](auto const& cell) { return cell.id == cellTO.id; });
+        if (cellIter != _cells.end()) {
+            auto& cell = *cellIter;
+            auto cellIndex = toInt(cellIter - _cells.begin());
+
+            cell.pos = getCorrectedPosition(cellTO.pos);
+            cell.vel = cellTO.vel;
+            cell.branchNumber = cellTO.branchNumber;
+            cell.tokenBlocked = cellTO.tokenBlocked;
+            cell.maxConnections = cellTO.maxConnections;
+            cell.energy = cellTO.energy;
+            cell.cellFunctionType = cellTO.cellFunctionType;
+            cell.barrier = cellTO.barrier;
+            switch (cell.cellFunctionType) {
+            case Enums::CellFunction_Computation: {
+                cell.numStaticBytes = cellTO.numStaticBytes;
+                cell.numMutableBytes = _settings.simulationParameters.cellFunctionComputerCellMemorySize;
+            } break;
+            case Enums::CellFunction_Sensor: {
+                cell.numStaticBytes = 0;
+                cell.numMutableBytes = 5;
+            } break;
+            default: {
+                cell.numStaticBytes = 0;
+                cell.numMutableBytes = 0;
+            }
+            }
+            std::memcpy(cell.staticData, cellTO.staticData, MAX_CELL_STATIC_BYTES);
+            std::memcpy(cell.mutableData, cellTO.mutableData, MAX_CELL_MUTABLE_BYTES);
+
+            auto& metadata = cell.metadata;
+            auto const& metadataTO = cellTO.metadata;
+            metadata.color = metadataTO.color;
+            metadata.nameLen = metadataTO.nameLen;
+            metadata.nameStringIndex = copyStringToStorage(metadataTO.nameLen, metadataTO.nameStringIndex, changeDataTO.stringBytes);
+            metadata.descriptionLen = metadataTO.descriptionLen;
+            metadata.descriptionStringIndex = copyStringToStorage(metadataTO.descriptionLen, metadataTO.descriptionStringIndex, changeDataTO.stringBytes);
+            metadata.sourceCodeLen = metadataTO.sourceCodeLen;
+            metadata.sourceCodeStringIndex = copyStringToStorage(metadataTO.sourceCodeLen, metadataTO.sourceCodeStringIndex, changeDataTO.stringBytes);
+
+            _tokens.erase(
+                std::remove_if(_tokens.begin(), _tokens.end(), [&](auto const& token) { return token.cellIndex == cellIndex; }), _tokens.end());
+            for (int i = 0; i < *changeDataTO.numTokens; ++i) {
+                auto token = changeDataTO.tokens[i];
+                token.cellIndex = cellIndex;
+                _tokens.emplace_back(token);
+            }
+        }
+    }
+    if (*changeDataTO.numParticles == 1) {
+        auto const& particleTO = changeDataTO.particles[0];
+        for (auto& particle : _particles) {
+            if (particle.id == particleTO.id) {
+                particle.energy = particleTO.energy;
+                particle.pos = getCorrectedPosition(particleTO.pos);
+                particle.metadata.color = particleTO.metadata.color;
+            }
+        }
+    }
+    adaptArraySizes({0, 0, 0});
+}
+
+void _CpuSimulationFacade::applyForce(ApplyForceData const& applyData)
+{
+    parallelFor(toInt(_cells.size()), [&](int index) {
+        auto& cell = _cells[index];
+        if (!cell.barrier && calcDistanceToLineSegment(applyData.startPos, applyData.endPos, cell.pos, applyData.radius) < applyData.radius) {
+            cell.vel = cell.vel + applyData.force;
+        }
+    });
+    parallelFor(toInt(_particles.size()), [&](int index) {
+        auto& particle = _particles[index];
+        if (calcDistanceToLineSegment(applyData.startPos, applyData.endPos, particle.pos, applyData.radius) < applyData.radius) {
+            particle.vel = particle.vel + applyData.force;
+        }
+    });
+}
+
+void _CpuSimulationFacade::switchSelection(PointSelectionData const& switchData)
+{
+    for (auto const& cell : _cells) {
+        if (cell.selected == 1 && getDistance(switchData.pos, cell.pos) < switchData.radius) {
+            return;
+        }
+    }
+    for (auto const& particle : _particles) {
+        if (particle.selected == 1 && getDistance(switchData.pos, particle.pos) < switchData.radius) {
+            return;
+        }
+    }
+
+    for (auto& cell : _cells) {
+        cell.selected = getDistance(switchData.pos, cell.pos) < switchData.radius ? 1 : 0;
+    }
+    for (auto& particle : _particles) {
+        particle.selected = getDistance(switchData.pos, particle.pos) < switchData.radius ? 1 : 0;
+    }
+    rolloutSelection();
+}
+
+void _CpuSimulationFacade::swapSelection(PointSelectionData const& selectionData)
+{
+    for (auto& cell : _cells) {
+        if (cell.selected == 2) {
+            cell.selected = 0;
+        }
+        if (getDistance(selectionData.pos, cell.pos) < selectionData.radius) {
+            cell.selected = 1 - cell.selected;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected == 2) {
+            particle.selected = 0;
+        }
+        if (getDistance(selectionData.pos, particle.pos) < selectionData.radius) {
+            particle.selected = 1 - particle.selected;
+        }
+    }
+    rolloutSelection();
+}
+
+void _CpuSimulationFacade::setSelection(AreaSelectionData const& selectionData)
+{
+    for (auto& cell : _cells) {
+        cell.selected = isContainedInRect(selectionData.startPos, selectionData.endPos, cell.pos) ? 1 : 0;
+    }
+    for (auto& particle : _particles) {
+        particle.selected = isContainedInRect(selectionData.startPos, selectionData.endPos, particle.pos) ? 1 : 0;
+    }
+    rolloutSelection();
+}
+
+SelectionShallowData _CpuSimulationFacade::getSelectionShallowData()
+{
+    SelectionShallowData result;
+    for (auto const& cell : _cells) {
+        if (cell.selected == 0) {
+            continue;
+        }
+        if (cell.selected == 1) {
+            ++result.numCells;
+            result.centerPosX += cell.pos.x;
+            result.centerPosY += cell.pos.y;
+            result.centerVelX += cell.vel.x;
+            result.centerVelY += cell.vel.y;
+        }
+        ++result.numClusterCells;
+        result.clusterCenterPosX += cell.pos.x;
+        result.clusterCenterPosY += cell.pos.y;
+        result.clusterCenterVelX += cell.vel.x;
+        result.clusterCenterVelY += cell.vel.y;
+    }
+    for (auto const& particle : _particles) {
+        if (particle.selected == 0) {
+            continue;
+        }
+        ++result.numParticles;
+        result.centerPosX += particle.pos.x;
+        result.centerPosY += particle.pos.y;
+        result.centerVelX += particle.vel.x;
+        result.centerVelY += particle.vel.y;
+        result.clusterCenterPosX += particle.pos.x;
+        result.clusterCenterPosY += particle.pos.y;
+        result.clusterCenterVelX += particle.vel.x;
+        result.clusterCenterVelY += particle.vel.y;
+    }
+
+    auto numEntities = result.numCells + result.numParticles;
+    if (numEntities > 0) {
+        result.centerPosX /= numEntities;
+        result.centerPosY /= numEntities;
+        result.centerVelX /= numEntities;
+        result.centerVelY /= numEntities;
+    }
+    auto numClusterEntities = result.numClusterCells + result.numParticles;
+    if (numClusterEntities > 0) {
+        result.clusterCenterPosX /= numClusterEntities;
+        result.clusterCenterPosY /= numClusterEntities;
+        result.clusterCenterVelX /= numClusterEntities;
+        result.clusterCenterVelY /= numClusterEntities;
+    }
+    return result;
+}
+
+void _CpuSimulationFacade::shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData)
+{
+    auto const& updateData = shallowUpdateData;
+    bool reconnectionRequired = !updateData.considerClusters && (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.angleDelta != 0);
+
+    if (reconnectionRequired) {
+        disconnectSelectionFromRemainings();
+    }
+
+    float2 posDelta{updateData.posDeltaX, updateData.posDeltaY};
+    float2 velDelta{updateData.velDeltaX, updateData.velDeltaY};
+    for (auto& cell : _cells) {
+        if (isSelected(cell, updateData.considerClusters)) {
+            cell.pos = getCorrectedPosition(cell.pos + posDelta);
+            cell.vel = cell.vel + velDelta;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            particle.pos = getCorrectedPosition(particle.pos + posDelta);
+            particle.vel = particle.vel + velDelta;
+        }
+    }
+
+    if (updateData.angleDelta != 0 || updateData.angularVelDelta != 0) {
+        float2 center{0, 0};
+        int numEntities = 0;
+        for (auto const& cell : _cells) {
+            if (isSelected(cell, updateData.considerClusters)) {
+                center = center + cell.pos;
+                ++numEntities;
+            }
+        }
+        for (auto const& particle : _particles) {
+            if (particle.selected != 0) {
+                center = center + particle.pos;
+                ++numEntities;
+            }
+        }
+        if (numEntities != 0) {
+            center = center / toFloat(numEntities);
+        }
+
+        auto rotationMatrix = Math::calcRotationMatrix(updateData.angleDelta);
+        auto rotate = [&](float2 const& relPos) {
+            auto result = rotationMatrix * RealVector2D{relPos.x, relPos.y};
+            return float2{result.x, result.y};
+        };
+        for (auto& cell : _cells) {
+            if (!isSelected(cell, updateData.considerClusters)) {
+                continue;
+            }
+            auto relPos = getCorrectedDirection(cell.pos - center);
+            if (updateData.angleDelta != 0) {
+                cell.pos = getCorrectedPosition(rotate(relPos) + center);
+            }
+            if (updateData.angularVelDelta != 0) {
+                float2 velDelta{-relPos.y, relPos.x};
+                cell.vel = cell.vel + velDelta * updateData.angularVelDelta * Const::DegToRad;
+            }
+        }
+        for (auto& particle : _particles) {
+            if (particle.selected != 0) {
+                auto relPos = getCorrectedDirection(particle.pos - center);
+                particle.pos = getCorrectedPosition(rotate(relPos) + center);
+            }
+        }
+    }
+
+    if (reconnectionRequired) {
+        connectSelectionToRemainings();
+        updateSelection();
+    }
+}
+
+void _CpuSimulationFacade::removeSelection()
+{
+    for (auto& cell : _cells) {
+        cell.selected = 0;
+    }
+    for (auto& particle : _particles) {
+        particle.selected = 0;
+    }
+}
+
+void _CpuSimulationFacade::updateSelection()
+{
+    for (auto& cell : _cells) {
+        if (cell.selected == 2) {
+            cell.selected = 0;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected == 2) {
+            particle.selected = 0;
+        }
+    }
+    rolloutSelection();
+}
+
+void _CpuSimulationFacade::colorSelectedEntities(unsigned char color, bool includeClusters)
+{
+    for (auto& cell : _cells) {
+        if (isSelected(cell, includeClusters)) {
+            cell.metadata.color = color;
+        }
+    }
+    for (auto& particle : _particles) {
+        if (particle.selected != 0) {
+            particle.metadata.color = color;
+        }
+    }
+}
+
+void _CpuSimulationFacade::reconnectSelectedEntities()
+{
+    disconnectSelectionFromRemainings();
+    connectSelectionToRemainings();
+    updateSelection();
+}
+
+void _CpuSimulationFacade::setGpuConstants(GpuSettings const& cudaConstants)
+{
+    _settings.gpuSettings = cudaConstants;
+}
+
+void _CpuSimulationFacade::setSimulationParameters(SimulationParameters const& parameters)
+{
+    _settings.simulationParameters = parameters;
+}
+
+void _CpuSimulationFacade::setSimulationParametersSpots(SimulationParametersSpots const& spots)
+{
+    _settings.simulationParametersSpots = spots;
+}
+
+void _CpuSimulationFacade::setFlowFieldSettings(FlowFieldSettings const& settings)
+{
+    _settings.flowFieldSettings = settings;
+}
+
+ArraySizes _CpuSimulationFacade::getArraySizes() const
+{
+    return _arraySizes;
+}
+
+void _CpuSimulationFacade::getEntityMonitorData(MonitorData& data)
+{
+    for (int i = 0; i < 7; ++i) {
+        data.numCellsByColor[i] = 0;
+        data.cellEnergyByColor[i] = 0;
+    }
+    for (auto& numCells : data.numCellsByFunction) {
+        numCells = 0;
+    }
+    for (auto& numTokens : data.tokenEnergyHistogram) {
+        numTokens = 0;
+    }
+    data.numConnections = 0;
+    data.totalInternalEnergy = 0;
+    for (auto const& cell : _cells) {
+        auto color = cell.metadata.color % 7;
+        ++data.numCellsByColor[color];
+        data.cellEnergyByColor[color] += cell.energy;
+        ++data.numCellsByFunction[((cell.cellFunctionType % Enums::CellFunction_Count) + Enums::CellFunction_Count) % Enums::CellFunction_Count];
+        data.numConnections += cell.numConnections;
+        data.totalInternalEnergy += cell.energy;
+    }
+    data.numConnections /= 2;
+    for (auto const& particle : _particles) {
+        data.totalInternalEnergy += particle.energy;
+    }
+    for (auto const& token : _tokens) {
+        data.totalInternalEnergy += token.energy;
+        ++data.tokenEnergyHistogram[calcMonitorHistogramBin(token.energy)];
+    }
+    data.numParticles = toInt(_particles.size());
+    data.numTokens = toInt(_tokens.size());
+}
+
+void _CpuSimulationFacade::getProcessMonitorData(MonitorData& data)
+{
+    //process statistics are not collected by the reference backend
+    data.numCreatedCells = 0;
+    data.numSuccessfulAttacks = 0;
+    data.numFailedAttacks = 0;
+    data.numMuscleActivities = 0;
+    data.garbageCollectionTime = 0;
+}
+
+void _CpuSimulationFacade::getClusterMonitorData(MonitorData& data)
+{
+    auto numCells = toInt(_cells.size());
+    DisjointSets cellSets(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cell = _cells[i];
+        for (int j = 0; j < cell.numConnections; ++j) {
+            cellSets.unite(i, cell.connections[j].cellIndex);
+        }
+    }
+    std::vector<int> clusterSizes(numCells, 0);
+    for (int i = 0; i < numCells; ++i) {
+        ++clusterSizes[cellSets.find(i)];
+    }
+
+    data.numClusters = 0;
+    for (auto& numClusters : data.clusterSizeHistogram) {
+        numClusters = 0;
+    }
+    for (auto const& clusterSize : clusterSizes) {
+        if (clusterSize > 0) {
+            ++data.numClusters;
+            ++data.clusterSizeHistogram[calcMonitorHistogramBin(toFloat(clusterSize))];
+        }
+    }
+}
+
+uint64_t _CpuSimulationFacade::getCurrentTimestep() const
+{
+    return _currentTimestep.load();
+}
+
+void _CpuSimulationFacade::setCurrentTimestep(uint64_t timestep)
+{
+    _currentTimestep.store(timestep);
+}
+
+void _CpuSimulationFacade::clear()
+{
+    _cells.clear();
+    _particles.clear();
+    _tokens.clear();
+    _stringBytes.clear();
+}
+
+void _CpuSimulationFacade::resizeArraysIfNecessary(ArraySizes const& additionals)
+{
+    adaptArraySizes(additionals);
+}
+
+void _CpuSimulationFacade::updateCellGrid()
+{
+    auto const& worldSize = _settings.generalSettings;
+    _gridCellSize = std::max(1.0f, _settings.simulationParameters.cellMaxCollisionDistance);
+    _gridSizeX = std::max(1, toInt(std::ceil(toFloat(worldSize.worldSizeX) / _gridCellSize)));
+    _gridSizeY = std::max(1, toInt(std::ceil(toFloat(worldSize.worldSizeY) / _gridCellSize)));
+
+    //counting sort of cell indices by grid cell
+    auto const numCells = toInt(_cells.size());
+    std::vector<int> gridIndices(numCells);
+    _gridStartIndices.assign(_gridSizeX * _gridSizeY + 1, 0);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& pos = _cells[i].pos;
+        auto x = getGridCoordinate(pos.x, _gridCellSize, _gridSizeX);
+        auto y = getGridCoordinate(pos.y, _gridCellSize, _gridSizeY);
+        gridIndices[i] = x + y * _gridSizeX;
+        ++_gridStartIndices[gridIndices[i] + 1];
+    }
+    for (int i = 0; i < _gridSizeX * _gridSizeY; ++i) {
+        _gridStartIndices[i + 1] += _gridStartIndices[i];
+    }
+    _gridCellIndices.resize(numCells);
+    std::vector<int> insertPositions(_gridStartIndices.begin(), _gridStartIndices.end() - 1);
+    for (int i = 0; i < numCells; ++i) {
+        _gridCellIndices[insertPositions[gridIndices[i]]++] = i;
+    }
+}
+
+template <typename Func>
+void _CpuSimulationFacade::forEachNearbyCell(float2 const& pos, Func const& func) const
+{
+    auto centerX = getGridCoordinate(pos.x, _gridCellSize, _gridSizeX);
+    auto centerY = getGridCoordinate(pos.y, _gridCellSize, _gridSizeY);
+    int visitedGridIndices[9];
+    int numVisited = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto x = ((centerX + dx) % _gridSizeX + _gridSizeX) % _gridSizeX;
+            auto y = ((centerY + dy) % _gridSizeY + _gridSizeY) % _gridSizeY;
+            auto gridIndex = x + y * _gridSizeX;
+
+            //small worlds: neighboring grid cells may coincide
+            if (std::find(visitedGridIndices, visitedGridIndices + numVisited, gridIndex) != visitedGridIndices + numVisited) {
+                continue;
+            }
+            visitedGridIndices[numVisited++] = gridIndex;
+
+            for (int i = _gridStartIndices[gridIndex]; i < _gridStartIndices[gridIndex + 1]; ++i) {
+                func(_gridCellIndices[i]);
+            }
+        }
+    }
+}
+
+void _CpuSimulationFacade::calcCollisionForces(std::vector<float2>& forces) const
+{
+    auto const& parameters = _settings.simulationParameters;
+
+    //the force of a collision pair (cell, otherCell) acts on both cells as in the GPU kernel,
+    //hence the force on a cell is gathered from both roles to avoid concurrent writes
+    auto calcForce = [&](CellAccessTO const& cell, CellAccessTO const& otherCell, float2 const& posDelta, float distance) {
+        auto velDelta = cell.vel - otherCell.vel;
+        auto isApproaching = dot(posDelta, velDelta) < 0;
+        auto barrierFactor = cell.barrier ? 2.0f : 1.0f;
+        if (length(cell.vel) > 0.5f && isApproaching) {
+            auto distanceSquared = distance * distance + 0.25f;
+            return posDelta * dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+        }
+        return normalized(posDelta) * (parameters.cellMaxCollisionDistance - distance) * parameters.cellRepulsionStrength * barrierFactor;
+    };
+
+    parallelFor(toInt(_cells.size()), [&](int index) {
+        auto const& cell = _cells[index];
+        float2 force{0, 0};
+        forEachNearbyCell(cell.pos, [&](int otherIndex) {
+            if (otherIndex == index || isConnected(index, otherIndex)) {
+                return;
+            }
+            auto const& otherCell = _cells[otherIndex];
+            auto posDelta = getCorrectedDirection(cell.pos - otherCell.pos);
+            auto distance = length(posDelta);
+            if (distance >= parameters.cellMaxCollisionDistance) {
+                return;
+            }
+            force = force + calcForce(cell, otherCell, posDelta, distance);
+            force = force - calcForce(otherCell, cell, posDelta * -1.0f, distance);
+        });
+        forces[index] = forces[index] + force;
+    });
+}
+
+void _CpuSimulationFacade::calcConnectionForces(std::vector<float2>& forces) const
+{
+    auto cellBindingForce = _settings.simulationParameters.spotValues.cellBindingForce;
+    parallelFor(toInt(_cells.size()), [&](int index) {
+        auto const& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        float2 force{0, 0};
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connection = cell.connections[i];
+            auto displacement = getCorrectedDirection(_cells[connection.cellIndex].pos - cell.pos);
+            auto deviation = length(displacement) - connection.distance;
+            force = force + normalized(displacement) * deviation / 2 * cellBindingForce;
+        }
+        forces[index] = forces[index] + force;
+    });
+}
+
+void _CpuSimulationFacade::removeOverstretchedConnections()
+{
+    auto maxBindingDistance = _settings.simulationParameters.cellMaxBindingDistance;
+    std::vector<int> cellIndices;
+    for (int index = 0; index < _cells.size(); ++index) {
+        auto const& cell = _cells[index];
+        if (cell.barrier) {
+            continue;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            if (getDistance(_cells[cell.connections[i].cellIndex].pos, cell.pos) > maxBindingDistance) {
+                cellIndices.emplace_back(index);
+                break;
+            }
+        }
+    }
+    for (auto const& index : cellIndices) {
+        while (_cells[index].numConnections > 0) {
+            removeConnection(index, _cells[index].connections[0].cellIndex);
+        }
+    }
+}
+
+void _CpuSimulationFacade::applyInnerFriction()
+{
+    auto const numCells = toInt(_cells.size());
+    std::vector<float2> velocities(numCells);
+    parallelFor(numCells, [&](int index) {
+        auto const& cell = _cells[index];
+        auto vel = cell.vel;
+        if (!cell.barrier) {
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+                auto averageVel = (vel + connectedCell.vel) / 2;
+                vel = vel * (1.0f - InnerFriction) + averageVel * InnerFriction;
+            }
+        }
+        velocities[index] = vel;
+    });
+    parallelFor(numCells, [&](int index) { _cells[index].vel = velocities[index]; });
+}
+
+void _CpuSimulationFacade::addData(DataAccessTO const& dataTO, bool selectData, bool createIds)
+{
+    auto const numOrigCells = toInt(_cells.size());
+    for (int i = 0; i < *dataTO.numCells; ++i) {
+        _maxId = std::max(_maxId, dataTO.cells[i].id);
+    }
+    for (int i = 0; i < *dataTO.numParticles; ++i) {
+        _maxId = std::max(_maxId, dataTO.particles[i].id);
+    }
+
+    for (int i = 0; i < *dataTO.numParticles; ++i) {
+        auto particle = dataTO.particles[i];
+        particle.id = createIds ? ++_maxId : particle.id;
+        particle.pos = getCorrectedPosition(particle.pos);
+        particle.selected = selectData ? 1 : 0;
+        _particles.emplace_back(particle);
+    }
+    for (int i = 0; i < *dataTO.numCells; ++i) {
+        auto cell = dataTO.cells[i];
+        cell.id = createIds ? ++_maxId : cell.id;
+        cell.pos = getCorrectedPosition(cell.pos);
+        cell.selected = selectData ? 1 : 0;
+        for (int j = 0; j < cell.numConnections; ++j) {
+            cell.connections[j].cellIndex += numOrigCells;
+        }
+        auto& metadata = cell.metadata;
+        metadata.nameStringIndex = copyStringToStorage(metadata.nameLen, metadata.nameStringIndex, dataTO.stringBytes);
+        metadata.descriptionStringIndex = copyStringToStorage(metadata.descriptionLen, metadata.descriptionStringIndex, dataTO.stringBytes);
+        metadata.sourceCodeStringIndex = copyStringToStorage(metadata.sourceCodeLen, metadata.sourceCodeStringIndex, dataTO.stringBytes);
+        _cells.emplace_back(cell);
+    }
+    for (int i = 0; i < *dataTO.numTokens; ++i) {
+        auto token = dataTO.tokens[i];
+        token.cellIndex += numOrigCells;
+        _tokens.emplace_back(token);
+    }
+    if (selectData) {
+        rolloutSelection();
+    }
+    adaptArraySizes({0, 0, 0});
+}
+
+void _CpuSimulationFacade::getDataIntern(std::vector<bool> const& cellFilter, std::vector<bool> const& particleFilter, DataAccessTO const& dataTO) const
+{
+    *dataTO.numCells = 0;
+    *dataTO.numParticles = 0;
+    *dataTO.numTokens = 0;
+    *dataTO.numStringBytes = 0;
+
+    auto copyString = [&](int len, int stringIndex) {
+        if (len <= 0) {
+            return 0;
+        }
+        auto result = *dataTO.numStringBytes;
+        std::memcpy(dataTO.stringBytes + result, _stringBytes.data() + stringIndex, len);
+        *dataTO.numStringBytes += len;
+        return result;
+    };
+
+    std::vector<int> cellTOIndices(_cells.size(), -1);
+    for (int i = 0; i < _cells.size(); ++i) {
+        if (!cellFilter[i]) {
+            continue;
+        }
+        cellTOIndices[i] = (*dataTO.numCells)++;
+        auto& cellTO = dataTO.cells[cellTOIndices[i]];
+        cellTO = _cells[i];
+        auto& metadata = cellTO.metadata;
+        metadata.nameStringIndex = copyString(metadata.nameLen, metadata.nameStringIndex);
+        metadata.descriptionStringIndex = copyString(metadata.descriptionLen, metadata.descriptionStringIndex);
+        metadata.sourceCodeStringIndex = copyString(metadata.sourceCodeLen, metadata.sourceCodeStringIndex);
+    }
+
+    //connections to cells outside the filter are marked with -1 as in the GPU implementation
+    for (int i = 0; i < *dataTO.numCells; ++i) {
+        auto& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            cellTO.connections[j].cellIndex = cellTOIndices[cellTO.connections[j].cellIndex];
+        }
+    }
+    for (int i = 0; i < _tokens.size(); ++i) {
+        auto const& token = _tokens[i];
+        if (cellTOIndices[token.cellIndex] == -1) {
+            continue;
+        }
+        auto& tokenTO = dataTO.tokens[(*dataTO.numTokens)++];
+        tokenTO = token;
+        tokenTO.cellIndex = cellTOIndices[token.cellIndex];
+        tokenTO.sequenceNumber = i;
+    }
+    for (int i = 0; i < _particles.size(); ++i) {
+        if (particleFilter[i]) {
+            dataTO.particles[(*dataTO.numParticles)++] = _particles[i];
+        }
+    }
+}
+
+void _CpuSimulationFacade::removeCells(std::vector<bool> const& cellsToRemove)
+{
+    for (int index = 0; index < _cells.size(); ++index) {
+        if (!cellsToRemove[index]) {
+            continue;
+        }
+        while (_cells[index].numConnections > 0) {
+            removeConnection(index, _cells[index].connections[0].cellIndex);
+        }
+    }
+
+    std::vector<int> newCellIndices(_cells.size(), -1);
+    std::vector<CellAccessTO> remainingCells;
+    std::vector<char> remainingStringBytes;
+    auto copyString = [&](int len, int stringIndex) {
+        auto result = toInt(remainingStringBytes.size());
+        if (len > 0) {
+            remainingStringBytes.insert(remainingStringBytes.end(), _stringBytes.begin() + stringIndex, _stringBytes.begin() + stringIndex + len);
+        }
+        return result;
+    };
+    for (int index = 0; index < _cells.size(); ++index) {
+        if (cellsToRemove[index]) {
+            continue;
+        }
+        newCellIndices[index] = toInt(remainingCells.size());
+        auto cell = _cells[index];
+        auto& metadata = cell.metadata;
+        metadata.nameStringIndex = copyString(metadata.nameLen, metadata.nameStringIndex);
+        metadata.descriptionStringIndex = copyString(metadata.descriptionLen, metadata.descriptionStringIndex);
+        metadata.sourceCodeStringIndex = copyString(metadata.sourceCodeLen, metadata.sourceCodeStringIndex);
+        remainingCells.emplace_back(cell);
+    }
+    for (auto& cell : remainingCells) {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            cell.connections[i].cellIndex = newCellIndices[cell.connections[i].cellIndex];
+        }
+    }
+    _cells = std::move(remainingCells);
+    _stringBytes = std::move(remainingStringBytes);
+
+    std::vector<TokenAccessTO> remainingTokens;
+    for (auto token : _tokens) {
+        if (newCellIndices[token.cellIndex] != -1) {
+            token.cellIndex = newCellIndices[token.cellIndex];
+            remainingTokens.emplace_back(token);
+        }
+    }
+    _tokens = std::move(remainingTokens);
+}
+
+int _CpuSimulationFacade::copyStringToStorage(int len, int stringIndex, char const* stringBytes)
+{
+    auto result = toInt(_stringBytes.size());
+    if (len > 0) {
+        _stringBytes.insert(_stringBytes.end(), stringBytes + stringIndex, stringBytes + stringIndex + len);
+    }
+    return result;
+}
+
+bool _CpuSimulationFacade::isSelected(CellAccessTO const& cell, bool includeClusters) const
+{
+    return (includeClusters && cell.selected != 0) || (!includeClusters && cell.selected == 1);
+}
+
+void _CpuSimulationFacade::rolloutSelection()
+{
+    std::vector<int> cellIndicesToVisit;
+    for (int index = 0; index < _cells.size(); ++index) {
+        if (_cells[index].selected != 0) {
+            cellIndicesToVisit.emplace_back(index);
+        }
+    }
+    while (!cellIndicesToVisit.empty()) {
+        auto const& cell = _cells[cellIndicesToVisit.back()];
+        cellIndicesToVisit.pop_back();
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto connectedCellIndex = cell.connections[i].cellIndex;
+            auto& connectedCell = _cells[connectedCellIndex];
+            if (connectedCell.selected == 0) {
+                connectedCell.selected = 2;
+                cellIndicesToVisit.emplace_back(connectedCellIndex);
+            }
+        }
+    }
+}
+
+void _CpuSimulationFacade::disconnectSelectionFromRemainings()
+{
+    auto maxBindingDistance = _settings.simulationParameters.cellMaxBindingDistance;
+    for (int index = 0; index < _cells.size(); ++index) {
+        if (_cells[index].selected != 1) {
+            continue;
+        }
+        for (int i = 0; i < _cells[index].numConnections;) {
+            auto const& connectedCell = _cells[_cells[index].connections[i].cellIndex];
+            if (connectedCell.selected != 1 && getDistance(_cells[index].pos, connectedCell.pos) > maxBindingDistance) {
+                removeConnection(index, _cells[index].connections[i].cellIndex);
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+void _CpuSimulationFacade::connectSelectionToRemainings()
+{
+    updateCellGrid();
+    auto maxCollisionDistance = _settings.simulationParameters.cellMaxCollisionDistance;
+    for (int index = 0; index < _cells.size(); ++index) {
+        if (_cells[index].selected != 1) {
+            continue;
+        }
+        forEachNearbyCell(_cells[index].pos, [&](int otherIndex) {
+            auto const& cell = _cells[index];
+            auto const& otherCell = _cells[otherIndex];
+            if (otherIndex == index || otherCell.selected == 1 || isConnected(index, otherIndex)) {
+                return;
+            }
+            auto distance = getDistance(cell.pos, otherCell.pos);
+            if (distance >= maxCollisionDistance) {
+                return;
+            }
+            if (cell.numConnections < cell.maxConnections && otherCell.numConnections < otherCell.maxConnections) {
+                addConnection(index, otherIndex, distance);
+                addConnection(otherIndex, index, distance);
+            }
+        });
+    }
+}
+
+void _CpuSimulationFacade::addConnection(int cellIndex, int otherCellIndex, float distance)
+{
+    auto& cell = _cells[cellIndex];
+    if (cell.numConnections == MAX_CELL_BONDS) {
+        return;
+    }
+    auto angleOfConnection = [&](int connectedCellIndex) { return angleOfVector(getCorrectedDirection(_cells[connectedCellIndex].pos - cell.pos)); };
+
+    //connections are sorted by angle, reference angles are taken from the actual geometry
+    auto newAngle = angleOfConnection(otherCellIndex);
+    int index = 0;
+    for (; index < cell.numConnections; ++index) {
+        if (angleOfConnection(cell.connections[index].cellIndex) > newAngle) {
+            break;
+        }
+    }
+    for (int i = cell.numConnections; i > index; --i) {
+        cell.connections[i] = cell.connections[i - 1];
+    }
+    cell.connections[index].cellIndex = otherCellIndex;
+    cell.connections[index].distance = distance;
+    ++cell.numConnections;
+
+    if (cell.numConnections == 1) {
+        cell.connections[0].angleFromPrevious = 360.0f;
+        return;
+    }
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto prevIndex = (i + cell.numConnections - 1) % cell.numConnections;
+        cell.connections[i].angleFromPrevious =
+            subtractAngle(angleOfConnection(cell.connections[i].cellIndex), angleOfConnection(cell.connections[prevIndex].cellIndex));
+    }
+}
+
+void _CpuSimulationFacade::removeConnection(int cellIndex, int otherCellIndex)
+{
+    auto removeOneWay = [&](CellAccessTO& cell, int connectedCellIndex) {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            if (cell.connections[i].cellIndex != connectedCellIndex) {
+                continue;
+            }
+            auto angleToAdd = cell.connections[i].angleFromPrevious;
+            for (int j = i; j < cell.numConnections - 1; ++j) {
+                cell.connections[j] = cell.connections[j + 1];
+            }
+            --cell.numConnections;
+            if (cell.numConnections > 0) {
+                cell.connections[i < cell.numConnections ? i : 0].angleFromPrevious += angleToAdd;
+            }
+            return;
+        }
+    };
+    removeOneWay(_cells[cellIndex], otherCellIndex);
+    removeOneWay(_cells[otherCellIndex], cellIndex);
+}
+
+bool _CpuSimulationFacade::isConnected(int cellIndex, int otherCellIndex) const
+{
+    auto const& cell = _cells[cellIndex];
+    for (int i = 0; i < cell.numConnections; ++i) {
+        if (cell.connections[i].cellIndex == otherCellIndex) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float2 _CpuSimulationFacade::getCorrectedPosition(float2 pos) const
+{
+    auto worldSizeX = toFloat(_settings.generalSettings.worldSizeX);
+    auto worldSizeY = toFloat(_settings.generalSettings.worldSizeY);
+    pos.x = std::fmod(pos.x, worldSizeX);
+    if (pos.x < 0) {
+        pos.x += worldSizeX;
+    }
+    pos.y = std::fmod(pos.y, worldSizeY);
+    if (pos.y < 0) {
+        pos.y += worldSizeY;
+    }
+    return pos;
+}
+
+float2 _CpuSimulationFacade::getCorrectedDirection(float2 delta) const
+{
+    auto worldSizeX = toFloat(_settings.generalSettings.worldSizeX);
+    auto worldSizeY = toFloat(_settings.generalSettings.worldSizeY);
+    delta.x -= worldSizeX * std::round(delta.x / worldSizeX);
+    delta.y -= worldSizeY * std::round(delta.y / worldSizeY);
+    return delta;
+}
+
+float _CpuSimulationFacade::getDistance(float2 const& pos1, float2 const& pos2) const
+{
+    return length(getCorrectedDirection(pos2 - pos1));
+}
+
+void _CpuSimulationFacade::adaptArraySizes(ArraySizes const& additionals)
+{
+    auto adapt = [](int& arraySize, int numEntities, int additionalEntities) {
+        if (numEntities + additionalEntities > arraySize) {
+            arraySize = (numEntities + additionalEntities) * 2;
+        }
+    };
+    adapt(_arraySizes.cellArraySize, toInt(_cells.size()), additionals.cellArraySize);
+    adapt(_arraySizes.particleArraySize, toInt(_particles.size()), additionals.particleArraySize);
+    adapt(_arraySizes.tokenArraySize, toInt(_tokens.size()), additionals.tokenArraySize);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "EngineGpuKernels/AccessTOs.cuh"
+#include "EngineGpuKernels/SimulationFacade.cuh"
+
+#include "Definitions.h"
+
+/**
+ * Host reference implementation of the simulation facade.
+ * Entities are kept in the access TO layout and processed in parallel on the CPU.
+ * The time step covers the physical part of the GPU pipeline (collisions, bonds, friction, movement),
+ * cell functions and token processing are not executed.
+ */
+class _CpuSimulationFacade : public _SimulationFacade
+{
+public:
+    _CpuSimulationFacade(uint64_t timestep, Settings const& settings);
+    ~_CpuSimulationFacade() override = default;
+
+    void* registerImageResource(unsigned int image) override;
+
+    void calcTimestep(TimestepProfile* profile) override;
+
+    void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom) override;
+    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) override;
+    void getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO) override;
+    void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO) override;
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO) override;
+    void addAndSelectSimulationData(DataAccessTO const& dataTO) override;
+    void setSimulationData(DataAccessTO const& dataTO) override;
+    void removeSelectedEntities(bool includeClusters) override;
+    void relaxSelectedEntities(bool includeClusters) override;
+    void uniformVelocitiesForSelectedEntities(bool includeClusters) override;
+    void makeSticky(bool includeClusters) override;
+    void removeStickiness(bool includeClusters) override;
+    void setBarrier(bool value, bool includeClusters) override;
+    void changeInspectedSimulationData(DataAccessTO const& changeDataTO) override;
+
+    void applyForce(ApplyForceData const& applyData) override;
+    void switchSelection(PointSelectionData const& switchData) override;
+    void swapSelection(PointSelectionData const& selectionData) override;
+    void setSelection(AreaSelectionData const& selectionData) override;
+    SelectionShallowData getSelectionShallowData() override;
+    void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData) override;
+    void removeSelection() override;
+    void updateSelection() override;
+    void colorSelectedEntities(unsigned char color, bool includeClusters) override;
+    void reconnectSelectedEntities() override;
+
+    void setGpuConstants(GpuSettings const& cudaConstants) override;
+    void setSimulationParameters(SimulationParameters const& parameters) override;
+    void setSimulationParametersSpots(SimulationParametersSpots const& spots) override;
+    void setFlowFieldSettings(FlowFieldSettings const& settings) override;
+
+    ArraySizes getArraySizes() const override;
+
+    void getEntityMonitorData(MonitorData& data) override;
+    void getProcessMonitorData(MonitorData& data) override;
+    void getClusterMonitorData(MonitorData& data) override;
+    uint64_t getCurrentTimestep() const override;
+    void setCurrentTimestep(uint64_t timestep) override;
+
+    void clear() override;
+
+    void resizeArraysIfNecessary(ArraySizes const& additionals) override;
+
+private:
+    //time step
+    void updateCellGrid();
+    template <typename Func>
+    void forEachNearbyCell(float2 const& pos, Func const& func) const;
+    void calcCollisionForces(std::vector<float2>& forces) const;
+    void calcConnectionForces(std::vector<float2>& forces) const;
+    void removeOverstretchedConnections();
+    void applyInnerFriction();
+
+    //data access
+    void addData(DataAccessTO const& dataTO, bool selectData, bool createIds);
+    void getDataIntern(std::vector<bool> const& cellFilter, std::vector<bool> const& particleFilter, DataAccessTO const& dataTO) const;
+    void removeCells(std::vector<bool> const& cellsToRemove);
+    int copyStringToStorage(int len, int stringIndex, char const* stringBytes);
+
+    //editing
+    bool isSelected(CellAccessTO const& cell, bool includeClusters) const;
+    void rolloutSelection();
+    void disconnectSelectionFromRemainings();
+    void connectSelectionToRemainings();
+    void addConnection(int cellIndex, int otherCellIndex, float distance);
+    void removeConnection(int cellIndex, int otherCellIndex);
+    bool isConnected(int cellIndex, int otherCellIndex) const;
+
+    //space
+    float2 getCorrectedPosition(float2 pos) const;
+    float2 getCorrectedDirection(float2 delta) const;
+    float getDistance(float2 const& pos1, float2 const& pos2) const;
+
+    void adaptArraySizes(ArraySizes const& additionals);
+
+    std::atomic<uint64_t> _currentTimestep;
+    Settings _settings;
+    ArraySizes _arraySizes;
+    uint64_t _maxId = 0;
+    int _counter = 0;
+
+    std::vector<CellAccessTO> _cells;
+    std::vector<ParticleAccessTO> _particles;
+    std::vector<TokenAccessTO> _tokens;
+    std::vector<char> _stringBytes;
+
+    //flat grid for neighborhood queries built in each time step
+    int _gridSizeX = 0;
+    int _gridSizeY = 0;
+    float _gridCellSize = 1.0f;
+    std::vector<int> _gridStartIndices;
+    std::vector<int> _gridCellIndices;
+};
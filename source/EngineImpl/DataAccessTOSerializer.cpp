@@ -0,0 +1,231 @@
+#include "DataAccessTOSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+namespace
+{
+    char const SnapshotMagic[] = "ALIENTO1";
+    int const MagicSize = 8;
+    uint32_t const SnapshotVersion = 1;
+
+    size_t const BufferSize = 1 << 20;
+    size_t const MaxBlockSize = 1 << 30;   //zlib takes input sizes as uInt
+
+    struct SnapshotHeader
+    {
+        char magic[MagicSize];
+        uint32_t version;
+        uint32_t cellSize;
+        uint32_t particleSize;
+        uint32_t tokenSize;
+        int numCells;
+        int numParticles;
+        int numTokens;
+        int numStringBytes;
+    };
+
+    SnapshotHeader readHeader(std::ifstream& stream)
+    {
+        SnapshotHeader result;
+        if (!stream.read(reinterpret_cast<char*>(&result), sizeof(result)) || std::memcmp(result.magic, SnapshotMagic, MagicSize) != 0) {
+            throw std::runtime_error("File is not a simulation snapshot.");
+        }
+        if (result.version != SnapshotVersion || result.cellSize != sizeof(CellAccessTO) || result.particleSize != sizeof(ParticleAccessTO)
+            || result.tokenSize != sizeof(TokenAccessTO)) {
+            throw std::runtime_error("Simulation snapshot has been written by an incompatible version.");
+        }
+        if (result.numCells < 0 || result.numParticles < 0 || result.numTokens < 0 || result.numStringBytes < 0
+            || result.numStringBytes > MAX_STRING_BYTES) {
+            throw std::runtime_error("Simulation snapshot is corrupted.");
+        }
+        return result;
+    }
+
+    //compresses data directly from the source arrays into the file
+    class DeflateWriter
+    {
+    public:
+        DeflateWriter(std::ofstream& stream)
+            : _stream(stream)
+            , _buffer(BufferSize)
+        {
+            _zStream.zalloc = Z_NULL;
+            _zStream.zfree = Z_NULL;
+            _zStream.opaque = Z_NULL;
+            if (deflateInit(&_zStream, Z_BEST_SPEED) != Z_OK) {
+                throw std::runtime_error("Could not initialize compression.");
+            }
+        }
+
+        ~DeflateWriter() { deflateEnd(&_zStream); }
+
+        void write(void const* data, size_t size)
+        {
+            auto bytes = reinterpret_cast<Bytef const*>(data);
+            while (size > 0) {
+                auto blockSize = std::min(size, MaxBlockSize);
+                _zStream.next_in = const_cast<Bytef*>(bytes);
+                _zStream.avail_in = static_cast<uInt>(blockSize);
+                deflateBuffer(Z_NO_FLUSH);
+                bytes += blockSize;
+                size -= blockSize;
+            }
+        }
+
+        void finish()
+        {
+            _zStream.next_in = Z_NULL;
+            _zStream.avail_in = 0;
+            deflateBuffer(Z_FINISH);
+        }
+
+    private:
+        void deflateBuffer(int flush)
+        {
+            int result;
+            do {
+                _zStream.next_out = _buffer.data();
+                _zStream.avail_out = static_cast<uInt>(_buffer.size());
+                result = deflate(&_zStream, flush);
+                if (result == Z_STREAM_ERROR) {
+                    throw std::runtime_error("Compression failed.");
+                }
+                _stream.write(reinterpret_cast<char const*>(_buffer.data()), _buffer.size() - _zStream.avail_out);
+                if (!_stream) {
+                    throw std::runtime_error("Could not write simulation snapshot.");
+                }
+            } while (_zStream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+        }
+
+        std::ofstream& _stream;
+        std::vector<Bytef> _buffer;
+        z_stream _zStream;
+    };
+
+    //decompresses data directly into the target arrays
+    class InflateReader
+    {
+    public:
+        InflateReader(std::ifstream& stream)
+            : _stream(stream)
+            , _buffer(BufferSize)
+        {
+            _zStream.zalloc = Z_NULL;
+            _zStream.zfree = Z_NULL;
+            _zStream.opaque = Z_NULL;
+            _zStream.next_in = Z_NULL;
+            _zStream.avail_in = 0;
+            if (inflateInit(&_zStream) != Z_OK) {
+                throw std::runtime_error("Could not initialize decompression.");
+            }
+        }
+
+        ~InflateReader() { inflateEnd(&_zStream); }
+
+        void read(void* data, size_t size)
+        {
+            auto bytes = reinterpret_cast<Bytef*>(data);
+            while (size > 0) {
+                auto blockSize = std::min(size, MaxBlockSize);
+                _zStream.next_out = bytes;
+                _zStream.avail_out = static_cast<uInt>(blockSize);
+                while (_zStream.avail_out > 0) {
+                    if (_zStream.avail_in == 0) {
+                        _stream.read(reinterpret_cast<char*>(_buffer.data()), _buffer.size());
+                        _zStream.next_in = _buffer.data();
+                        _zStream.avail_in = static_cast<uInt>(_stream.gcount());
+                        if (_zStream.avail_in == 0) {
+                            throw std::runtime_error("Simulation snapshot is truncated.");
+                        }
+                    }
+                    auto result = inflate(&_zStream, Z_NO_FLUSH);
+                    if (result == Z_STREAM_END && _zStream.avail_out > 0) {
+                        throw std::runtime_error("Simulation snapshot is truncated.");
+                    }
+                    if (result != Z_OK && result != Z_STREAM_END) {
+                        throw std::runtime_error("Simulation snapshot is corrupted.");
+                    }
+                }
+                bytes += blockSize;
+                size -= blockSize;
+            }
+        }
+
+    private:
+        std::ifstream& _stream;
+        std::vector<Bytef> _buffer;
+        z_stream _zStream;
+    };
+}
+
+bool DataAccessTOSerializer::isSnapshotFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[MagicSize];
+    if (!stream.read(magic, MagicSize)) {
+        return false;
+    }
+    return std::memcmp(magic, SnapshotMagic, MagicSize) == 0;
+}
+
+void DataAccessTOSerializer::serialize(std::string const& filename, DataAccessTO const& dataTO)
+{
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Could not create file " + filename + ".");
+    }
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SnapshotMagic, MagicSize);
+    header.version = SnapshotVersion;
+    header.cellSize = sizeof(CellAccessTO);
+    header.particleSize = sizeof(ParticleAccessTO);
+    header.tokenSize = sizeof(TokenAccessTO);
+    header.numCells = *dataTO.numCells;
+    header.numParticles = *dataTO.numParticles;
+    header.numTokens = *dataTO.numTokens;
+    header.numStringBytes = *dataTO.numStringBytes;
+    stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    DeflateWriter writer(stream);
+    writer.write(dataTO.cells, sizeof(CellAccessTO) * header.numCells);
+    writer.write(dataTO.particles, sizeof(ParticleAccessTO) * header.numParticles);
+    writer.write(dataTO.tokens, sizeof(TokenAccessTO) * header.numTokens);
+    writer.write(dataTO.stringBytes, header.numStringBytes);
+    writer.finish();
+
+    stream.close();
+    if (!stream) {
+        throw std::runtime_error("Could not write file " + filename + ".");
+    }
+}
+
+ArraySizes DataAccessTOSerializer::getArraySizes(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    auto header = readHeader(stream);
+    return {header.numCells, header.numParticles, header.numTokens};
+}
+
+void DataAccessTOSerializer::deserialize(DataAccessTO const& dataTO, std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    auto header = readHeader(stream);
+
+    InflateReader reader(stream);
+    reader.read(dataTO.cells, sizeof(CellAccessTO) * header.numCells);
+    reader.read(dataTO.particles, sizeof(ParticleAccessTO) * header.numParticles);
+    reader.read(dataTO.tokens, sizeof(TokenAccessTO) * header.numTokens);
+    reader.read(dataTO.stringBytes, header.numStringBytes);
+
+    *dataTO.numCells = header.numCells;
+    *dataTO.numParticles = header.numParticles;
+    *dataTO.numTokens = header.numTokens;
+    *dataTO.numStringBytes = header.numStringBytes;
+}
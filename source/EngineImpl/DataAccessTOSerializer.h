@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "EngineGpuKernels/AccessTOs.cuh"
+#include "EngineGpuKernels/Definitions.cuh"
+
+/**
+ * Writes the flat entity arrays of a DataAccessTO to a compressed file without conversion to descriptions.
+ * The arrays are stored in their in-memory layout, hence snapshots are only readable by builds with identical access TO structs.
+ */
+class DataAccessTOSerializer
+{
+public:
+    static bool isSnapshotFile(std::string const& filename);
+
+    //throws std::runtime_error on failure
+    static void serialize(std::string const& filename, DataAccessTO const& dataTO);
+
+    //returns the number of entities stored in the snapshot
+    static ArraySizes getArraySizes(std::string const& filename);
+
+    //dataTO must provide space for the entities returned by getArraySizes
+    static void deserialize(DataAccessTO const& dataTO, std::string const& filename);
+};
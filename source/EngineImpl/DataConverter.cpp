@@ -1,44 +1,69 @@
 #include "DataConverter.h"
 
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
 
+#include "Base/DisjointSets.h"
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ThreadPool.h"
 #include "EngineInterface/Descriptions.h"
 
+static_assert(Const::MaxCellBonds == MAX_CELL_BONDS, "ConnectionDescriptions must be able to hold all bonds of a cell");
 
 DataConverter::DataConverter(SimulationParameters const& parameters)
     : _parameters(parameters)
 {}
 
-ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescription(DataAccessTO const& dataTO, SortTokens sortTokens) const
+ClusteredDataDescription
+DataConverter::convertAccessTOtoClusteredDataDescription(DataAccessTO const& dataTO, SortTokens sortTokens, Parallelization parallelization) const
 {
 	ClusteredDataDescription result;
 
-    //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
-    }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+    //cells: determine connected components
+    auto numCells = *dataTO.numCells;
+    DisjointSets cellSets(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            auto const& connectionTO = cellTO.connections[j];
+            if (connectionTO.cellIndex != -1) {
+                cellSets.unite(i, connectionTO.cellIndex);
+            }
+        }
+    }
+
+    //cells: assign positions in clusters
+    std::vector<int> clusterDescIndexByRepresentative(numCells, -1);
+    std::vector<int> cellTOIndexToClusterDescIndex(numCells);
+    std::vector<int> cellTOIndexToCellDescIndex(numCells);
+    std::vector<int> clusterSizes;
+    for (int i = 0; i < numCells; ++i) {
+        auto& clusterDescIndex = clusterDescIndexByRepresentative[cellSets.find(i)];
+        if (clusterDescIndex == -1) {
+            clusterDescIndex = toInt(clusterSizes.size());
+            clusterSizes.emplace_back(0);
         }
-        ++clusterDescIndex;
+        cellTOIndexToClusterDescIndex[i] = clusterDescIndex;
+        cellTOIndexToCellDescIndex[i] = clusterSizes[clusterDescIndex]++;
+    }
+
+    //cells: create descriptions
+    result.clusters.resize(clusterSizes.size());
+    for (int i = 0; i < toInt(clusterSizes.size()); ++i) {
+        auto& cluster = result.clusters[i];
+        cluster.id = NumberGenerator::getInstance().getId();
+        cluster.cells.resize(clusterSizes[i]);
+    }
+    auto createCellDescriptions = [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            result.clusters[cellTOIndexToClusterDescIndex[i]].cells[cellTOIndexToCellDescIndex[i]] = createCellDescription(dataTO, i);
+        }
+    };
+    if (parallelization == Parallelization::Yes) {
+        ThreadPool::getInstance().parallelFor(0, numCells, createCellDescriptions);
+    } else {
+        createCellDescriptions(0, numCells);
     }
-    result.addClusters(clusters);
 
     //tokens
     for (int i = 0; i < *dataTO.numTokens; ++i) {
@@ -84,25 +109,42 @@ ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescriptio
 }
 
 DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO const& dataTO, SortTokens sortTokens) const
+{
+    return convertAccessTOtoDataDescription(
+        dataTO, std::vector<bool>(*dataTO.numCells, true), std::vector<bool>(*dataTO.numParticles, true), sortTokens);
+}
+
+DataDescription DataConverter::convertAccessTOtoDataDescription(
+    DataAccessTO const& dataTO,
+    std::vector<bool> const& cellFilter,
+    std::vector<bool> const& particleFilter,
+    SortTokens sortTokens) const
 {
     DataDescription result;
 
     //cells
+    std::vector<int> cellTOIndexToCellDescIndex(*dataTO.numCells, -1);
     std::vector<CellDescription> cells;
     for (int i = 0; i < *dataTO.numCells; ++i) {
-        cells.emplace_back(createCellDescription(dataTO, i));
+        if (cellFilter.at(i)) {
+            cellTOIndexToCellDescIndex[i] = toInt(cells.size());
+            cells.emplace_back(createCellDescription(dataTO, i));
+        }
     }
     result.addCells(cells);
 
     //tokens
     for (int i = 0; i < *dataTO.numTokens; ++i) {
         TokenAccessTO const& token = dataTO.tokens[i];
+        auto cellDescIndex = cellTOIndexToCellDescIndex.at(token.cellIndex);
+        if (cellDescIndex == -1) {
+            continue;
+        }
 
         std::string data(_parameters.tokenMemorySize, 0);
         for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
             data[i] = token.memory[i];
         }
-        auto cellDescIndex = token.cellIndex;
         CellDescription& cell = result.cells.at(cellDescIndex);
         cell.addToken(TokenDescription().setEnergy(token.energy).setData(data).setSequenceNumber(token.sequenceNumber));
     }
@@ -118,6 +160,9 @@ DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO con
     //particles
     std::vector<ParticleDescription> particles;
     for (int i = 0; i < *dataTO.numParticles; ++i) {
+        if (!particleFilter.at(i)) {
+            continue;
+        }
         ParticleAccessTO const& particle = dataTO.particles[i];
         particles.emplace_back(ParticleDescription()
                                    .setId(particle.id)
@@ -229,58 +274,175 @@ namespace
     }
 }
 
-namespace
+BulkDataDescription DataConverter::convertAccessTOtoBulkDataDescription(DataAccessTO const& dataTO) const
 {
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
+    BulkDataDescription result;
+
+    //cells
+    auto numCells = *dataTO.numCells;
+    auto& cells = result.cells;
+    cells.resize(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        cells.connectionOffsets[i + 1] = cells.connectionOffsets[i] + dataTO.cells[i].numConnections;
+    }
+    cells.resizeConnections(cells.connectionOffsets.back());
+
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            auto const& cellTO = dataTO.cells[i];
+            cells.ids[i] = cellTO.id;
+            cells.positions[i] = {cellTO.pos.x, cellTO.pos.y};
+            cells.velocities[i] = {cellTO.vel.x, cellTO.vel.y};
+            cells.energies[i] = cellTO.energy;
+            cells.colors[i] = cellTO.metadata.color;
+            cells.maxConnections[i] = cellTO.maxConnections;
+            cells.tokenBranchNumbers[i] = cellTO.branchNumber;
+            cells.tokenBlocked[i] = cellTO.tokenBlocked;
+            cells.barriers[i] = cellTO.barrier;
+            cells.cellFunctionTypes[i] = cellTO.cellFunctionType;
+            cells.cellFunctionInvocations[i] = cellTO.cellFunctionInvocations;
+            cells.constData[i] = convertToString(cellTO.staticData, cellTO.numStaticBytes);
+            cells.volatileData[i] = convertToString(cellTO.mutableData, cellTO.numMutableBytes);
+
+            auto const& metadataTO = cellTO.metadata;
+            if (metadataTO.nameLen > 0) {
+                cells.names[i] = std::string(&dataTO.stringBytes[metadataTO.nameStringIndex], metadataTO.nameLen);
+            }
+            if (metadataTO.descriptionLen > 0) {
+                cells.descriptions[i] = std::string(&dataTO.stringBytes[metadataTO.descriptionStringIndex], metadataTO.descriptionLen);
+            }
+            if (metadataTO.sourceCodeLen > 0) {
+                cells.sourceCodes[i] = std::string(&dataTO.stringBytes[metadataTO.sourceCodeStringIndex], metadataTO.sourceCodeLen);
+            }
+
+            auto connectionIndex = cells.connectionOffsets[i];
+            for (int j = 0; j < cellTO.numConnections; ++j, ++connectionIndex) {
+                auto const& connectionTO = cellTO.connections[j];
+                cells.connectionCellIndices[connectionIndex] = connectionTO.cellIndex;
+                cells.connectionDistances[connectionIndex] = connectionTO.distance;
+                cells.connectionAnglesFromPrevious[connectionIndex] = connectionTO.angleFromPrevious;
+            }
         }
+    });
+
+    //tokens: counting sort by cell index, order of tokens within a cell is preserved
+    auto numTokens = *dataTO.numTokens;
+    for (int i = 0; i < numTokens; ++i) {
+        ++cells.tokenOffsets[dataTO.tokens[i].cellIndex + 1];
+    }
+    for (int i = 0; i < numCells; ++i) {
+        cells.tokenOffsets[i + 1] += cells.tokenOffsets[i];
     }
+    cells.resizeTokens(numTokens);
+    std::vector<int> nextTokenIndices(cells.tokenOffsets.begin(), cells.tokenOffsets.end() - 1);
+    for (int i = 0; i < numTokens; ++i) {
+        auto const& tokenTO = dataTO.tokens[i];
+        auto tokenIndex = nextTokenIndices[tokenTO.cellIndex]++;
+        cells.tokenEnergies[tokenIndex] = tokenTO.energy;
+        cells.tokenData[tokenIndex] = convertToString(tokenTO.memory, _parameters.tokenMemorySize);
+    }
+
+    //particles
+    auto numParticles = *dataTO.numParticles;
+    auto& particles = result.particles;
+    particles.resize(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        auto const& particleTO = dataTO.particles[i];
+        particles.ids[i] = particleTO.id;
+        particles.positions[i] = {particleTO.pos.x, particleTO.pos.y};
+        particles.velocities[i] = {particleTO.vel.x, particleTO.vel.y};
+        particles.energies[i] = particleTO.energy;
+        particles.colors[i] = particleTO.metadata.color;
+    }
+    return result;
 }
 
-auto DataConverter::scanAndCreateClusterDescription(
-    DataAccessTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
+void DataConverter::convertBulkDataDescriptionToAccessTO(DataAccessTO& result, BulkDataDescription const& description) const
 {
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
+    auto const& cells = description.cells;
+    auto cellIndexOffset = *result.numCells;
+    auto numCells = cells.size();
+    *result.numCells += numCells;
+
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            auto& cellTO = result.cells[cellIndexOffset + i];
+            cellTO.id = cells.ids[i] == 0 ? NumberGenerator::getInstance().getId() : cells.ids[i];
+            cellTO.pos = {cells.positions[i].x, cells.positions[i].y};
+            cellTO.vel = {cells.velocities[i].x, cells.velocities[i].y};
+            cellTO.energy = cells.energies[i];
+            cellTO.maxConnections = cells.maxConnections[i];
+            cellTO.branchNumber = cells.tokenBranchNumbers[i];
+            cellTO.tokenBlocked = cells.tokenBlocked[i];
+            cellTO.barrier = cells.barriers[i];
+            cellTO.cellFunctionInvocations = cells.cellFunctionInvocations[i];
+            cellTO.cellFunctionType = cells.cellFunctionTypes[i] % Enums::CellFunction_Count;
+            cellTO.numStaticBytes = std::min(toInt(cells.constData[i].size()), MAX_CELL_STATIC_BYTES);
+            cellTO.numMutableBytes = std::min(toInt(cells.volatileData[i].size()), MAX_CELL_MUTABLE_BYTES);
+            convertToArray(cells.constData[i], cellTO.staticData, MAX_CELL_STATIC_BYTES);
+            convertToArray(cells.volatileData[i], cellTO.mutableData, MAX_CELL_MUTABLE_BYTES);
+            cellTO.metadata.color = cells.colors[i];
+
+            //connections to cells not present are removed and their angles are added to the next connection
+            int index = 0;
+            float angleOffset = 0;
+            for (int j = cells.connectionOffsets[i]; j < cells.connectionOffsets[i + 1]; ++j) {
+                auto connectedCellIndex = cells.connectionCellIndices[j];
+                if (connectedCellIndex != -1) {
+                    auto& connectionTO = cellTO.connections[index];
+                    connectionTO.cellIndex = cellIndexOffset + connectedCellIndex;
+                    connectionTO.distance = cells.connectionDistances[j];
+                    connectionTO.angleFromPrevious = cells.connectionAnglesFromPrevious[j] + angleOffset;
+                    ++index;
+                    angleOffset = 0;
+                } else {
+                    angleOffset += cells.connectionAnglesFromPrevious[j];
                 }
             }
-            ++cellDescIndex;
+            if (angleOffset != 0 && index > 0) {
+                cellTO.connections[0].angleFromPrevious += angleOffset;
+            }
+            cellTO.numConnections = index;
         }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
+    });
+
+    //strings are appended sequentially
+    for (int i = 0; i < numCells; ++i) {
+        auto& metadataTO = result.cells[cellIndexOffset + i].metadata;
+        metadataTO.nameLen = toInt(cells.names[i].size());
+        if (metadataTO.nameLen > 0) {
+            metadataTO.nameStringIndex = convertStringAndReturnStringIndex(result, cells.names[i]);
+        }
+        metadataTO.descriptionLen = toInt(cells.descriptions[i].size());
+        if (metadataTO.descriptionLen > 0) {
+            metadataTO.descriptionStringIndex = convertStringAndReturnStringIndex(result, cells.descriptions[i]);
+        }
+        metadataTO.sourceCodeLen = toInt(cells.sourceCodes[i].size());
+        if (metadataTO.sourceCodeLen > 0) {
+            metadataTO.sourceCodeStringIndex = convertStringAndReturnStringIndex(result, cells.sourceCodes[i]);
+        }
+    }
 
-    result.cluster.id = NumberGenerator::getInstance().getId();
-    result.cluster.addCells(cells);
+    //tokens
+    for (int i = 0; i < numCells; ++i) {
+        for (int j = cells.tokenOffsets[i]; j < cells.tokenOffsets[i + 1]; ++j) {
+            auto& tokenTO = result.tokens[(*result.numTokens)++];
+            tokenTO.energy = cells.tokenEnergies[j];
+            tokenTO.cellIndex = cellIndexOffset + i;
+            convertToArray(cells.tokenData[j], tokenTO.memory, _parameters.tokenMemorySize);
+        }
+    }
 
-    return result;
+    //particles
+    auto const& particles = description.particles;
+    for (int i = 0; i < particles.size(); ++i) {
+        auto& particleTO = result.particles[(*result.numParticles)++];
+        particleTO.id = particles.ids[i] == 0 ? NumberGenerator::getInstance().getId() : particles.ids[i];
+        particleTO.pos = {particles.positions[i].x, particles.positions[i].y};
+        particleTO.vel = {particles.velocities[i].x, particles.velocities[i].y};
+        particleTO.energy = particles.energies[i];
+        particleTO.metadata.color = particles.colors[i];
+    }
 }
 
 CellDescription DataConverter::createCellDescription(DataAccessTO const& dataTO, int cellIndex) const
@@ -293,7 +455,7 @@ CellDescription DataConverter::createCellDescription(DataAccessTO const& dataTO,
     result.vel = RealVector2D(cellTO.vel.x, cellTO.vel.y);
     result.energy = cellTO.energy;
     result.maxConnections = cellTO.maxConnections;
-    std::vector<ConnectionDescription> connections;
+    ConnectionDescriptions connections;
     for (int i = 0; i < cellTO.numConnections; ++i) {
         auto const& connectionTO = cellTO.connections[i];
         ConnectionDescription connection;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GpuSettings.h"
@@ -16,25 +17,28 @@ public:
     DataConverter(SimulationParameters const& parameters);
 
     enum class SortTokens {No, Yes};
-    ClusteredDataDescription convertAccessTOtoClusteredDataDescription(DataAccessTO const& dataTO, SortTokens sortTokens = SortTokens::No)
-        const;
+    enum class Parallelization {No, Yes};
+    ClusteredDataDescription convertAccessTOtoClusteredDataDescription(
+        DataAccessTO const& dataTO,
+        SortTokens sortTokens = SortTokens::No,
+        Parallelization parallelization = Parallelization::No) const;
     DataDescription convertAccessTOtoDataDescription(DataAccessTO const& dataTO, SortTokens sortTokens = SortTokens::No) const;
+    DataDescription convertAccessTOtoDataDescription(
+        DataAccessTO const& dataTO,
+        std::vector<bool> const& cellFilter,
+        std::vector<bool> const& particleFilter,
+        SortTokens sortTokens = SortTokens::No) const;  //only cells and particles with set filter flag are converted
     OverlayDescription convertAccessTOtoOverlayDescription(DataAccessTO const& dataTO) const;
+
+    //column-wise conversions without intermediate descriptions, cell indices of connections are taken over directly
+    BulkDataDescription convertAccessTOtoBulkDataDescription(DataAccessTO const& dataTO) const;
+    void convertBulkDataDescriptionToAccessTO(DataAccessTO& result, BulkDataDescription const& description) const;
     void convertClusteredDataDescriptionToAccessTO(DataAccessTO& result, ClusteredDataDescription const& description) const;
     void convertDataDescriptionToAccessTO(DataAccessTO& result, DataDescription const& description) const;
     void convertCellDescriptionToAccessTO(DataAccessTO& result, CellDescription const& cell) const;
     void convertParticleDescriptionToAccessTO(DataAccessTO& result, ParticleDescription const& particle) const;
 
 private:
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataAccessTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
     CellDescription createCellDescription(DataAccessTO const& dataTO, int cellIndex) const;
 
 	void addCell(
@@ -0,0 +1,170 @@
+#include "DeltaTracker.h"
+
+#include <cstddef>
+
+namespace
+{
+    size_t const MaxRemovals = 100000;
+
+    //FNV-1a
+    class Hasher
+    {
+    public:
+        void addBytes(void const* data, size_t size)
+        {
+            auto bytes = reinterpret_cast<unsigned char const*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                _hash = (_hash ^ bytes[i]) * 1099511628211ull;
+            }
+        }
+
+        template <typename T>
+        void add(T const& value)
+        {
+            addBytes(&value, sizeof(T));
+        }
+
+        uint64_t getHash() const { return _hash; }
+
+    private:
+        uint64_t _hash = 14695981039346656037ull;
+    };
+}
+
+auto DeltaTracker::update(DataAccessTO const& dataTO, uint64_t sinceEpoch) -> Changes
+{
+    ++_epoch;
+
+    Changes result;
+    result.epoch = _epoch;
+    result.complete = sinceEpoch == 0 || sinceEpoch < _oldestValidEpoch || sinceEpoch > _epoch;
+
+    auto updateEntity = [&](uint64_t id, uint64_t fingerprint) {
+        auto [iter, inserted] = _entityStateById.try_emplace(id);
+        auto& state = iter->second;
+        if (inserted || state.fingerprint != fingerprint) {
+            state.changeEpoch = _epoch;
+        }
+        state.fingerprint = fingerprint;
+        state.updateEpoch = _epoch;
+        return result.complete || state.changeEpoch > sinceEpoch;
+    };
+
+    auto tokenIndices = calcTokenIndices(dataTO);
+    result.changedCells.resize(*dataTO.numCells);
+    for (int i = 0; i < *dataTO.numCells; ++i) {
+        result.changedCells[i] = updateEntity(dataTO.cells[i].id, calcFingerprint(dataTO, i, tokenIndices));
+    }
+    result.changedParticles.resize(*dataTO.numParticles);
+    for (int i = 0; i < *dataTO.numParticles; ++i) {
+        result.changedParticles[i] = updateEntity(dataTO.particles[i].id, calcFingerprint(dataTO.particles[i]));
+    }
+
+    //entities not contained in this update are removed
+    for (auto iter = _entityStateById.begin(); iter != _entityStateById.end();) {
+        if (iter->second.updateEpoch != _epoch) {
+            addRemovedId(iter->first);
+            iter = _entityStateById.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    if (!result.complete) {
+        for (auto iter = _removals.rbegin(); iter != _removals.rend() && iter->epoch > sinceEpoch; ++iter) {
+            result.removedIds.emplace_back(iter->id);
+        }
+    }
+    return result;
+}
+
+void DeltaTracker::reset()
+{
+    _entityStateById.clear();
+    _removals.clear();
+    _oldestValidEpoch = _epoch + 1;
+}
+
+auto DeltaTracker::calcTokenIndices(DataAccessTO const& dataTO) const -> TokenIndices
+{
+    TokenIndices result;
+    result.startIndexByCell.resize(*dataTO.numCells + 1, 0);
+    for (int i = 0; i < *dataTO.numTokens; ++i) {
+        ++result.startIndexByCell[dataTO.tokens[i].cellIndex + 1];
+    }
+    for (int i = 0; i < *dataTO.numCells; ++i) {
+        result.startIndexByCell[i + 1] += result.startIndexByCell[i];
+    }
+    result.indices.resize(*dataTO.numTokens);
+    auto insertIndexByCell = result.startIndexByCell;
+    for (int i = 0; i < *dataTO.numTokens; ++i) {
+        result.indices[insertIndexByCell[dataTO.tokens[i].cellIndex]++] = i;
+    }
+    return result;
+}
+
+uint64_t DeltaTracker::calcFingerprint(DataAccessTO const& dataTO, int cellIndex, TokenIndices const& tokenIndices) const
+{
+    //fields are hashed separately since padding bytes are undefined and connections are compared by id
+    auto const& cell = dataTO.cells[cellIndex];
+    Hasher hasher;
+    hasher.add(cell.pos.x);
+    hasher.add(cell.pos.y);
+    hasher.add(cell.vel.x);
+    hasher.add(cell.vel.y);
+    hasher.add(cell.energy);
+    hasher.add(cell.maxConnections);
+    hasher.add(cell.numConnections);
+    hasher.add(cell.branchNumber);
+    hasher.add(cell.tokenBlocked);
+    for (int i = 0; i < cell.numConnections; ++i) {
+        auto const& connection = cell.connections[i];
+        hasher.add(connection.cellIndex != -1 ? dataTO.cells[connection.cellIndex].id : uint64_t(0));
+        hasher.add(connection.distance);
+        hasher.add(connection.angleFromPrevious);
+    }
+    hasher.add(cell.cellFunctionType);
+    hasher.add(cell.numStaticBytes);
+    hasher.addBytes(cell.staticData, cell.numStaticBytes);
+    hasher.add(cell.numMutableBytes);
+    hasher.addBytes(cell.mutableData, cell.numMutableBytes);
+    hasher.add(cell.cellFunctionInvocations);
+    hasher.add(cell.barrier);
+
+    auto const& metadata = cell.metadata;
+    hasher.add(metadata.color);
+    hasher.add(metadata.nameLen);
+    hasher.addBytes(dataTO.stringBytes + metadata.nameStringIndex, metadata.nameLen);
+    hasher.add(metadata.descriptionLen);
+    hasher.addBytes(dataTO.stringBytes + metadata.descriptionStringIndex, metadata.descriptionLen);
+    hasher.add(metadata.sourceCodeLen);
+    hasher.addBytes(dataTO.stringBytes + metadata.sourceCodeStringIndex, metadata.sourceCodeLen);
+
+    for (int i = tokenIndices.startIndexByCell[cellIndex]; i < tokenIndices.startIndexByCell[cellIndex + 1]; ++i) {
+        auto const& token = dataTO.tokens[tokenIndices.indices[i]];
+        hasher.add(token.energy);
+        hasher.add(token.sequenceNumber);
+        hasher.addBytes(token.memory, MAX_TOKEN_MEM_SIZE);
+    }
+    return hasher.getHash();
+}
+
+uint64_t DeltaTracker::calcFingerprint(ParticleAccessTO const& particle) const
+{
+    Hasher hasher;
+    hasher.add(particle.pos.x);
+    hasher.add(particle.pos.y);
+    hasher.add(particle.vel.x);
+    hasher.add(particle.vel.y);
+    hasher.add(particle.energy);
+    hasher.add(particle.metadata.color);
+    return hasher.getHash();
+}
+
+void DeltaTracker::addRemovedId(uint64_t id)
+{
+    _removals.push_back({id, _epoch});
+    if (_removals.size() > MaxRemovals) {
+        _oldestValidEpoch = _removals.front().epoch;
+        _removals.pop_front();
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineGpuKernels/AccessTOs.cuh"
+
+/**
+ * Tracks changes of the entities returned by successive data requests of one kind (e.g. inspected entities).
+ * Each update compares fingerprints of the entities in the given access TO with the previous ones and
+ * records the epoch of their last change. Entities which were missing in the previous update count as changed.
+ */
+class DeltaTracker
+{
+public:
+    struct Changes
+    {
+        uint64_t epoch = 0;
+        bool complete = false;  //sinceEpoch is unknown or too old: all entities are marked as changed
+        std::vector<bool> changedCells;
+        std::vector<bool> changedParticles;
+        std::vector<uint64_t> removedIds;
+    };
+    Changes update(DataAccessTO const& dataTO, uint64_t sinceEpoch);
+
+    //forgets all entities, clients will receive complete data on their next request
+    void reset();
+
+private:
+    struct TokenIndices
+    {
+        std::vector<int> startIndexByCell;  //tokens of cell i: indices[startIndexByCell[i]]...indices[startIndexByCell[i + 1] - 1]
+        std::vector<int> indices;
+    };
+    TokenIndices calcTokenIndices(DataAccessTO const& dataTO) const;
+    uint64_t calcFingerprint(DataAccessTO const& dataTO, int cellIndex, TokenIndices const& tokenIndices) const;
+    uint64_t calcFingerprint(ParticleAccessTO const& particle) const;
+    void addRemovedId(uint64_t id);
+
+    struct EntityState
+    {
+        uint64_t fingerprint = 0;
+        uint64_t changeEpoch = 0;
+        uint64_t updateEpoch = 0;
+    };
+    std::unordered_map<uint64_t, EntityState> _entityStateById;
+
+    struct Removal
+    {
+        uint64_t id;
+        uint64_t epoch;
+    };
+    std::deque<Removal> _removals;
+
+    uint64_t _epoch = 0;
+    uint64_t _oldestValidEpoch = 0;   //requests referring to older epochs obtain complete data
+};
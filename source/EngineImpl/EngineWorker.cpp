@@ -1,55 +1,80 @@
 #include "EngineWorker.h"
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
+#include "Base/Exceptions.h"
+#include "EngineInterface/InspectedEntityIds.h"
 #include "EngineGpuKernels/AccessTOs.cuh"
+#if defined(ALIEN_CUDA)
 #include "EngineGpuKernels/CudaSimulationFacade.cuh"
+#endif
 #include "AccessDataTOCache.h"
+#include "CpuSimulationFacade.h"
+#include "DataAccessTOSerializer.h"
 #include "DataConverter.h"
 
 namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
-    std::chrono::milliseconds const MonitorUpdate(30);
+    std::chrono::milliseconds const CommandTimeout(5000);
 }
 
 void EngineWorker::initCuda()
 {
+#if defined(ALIEN_CUDA)
     _CudaSimulationFacade::initCuda();
+#else
+    throw SystemRequirementNotMetException("This build does not contain the CUDA backend.");
+#endif
 }
 
 void EngineWorker::newSimulation(uint64_t timestep, Settings const& settings)
 {
-    _accessState = 0;
     _settings = settings;
     _dataTOCache = std::make_shared<_AccessDataTOCache>(settings.gpuSettings);
-    _cudaSimulation = std::make_shared<_CudaSimulationFacade>(timestep, settings);
+    _inspectedDataTracker.reset();
+    if (settings.backend == SimulationBackend::Cpu) {
+        _simulationFacade = std::make_shared<_CpuSimulationFacade>(timestep, settings);
+    } else {
+#if defined(ALIEN_CUDA)
+        _simulationFacade = std::make_shared<_CudaSimulationFacade>(timestep, settings);
+#else
+        throw SystemRequirementNotMetException("This build does not contain the CUDA backend.");
+#endif
+    }
 
     if (_imageResourceToRegister) {
-        _cudaResource = _cudaSimulation->registerImageResource(*_imageResourceToRegister);
+        _cudaResource = _simulationFacade->registerImageResource(*_imageResourceToRegister);
         _imageResourceToRegister = std::nullopt;
     }
+    if (_statisticsLogWriter) {
+        _statisticsLogWriter->startSession();
+    }
     updateMonitorDataIntern();
 }
 
 void EngineWorker::clear()
 {
-    EngineWorkerGuard access(this);
-    return _cudaSimulation->clear();
+    executeCommand([&] {
+        _simulationFacade->clear();
+    });
 }
 
 void EngineWorker::registerImageResource(void* image)
 {
-    GLuint imageId = reinterpret_cast<uintptr_t>(image);
-    if (!_cudaSimulation) {
+    auto imageId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(image));
+    if (!_simulationFacade) {
 
         //cuda is not initialized yet => register image resource later
         _imageResourceToRegister = imageId;
     } else {
 
-        EngineWorkerGuard access(this);
-        _cudaResource = _cudaSimulation->registerImageResource(imageId);
+        auto registerImage = [&] { _cudaResource = _simulationFacade->registerImageResource(imageId); };
+        if (!tryExecuteExclusively(registerImage, CommandTimeout)) {
+            throw std::runtime_error("GPU Timeout");
+        }
     }
 }
 
@@ -59,17 +84,12 @@ void EngineWorker::tryDrawVectorGraphics(
     IntVector2D const& imageSize,
     double zoom)
 {
-    EngineWorkerGuard access(this, FrameTimeout);
-
-
-    if (!access.isTimeout()) {
-        _cudaSimulation->drawVectorGraphics(
-            {rectUpperLeft.x, rectUpperLeft.y},
-            {rectLowerRight.x, rectLowerRight.y},
-            _cudaResource,
-            {imageSize.x, imageSize.y},
-            zoom);
-    }
+    tryExecuteExclusively(
+        [&] {
+            _simulationFacade->drawVectorGraphics(
+                {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom);
+        },
+        FrameTimeout);
 }
 
 std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOverlay(
@@ -78,123 +98,205 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
     IntVector2D const& imageSize,
     double zoom)
 {
-    EngineWorkerGuard access(this, FrameTimeout);
+    std::optional<OverlayDescription> result;
+    tryExecuteExclusively(
+        [&] {
+            _simulationFacade->drawVectorGraphics(
+                {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, _cudaResource, {imageSize.x, imageSize.y}, zoom);
+
+            auto arraySizes = _simulationFacade->getArraySizes();
+            DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, 0});  //overlays contain no tokens
 
-    if (!access.isTimeout()) {
-        _cudaSimulation->drawVectorGraphics(
-            {rectUpperLeft.x, rectUpperLeft.y},
-            {rectLowerRight.x, rectLowerRight.y},
-            _cudaResource,
-            {imageSize.x, imageSize.y},
-            zoom);
+            _simulationFacade->getOverlayData(
+                {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)}, int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)}, dataTO);
 
-        auto arraySizes = _cudaSimulation->getArraySizes();
-        DataAccessTO dataTO = _dataTOCache->getDataTO(
-            {arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+            DataConverter converter(_settings.simulationParameters);
+            result = converter.convertAccessTOtoOverlayDescription(dataTO);
+            _dataTOCache->releaseDataTO(dataTO);
+        },
+        FrameTimeout);
+    return result;
+}
 
-        _cudaSimulation->getOverlayData(
-            {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
-            int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)},
-            dataTO);
+ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO =
+            _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSimulationData(
+            {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
         DataConverter converter(_settings.simulationParameters);
-        auto result = converter.convertAccessTOtoOverlayDescription(dataTO);
+
+        auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO, DataConverter::SortTokens::No, DataConverter::Parallelization::Yes);
         _dataTOCache->releaseDataTO(dataTO);
 
         return result;
-    }
-    return std::nullopt;
+    });
 }
 
-ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    EngineWorkerGuard access(this);
-
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSimulationData(
-        {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
-    DataConverter converter(_settings.simulationParameters);
+        DataConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO);
-    _dataTOCache->releaseDataTO(dataTO);
+        auto result = converter.convertAccessTOtoDataDescription(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
 
-    return result;
+        return result;
+    });
 }
 
-DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+BulkDataDescription EngineWorker::getBulkSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    EngineWorkerGuard access(this);
-
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
 
-    DataConverter converter(_settings.simulationParameters);
+        DataConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertAccessTOtoDataDescription(dataTO);
-    _dataTOCache->releaseDataTO(dataTO);
+        auto result = converter.convertAccessTOtoBulkDataDescription(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
 
-    return result;
+        return result;
+    });
 }
 
 ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSelectedSimulationData(includeClusters, dataTO);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
-
-    DataConverter converter(_settings.simulationParameters);
+        DataConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO);
-    _dataTOCache->releaseDataTO(dataTO);
+        auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO, DataConverter::SortTokens::No, DataConverter::Parallelization::Yes);
+        _dataTOCache->releaseDataTO(dataTO);
 
-    return result;
+        return result;
+    });
 }
 
 DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO =
+            _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSelectedSimulationData(includeClusters, dataTO);
 
-    DataConverter converter(_settings.simulationParameters);
+        DataConverter converter(_settings.simulationParameters);
 
-    auto result = converter.convertAccessTOtoDataDescription(dataTO);
-    _dataTOCache->releaseDataTO(dataTO);
+        auto result = converter.convertAccessTOtoDataDescription(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
 
-    return result;
+        return result;
+    });
 }
 
 DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> entityIds)
 {
-    EngineWorkerGuard access(this);
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({Const::MaxInspectedEntities, Const::MaxInspectedEntities, arraySizes.tokenArraySize});
+        _simulationFacade->getInspectedSimulationData(entityIds, dataTO);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getInspectedSimulationData(entityIds, dataTO);
+        DataConverter converter(_settings.simulationParameters);
 
-    DataConverter converter(_settings.simulationParameters);
+        auto result = converter.convertAccessTOtoDataDescription(dataTO, DataConverter::SortTokens::Yes);
+        _dataTOCache->releaseDataTO(dataTO);
 
-    auto result = converter.convertAccessTOtoDataDescription(dataTO, DataConverter::SortTokens::Yes);
-    _dataTOCache->releaseDataTO(dataTO);
+        return result;
+    });
+}
 
-    return result;
+namespace
+{
+    DataDescriptionDelta createDataDescriptionDelta(DataConverter const& converter, DataAccessTO const& dataTO, DeltaTracker::Changes const& changes)
+    {
+        DataDescriptionDelta result;
+        result.epoch = changes.epoch;
+        result.complete = changes.complete;
+        result.changedData = converter.convertAccessTOtoDataDescription(dataTO, changes.changedCells, changes.changedParticles, DataConverter::SortTokens::Yes);
+        result.removedIds = changes.removedIds;
+        return result;
+    }
+}
+
+DataDescriptionDelta EngineWorker::getInspectedSimulationDataDelta(std::vector<uint64_t> entityIds, uint64_t sinceEpoch)
+{
+    return executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({Const::MaxInspectedEntities, Const::MaxInspectedEntities, arraySizes.tokenArraySize});
+        _simulationFacade->getInspectedSimulationData(entityIds, dataTO);
+
+        auto changes = _inspectedDataTracker.update(dataTO, sinceEpoch);
+        DataConverter converter(_settings.simulationParameters);
+        auto result = createDataDescriptionDelta(converter, dataTO, changes);
+
+        //requested entities which do not exist (anymore) are reported as removed
+        if (!result.complete) {
+            std::unordered_set<uint64_t> knownIds(result.removedIds.begin(), result.removedIds.end());
+            for (int i = 0; i < *dataTO.numCells; ++i) {
+                knownIds.insert(dataTO.cells[i].id);
+            }
+            for (int i = 0; i < *dataTO.numParticles; ++i) {
+                knownIds.insert(dataTO.particles[i].id);
+            }
+            for (auto const& id : entityIds) {
+                if (knownIds.find(id) == knownIds.end()) {
+                    result.removedIds.emplace_back(id);
+                }
+            }
+        }
+        _dataTOCache->releaseDataTO(dataTO);
+
+        return result;
+    });
 }
 
 MonitorData EngineWorker::getMonitorData() const
 {
-    std::lock_guard guard(_mutexForStatistics);
+    return _publishedMonitorData.load();
+}
+
+void EngineWorker::enableStatisticsLog(std::string const& filename)
+{
+    _statisticsLogWriter.emplace(filename);
+}
+
+void EngineWorker::flushStatisticsLog()
+{
+    executeCommand([&] {
+        if (_statisticsLogWriter) {
+            _statisticsLogWriter->flush();
+        }
+    });
+}
 
-    return _lastStatistics;
+void EngineWorker::setTimestepProfilingEnabled(bool value)
+{
+    if (value && !_isTimestepProfilingEnabled.load()) {
+        _timestepProfiles.clear();
+    }
+    _isTimestepProfilingEnabled.store(value);
+}
+
+bool EngineWorker::isTimestepProfilingEnabled() const
+{
+    return _isTimestepProfilingEnabled.load();
+}
+
+std::vector<TimestepProfile> EngineWorker::getTimestepProfiles() const
+{
+    return _timestepProfiles.getProfiles();
 }
 
 namespace
@@ -227,144 +329,214 @@ namespace
         result.particles = data.particles.size();
         return result;
     }
+    NumberOfEntities getNumberOfEntities(BulkDataDescription const& data)
+    {
+        NumberOfEntities result;
+        result.cells = data.cells.size();
+        result.tokens = data.cells.getNumTokens();
+        result.particles = data.particles.size();
+        return result;
+    }
 }
 
 void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdate)
 {
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->resizeArraysIfNecessary(
-        {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
+    executeCommand([&] {
+        _simulationFacade->resizeArraysIfNecessary(
+            {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    DataAccessTO dataTO = provideTO();
+        DataAccessTO dataTO = _dataTOCache->getDataTO({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    DataConverter converter(_settings.simulationParameters);
-    converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
-    _cudaSimulation->addAndSelectSimulationData(dataTO);
-    updateMonitorDataIntern();
+        _simulationFacade->addAndSelectSimulationData(dataTO);
+        updateMonitorDataIntern();
 
-    _dataTOCache->releaseDataTO(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+    });
 }
 
 void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
 {
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
-    EngineWorkerGuard access(this);
+    executeCommand([&] {
+        _simulationFacade->resizeArraysIfNecessary(
+            {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    _cudaSimulation->resizeArraysIfNecessary(
-        {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
+        DataAccessTO dataTO = _dataTOCache->getDataTO({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    DataAccessTO dataTO = provideTO();
-
-    DataConverter converter(_settings.simulationParameters);
-    converter.convertClusteredDataDescriptionToAccessTO(dataTO, dataToUpdate);
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertClusteredDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
-    _cudaSimulation->setSimulationData(dataTO);
-    updateMonitorDataIntern();
+        _simulationFacade->setSimulationData(dataTO);
+        updateMonitorDataIntern();
 
-    _dataTOCache->releaseDataTO(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+    });
 }
 
 void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
 {
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
-    EngineWorkerGuard access(this);
+    executeCommand([&] {
+        _simulationFacade->resizeArraysIfNecessary({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    _cudaSimulation->resizeArraysIfNecessary({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
+        DataAccessTO dataTO = _dataTOCache->getDataTO({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
-    DataAccessTO dataTO = provideTO();
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
-    DataConverter converter(_settings.simulationParameters);
-    converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
+        _simulationFacade->setSimulationData(dataTO);
+        updateMonitorDataIntern();
 
-    _cudaSimulation->setSimulationData(dataTO);
-    updateMonitorDataIntern();
+        _dataTOCache->releaseDataTO(dataTO);
+    });
+}
 
-    _dataTOCache->releaseDataTO(dataTO);
+void EngineWorker::setBulkSimulationData(BulkDataDescription const& dataToUpdate)
+{
+    auto numberOfEntities = getNumberOfEntities(dataToUpdate);
+
+    executeCommand([&] {
+        _simulationFacade->resizeArraysIfNecessary({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
+
+        DataAccessTO dataTO = _dataTOCache->getDataTO({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
+
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertBulkDataDescriptionToAccessTO(dataTO, dataToUpdate);
+
+        _simulationFacade->setSimulationData(dataTO);
+        updateMonitorDataIntern();
+
+        _dataTOCache->releaseDataTO(dataTO);
+    });
 }
 
 void EngineWorker::removeSelectedEntities(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->removeSelectedEntities(includeClusters);
-    updateMonitorDataIntern();
+    executeCommand([&] {
+        _simulationFacade->removeSelectedEntities(includeClusters);
+        updateMonitorDataIntern();
+    });
 }
 
 void EngineWorker::relaxSelectedEntities(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->relaxSelectedEntities(includeClusters);
+    executeCommand([&] {
+        _simulationFacade->relaxSelectedEntities(includeClusters);
+    });
 }
 
 void EngineWorker::uniformVelocitiesForSelectedEntities(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->uniformVelocitiesForSelectedEntities(includeClusters);
+    executeCommand([&] {
+        _simulationFacade->uniformVelocitiesForSelectedEntities(includeClusters);
+    });
 }
 
 void EngineWorker::makeSticky(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->makeSticky(includeClusters);
+    executeCommand([&] {
+        _simulationFacade->makeSticky(includeClusters);
+    });
 }
 
 void EngineWorker::removeStickiness(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->removeStickiness(includeClusters);
+    executeCommand([&] {
+        _simulationFacade->removeStickiness(includeClusters);
+    });
 }
 
 void EngineWorker::setBarrier(bool value, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _cudaSimulation->setBarrier(value, includeClusters);
+    executeCommand([&] {
+        _simulationFacade->setBarrier(value, includeClusters);
+    });
 }
 
 void EngineWorker::changeCell(CellDescription const& changedCell)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
+    executeCommand([&] {
+        auto dataTO = _dataTOCache->getDataTO({1, 0, toInt(changedCell.tokens.size())});
 
-    DataConverter converter(_settings.simulationParameters);
-    converter.convertCellDescriptionToAccessTO(dataTO, changedCell);
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertCellDescriptionToAccessTO(dataTO, changedCell);
 
-    _cudaSimulation->changeInspectedSimulationData(dataTO);
+        _simulationFacade->changeInspectedSimulationData(dataTO);
 
-    _dataTOCache->releaseDataTO(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+    });
 }
 
 void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
 {
-    EngineWorkerGuard access(this);
+    executeCommand([&] {
+        auto dataTO = _dataTOCache->getDataTO({0, 1, 0});
 
-    auto dataTO = provideTO();
+        DataConverter converter(_settings.simulationParameters);
+        converter.convertParticleDescriptionToAccessTO(dataTO, changedParticle);
 
-    DataConverter converter(_settings.simulationParameters);
-    converter.convertParticleDescriptionToAccessTO(dataTO, changedParticle);
+        _simulationFacade->changeInspectedSimulationData(dataTO);
 
-    _cudaSimulation->changeInspectedSimulationData(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+    });
+}
 
-    _dataTOCache->releaseDataTO(dataTO);
+void EngineWorker::serializeSimulationDataToFile(std::string const& filename)
+{
+    auto dataTO = executeCommand([&] {
+        auto arraySizes = _simulationFacade->getArraySizes();
+        auto result = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _simulationFacade->getSimulationData(
+            {-10, -10}, {_settings.generalSettings.worldSizeX + 10, _settings.generalSettings.worldSizeY + 10}, result);
+        return result;
+    });
+
+    //simulation can continue while writing, the cache is only accessed by the worker thread
+    auto releaseDataTO = [this, dataTO] { _dataTOCache->releaseDataTO(dataTO); };
+    try {
+        DataAccessTOSerializer::serialize(filename, dataTO);
+    } catch (...) {
+        _commandQueue.post(releaseDataTO);
+        throw;
+    }
+    _commandQueue.post(releaseDataTO);
 }
 
-void EngineWorker::calcSingleTimestep()
+void EngineWorker::deserializeSimulationDataFromFile(std::string const& filename)
 {
-    EngineWorkerGuard access(this);
+    auto numberOfEntities = DataAccessTOSerializer::getArraySizes(filename);
 
-    _cudaSimulation->calcTimestep();
-    updateMonitorDataIntern();
+    executeCommand([&] {
+        _simulationFacade->resizeArraysIfNecessary(numberOfEntities);
+
+        DataAccessTO dataTO = _dataTOCache->getDataTO({numberOfEntities.cellArraySize, numberOfEntities.particleArraySize, numberOfEntities.tokenArraySize});
+        try {
+            DataAccessTOSerializer::deserialize(dataTO, filename);
+        } catch (...) {
+            _dataTOCache->releaseDataTO(dataTO);
+            throw;
+        }
+
+        _simulationFacade->setSimulationData(dataTO);
+        updateMonitorDataIntern();
+
+        _dataTOCache->releaseDataTO(dataTO);
+    });
+}
+
+void EngineWorker::calcSingleTimestep()
+{
+    executeCommand([&] {
+        calcTimestepIntern();
+        updateMonitorDataIntern();
+    });
 }
 
 void EngineWorker::beginShutdown()
@@ -376,7 +548,11 @@ void EngineWorker::endShutdown()
 {
     _isSimulationRunning = false;
     _isShutdown = false;
-    _cudaSimulation.reset();
+    _commandQueue.clear();
+    _simulationFacade.reset();
+    if (_statisticsLogWriter) {
+        _statisticsLogWriter->flush();
+    }
 }
 
 int EngineWorker::getTpsRestriction() const
@@ -397,37 +573,39 @@ float EngineWorker::getTps() const
 
 uint64_t EngineWorker::getCurrentTimestep() const
 {
-    return _cudaSimulation->getCurrentTimestep();
+    return _simulationFacade->getCurrentTimestep();
 }
 
 void EngineWorker::setCurrentTimestep(uint64_t value)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->setCurrentTimestep(value);
+    executeCommand([&] {
+        _simulationFacade->setCurrentTimestep(value);
+    });
 }
 
 void EngineWorker::setSimulationParameters_async(SimulationParameters const& parameters)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateSimulationParametersJob = parameters;
+    _commandQueue.post([this, parameters] { _simulationFacade->setSimulationParameters(parameters); });
 }
 
 void EngineWorker::setSimulationParametersSpots_async(SimulationParametersSpots const& spots)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateSimulationParametersSpotsJob = spots;
+    _commandQueue.post([this, spots] { _simulationFacade->setSimulationParametersSpots(spots); });
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    _commandQueue.post([this, gpuSettings] { _simulationFacade->setGpuConstants(gpuSettings); });
 }
 
 void EngineWorker::setFlowFieldSettings_async(FlowFieldSettings const& flowFieldSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _flowFieldSettings = flowFieldSettings;
+    _commandQueue.post([this, flowFieldSettings] { _simulationFacade->setFlowFieldSettings(flowFieldSettings); });
+}
+
+void EngineWorker::setMonitorSettings_async(MonitorSettings const& monitorSettings)
+{
+    _commandQueue.post([this, monitorSettings] { _monitorSettings = monitorSettings; });
 }
 
 void EngineWorker::applyForce_async(
@@ -436,68 +614,78 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    _commandQueue.post([this, start, end, force, radius] {
+        _simulationFacade->applyForce({{start.x, start.y}, {end.x, end.y}, {force.x, force.y}, radius, false});
+    });
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    executeCommand([&] {
+        _simulationFacade->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    });
 }
 
 void EngineWorker::swapSelection(RealVector2D const& pos, float radius)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    executeCommand([&] {
+        _simulationFacade->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
+    });
 }
 
 SelectionShallowData EngineWorker::getSelectionShallowData()
 {
-    EngineWorkerGuard access(this);
-    return _cudaSimulation->getSelectionShallowData();
+    return executeCommand([&] {
+        return _simulationFacade->getSelectionShallowData();
+    });
 }
 
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    executeCommand([&] {
+        _simulationFacade->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
+    });
 }
 
 void EngineWorker::removeSelection()
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->removeSelection();
+    executeCommand([&] {
+        _simulationFacade->removeSelection();
 
-    updateMonitorDataIntern();
+        updateMonitorDataIntern();
+    });
 }
 
 void EngineWorker::updateSelection()
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->updateSelection();
+    executeCommand([&] {
+        _simulationFacade->updateSelection();
+    });
 }
 
 void EngineWorker::shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& updateData)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->shallowUpdateSelectedEntities(updateData);
+    executeCommand([&] {
+        _simulationFacade->shallowUpdateSelectedEntities(updateData);
 
-    updateMonitorDataIntern();
+        updateMonitorDataIntern();
+    });
 }
 
 void EngineWorker::colorSelectedEntities(unsigned char color, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->colorSelectedEntities(color, includeClusters);
+    executeCommand([&] {
+        _simulationFacade->colorSelectedEntities(color, includeClusters);
 
-    updateMonitorDataIntern();
+        updateMonitorDataIntern();
+    });
 }
 
 void EngineWorker::reconnectSelectedEntities()
 {
-    EngineWorkerGuard access(this);
-    _cudaSimulation->reconnectSelectedEntities();
+    executeCommand([&] {
+        _simulationFacade->reconnectSelectedEntities();
+    });
 }
 
 void EngineWorker::runThreadLoop()
@@ -508,23 +696,18 @@ void EngineWorker::runThreadLoop()
 
         while (!_isShutdown.load()) {
 
-            if (_accessState == 0) {
-                if (_isSimulationRunning.load()) {
-                    _cudaSimulation->calcTimestep();
-                    if (++_monitorCounter == 3) {  //for performance reasons...
-                        updateMonitorDataIntern(true);
-                        _monitorCounter = 0;
-                    }
+            if (_isSimulationRunning.load()) {
+                calcTimestepIntern();
+                updateMonitorDataIntern(true);
+                if (_simulationFacade->getCurrentTimestep() >= _stopTimestep.load()) {
+                    _isSimulationRunning.store(false);
                 }
-                measureTPS();
-                slowdownTPS();
             }
+            measureTPS();
+            slowdownTPS();
 
-            processJobs();
-
-            if (_accessState == 1) {
-                _accessState = 2;
-            }
+            _commandQueue.processCommands();
+            _dataTOCache->freeIdleBuffers();
         }
     } catch (std::exception const& e) {
         std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
@@ -534,13 +717,23 @@ void EngineWorker::runThreadLoop()
 
 void EngineWorker::runSimulation()
 {
+    _stopTimestep.store(std::numeric_limits<uint64_t>::max());
     _isSimulationRunning.store(true);
 }
 
+void EngineWorker::runSimulationUntil(uint64_t timestep)
+{
+    _stopTimestep.store(timestep);
+    if (_simulationFacade->getCurrentTimestep() < timestep) {
+        _isSimulationRunning.store(true);
+    }
+}
+
 void EngineWorker::pauseSimulation()
 {
-    EngineWorkerGuard access(this);
-    _isSimulationRunning.store(false);
+    executeCommand([&] {
+        _isSimulationRunning.store(false);
+    });
 }
 
 bool EngineWorker::isSimulationRunning() const
@@ -548,62 +741,91 @@ bool EngineWorker::isSimulationRunning() const
     return _isSimulationRunning.load();
 }
 
-DataAccessTO EngineWorker::provideTO()
+LatencyHistogramData EngineWorker::getCommandRoundTripLatencies() const
 {
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    return _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+    return _commandQueue.getRoundTripLatencies();
 }
 
-void EngineWorker::updateMonitorDataIntern(bool afterMinDuration)
+LatencyHistogramData EngineWorker::getCommandQueueingLatencies() const
 {
-    auto now = std::chrono::steady_clock::now();
-    if (!afterMinDuration  || !_lastMonitorUpdate || now - *_lastMonitorUpdate > MonitorUpdate) {
+    return _commandQueue.getQueueingLatencies();
+}
+
+void EngineWorker::executeCommandIntern(std::function<void()> const& func)
+{
+    checkForException();
+    if (!_commandQueue.execute(func, CommandTimeout)) {
+        checkForException();
+        throw std::runtime_error("GPU Timeout");
+    }
+}
+
+bool EngineWorker::tryExecuteExclusively(std::function<void()> const& func, std::chrono::milliseconds const& maxDuration)
+{
+    checkForException();
+    return _commandQueue.executeExclusively(func, maxDuration);
+}
 
-        std::lock_guard guard(_mutexForStatistics);
-        _lastStatistics = _cudaSimulation->getMonitorData();
-        _lastMonitorUpdate = now;
+void EngineWorker::checkForException() const
+{
+    std::unique_lock<std::mutex> uniqueLock(_exceptionData.mutex);
+    if (_exceptionData.errorMessage) {
+        throw std::runtime_error(*_exceptionData.errorMessage);
     }
 }
 
-void EngineWorker::processJobs()
+void EngineWorker::calcTimestepIntern()
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateSimulationParametersJob) {
-        _cudaSimulation->setSimulationParameters(*_updateSimulationParametersJob);
-        _updateSimulationParametersJob = std::nullopt;
+    if (!_isTimestepProfilingEnabled.load()) {
+        _simulationFacade->calcTimestep(nullptr);
+        return;
     }
-    if (_updateSimulationParametersSpotsJob) {
-        _cudaSimulation->setSimulationParametersSpots(*_updateSimulationParametersSpotsJob);
-        _updateSimulationParametersSpotsJob = std::nullopt;
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _timestepProfile.timestep = _simulationFacade->getCurrentTimestep();
+    _simulationFacade->calcTimestep(&_timestepProfile);
+
+    auto toMicroseconds = [](auto const& duration) { return std::chrono::duration<double, std::micro>(duration).count(); };
+    _timestepProfile.startTime = toMicroseconds(startTimepoint.time_since_epoch());
+    _timestepProfile.duration = static_cast<float>(toMicroseconds(std::chrono::steady_clock::now() - startTimepoint));
+    _timestepProfiles.add(_timestepProfile);
+}
+
+void EngineWorker::updateMonitorDataIntern(bool afterMinDuration)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto isUpdateDue = [&](std::optional<std::chrono::steady_clock::time_point> const& lastUpdate, int updateInterval) {
+        return !afterMinDuration || !lastUpdate || now - *lastUpdate >= std::chrono::milliseconds(updateInterval);
+    };
+    auto updateEntities = isUpdateDue(_lastEntitiesMonitorUpdate, _monitorSettings.entitiesUpdateInterval);
+    auto updateProcesses = isUpdateDue(_lastProcessesMonitorUpdate, _monitorSettings.processesUpdateInterval);
+    auto updateClusters = isUpdateDue(_lastClustersMonitorUpdate, _monitorSettings.clustersUpdateInterval);
+    if (!updateEntities && !updateProcesses && !updateClusters) {
+        return;
     }
-    if (_updateGpuSettingsJob) {
-        _cudaSimulation->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
+    if (updateEntities) {
+        _simulationFacade->getEntityMonitorData(_monitorData);
+        _lastEntitiesMonitorUpdate = now;
     }
-    if (_flowFieldSettings) {
-        _cudaSimulation->setFlowFieldSettings(*_flowFieldSettings);
-        _flowFieldSettings = std::nullopt;
+    if (updateProcesses) {
+        _simulationFacade->getProcessMonitorData(_monitorData);
+        _lastProcessesMonitorUpdate = now;
     }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
-            _cudaSimulation->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
-                 false});
-        }
-        _applyForceJobs.clear();
+    if (updateClusters) {
+        _simulationFacade->getClusterMonitorData(_monitorData);
+        _lastClustersMonitorUpdate = now;
+    }
+    _monitorData.timeStep = _simulationFacade->getCurrentTimestep();
+    _publishedMonitorData.store(_monitorData);
+    if (_statisticsLogWriter) {
+        _statisticsLogWriter->add(_monitorData);
     }
 }
 
-void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
+void EngineWorker::waitAndProcessCommands(std::chrono::microseconds const& duration)
 {
     auto startTimepoint = std::chrono::steady_clock::now();
     while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
-        }
+        _commandQueue.processCommands();
     }
 }
 
@@ -642,7 +864,7 @@ void EngineWorker::slowdownTPS()
         if (_isSimulationRunning.load() && tpsRestriction > 0) {
             auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
             if (desiredDuration > timestepDuration) {
-                waitAndAllowAccess(desiredDuration - timestepDuration);
+                waitAndProcessCommands(desiredDuration - timestepDuration);
             } else {
             }
             _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
@@ -650,44 +872,3 @@ void EngineWorker::slowdownTPS()
     }
     _slowDownTimepoint = std::chrono::steady_clock::now();
 }
-
-EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::chrono::milliseconds> const& maxDuration)
-    : _worker(worker)
-{
-    worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(5)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU Timeout");
-            }
-        }
-    }
-
-    checkForException(worker->_exceptionData);
-}
-
-EngineWorkerGuard::~EngineWorkerGuard()
-{
-    _worker->_accessState = 0;
-}
-
-bool EngineWorkerGuard::isTimeout() const
-{
-    return _isTimeout;
-}
-
-void EngineWorkerGuard::checkForException(ExceptionData const& exceptionData)
-{
-    std::unique_lock<std::mutex> uniqueLock(exceptionData.mutex);
-    if (exceptionData.errorMessage) {
-        throw std::runtime_error(*exceptionData.errorMessage);
-    }
-}
@@ -2,15 +2,11 @@
 
 #include <atomic>
 #include <mutex>
-#include <condition_variable>
-
-#if defined(_WIN32)
-#define NOMINMAX
-#include <windows.h>
-#endif
-#include <GL/gl.h>
+#include <optional>
+#include <type_traits>
 
 #include "Base/Definitions.h"
+#include "Base/SeqLock.h"
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/SimulationParameters.h"
@@ -21,8 +17,12 @@
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/StatisticsLog.h"
+#include "EngineInterface/TimestepProfile.h"
 #include "EngineGpuKernels/Definitions.h"
 
+#include "CommandQueue.h"
+#include "DeltaTracker.h"
 #include "Definitions.h"
 
 struct ExceptionData
@@ -33,9 +33,12 @@ struct ExceptionData
 
 struct DataAccessTO;
 
+/**
+ * Runs the simulation on its own thread. Requests from other threads are passed as commands via a lock-free queue
+ * and executed between time steps.
+ */
 class EngineWorker
 {
-    friend class EngineWorkerGuard;
 public:
     void initCuda();
 
@@ -50,14 +53,22 @@ public:
 
     ClusteredDataDescription getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
     DataDescription getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    BulkDataDescription getBulkSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters);
     DataDescription getSelectedSimulationData(bool includeClusters);
     DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds);
-    MonitorData getMonitorData() const;
+    DataDescriptionDelta getInspectedSimulationDataDelta(std::vector<uint64_t> entityIds, uint64_t sinceEpoch);
+    MonitorData getMonitorData() const;  //never blocks the worker thread
+    void enableStatisticsLog(std::string const& filename);
+    void flushStatisticsLog();
+    void setTimestepProfilingEnabled(bool value);
+    bool isTimestepProfilingEnabled() const;
+    std::vector<TimestepProfile> getTimestepProfiles() const;
 
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
+    void setBulkSimulationData(BulkDataDescription const& dataToUpdate);
     void removeSelectedEntities(bool includeClusters);
     void relaxSelectedEntities(bool includeClusters);
     void uniformVelocitiesForSelectedEntities(bool includeClusters);
@@ -67,6 +78,9 @@ public:
     void changeCell(CellDescription const& changedCell);
     void changeParticle(ParticleDescription const& changedParticle);
 
+    void serializeSimulationDataToFile(std::string const& filename);
+    void deserializeSimulationDataFromFile(std::string const& filename);
+
     void calcSingleTimestep();
 
     void beginShutdown(); //caller should wait for termination of thread
@@ -83,6 +97,7 @@ public:
     void setSimulationParametersSpots_async(SimulationParametersSpots const& spots);
     void setGpuSettings_async(GpuSettings const& gpuSettings);
     void setFlowFieldSettings_async(FlowFieldSettings const& flowFieldSettings);
+    void setMonitorSettings_async(MonitorSettings const& monitorSettings);
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius);
 
@@ -98,42 +113,42 @@ public:
 
     void runThreadLoop();
     void runSimulation();
+    void runSimulationUntil(uint64_t timestep);
     void pauseSimulation();
     bool isSimulationRunning() const;
 
+    LatencyHistogramData getCommandRoundTripLatencies() const;
+    LatencyHistogramData getCommandQueueingLatencies() const;
+
 private:
-    DataAccessTO provideTO(); 
-    void updateMonitorDataIntern(bool afterMinDuration = false);
-    void processJobs();
+    //func is executed on the worker thread, throws if the worker thread does not respond
+    template <typename Func>
+    auto executeCommand(Func const& func) -> decltype(func());
+    void executeCommandIntern(std::function<void()> const& func);
+
+    //func is executed on the calling thread while the worker thread is blocked (needed for graphics interop)
+    //returns false if the worker thread does not respond within maxDuration
+    bool tryExecuteExclusively(std::function<void()> const& func, std::chrono::milliseconds const& maxDuration);
 
-    void waitAndAllowAccess(std::chrono::microseconds const& duration);
+    void checkForException() const;
+
+    void calcTimestepIntern();
+    void updateMonitorDataIntern(bool afterMinDuration = false);  //afterMinDuration: only metrics whose update interval has elapsed
+
+    void waitAndProcessCommands(std::chrono::microseconds const& duration);
     void measureTPS();
     void slowdownTPS();
 
-    CudaSimulationFacade _cudaSimulation;
+    SimulationFacade _simulationFacade;
 
     //sync
-    std::atomic<int> _accessState{0};    //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
+    CommandQueue _commandQueue;
     std::atomic<bool> _isSimulationRunning{false};
+    std::atomic<uint64_t> _stopTimestep{0};
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
-    //async jobs
-    mutable std::mutex _mutexForAsyncJobs;
-    std::optional<SimulationParameters> _updateSimulationParametersJob;
-    std::optional<SimulationParametersSpots> _updateSimulationParametersSpotsJob;
-    std::optional<GpuSettings> _updateGpuSettingsJob;
-    std::optional<FlowFieldSettings> _flowFieldSettings;
-    std::optional<GLuint> _imageResourceToRegister;
-
-    struct ApplyForceJob
-    {
-        RealVector2D start;
-        RealVector2D end;
-        RealVector2D force;
-        float radius;
-    };
-    std::vector<ApplyForceJob> _applyForceJobs;
+    std::optional<unsigned int> _imageResourceToRegister;  //image to register as soon as the simulation facade exists
 
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
@@ -142,33 +157,41 @@ private:
     std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
     std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
     std::optional<std::chrono::microseconds> _slowDownOvershot;
+
+    //time step profiling
+    std::atomic<bool> _isTimestepProfilingEnabled{false};
+    TimestepProfile _timestepProfile;  //accessed by worker thread only, reused to avoid allocations
+    TimestepProfileBuffer _timestepProfiles;
   
     //settings
     Settings _settings;
 
     //statistics data
-    std::optional<std::chrono::steady_clock::time_point> _lastMonitorUpdate;
-    mutable std::mutex _mutexForStatistics;
-    MonitorData _lastStatistics;
-    int _monitorCounter = 0;
+    MonitorSettings _monitorSettings;
+    std::optional<std::chrono::steady_clock::time_point> _lastEntitiesMonitorUpdate;
+    std::optional<std::chrono::steady_clock::time_point> _lastProcessesMonitorUpdate;
+    std::optional<std::chrono::steady_clock::time_point> _lastClustersMonitorUpdate;
+    MonitorData _monitorData;  //accessed by worker thread only
+    SeqLock<MonitorData> _publishedMonitorData;
+    std::optional<StatisticsLogWriter> _statisticsLogWriter;  //accessed by worker thread only after the simulation has been started
 
     //internals
     void* _cudaResource;
     AccessDataTOCache _dataTOCache;
+
+    //incremental data requests
+    DeltaTracker _inspectedDataTracker;
 };
 
-class EngineWorkerGuard
+template <typename Func>
+auto EngineWorker::executeCommand(Func const& func) -> decltype(func())
 {
-public:
-    EngineWorkerGuard(EngineWorker* worker, std::optional<std::chrono::milliseconds> const& maxDuration = std::nullopt);
-    ~EngineWorkerGuard();
-
-    bool isTimeout() const;
-
-private:
-    void checkForException(ExceptionData const& exceptionData);
-
-    EngineWorker* _worker;
-
-    bool _isTimeout = false;
-};
+    using Result = decltype(func());
+    if constexpr (std::is_void_v<Result>) {
+        executeCommandIntern(func);
+    } else {
+        Result result;
+        executeCommandIntern([&] { result = func(); });
+        return result;
+    }
+}
@@ -1,5 +1,6 @@
 #include "SimulationControllerImpl.h"
 
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/Descriptions.h"
 
 void _SimulationControllerImpl::initCuda()
@@ -13,6 +14,7 @@ void _SimulationControllerImpl::newSimulation(uint64_t timestep, Settings const&
     _origSettings = settings;
     _symbolMap = symbolMap;
     _origSymbolMap = symbolMap;
+    _symbolTable = SymbolTable(symbolMap);
     _worker.newSimulation(timestep, settings);
 
     _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
@@ -62,6 +64,12 @@ DataDescription _SimulationControllerImpl::getSimulationData()
     return _worker.getSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
+BulkDataDescription _SimulationControllerImpl::getBulkSimulationData()
+{
+    auto size = getWorldSize();
+    return _worker.getBulkSimulationData({-10, -10}, {size.x + 10, size.y + 10});
+}
+
 ClusteredDataDescription _SimulationControllerImpl::getSelectedClusteredSimulationData(bool includeClusters)
 {
     return _worker.getSelectedClusteredSimulationData(includeClusters);
@@ -77,6 +85,11 @@ DataDescription _SimulationControllerImpl::getInspectedSimulationData(std::vecto
     return _worker.getInspectedSimulationData(entityIds);
 }
 
+DataDescriptionDelta _SimulationControllerImpl::getInspectedSimulationDataDelta(std::vector<uint64_t> entityIds, uint64_t sinceEpoch)
+{
+    return _worker.getInspectedSimulationDataDelta(entityIds, sinceEpoch);
+}
+
 void _SimulationControllerImpl::addAndSelectSimulationData(DataDescription const& dataToAdd)
 {
     _worker.addAndSelectSimulationData(dataToAdd);
@@ -94,6 +107,12 @@ void _SimulationControllerImpl::setSimulationData(DataDescription const& dataToU
     _selectionNeedsUpdate = true;
 }
 
+void _SimulationControllerImpl::setBulkSimulationData(BulkDataDescription const& dataToUpdate)
+{
+    _worker.setBulkSimulationData(dataToUpdate);
+    _selectionNeedsUpdate = true;
+}
+
 void _SimulationControllerImpl::removeSelectedEntities(bool includeClusters)
 {
     _worker.removeSelectedEntities(includeClusters);
@@ -145,6 +164,26 @@ void _SimulationControllerImpl::changeParticle(ParticleDescription const& change
     _worker.changeParticle(changedParticle);
 }
 
+bool _SimulationControllerImpl::serializeSimulationDataToFile(std::string const& filename)
+{
+    try {
+        _worker.serializeSimulationDataToFile(filename);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool _SimulationControllerImpl::deserializeSimulationDataFromFile(std::string const& filename)
+{
+    try {
+        _worker.deserializeSimulationDataFromFile(filename);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 void _SimulationControllerImpl::calcSingleTimestep()
 {
     _worker.calcSingleTimestep();
@@ -156,6 +195,11 @@ void _SimulationControllerImpl::runSimulation()
     _worker.runSimulation();
 }
 
+void _SimulationControllerImpl::runSimulationUntil(uint64_t timestep)
+{
+    _worker.runSimulationUntil(timestep);
+}
+
 void _SimulationControllerImpl::pauseSimulation()
 {
     _worker.pauseSimulation();
@@ -335,9 +379,15 @@ SymbolMap const& _SimulationControllerImpl::getOriginalSymbolMap() const
     return _origSymbolMap;
 }
 
+SymbolTable const& _SimulationControllerImpl::getSymbolTable() const
+{
+    return _symbolTable;
+}
+
 void _SimulationControllerImpl::setSymbolMap(SymbolMap const& symbolMap)
 {
     _symbolMap = symbolMap;
+    _symbolTable = SymbolTable(symbolMap);
 }
 
 MonitorData _SimulationControllerImpl::getStatistics() const
@@ -345,6 +395,42 @@ MonitorData _SimulationControllerImpl::getStatistics() const
     return _worker.getMonitorData();
 }
 
+MonitorSettings _SimulationControllerImpl::getMonitorSettings() const
+{
+    return _monitorSettings;
+}
+
+void _SimulationControllerImpl::setMonitorSettings_async(MonitorSettings const& monitorSettings)
+{
+    _monitorSettings = monitorSettings;
+    _worker.setMonitorSettings_async(monitorSettings);
+}
+
+void _SimulationControllerImpl::enableStatisticsLog(std::string const& filename)
+{
+    _worker.enableStatisticsLog(filename);
+}
+
+void _SimulationControllerImpl::flushStatisticsLog()
+{
+    _worker.flushStatisticsLog();
+}
+
+void _SimulationControllerImpl::setTimestepProfilingEnabled(bool value)
+{
+    _worker.setTimestepProfilingEnabled(value);
+}
+
+bool _SimulationControllerImpl::isTimestepProfilingEnabled() const
+{
+    return _worker.isTimestepProfilingEnabled();
+}
+
+std::vector<TimestepProfile> _SimulationControllerImpl::getTimestepProfiles() const
+{
+    return _worker.getTimestepProfiles();
+}
+
 std::optional<int> _SimulationControllerImpl::getTpsRestriction() const
 {
     auto result = _worker.getTpsRestriction();
@@ -360,3 +446,13 @@ float _SimulationControllerImpl::getTps() const
 {
     return _worker.getTps();
 }
+
+LatencyHistogramData _SimulationControllerImpl::getCommandRoundTripLatencies() const
+{
+    return _worker.getCommandRoundTripLatencies();
+}
+
+LatencyHistogramData _SimulationControllerImpl::getCommandQueueingLatencies() const
+{
+    return _worker.getCommandQueueingLatencies();
+}
@@ -42,13 +42,16 @@ public:
 
     ClusteredDataDescription getClusteredSimulationData() override;
     DataDescription getSimulationData() override;
+    BulkDataDescription getBulkSimulationData() override;
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
     DataDescription getSelectedSimulationData(bool includeClusters) override;
     DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds) override;
+    DataDescriptionDelta getInspectedSimulationDataDelta(std::vector<uint64_t> entityIds, uint64_t sinceEpoch) override;
 
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
+    void setBulkSimulationData(BulkDataDescription const& dataToUpdate) override;
     void removeSelectedEntities(bool includeClusters) override;
     void relaxSelectedEntities(bool includeClusters) override;
     void uniformVelocitiesForSelectedEntities(bool includeClusters) override;
@@ -60,8 +63,12 @@ public:
     void changeCell(CellDescription const& changedCell) override;
     void changeParticle(ParticleDescription const& changedParticle) override;
 
+    bool serializeSimulationDataToFile(std::string const& filename) override;
+    bool deserializeSimulationDataFromFile(std::string const& filename) override;
+
     void calcSingleTimestep() override;
     void runSimulation() override;
+    void runSimulationUntil(uint64_t timestep) override;
     void pauseSimulation() override;
 
     bool isSimulationRunning() const override;
@@ -105,14 +112,26 @@ public:
     Settings getSettings() const override;
     SymbolMap const& getSymbolMap() const override;
     SymbolMap const& getOriginalSymbolMap() const override;
+    SymbolTable const& getSymbolTable() const override;
     void setSymbolMap(SymbolMap const& symbolMap) override;
     MonitorData getStatistics() const override;
+    MonitorSettings getMonitorSettings() const override;
+    void setMonitorSettings_async(MonitorSettings const& monitorSettings) override;
+
+    void enableStatisticsLog(std::string const& filename) override;
+    void flushStatisticsLog() override;
+    void setTimestepProfilingEnabled(bool value) override;
+    bool isTimestepProfilingEnabled() const override;
+    std::vector<TimestepProfile> getTimestepProfiles() const override;
 
     std::optional<int> getTpsRestriction() const override;
     void setTpsRestriction(std::optional<int> const& value) override;
 
     float getTps() const override;
 
+    LatencyHistogramData getCommandRoundTripLatencies() const override;
+    LatencyHistogramData getCommandQueueingLatencies() const override;
+
 private:
     bool _selectionNeedsUpdate = false;
 
@@ -120,6 +139,8 @@ private:
     Settings _settings;
     SymbolMap _symbolMap;
     SymbolMap _origSymbolMap;
+    SymbolTable _symbolTable;
+    MonitorSettings _monitorSettings;
 
     EngineWorker _worker;
     std::thread* _thread = nullptr;
@@ -0,0 +1,67 @@
+#include "AutosaveHelper.h"
+
+#include <filesystem>
+
+#include "Base/LoggingService.h"
+#include "BulkDataDescription.h"
+#include "SimulationController.h"
+
+namespace
+{
+    bool isSnapshotUpToDate(std::string const& snapshotFilename, std::string const& filename)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(snapshotFilename, error)) {
+            return false;
+        }
+        if (!std::filesystem::exists(filename, error)) {
+            return true;
+        }
+        return std::filesystem::last_write_time(snapshotFilename, error) >= std::filesystem::last_write_time(filename, error);
+    }
+}
+
+bool AutosaveHelper::save(SimulationController const& simController, std::string const& snapshotFilename, std::string const& filename, bool portable)
+{
+    DeserializedSimulation sim;
+    sim.timestep = simController->getCurrentTimestep();
+    sim.settings = simController->getSettings();
+    sim.symbolMap = simController->getSymbolMap();
+
+    //portable file first, so that the snapshot remains the more recent one
+    auto result = true;
+    if (portable) {
+        result = Serializer::serializeSimulationToFiles(filename, sim, simController->getBulkSimulationData());
+    }
+    if (simController->serializeSimulationDataToFile(snapshotFilename)) {
+        result &= Serializer::serializeSimulationMetadataToFiles(snapshotFilename, sim);
+    } else {
+        result = false;
+    }
+    return result;
+}
+
+bool AutosaveHelper::load(
+    SimulationController const& simController,
+    std::string const& snapshotFilename,
+    std::string const& filename,
+    DeserializedSimulation& data)
+{
+    if (isSnapshotUpToDate(snapshotFilename, filename) && Serializer::deserializeSimulationMetadataFromFiles(data, snapshotFilename)) {
+        simController->newSimulation(data.timestep, data.settings, data.symbolMap);
+        if (simController->deserializeSimulationDataFromFile(snapshotFilename)) {
+            return true;
+        }
+
+        //e.g. the snapshot has been written by a version with a different data layout
+        log(Priority::Important, "Autosave snapshot could not be read, falling back to " + filename);
+        simController->closeSimulation();
+    }
+    data = DeserializedSimulation();
+    if (!Serializer::deserializeSimulationFromFiles(data, filename)) {
+        return false;
+    }
+    simController->newSimulation(data.timestep, data.settings, data.symbolMap);
+    simController->setClusteredSimulationData(data.content);
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include "Definitions.h"
+#include "Serializer.h"
+
+/**
+ * An autosave consists of a snapshot of the engine data and of a simulation file in the portable format.
+ * The snapshot is fast to write but only readable by builds with the same data layout, hence the portable file serves as fallback.
+ */
+class AutosaveHelper
+{
+public:
+    //the portable simulation file is only written if requested since it requires the conversion into descriptions
+    static bool save(SimulationController const& simController, std::string const& snapshotFilename, std::string const& filename, bool portable);
+
+    //creates a new simulation from the snapshot if it is up to date and readable, otherwise from the portable simulation file
+    //returns false if no simulation could be created
+    static bool load(SimulationController const& simController, std::string const& snapshotFilename, std::string const& filename, DeserializedSimulation& data);
+};
@@ -0,0 +1,276 @@
+#include "BulkDataDescription.h"
+
+#include "Base/DisjointSets.h"
+#include "Base/Math.h"
+#include "Base/Physics.h"
+
+#include "Descriptions.h"
+
+void BulkDataDescription::Cells::resize(int numCells)
+{
+    ids.resize(numCells);
+    positions.resize(numCells);
+    velocities.resize(numCells);
+    energies.resize(numCells);
+    colors.resize(numCells);
+    maxConnections.resize(numCells);
+    tokenBranchNumbers.resize(numCells);
+    tokenBlocked.resize(numCells);
+    barriers.resize(numCells);
+    cellFunctionTypes.resize(numCells);
+    cellFunctionInvocations.resize(numCells);
+    constData.resize(numCells);
+    volatileData.resize(numCells);
+    names.resize(numCells);
+    descriptions.resize(numCells);
+    sourceCodes.resize(numCells);
+    connectionOffsets.resize(numCells + 1);
+    tokenOffsets.resize(numCells + 1);
+}
+
+void BulkDataDescription::Cells::resizeConnections(int numConnections)
+{
+    connectionCellIndices.resize(numConnections);
+    connectionDistances.resize(numConnections);
+    connectionAnglesFromPrevious.resize(numConnections);
+}
+
+void BulkDataDescription::Cells::resizeTokens(int numTokens)
+{
+    tokenEnergies.resize(numTokens);
+    tokenData.resize(numTokens);
+}
+
+void BulkDataDescription::Particles::resize(int numParticles)
+{
+    ids.resize(numParticles);
+    positions.resize(numParticles);
+    velocities.resize(numParticles);
+    energies.resize(numParticles);
+    colors.resize(numParticles);
+}
+
+BulkDataDescription::BulkDataDescription(DataDescription const& data)
+{
+    auto numCells = toInt(data.cells.size());
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        cellIndexById.emplace(data.cells[i].id, i);
+    }
+
+    cells.resize(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cell = data.cells[i];
+        cells.ids[i] = cell.id;
+        cells.positions[i] = cell.pos;
+        cells.velocities[i] = cell.vel;
+        cells.energies[i] = toFloat(cell.energy);
+        cells.colors[i] = cell.metadata.color;
+        cells.maxConnections[i] = cell.maxConnections;
+        cells.tokenBranchNumbers[i] = cell.tokenBranchNumber;
+        cells.tokenBlocked[i] = cell.tokenBlocked;
+        cells.barriers[i] = cell.barrier;
+        cells.cellFunctionTypes[i] = cell.cellFeature.getType();
+        cells.cellFunctionInvocations[i] = cell.cellFunctionInvocations;
+        cells.constData[i] = cell.cellFeature.constData;
+        cells.volatileData[i] = cell.cellFeature.volatileData;
+        cells.names[i] = cell.metadata.name;
+        cells.descriptions[i] = cell.metadata.description;
+        cells.sourceCodes[i] = cell.metadata.computerSourcecode;
+        cells.connectionOffsets[i + 1] = cells.connectionOffsets[i] + toInt(cell.connections.size());
+        cells.tokenOffsets[i + 1] = cells.tokenOffsets[i] + toInt(cell.tokens.size());
+    }
+
+    cells.resizeConnections(cells.connectionOffsets.back());
+    cells.resizeTokens(cells.tokenOffsets.back());
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cell = data.cells[i];
+        auto connectionIndex = cells.connectionOffsets[i];
+        for (auto const& connection : cell.connections) {
+            auto findResult = cellIndexById.find(connection.cellId);
+            cells.connectionCellIndices[connectionIndex] = findResult != cellIndexById.end() ? findResult->second : -1;
+            cells.connectionDistances[connectionIndex] = connection.distance;
+            cells.connectionAnglesFromPrevious[connectionIndex] = connection.angleFromPrevious;
+            ++connectionIndex;
+        }
+        auto tokenIndex = cells.tokenOffsets[i];
+        for (auto const& token : cell.tokens) {
+            cells.tokenEnergies[tokenIndex] = toFloat(token.energy);
+            cells.tokenData[tokenIndex] = token.data;
+            ++tokenIndex;
+        }
+    }
+
+    auto numParticles = toInt(data.particles.size());
+    particles.resize(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        auto const& particle = data.particles[i];
+        particles.ids[i] = particle.id;
+        particles.positions[i] = particle.pos;
+        particles.velocities[i] = particle.vel;
+        particles.energies[i] = toFloat(particle.energy);
+        particles.colors[i] = particle.metadata.color;
+    }
+}
+
+DataDescription BulkDataDescription::toDataDescription() const
+{
+    DataDescription result;
+    result.cells.resize(cells.size());
+    for (int i = 0; i < cells.size(); ++i) {
+        result.cells[i] = getCellDescription(i);
+    }
+    result.particles.resize(particles.size());
+    for (int i = 0; i < particles.size(); ++i) {
+        result.particles[i] = getParticleDescription(i);
+    }
+    return result;
+}
+
+CellDescription BulkDataDescription::getCellDescription(int index) const
+{
+    CellDescription result;
+    result.id = cells.ids[index];
+    result.pos = cells.positions[index];
+    result.vel = cells.velocities[index];
+    result.energy = cells.energies[index];
+    result.maxConnections = cells.maxConnections[index];
+    result.tokenBlocked = cells.tokenBlocked[index];
+    result.tokenBranchNumber = cells.tokenBranchNumbers[index];
+    result.barrier = cells.barriers[index];
+    result.cellFunctionInvocations = cells.cellFunctionInvocations[index];
+    result.cellFeature.setType(static_cast<Enums::CellFunction>(cells.cellFunctionTypes[index]));
+    result.cellFeature.constData = cells.constData[index];
+    result.cellFeature.volatileData = cells.volatileData[index];
+    result.metadata.color = cells.colors[index];
+    result.metadata.name = cells.names[index];
+    result.metadata.description = cells.descriptions[index];
+    result.metadata.computerSourcecode = cells.sourceCodes[index];
+
+    for (int j = cells.connectionOffsets[index]; j < cells.connectionOffsets[index + 1]; ++j) {
+        ConnectionDescription connection;
+        auto connectedCellIndex = cells.connectionCellIndices[j];
+        connection.cellId = connectedCellIndex != -1 ? cells.ids[connectedCellIndex] : 0;
+        connection.distance = cells.connectionDistances[j];
+        connection.angleFromPrevious = cells.connectionAnglesFromPrevious[j];
+        result.connections.emplace_back(connection);
+    }
+    for (int j = cells.tokenOffsets[index]; j < cells.tokenOffsets[index + 1]; ++j) {
+        result.addToken(TokenDescription().setEnergy(cells.tokenEnergies[j]).setData(cells.tokenData[j]));
+    }
+    return result;
+}
+
+ParticleDescription BulkDataDescription::getParticleDescription(int index) const
+{
+    ParticleDescription result;
+    result.id = particles.ids[index];
+    result.pos = particles.positions[index];
+    result.vel = particles.velocities[index];
+    result.energy = particles.energies[index];
+    result.metadata.color = particles.colors[index];
+    return result;
+}
+
+std::vector<int> BulkDataDescription::calcClusterIndices(int& numClusters) const
+{
+    auto numCells = cells.size();
+    DisjointSets cellSets(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        for (int j = cells.connectionOffsets[i]; j < cells.connectionOffsets[i + 1]; ++j) {
+            auto connectedCellIndex = cells.connectionCellIndices[j];
+            if (connectedCellIndex != -1) {
+                cellSets.unite(i, connectedCellIndex);
+            }
+        }
+    }
+
+    std::vector<int> result(numCells);
+    std::vector<int> clusterIndexByRepresentative(numCells, -1);
+    numClusters = 0;
+    for (int i = 0; i < numCells; ++i) {
+        auto& clusterIndex = clusterIndexByRepresentative[cellSets.find(i)];
+        if (clusterIndex == -1) {
+            clusterIndex = numClusters++;
+        }
+        result[i] = clusterIndex;
+    }
+    return result;
+}
+
+RealVector2D BulkDataDescription::calcCenter() const
+{
+    double sumX = 0;
+    double sumY = 0;
+    for (auto const& pos : cells.positions) {
+        sumX += pos.x;
+        sumY += pos.y;
+    }
+    for (auto const& pos : particles.positions) {
+        sumX += pos.x;
+        sumY += pos.y;
+    }
+    auto numEntities = cells.size() + particles.size();
+    return {toFloat(sumX / numEntities), toFloat(sumY / numEntities)};
+}
+
+namespace
+{
+    //operates on the components directly to allow auto-vectorization
+    void shiftPositions(std::vector<RealVector2D>& positions, RealVector2D const& delta)
+    {
+        auto data = positions.data();
+        auto size = positions.size();
+        for (size_t i = 0; i < size; ++i) {
+            data[i].x += delta.x;
+            data[i].y += delta.y;
+        }
+    }
+
+    void rotatePositions(std::vector<RealVector2D>& positions, RealMatrix2D const& rotationMatrix, RealVector2D const& center)
+    {
+        auto data = positions.data();
+        auto size = positions.size();
+        for (size_t i = 0; i < size; ++i) {
+            auto relX = data[i].x - center.x;
+            auto relY = data[i].y - center.y;
+            data[i].x = center.x + rotationMatrix[0][0] * relX + rotationMatrix[0][1] * relY;
+            data[i].y = center.y + rotationMatrix[1][0] * relX + rotationMatrix[1][1] * relY;
+        }
+    }
+
+    void accelerateVelocities(
+        std::vector<RealVector2D> const& positions,
+        std::vector<RealVector2D>& velocities,
+        RealVector2D const& center,
+        RealVector2D const& velDelta,
+        float angularVelDelta)
+    {
+        auto size = positions.size();
+        for (size_t i = 0; i < size; ++i) {
+            velocities[i] += Physics::tangentialVelocity(positions[i] - center, velDelta, angularVelDelta);
+        }
+    }
+}
+
+void BulkDataDescription::shift(RealVector2D const& delta)
+{
+    shiftPositions(cells.positions, delta);
+    shiftPositions(particles.positions, delta);
+}
+
+void BulkDataDescription::rotate(float angle)
+{
+    auto rotationMatrix = Math::calcRotationMatrix(angle);
+    auto center = calcCenter();
+    rotatePositions(cells.positions, rotationMatrix, center);
+    rotatePositions(particles.positions, rotationMatrix, center);
+}
+
+void BulkDataDescription::accelerate(RealVector2D const& velDelta, float angularVelDelta)
+{
+    auto center = calcCenter();
+    accelerateVelocities(cells.positions, cells.velocities, center, velDelta, angularVelDelta);
+    accelerateVelocities(particles.positions, particles.velocities, center, velDelta, angularVelDelta);
+}
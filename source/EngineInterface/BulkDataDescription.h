@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Base/InternedString.h"
+
+#include "Definitions.h"
+
+/**
+ * Structure-of-arrays representation of cells and particles for operations on whole worlds.
+ * Connections and tokens are stored in compressed rows: the connections of cell i are found at [connectionOffsets[i], connectionOffsets[i + 1])
+ * and refer to other cells by index instead of id, hence copies and shifts of the data do not require id lookups.
+ */
+struct BulkDataDescription
+{
+    struct Cells
+    {
+        std::vector<uint64_t> ids;
+        std::vector<RealVector2D> positions;
+        std::vector<RealVector2D> velocities;
+        std::vector<float> energies;
+        std::vector<unsigned char> colors;
+        std::vector<int> maxConnections;
+        std::vector<int> tokenBranchNumbers;
+        std::vector<unsigned char> tokenBlocked;  //no std::vector<bool> to allow concurrent writes
+        std::vector<unsigned char> barriers;
+        std::vector<int> cellFunctionTypes;
+        std::vector<int> cellFunctionInvocations;
+        std::vector<InternedString> constData;
+        std::vector<InternedString> volatileData;
+        std::vector<InternedString> names;
+        std::vector<InternedString> descriptions;
+        std::vector<InternedString> sourceCodes;
+
+        std::vector<int> connectionOffsets = {0};  //size = number of cells + 1
+        std::vector<int> connectionCellIndices;     //-1 if connected cell is not present
+        std::vector<float> connectionDistances;
+        std::vector<float> connectionAnglesFromPrevious;
+
+        std::vector<int> tokenOffsets = {0};  //size = number of cells + 1
+        std::vector<float> tokenEnergies;
+        std::vector<std::string> tokenData;
+
+        int size() const { return toInt(ids.size()); }
+        int getNumConnections() const { return toInt(connectionCellIndices.size()); }
+        int getNumTokens() const { return toInt(tokenEnergies.size()); }
+
+        //resizes the per-cell columns, the connection and token rows have to be set up by the caller
+        void resize(int numCells);
+        void resizeConnections(int numConnections);
+        void resizeTokens(int numTokens);
+    };
+    Cells cells;
+
+    struct Particles
+    {
+        std::vector<uint64_t> ids;
+        std::vector<RealVector2D> positions;
+        std::vector<RealVector2D> velocities;
+        std::vector<float> energies;
+        std::vector<unsigned char> colors;
+
+        int size() const { return toInt(ids.size()); }
+        void resize(int numParticles);
+    };
+    Particles particles;
+
+    BulkDataDescription() = default;
+    explicit BulkDataDescription(DataDescription const& data);  //connections to cells outside of data are kept with index -1
+
+    DataDescription toDataDescription() const;
+    CellDescription getCellDescription(int index) const;
+    ParticleDescription getParticleDescription(int index) const;
+
+    bool isEmpty() const { return cells.size() == 0 && particles.size() == 0; }
+
+    //returns the index of the connected component for each cell, components are numbered in order of their first cell
+    std::vector<int> calcClusterIndices(int& numClusters) const;
+
+    RealVector2D calcCenter() const;
+    void shift(RealVector2D const& delta);
+    void rotate(float angle);
+    void accelerate(RealVector2D const& velDelta, float angularVelDelta);
+};
@@ -1,11 +1,17 @@
 #include "CellComputationCompiler.h"
 
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <boost/algorithm/string/case_conv.hpp>
 
+#include "Base/ThreadPool.h"
+
+#include "CellComputationExecutor.h"
 #include "SymbolMap.h"
 #include "SimulationParameters.h"
 #include "Definitions.h"
+#include "Descriptions.h"
 
 namespace
 {
@@ -149,33 +155,30 @@ namespace
         return true;
     }
 
-    std::string applyTableToCode(SymbolMap const& symbols, std::string s)
+    //substitutes the operand enclosed in up to two brackets in a single pass
+    std::string applyTableToCode(SymbolTable const& symbols, std::string const& s)
     {
-        std::string prefix;
-        std::string postfix;
-        for (int i = 0; i < 2; ++i) {
-            auto first = s.substr(0, 1);
-            if (first == "[" || first == "(") {
-                prefix = prefix + first;
-                s = s.substr(1);
-            }
+        std::string_view view(s);
+        size_t prefixSize = 0;
+        while (prefixSize < 2 && prefixSize < view.size() && (view[prefixSize] == '[' || view[prefixSize] == '(')) {
+            ++prefixSize;
         }
-        for (int i = 0; i < 2; ++i) {
-            auto last = lastChar(s);
-            if (last == "]" || last == ")") {
-                postfix = last + postfix;
-                s = s.substr(0, s.size() - 1);
-            }
+        size_t postfixSize = 0;
+        while (postfixSize < 2 && prefixSize + postfixSize < view.size()
+               && (view[view.size() - postfixSize - 1] == ']' || view[view.size() - postfixSize - 1] == ')')) {
+            ++postfixSize;
         }
-        auto findResult = symbols.find(s);
-        if (findResult != symbols.end()) {
-            s = findResult->second;
+        if (auto value = symbols.find(view.substr(prefixSize, view.size() - prefixSize - postfixSize))) {
+            std::string result;
+            result.reserve(prefixSize + value->size() + postfixSize);
+            result.append(view.substr(0, prefixSize)).append(*value).append(view.substr(view.size() - postfixSize));
+            return result;
         }
-        return prefix + s + postfix;
+        return s;
     }
 
     bool resolveInstructionAndReturnSuccess(
-        SymbolMap const& symbols,
+        SymbolTable const& symbols,
         CellInstruction& instructionCoded,
         InstructionUncoded instructionUncoded)
     {
@@ -301,7 +304,224 @@ namespace
 }
 
 
+namespace
+{
+    void hashCombine(size_t& seed, size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+
+    struct CompilationKey
+    {
+        std::string code;
+        uint64_t symbolsHash;
+        int maxBytes;
+
+        bool operator==(CompilationKey const& other) const
+        {
+            return code == other.code && symbolsHash == other.symbolsHash && maxBytes == other.maxBytes;
+        }
+    };
+
+    struct DecompilationKey
+    {
+        std::string data;
+        int tokenMemorySize;
+        int cellMemorySize;
+
+        bool operator==(DecompilationKey const& other) const
+        {
+            return data == other.data && tokenMemorySize == other.tokenMemorySize && cellMemorySize == other.cellMemorySize;
+        }
+    };
+
+    struct CompilationKeyHash
+    {
+        size_t operator()(CompilationKey const& key) const
+        {
+            auto result = std::hash<std::string>()(key.code);
+            hashCombine(result, key.symbolsHash);
+            hashCombine(result, key.maxBytes);
+            return result;
+        }
+    };
+
+    struct DecompilationKeyHash
+    {
+        size_t operator()(DecompilationKey const& key) const
+        {
+            auto result = std::hash<std::string>()(key.data);
+            hashCombine(result, key.tokenMemorySize);
+            hashCombine(result, key.cellMemorySize);
+            return result;
+        }
+    };
+
+    //the cache is cleared when it becomes full, programs in use are recompiled quickly
+    template <typename Key, typename Value, typename KeyHash>
+    class Cache
+    {
+    public:
+        std::optional<Value> find(Key const& key) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto findResult = _values.find(key);
+            if (findResult != _values.end()) {
+                return findResult->second;
+            }
+            return std::nullopt;
+        }
+
+        void insert(Key key, Value value)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_values.size() >= MaxEntries) {
+                _values.clear();
+            }
+            _values.emplace(std::move(key), std::move(value));
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _values.clear();
+        }
+
+    private:
+        static int const MaxEntries = 10000;
+
+        mutable std::mutex _mutex;
+        std::unordered_map<Key, Value, KeyHash> _values;
+    };
+
+    Cache<CompilationKey, CompilationResult, CompilationKeyHash> compilationCache;
+    Cache<DecompilationKey, std::string, DecompilationKeyHash> decompilationCache;
+}
+
 CompilationResult CellComputationCompiler::compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters)
+{
+    return compileSourceCode(code, SymbolTable(symbols), parameters);
+}
+
+CompilationResult CellComputationCompiler::compileSourceCode(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters)
+{
+    return compileSourceCodeCached(code, symbols, parameters);
+}
+
+std::string CellComputationCompiler::decompileSourceCode(std::string const& data, SymbolMap const& symbols, SimulationParameters const& parameters)
+{
+    return decompileSourceCodeCached(data, parameters);
+}
+
+int CellComputationCompiler::compileSourceCodes(DataDescription& data, SymbolTable const& symbols, SimulationParameters const& parameters)
+{
+    //interned source codes with same content share their address
+    std::unordered_map<std::string const*, int> resultIndexBySourceCode;
+    std::vector<std::string const*> sourceCodes;
+    std::vector<int> resultIndexByCellIndex(data.cells.size(), -1);
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        auto const& cell = data.cells[i];
+        if (cell.cellFeature.getType() != Enums::CellFunction_Computation || cell.metadata.computerSourcecode.empty()) {
+            continue;
+        }
+        auto sourceCode = &cell.metadata.computerSourcecode.str();
+        auto insertResult = resultIndexBySourceCode.emplace(sourceCode, toInt(sourceCodes.size()));
+        if (insertResult.second) {
+            sourceCodes.emplace_back(sourceCode);
+        }
+        resultIndexByCellIndex[i] = insertResult.first->second;
+    }
+
+    std::vector<CompilationResult> results(sourceCodes.size());
+    ThreadPool::getInstance().parallelFor(0, toInt(sourceCodes.size()), [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            results[i] = compileSourceCodeCached(*sourceCodes[i], symbols, parameters);
+        }
+    }, 1);
+
+    //assigning interned results per source code avoids interning the same data for each cell
+    std::vector<std::optional<InternedString>> compilations(results.size());
+    for (int i = 0; i < toInt(results.size()); ++i) {
+        if (results[i].compilationOk) {
+            compilations[i] = InternedString(results[i].compilation);
+        }
+    }
+
+    int result = 0;
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        auto resultIndex = resultIndexByCellIndex[i];
+        if (resultIndex == -1) {
+            continue;
+        }
+        if (auto const& compilation = compilations[resultIndex]) {
+            data.cells[i].cellFeature.constData = *compilation;
+        } else {
+            ++result;
+        }
+    }
+    return result;
+}
+
+void CellComputationCompiler::decompileSourceCodes(DataDescription& data, SymbolMap const& symbols, SimulationParameters const& parameters)
+{
+    std::unordered_map<std::string const*, int> resultIndexByData;
+    std::vector<std::string const*> datas;
+    std::vector<int> resultIndexByCellIndex(data.cells.size(), -1);
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        auto const& cell = data.cells[i];
+        if (cell.cellFeature.getType() != Enums::CellFunction_Computation || !cell.metadata.computerSourcecode.empty()) {
+            continue;
+        }
+        auto constData = &cell.cellFeature.constData.str();
+        auto insertResult = resultIndexByData.emplace(constData, toInt(datas.size()));
+        if (insertResult.second) {
+            datas.emplace_back(constData);
+        }
+        resultIndexByCellIndex[i] = insertResult.first->second;
+    }
+
+    std::vector<std::string> results(datas.size());
+    ThreadPool::getInstance().parallelFor(0, toInt(datas.size()), [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            results[i] = decompileSourceCodeCached(*datas[i], parameters);
+        }
+    }, 1);
+
+    std::vector<InternedString> sourceCodes(results.begin(), results.end());
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        auto resultIndex = resultIndexByCellIndex[i];
+        if (resultIndex != -1) {
+            data.cells[i].metadata.computerSourcecode = sourceCodes[resultIndex];
+        }
+    }
+}
+
+void CellComputationCompiler::clearCache()
+{
+    compilationCache.clear();
+    decompilationCache.clear();
+}
+
+CompilationResult CellComputationCompiler::compileSourceCodeCached(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters)
+{
+    CompilationKey key{code, symbols.getHash(), getMaxBytes(parameters)};
+    if (auto result = compilationCache.find(key)) {
+        return *result;
+    }
+    auto result = compileSourceCodeIntern(code, symbols, parameters);
+    compilationCache.insert(std::move(key), result);
+    return result;
+}
+
+std::string CellComputationCompiler::decompileSourceCodeCached(std::string const& data, SimulationParameters const& parameters)
+{
+    DecompilationKey key{data, parameters.tokenMemorySize, parameters.cellFunctionComputerCellMemorySize};
+    if (auto result = decompilationCache.find(key)) {
+        return *result;
+    }
+    auto result = decompileSourceCodeIntern(data, parameters);
+    decompilationCache.insert(std::move(key), result);
+    return result;
+}
+
+CompilationResult CellComputationCompiler::compileSourceCodeIntern(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters)
 {
     CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
 
@@ -349,10 +569,7 @@ namespace
     }
 }
 
-std::string CellComputationCompiler::decompileSourceCode(
-    std::string const& data,
-    SymbolMap const& symbols,
-    SimulationParameters const& parameters)
+std::string CellComputationCompiler::decompileSourceCodeIntern(std::string const& data, SimulationParameters const& parameters)
 {
     std::string text;
     std::string textOp1, textOp2;
@@ -498,19 +715,11 @@ void CellComputationCompiler::readInstruction(
     int& instructionPointer,
     CellInstruction& instructionCoded)
 {
-    //machine code: [INSTR - 4 Bits][MEM/ADDR/CMEM - 2 Bit][MEM/ADDR/CMEM/CONST - 2 Bit]
-    instructionCoded.operation = static_cast<Enums::ComputationOperation>((data[instructionPointer] >> 4) & 0xF);
-    instructionCoded.opType1 = static_cast<Enums::ComputationOpType>(((data[instructionPointer] >> 2) & 0x3) % 3);
-    instructionCoded.opType2 = static_cast<Enums::ComputationOpType>(data[instructionPointer] & 0x3);
-    instructionCoded.operand1 = data[instructionPointer + 1];  //readInteger(_code,instructionPointer + 1);
-    instructionCoded.operand2 = data[instructionPointer + 2];  //readInteger(_code,instructionPointer + 2);
-
-    //increment instruction pointer
+    instructionCoded = CellComputationExecutor::decodeInstruction(data.c_str() + instructionPointer);
     instructionPointer += 3;
 }
 
 uint8_t CellComputationCompiler::convertToAddress(int8_t addr, uint32_t size)
 {
-    uint32_t t = static_cast<uint32_t>(static_cast<uint8_t>(addr));
-    return ((t % size) + size) % size;
+    return CellComputationExecutor::convertToAddress(addr, size);
 }
@@ -4,6 +4,7 @@
 
 #include "Definitions.h"
 #include "SymbolMap.h"
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
 
 
@@ -15,19 +16,36 @@ struct CompilationResult
 };
 
 /**
- * Simple compiler for cell's machine language
+ * Simple compiler for cell's machine language.
+ * Results are cached by the content of the source code or data, the symbol table hash and the relevant simulation parameters.
  */
 class CellComputationCompiler
 {
 public:
-    static CompilationResult compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters);
+    static CompilationResult compileSourceCode(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters);
+    static CompilationResult compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters);  //builds a SymbolTable
     static std::string
     decompileSourceCode(std::string const& data, SymbolMap const& symbols, SimulationParameters const& parameters);
 
+    //compiles the source codes of all computation cells in parallel, identical source codes are compiled once
+    //returns the number of cells whose source code could not be compiled (their data remains unchanged)
+    static int compileSourceCodes(DataDescription& data, SymbolTable const& symbols, SimulationParameters const& parameters);
+
+    //sets the missing source codes of all computation cells by decompiling their data in parallel
+    static void decompileSourceCodes(DataDescription& data, SymbolMap const& symbols, SimulationParameters const& parameters);
+
+    static void clearCache();
+
     static std::optional<int> extractAddress(std::string const& s);
     static int getMaxBytes(SimulationParameters const& parameters);
 
 private:
+    static CompilationResult compileSourceCodeIntern(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters);
+    static std::string decompileSourceCodeIntern(std::string const& data, SimulationParameters const& parameters);
+
+    static CompilationResult compileSourceCodeCached(std::string const& code, SymbolTable const& symbols, SimulationParameters const& parameters);
+    static std::string decompileSourceCodeCached(std::string const& data, SimulationParameters const& parameters);
+
     static void writeInstruction(std::string& data, CellInstruction const& instructionCoded);
     static void readInstruction(
         std::string const& data,
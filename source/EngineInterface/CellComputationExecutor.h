@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+
+#include "CellInstruction.h"
+
+#if defined(__CUDACC__)
+#define CELL_COMPUTATION_FUNC __inline__ __host__ __device__ constexpr
+#else
+#define CELL_COMPUTATION_FUNC inline constexpr
+#endif
+
+/**
+ * Decoder and executor of the cell computer machine code used by the GPU kernels as well as by host code.
+ * All functions are constexpr, hence small programs can also be evaluated at compile time.
+ */
+class CellComputationExecutor
+{
+public:
+    //machine code: [INSTR - 4 Bits][MEM/ADDR/CMEM - 2 Bit][MEM/ADDR/CMEM/CONST - 2 Bit]
+    CELL_COMPUTATION_FUNC static CellInstruction decodeInstruction(char const* data)
+    {
+        CellInstruction result{};
+        result.operation = (data[0] >> 4) & 0xF;
+        result.opType1 = ((data[0] >> 2) & 0x3) % 3;
+        result.opType2 = data[0] & 0x3;
+        result.operand1 = data[1];
+        result.operand2 = data[2];
+        return result;
+    }
+
+    CELL_COMPUTATION_FUNC static uint8_t convertToAddress(int8_t addr, uint32_t size)
+    {
+        auto t = static_cast<uint32_t>(static_cast<uint8_t>(addr));
+        return ((t % size) + size) % size;
+    }
+
+    //executes numBytes of the program (read in steps of 3 bytes) on the given memories
+    //MaxBytes is the capacity of the program memory and bounds the nesting depth of conditions
+    template <int MaxBytes>
+    CELL_COMPUTATION_FUNC static void
+    execute(char const* program, int numBytes, char* tokenMemory, uint32_t tokenMemorySize, char* cellMemory, uint32_t cellMemorySize)
+    {
+        bool condTable[MaxBytes / 3 + 1] = {};
+        int condPointer = 0;
+        for (int instructionPointer = 0; instructionPointer < numBytes; instructionPointer += 3) {
+            auto instruction = decodeInstruction(program + instructionPointer);
+
+            //operand 1: pointer to mem
+            uint8_t opPointer1 = 0;
+            char* memory1 = tokenMemory;
+            if (instruction.opType1 == Enums::ComputationOpType_Mem) {
+                opPointer1 = convertToAddress(instruction.operand1, tokenMemorySize);
+            }
+            if (instruction.opType1 == Enums::ComputationOpType_MemMem) {
+                instruction.operand1 = tokenMemory[convertToAddress(instruction.operand1, tokenMemorySize)];
+                opPointer1 = convertToAddress(instruction.operand1, tokenMemorySize);
+            }
+            if (instruction.opType1 == Enums::ComputationOpType_Cmem) {
+                opPointer1 = convertToAddress(instruction.operand1, cellMemorySize);
+                memory1 = cellMemory;
+            }
+
+            //operand 2: loading value
+            if (instruction.opType2 == Enums::ComputationOpType_Mem) {
+                instruction.operand2 = tokenMemory[convertToAddress(instruction.operand2, tokenMemorySize)];
+            }
+            if (instruction.opType2 == Enums::ComputationOpType_MemMem) {
+                instruction.operand2 = tokenMemory[convertToAddress(instruction.operand2, tokenMemorySize)];
+                instruction.operand2 = tokenMemory[convertToAddress(instruction.operand2, tokenMemorySize)];
+            }
+            if (instruction.opType2 == Enums::ComputationOpType_Cmem) {
+                instruction.operand2 = cellMemory[convertToAddress(instruction.operand2, cellMemorySize)];
+            }
+
+            //execute instruction
+            bool execute = true;
+            for (int k = 0; k < condPointer; ++k) {
+                if (!condTable[k]) {
+                    execute = false;
+                }
+            }
+            if (execute && instruction.operation <= Enums::ComputationOperation_And) {
+                memory1[opPointer1] = calcOperation(instruction.operation, memory1[opPointer1], instruction.operand2);
+            }
+
+            //if instructions
+            instruction.operand1 = memory1[opPointer1];
+            if (instruction.operation >= Enums::ComputationOperation_Ifg && instruction.operation <= Enums::ComputationOperation_Ifl) {
+                condTable[condPointer] = calcCondition(instruction.operation, instruction.operand1, instruction.operand2);
+                condPointer++;
+            }
+            if (instruction.operation == Enums::ComputationOperation_Else) {
+                if (condPointer > 0) {
+                    condTable[condPointer - 1] = !condTable[condPointer - 1];
+                }
+            }
+            if (instruction.operation == Enums::ComputationOperation_Endif) {
+                if (condPointer > 0) {
+                    condPointer--;
+                }
+            }
+        }
+    }
+
+    //result of an arithmetic or logical operation on a memory byte
+    CELL_COMPUTATION_FUNC static char calcOperation(Enums::ComputationOperation operation, int8_t value, uint8_t operand)
+    {
+        switch (operation) {
+        case Enums::ComputationOperation_Mov:
+            return operand;
+        case Enums::ComputationOperation_Add:
+            return value + operand;
+        case Enums::ComputationOperation_Sub:
+            return value - operand;
+        case Enums::ComputationOperation_Mul:
+            return value * operand;
+        case Enums::ComputationOperation_Div:
+            return operand > 0 ? value / operand : 0;
+        case Enums::ComputationOperation_Xor:
+            return value ^ operand;
+        case Enums::ComputationOperation_Or:
+            return value | operand;
+        case Enums::ComputationOperation_And:
+            return value & operand;
+        default:
+            return value;
+        }
+    }
+
+    //operands are compared unsigned
+    CELL_COMPUTATION_FUNC static bool calcCondition(Enums::ComputationOperation operation, uint8_t operand1, uint8_t operand2)
+    {
+        switch (operation) {
+        case Enums::ComputationOperation_Ifg:
+            return operand1 > operand2;
+        case Enums::ComputationOperation_Ifge:
+            return operand1 >= operand2;
+        case Enums::ComputationOperation_Ife:
+            return operand1 == operand2;
+        case Enums::ComputationOperation_Ifne:
+            return operand1 != operand2;
+        case Enums::ComputationOperation_Ifle:
+            return operand1 <= operand2;
+        case Enums::ComputationOperation_Ifl:
+            return operand1 < operand2;
+        default:
+            return false;
+        }
+    }
+};
@@ -0,0 +1,308 @@
+#include "CellComputationInterpreter.h"
+
+#include <algorithm>
+
+#include "Base/ThreadPool.h"
+
+#include "CellComputationExecutor.h"
+
+namespace
+{
+    int const NumLanes = 16;
+    int const MaxConditions = CellComputationInterpreter::MaxProgramBytes / 3 + 1;
+
+    //programs are padded with zeros as in the static data of cells on the GPU
+    struct PaddedProgram
+    {
+        char data[CellComputationInterpreter::MaxProgramBytes + 2] = {};
+        int numBytes = 0;
+
+        PaddedProgram() = default;
+        PaddedProgram(std::string const& program, SimulationParameters const& parameters)
+        {
+            numBytes = std::min({toInt(program.size()), parameters.cellFunctionComputerMaxInstructions * 3, CellComputationInterpreter::MaxProgramBytes});
+            std::copy(program.begin(), program.begin() + numBytes, data);
+        }
+    };
+
+    void execute(PaddedProgram const& program, std::string& tokenMemory, std::string& cellMemory, SimulationParameters const& parameters)
+    {
+        tokenMemory.resize(parameters.tokenMemorySize);
+        cellMemory.resize(parameters.cellFunctionComputerCellMemorySize);
+        CellComputationExecutor::execute<CellComputationInterpreter::MaxProgramBytes>(
+            program.data,
+            program.numBytes,
+            tokenMemory.data(),
+            parameters.tokenMemorySize,
+            cellMemory.data(),
+            parameters.cellFunctionComputerCellMemorySize);
+    }
+
+    struct DecodedProgram
+    {
+        PaddedProgram paddedProgram;
+        std::vector<CellInstruction> instructions;
+
+        //indirect addressing leads to different addresses in the lanes, such programs are run one by one
+        bool indirect = false;
+
+        //memory bytes that can be accessed by programs without indirect addressing
+        std::vector<int> tokenAddresses;
+        std::vector<int> cellAddresses;
+    };
+
+    DecodedProgram decodeProgram(std::string const& program, SimulationParameters const& parameters)
+    {
+        DecodedProgram result;
+        result.paddedProgram = PaddedProgram(program, parameters);
+        auto const& paddedProgram = result.paddedProgram;
+        std::vector<bool> tokenAddressUsed(parameters.tokenMemorySize, false);
+        std::vector<bool> cellAddressUsed(parameters.cellFunctionComputerCellMemorySize, false);
+        auto useAddress = [](std::vector<bool>& addressUsed, uint8_t operand) {
+            addressUsed[CellComputationExecutor::convertToAddress(operand, toInt(addressUsed.size()))] = true;
+        };
+        for (int instructionPointer = 0; instructionPointer < paddedProgram.numBytes; instructionPointer += 3) {
+            auto instruction = CellComputationExecutor::decodeInstruction(paddedProgram.data + instructionPointer);
+            result.instructions.emplace_back(instruction);
+            for (auto const& [opType, operand] : {std::make_pair(instruction.opType1, instruction.operand1), std::make_pair(instruction.opType2, instruction.operand2)}) {
+                if (opType == Enums::ComputationOpType_Mem) {
+                    useAddress(tokenAddressUsed, operand);
+                }
+                if (opType == Enums::ComputationOpType_MemMem) {
+                    result.indirect = true;
+                }
+                if (opType == Enums::ComputationOpType_Cmem) {
+                    useAddress(cellAddressUsed, operand);
+                }
+            }
+        }
+        for (int i = 0; i < toInt(tokenAddressUsed.size()); ++i) {
+            if (tokenAddressUsed[i]) {
+                result.tokenAddresses.emplace_back(i);
+            }
+        }
+        for (int i = 0; i < toInt(cellAddressUsed.size()); ++i) {
+            if (cellAddressUsed[i]) {
+                result.cellAddresses.emplace_back(i);
+            }
+        }
+        return result;
+    }
+
+    //memories of NumLanes runs are interleaved, i.e. byte b of lane l is stored at b * NumLanes + l,
+    //so that each instruction operates on a contiguous row
+    class LaneExecutor
+    {
+    public:
+        LaneExecutor(int tokenMemorySize, int cellMemorySize)
+            : _tokenMemorySize(tokenMemorySize)
+            , _cellMemorySize(cellMemorySize)
+            , _tokenMemory(tokenMemorySize * NumLanes)
+            , _cellMemory(cellMemorySize * NumLanes)
+        {}
+
+        //only the bytes accessible by the program are transferred
+        void load(DecodedProgram const& program, std::string* tokenMemories[], std::string* cellMemories[], int numRuns)
+        {
+            loadMemory(_tokenMemory, program.tokenAddresses, tokenMemories, numRuns);
+            loadMemory(_cellMemory, program.cellAddresses, cellMemories, numRuns);
+        }
+
+        void store(DecodedProgram const& program, std::string* tokenMemories[], std::string* cellMemories[], int numRuns) const
+        {
+            storeMemory(_tokenMemory, _tokenMemorySize, program.tokenAddresses, tokenMemories, numRuns);
+            storeMemory(_cellMemory, _cellMemorySize, program.cellAddresses, cellMemories, numRuns);
+        }
+
+        //mirrors CellComputationExecutor::execute for all lanes
+        //without indirect addressing all lanes access the same addresses and the condition nesting only depends on the program
+        void execute(std::vector<CellInstruction> const& instructions)
+        {
+            int condPointer = 0;
+            for (auto const& instruction : instructions) {
+                char* row1 = nullptr;
+                if (instruction.opType1 == Enums::ComputationOpType_Mem) {
+                    row1 = &_tokenMemory[toRowIndex(CellComputationExecutor::convertToAddress(instruction.operand1, _tokenMemorySize))];
+                }
+                if (instruction.opType1 == Enums::ComputationOpType_Cmem) {
+                    row1 = &_cellMemory[toRowIndex(CellComputationExecutor::convertToAddress(instruction.operand1, _cellMemorySize))];
+                }
+
+                uint8_t operand2[NumLanes];
+                if (instruction.opType2 == Enums::ComputationOpType_Constant) {
+                    std::fill_n(operand2, NumLanes, instruction.operand2);
+                } else {
+                    auto row2 = instruction.opType2 == Enums::ComputationOpType_Mem
+                        ? &_tokenMemory[toRowIndex(CellComputationExecutor::convertToAddress(instruction.operand2, _tokenMemorySize))]
+                        : &_cellMemory[toRowIndex(CellComputationExecutor::convertToAddress(instruction.operand2, _cellMemorySize))];
+                    std::copy_n(row2, NumLanes, operand2);
+                }
+
+                if (instruction.operation <= Enums::ComputationOperation_And) {
+                    bool execute[NumLanes];
+                    std::fill_n(execute, NumLanes, true);
+                    for (int k = 0; k < condPointer; ++k) {
+                        for (int lane = 0; lane < NumLanes; ++lane) {
+                            execute[lane] &= _condTable[k][lane];
+                        }
+                    }
+                    switch (instruction.operation) {
+                    case Enums::ComputationOperation_Mov:
+                        applyOperation<Enums::ComputationOperation_Mov>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Add:
+                        applyOperation<Enums::ComputationOperation_Add>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Sub:
+                        applyOperation<Enums::ComputationOperation_Sub>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Mul:
+                        applyOperation<Enums::ComputationOperation_Mul>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Div:
+                        applyOperation<Enums::ComputationOperation_Div>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Xor:
+                        applyOperation<Enums::ComputationOperation_Xor>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_Or:
+                        applyOperation<Enums::ComputationOperation_Or>(row1, operand2, execute);
+                        break;
+                    case Enums::ComputationOperation_And:
+                        applyOperation<Enums::ComputationOperation_And>(row1, operand2, execute);
+                        break;
+                    }
+                }
+                if (instruction.operation >= Enums::ComputationOperation_Ifg && instruction.operation <= Enums::ComputationOperation_Ifl) {
+                    for (int lane = 0; lane < NumLanes; ++lane) {
+                        _condTable[condPointer][lane] = CellComputationExecutor::calcCondition(instruction.operation, row1[lane], operand2[lane]);
+                    }
+                    ++condPointer;
+                }
+                if (instruction.operation == Enums::ComputationOperation_Else && condPointer > 0) {
+                    for (int lane = 0; lane < NumLanes; ++lane) {
+                        _condTable[condPointer - 1][lane] = !_condTable[condPointer - 1][lane];
+                    }
+                }
+                if (instruction.operation == Enums::ComputationOperation_Endif && condPointer > 0) {
+                    --condPointer;
+                }
+            }
+        }
+
+    private:
+        int toRowIndex(uint8_t address) const { return address * NumLanes; }
+
+        //the operation is a template parameter so that the lane loop is free of branches
+        template <Enums::ComputationOperation Operation>
+        static void applyOperation(char* row, uint8_t const* operand, bool const* execute)
+        {
+            for (int lane = 0; lane < NumLanes; ++lane) {
+                auto result = CellComputationExecutor::calcOperation(Operation, row[lane], operand[lane]);
+                row[lane] = execute[lane] ? result : row[lane];
+            }
+        }
+
+        static void loadMemory(std::vector<char>& laneMemory, std::vector<int> const& addresses, std::string* memories[], int numRuns)
+        {
+            for (auto const& address : addresses) {
+                auto row = &laneMemory[address * NumLanes];
+                for (int lane = 0; lane < numRuns; ++lane) {
+                    auto const& memory = *memories[lane];
+                    row[lane] = address < toInt(memory.size()) ? memory[address] : 0;
+                }
+            }
+        }
+
+        static void storeMemory(std::vector<char> const& laneMemory, int memorySize, std::vector<int> const& addresses, std::string* memories[], int numRuns)
+        {
+            for (int lane = 0; lane < numRuns; ++lane) {
+                memories[lane]->resize(memorySize);
+            }
+            for (auto const& address : addresses) {
+                auto row = &laneMemory[address * NumLanes];
+                for (int lane = 0; lane < numRuns; ++lane) {
+                    (*memories[lane])[address] = row[lane];
+                }
+            }
+        }
+
+        int _tokenMemorySize;
+        int _cellMemorySize;
+        std::vector<char> _tokenMemory;
+        std::vector<char> _cellMemory;
+        bool _condTable[MaxConditions][NumLanes] = {};
+    };
+}
+
+void CellComputationInterpreter::run(std::string const& program, std::string& tokenMemory, std::string& cellMemory, SimulationParameters const& parameters)
+{
+    execute(PaddedProgram(program, parameters), tokenMemory, cellMemory, parameters);
+}
+
+void CellComputationInterpreter::runBatch(
+    std::vector<std::string> const& programs,
+    std::vector<int> const& programIndices,
+    std::vector<std::string>& tokenMemories,
+    std::vector<std::string>& cellMemories,
+    SimulationParameters const& parameters)
+{
+    std::vector<DecodedProgram> decodedPrograms(programs.size());
+    for (int i = 0; i < toInt(programs.size()); ++i) {
+        decodedPrograms[i] = decodeProgram(programs[i], parameters);
+    }
+
+    //order runs by program (stable counting sort keeps the memory access sequential for consecutive runs of a program)
+    std::vector<int> runOffsets(programs.size() + 1, 0);
+    for (auto const& programIndex : programIndices) {
+        ++runOffsets[programIndex + 1];
+    }
+    for (int i = 0; i < toInt(programs.size()); ++i) {
+        runOffsets[i + 1] += runOffsets[i];
+    }
+    std::vector<int> runIndices(programIndices.size());
+    {
+        auto insertPositions = runOffsets;
+        for (int i = 0; i < toInt(programIndices.size()); ++i) {
+            runIndices[insertPositions[programIndices[i]]++] = i;
+        }
+    }
+
+    struct LaneGroup
+    {
+        int programIndex;
+        int startIndex;
+        int endIndex;
+    };
+    std::vector<LaneGroup> laneGroups;
+    for (int i = 0; i < toInt(programs.size()); ++i) {
+        for (int startIndex = runOffsets[i]; startIndex < runOffsets[i + 1]; startIndex += NumLanes) {
+            laneGroups.emplace_back(LaneGroup{i, startIndex, std::min(startIndex + NumLanes, runOffsets[i + 1])});
+        }
+    }
+
+    ThreadPool::getInstance().parallelFor(0, toInt(laneGroups.size()), [&](int startIndex, int endIndex) {
+        LaneExecutor executor(parameters.tokenMemorySize, parameters.cellFunctionComputerCellMemorySize);
+        std::string* laneTokenMemories[NumLanes];
+        std::string* laneCellMemories[NumLanes];
+        for (int group = startIndex; group < endIndex; ++group) {
+            auto const& laneGroup = laneGroups[group];
+            auto const& program = decodedPrograms[laneGroup.programIndex];
+            if (program.indirect) {
+                for (int i = laneGroup.startIndex; i < laneGroup.endIndex; ++i) {
+                    execute(program.paddedProgram, tokenMemories[runIndices[i]], cellMemories[runIndices[i]], parameters);
+                }
+                continue;
+            }
+            auto numRuns = laneGroup.endIndex - laneGroup.startIndex;
+            for (int lane = 0; lane < numRuns; ++lane) {
+                auto runIndex = runIndices[laneGroup.startIndex + lane];
+                laneTokenMemories[lane] = &tokenMemories[runIndex];
+                laneCellMemories[lane] = &cellMemories[runIndex];
+            }
+            executor.load(program, laneTokenMemories, laneCellMemories, numRuns);
+            executor.execute(program.instructions);
+            executor.store(program, laneTokenMemories, laneCellMemories, numRuns);
+        }
+    });
+}
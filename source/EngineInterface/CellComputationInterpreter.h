@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Definitions.h"
+#include "SimulationParameters.h"
+
+/**
+ * Runs compiled cell programs on the CPU with the same semantics as the cell computers on the GPU.
+ * Memories are strings of size tokenMemorySize and cellFunctionComputerCellMemorySize, respectively.
+ */
+class CellComputationInterpreter
+{
+public:
+    static void run(std::string const& program, std::string& tokenMemory, std::string& cellMemory, SimulationParameters const& parameters);
+
+    //runs programs[programIndices[i]] on tokenMemories[i] and cellMemories[i] for all i
+    //runs of the same program are executed side by side in SIMD lanes, different programs in parallel
+    static void runBatch(
+        std::vector<std::string> const& programs,
+        std::vector<int> const& programIndices,
+        std::vector<std::string>& tokenMemories,
+        std::vector<std::string>& cellMemories,
+        SimulationParameters const& parameters);
+
+    static int const MaxProgramBytes = 48;  //corresponds to the static data size of cells on the GPU
+};
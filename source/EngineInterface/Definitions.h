@@ -9,8 +9,10 @@
 
 struct SimulationParameters;
 
+struct BulkDataDescription;
 struct ClusteredDataDescription;
 struct DataDescription;
+struct DataDescriptionDelta;
 struct ClusterDescription;
 struct CellDescription;
 struct ParticleDescription;
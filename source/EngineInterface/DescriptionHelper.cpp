@@ -4,7 +4,17 @@
 
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
+#include "Base/Physics.h"
+#include "Base/RandomStream.h"
+#include "Base/ThreadPool.h"
+#include "BulkDataDescription.h"
 #include "SpaceCalculator.h"
+#include "SpatialGrid.h"
+
+namespace
+{
+    float const OverlappingDistance = 2.0f;
+}
 
 DataDescription DescriptionHelper::createRect(CreateRectParameters const& parameters)
 {
@@ -28,71 +38,175 @@ DataDescription DescriptionHelper::createRect(CreateRectParameters const& parame
     return result;
 }
 
-void DescriptionHelper::duplicate(ClusteredDataDescription& data, IntVector2D const& origSize, IntVector2D const& size)
+void DescriptionHelper::duplicate(
+    BulkDataDescription& data,
+    IntVector2D const& origSize,
+    IntVector2D const& size,
+    std::function<void(float)> const& progressCallback)
 {
-    ClusteredDataDescription result;
+    auto const& cells = data.cells;
+    auto const& particles = data.particles;
+    auto numCells = cells.size();
+    auto numParticles = particles.size();
+
+    int numClusters = 0;
+    auto clusterIndices = data.calcClusterIndices(numClusters);
+    std::vector<RealVector2D> clusterPositions(numClusters);
+    std::vector<int> clusterSizes(numClusters, 0);
+    std::vector<int> clusterNumConnections(numClusters, 0);
+    std::vector<int> clusterNumTokens(numClusters, 0);
+    for (int i = 0; i < numCells; ++i) {
+        auto clusterIndex = clusterIndices[i];
+        clusterPositions[clusterIndex] += cells.positions[i];
+        ++clusterSizes[clusterIndex];
+        clusterNumConnections[clusterIndex] += cells.connectionOffsets[i + 1] - cells.connectionOffsets[i];
+        clusterNumTokens[clusterIndex] += cells.tokenOffsets[i + 1] - cells.tokenOffsets[i];
+    }
+    for (int i = 0; i < numClusters; ++i) {
+        clusterPositions[i] /= clusterSizes[i];
+    }
 
+    //tiles: a cluster is copied if its center lies inside the world, a particle if its position does
+    struct Tile
+    {
+        RealVector2D offset;
+        std::vector<unsigned char> clusterIncluded;
+        int cellStartIndex = 0;
+        int particleStartIndex = 0;
+    };
+    std::vector<Tile> tiles;
+    int numNewCells = 0;
+    int numNewConnections = 0;
+    int numNewTokens = 0;
+    int numNewParticles = 0;
     for (int incX = 0; incX < size.x; incX += origSize.x) {
         for (int incY = 0; incY < size.y; incY += origSize.y) {
-            for (auto cluster : data.clusters) {
-                auto origPos = cluster.getClusterPosFromCells();
-                RealVector2D clusterPos = {origPos.x + incX, origPos.y + incY};
-                if (clusterPos.x < size.x && clusterPos.y < size.y) {
-                    for (auto& cell : cluster.cells) {
-                        cell.pos = RealVector2D{cell.pos.x + incX, cell.pos.y + incY};
-                        if (incX > 0 || incY > 0) {
-                            removeMetadata(cell);
-                        }
-                    }
-                    makeValid(cluster);
-                    result.addCluster(cluster);
+            Tile tile;
+            tile.offset = {toFloat(incX), toFloat(incY)};
+            tile.clusterIncluded.resize(numClusters);
+            tile.cellStartIndex = numNewCells;
+            tile.particleStartIndex = numNewParticles;
+            for (int i = 0; i < numClusters; ++i) {
+                auto const& clusterPos = clusterPositions[i];
+                tile.clusterIncluded[i] = clusterPos.x + tile.offset.x < size.x && clusterPos.y + tile.offset.y < size.y;
+                if (tile.clusterIncluded[i]) {
+                    numNewCells += clusterSizes[i];
+                    numNewConnections += clusterNumConnections[i];
+                    numNewTokens += clusterNumTokens[i];
                 }
             }
-            for (auto particle : data.particles) {
-                auto origPos = particle.pos;
-                particle.pos = RealVector2D{origPos.x + incX, origPos.y + incY};
-                if (particle.pos.x < size.x && particle.pos.y < size.y) {
-                    particle.setId(NumberGenerator::getInstance().getId());
-                    result.addParticle(particle);
+            for (auto const& pos : particles.positions) {
+                if (pos.x + tile.offset.x < size.x && pos.y + tile.offset.y < size.y) {
+                    ++numNewParticles;
                 }
             }
+            tiles.emplace_back(std::move(tile));
         }
     }
-    data = result;
-}
 
-namespace
-{
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
+    //output is allocated at once and copies obtain ids from a single reserved range
+    BulkDataDescription result;
+    auto& newCells = result.cells;
+    auto& newParticles = result.particles;
+    newCells.resize(numNewCells);
+    newCells.resizeConnections(numNewConnections);
+    newCells.resizeTokens(numNewTokens);
+    newParticles.resize(numNewParticles);
+
+    auto numOrigCells = tiles.size() > 1 ? tiles[1].cellStartIndex : numNewCells;
+    auto numOrigParticles = tiles.size() > 1 ? tiles[1].particleStartIndex : numNewParticles;
+    auto firstNewCellId = NumberGenerator::getInstance().reserveIds(numNewCells - numOrigCells);
+    auto firstNewParticleId = NumberGenerator::getInstance().reserveIds(numNewParticles - numOrigParticles);
+
+    std::vector<int> newCellIndices(numCells);
+    std::vector<int> sourceCellIndices;
+    sourceCellIndices.reserve(numCells);
+    std::vector<int> sourceParticleIndices;
+    sourceParticleIndices.reserve(numParticles);
+    for (int tileIndex = 0; tileIndex < toInt(tiles.size()); ++tileIndex) {
+        auto const& tile = tiles[tileIndex];
+        auto const& offset = tile.offset;
+
+        //determine target indices and rows of copied cells
+        sourceCellIndices.clear();
+        auto newCellIndex = tile.cellStartIndex;
+        for (int i = 0; i < numCells; ++i) {
+            if (tile.clusterIncluded[clusterIndices[i]]) {
+                newCellIndices[i] = newCellIndex;
+                newCells.connectionOffsets[newCellIndex + 1] =
+                    newCells.connectionOffsets[newCellIndex] + cells.connectionOffsets[i + 1] - cells.connectionOffsets[i];
+                newCells.tokenOffsets[newCellIndex + 1] = newCells.tokenOffsets[newCellIndex] + cells.tokenOffsets[i + 1] - cells.tokenOffsets[i];
+                sourceCellIndices.emplace_back(i);
+                ++newCellIndex;
+            } else {
+                newCellIndices[i] = -1;
+            }
+        }
+
+        ThreadPool::getInstance().parallelFor(0, toInt(sourceCellIndices.size()), [&](int startIndex, int endIndex) {
+            for (int index = startIndex; index < endIndex; ++index) {
+                auto sourceIndex = sourceCellIndices[index];
+                auto i = tile.cellStartIndex + index;
+                newCells.ids[i] = tileIndex == 0 ? cells.ids[sourceIndex] : firstNewCellId + (i - numOrigCells);
+                newCells.positions[i] = {cells.positions[sourceIndex].x + offset.x, cells.positions[sourceIndex].y + offset.y};
+                newCells.velocities[i] = cells.velocities[sourceIndex];
+                newCells.energies[i] = cells.energies[sourceIndex];
+                newCells.colors[i] = cells.colors[sourceIndex];
+                newCells.maxConnections[i] = cells.maxConnections[sourceIndex];
+                newCells.tokenBranchNumbers[i] = cells.tokenBranchNumbers[sourceIndex];
+                newCells.tokenBlocked[i] = cells.tokenBlocked[sourceIndex];
+                newCells.barriers[i] = cells.barriers[sourceIndex];
+                newCells.cellFunctionTypes[i] = cells.cellFunctionTypes[sourceIndex];
+                newCells.cellFunctionInvocations[i] = cells.cellFunctionInvocations[sourceIndex];
+                newCells.constData[i] = cells.constData[sourceIndex];
+                newCells.volatileData[i] = cells.volatileData[sourceIndex];
+
+                //metadata only for original cells
+                if (tileIndex == 0) {
+                    newCells.names[i] = cells.names[sourceIndex];
+                    newCells.descriptions[i] = cells.descriptions[sourceIndex];
+                    newCells.sourceCodes[i] = cells.sourceCodes[sourceIndex];
+                }
+
+                auto newConnectionIndex = newCells.connectionOffsets[i];
+                for (int j = cells.connectionOffsets[sourceIndex]; j < cells.connectionOffsets[sourceIndex + 1]; ++j, ++newConnectionIndex) {
+                    auto connectedCellIndex = cells.connectionCellIndices[j];
+                    newCells.connectionCellIndices[newConnectionIndex] = connectedCellIndex != -1 ? newCellIndices[connectedCellIndex] : -1;
+                    newCells.connectionDistances[newConnectionIndex] = cells.connectionDistances[j];
+                    newCells.connectionAnglesFromPrevious[newConnectionIndex] = cells.connectionAnglesFromPrevious[j];
                 }
+                auto newTokenIndex = newCells.tokenOffsets[i];
+                for (int j = cells.tokenOffsets[sourceIndex]; j < cells.tokenOffsets[sourceIndex + 1]; ++j, ++newTokenIndex) {
+                    newCells.tokenEnergies[newTokenIndex] = cells.tokenEnergies[j];
+                    newCells.tokenData[newTokenIndex] = cells.tokenData[j];
+                }
+            }
+        });
+
+        sourceParticleIndices.clear();
+        for (int i = 0; i < numParticles; ++i) {
+            auto const& pos = particles.positions[i];
+            if (pos.x + offset.x < size.x && pos.y + offset.y < size.y) {
+                sourceParticleIndices.emplace_back(i);
             }
         }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
+        ThreadPool::getInstance().parallelFor(0, toInt(sourceParticleIndices.size()), [&](int startIndex, int endIndex) {
+            for (int index = startIndex; index < endIndex; ++index) {
+                auto sourceIndex = sourceParticleIndices[index];
+                auto i = tile.particleStartIndex + index;
+                newParticles.ids[i] = tileIndex == 0 ? particles.ids[sourceIndex] : firstNewParticleId + (i - numOrigParticles);
+                newParticles.positions[i] = {particles.positions[sourceIndex].x + offset.x, particles.positions[sourceIndex].y + offset.y};
+                newParticles.velocities[i] = particles.velocities[sourceIndex];
+                newParticles.energies[i] = particles.energies[sourceIndex];
+                newParticles.colors[i] = particles.colors[sourceIndex];
+            }
         });
-        return result;
+
+        if (progressCallback) {
+            progressCallback(toFloat(tileIndex + 1) / toFloat(tiles.size()));
+        }
     }
+    data = std::move(result);
 }
 
 DataDescription DescriptionHelper::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
@@ -123,6 +237,54 @@ DataDescription DescriptionHelper::gridMultiply(DataDescription const& input, Gr
     return result;
 }
 
+namespace
+{
+    int const MaxPlacementAttempts = 200;
+    int const PlacementBatchSizePerThread = 8;
+
+    struct PlacementTransform
+    {
+        RealVector2D shift;
+        RealMatrix2D rotationMatrix;
+        RealVector2D velDelta;
+        float angularVelDelta;
+    };
+
+    PlacementTransform generatePlacementTransform(
+        DescriptionHelper::RandomMultiplyParameters const& parameters,
+        IntVector2D const& worldSize,
+        uint32_t seed,
+        int copyIndex,
+        int attempt)
+    {
+        //values only depend on seed, copy index and attempt and not on the evaluation order
+        RandomStream randomStream(seed, copyIndex, attempt);
+        PlacementTransform result;
+        result.shift = {randomStream.getRandomFloat(0, toFloat(worldSize.x)), randomStream.getRandomFloat(0, toFloat(worldSize.y))};
+        result.rotationMatrix = Math::calcRotationMatrix(randomStream.getRandomFloat(parameters._minAngle, parameters._maxAngle));
+        result.velDelta = {
+            randomStream.getRandomFloat(parameters._minVelX, parameters._maxVelX), randomStream.getRandomFloat(parameters._minVelY, parameters._maxVelY)};
+        result.angularVelDelta = randomStream.getRandomFloat(parameters._minAngularVel, parameters._maxAngularVel);
+        return result;
+    }
+
+    //equivalent to shift, rotate and accelerate
+    void applyPlacementTransform(DataDescription& data, RealVector2D const& center, PlacementTransform const& transform)
+    {
+        auto apply = [&](RealVector2D& pos, RealVector2D& vel) {
+            auto rotatedRelPos = transform.rotationMatrix * (pos - center);
+            pos = center + transform.shift + rotatedRelPos;
+            vel += Physics::tangentialVelocity(rotatedRelPos, transform.velDelta, transform.angularVelDelta);
+        };
+        for (auto& cell : data.cells) {
+            apply(cell.pos, cell.vel);
+        }
+        for (auto& particle : data.particles) {
+            apply(particle.pos, particle.vel);
+        }
+    }
+}
+
 DataDescription DescriptionHelper::randomMultiply(
     DataDescription const& input,
     RandomMultiplyParameters const& parameters,
@@ -131,87 +293,128 @@ DataDescription DescriptionHelper::randomMultiply(
     bool& overlappingCheckSuccessful)
 {
     overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<int>> cellIndicesByPos;
+    auto seed = parameters._seed ? *parameters._seed : NumberGenerator::getInstance().getRandomInt();
+    auto& threadPool = ThreadPool::getInstance();
+    auto numCopies = std::max(0, parameters._number);
+
+    auto templateData = input;
+    removeMetadata(templateData);
+    auto center = templateData.isEmpty() ? RealVector2D{0, 0} : templateData.calcCenter();
+
+    //attempt which is used for each copy
+    std::vector<int> attemptByCopy(numCopies, 0);
 
-    //create map for overlapping check
     if (parameters._overlappingCheck) {
-        int index = 0;
+        SpaceCalculator spaceCalculator(worldSize);
+        float boundingRadius = 0;
+        for (auto const& cell : templateData.cells) {
+            boundingRadius = std::max(boundingRadius, Math::length(cell.pos - center));
+        }
+
+        std::vector<RealVector2D> cellPositions;
+        cellPositions.reserve(existentData.cells.size() + templateData.cells.size() * numCopies);
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellIndicesByPos[intPos].emplace_back(index);
-            ++index;
+            cellPositions.emplace_back(cell.pos);
         }
-    }
+        SpatialGrid cellGrid(cellPositions, OverlappingDistance, worldSize);
 
-    //do multiplication
-    DataDescription result = input;
-    makeValid(result);
-    auto& numberGen = NumberGenerator::getInstance();
-    for (int i = 0; i < parameters._number; ++i) {
-        bool overlapping = false;
-        DataDescription copy;
-        int attempts = 0;
-        do {
-            copy = input;
-            removeMetadata(copy);
-            copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
-            copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
-            copy.accelerate(
-                {toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
-                 toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))},
-                toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
-
-            //overlapping check
-            overlapping = false;
-            if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(existentData, cellIndicesByPos, spaceCalculator, pos)) {
-                        overlapping = true;
+        auto isOverlapping = [&](int copyIndex, int attempt) {
+            auto transform = generatePlacementTransform(parameters, worldSize, seed, copyIndex, attempt);
+
+            //broad phase with bounding circle
+            if (!cellGrid.isEntryCloserThan(center + transform.shift, boundingRadius + OverlappingDistance)) {
+                return false;
+            }
+            for (auto const& cell : templateData.cells) {
+                if (cellGrid.isEntryCloserThan(center + transform.shift + transform.rotationMatrix * (cell.pos - center), OverlappingDistance)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        //copies are placed in batches: candidates are searched in parallel against the copies of the previous batches,
+        //afterwards they are committed in order and only rechecked if they may conflict with a copy of the same batch
+        //=> result is identical to sequential placement
+        auto batchSize = threadPool.getNumThreads() * PlacementBatchSizePerThread;
+        for (int batchStart = 0; batchStart < numCopies && overlappingCheckSuccessful; batchStart += batchSize) {
+            auto batchEnd = std::min(numCopies, batchStart + batchSize);
+            threadPool.parallelFor(
+                batchStart,
+                batchEnd,
+                [&](int startIndex, int endIndex) {
+                    for (int copyIndex = startIndex; copyIndex < endIndex; ++copyIndex) {
+                        auto& attempt = attemptByCopy.at(copyIndex);
+                        while (attempt < MaxPlacementAttempts - 1 && isOverlapping(copyIndex, attempt)) {
+                            ++attempt;
+                        }
                     }
+                },
+                1);
+
+            std::vector<RealVector2D> committedCenters;
+            for (int copyIndex = batchStart; copyIndex < batchEnd; ++copyIndex) {
+                auto& attempt = attemptByCopy.at(copyIndex);
+                auto transform = generatePlacementTransform(parameters, worldSize, seed, copyIndex, attempt);
+                auto mayConflict = std::any_of(committedCenters.begin(), committedCenters.end(), [&](RealVector2D const& committedCenter) {
+                    return spaceCalculator.distance(committedCenter, center + transform.shift) < 2 * boundingRadius + OverlappingDistance;
+                });
+                if (mayConflict) {
+                    while (attempt < MaxPlacementAttempts - 1 && isOverlapping(copyIndex, attempt)) {
+                        ++attempt;
+                    }
+                    transform = generatePlacementTransform(parameters, worldSize, seed, copyIndex, attempt);
+                }
+                if (attempt == MaxPlacementAttempts - 1 && isOverlapping(copyIndex, attempt)) {
+
+                    //overlapping copy is still used but no further checks are performed
+                    overlappingCheckSuccessful = false;
+                    std::fill(attemptByCopy.begin() + copyIndex + 1, attemptByCopy.end(), 0);
+                    break;
+                }
+                committedCenters.emplace_back(center + transform.shift);
+                for (auto const& cell : templateData.cells) {
+                    cellGrid.add(center + transform.shift + transform.rotationMatrix * (cell.pos - center));
                 }
             }
-            ++attempts;
-        } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
-        if (attempts == 200) {
-            overlappingCheckSuccessful = false;
         }
+    }
+
+    //create copies
+    std::vector<DataDescription> copies(numCopies);
+    threadPool.parallelFor(0, numCopies, [&](int startIndex, int endIndex) {
+        for (int copyIndex = startIndex; copyIndex < endIndex; ++copyIndex) {
+            auto& copy = copies.at(copyIndex);
+            copy = templateData;
+            applyPlacementTransform(copy, center, generatePlacementTransform(parameters, worldSize, seed, copyIndex, attemptByCopy.at(copyIndex)));
+        }
+    });
 
+    DataDescription result = input;
+    makeValid(result);
+    for (auto& copy : copies) {
         makeValid(copy);
         result.add(copy);
-
-        //add copy to existentData for overlapping check
-        if (parameters._overlappingCheck) {
-            for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellIndicesByPos[intPos].emplace_back(index);
-            }
-        }
     }
-
     return result;
 }
 
 void DescriptionHelper::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> cellPositions;
+    cellPositions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        cellPositions.emplace_back(cell.pos);
     }
+    SpatialGrid cellGrid(cellPositions, maxDistance);
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
     for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+        auto nearbyCellIndices = cellGrid.getIndicesWithinRadius(cell.pos, maxDistance);
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -229,42 +432,79 @@ void DescriptionHelper::removeStickiness(DataDescription& data)
     }
 }
 
-void DescriptionHelper::correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize)
+void DescriptionHelper::correctConnections(BulkDataDescription& data, IntVector2D const& worldSize)
 {
-//     SpaceCalculator spaceCalculator(worldSize);
-    auto threshold = std::min(worldSize.x, worldSize.y) /3;
-    std::unordered_map<uint64_t, CellDescription&> cellById;
-    for (auto& cluster : data.clusters) {
-        for (auto& cell : cluster.cells) {
-            cellById.emplace(cell.id, cell);
+    auto& cells = data.cells;
+    auto numCells = cells.size();
+    auto threshold = toFloat(std::min(worldSize.x, worldSize.y) / 3);
+
+    //connections spanning more than the threshold wrap around the old world and are removed
+    auto isConnectionValid = [&](int cellIndex, int connectionIndex) {
+        auto connectedCellIndex = cells.connectionCellIndices[connectionIndex];
+        if (connectedCellIndex == -1) {
+            return true;
+        }
+        auto const& pos = cells.positions[cellIndex];
+        auto const& connectedPos = cells.positions[connectedCellIndex];
+        auto deltaX = connectedPos.x - pos.x;
+        auto deltaY = connectedPos.y - pos.y;
+        return deltaX * deltaX + deltaY * deltaY <= threshold * threshold;
+    };
+
+    std::vector<int> newConnectionOffsets(numCells + 1, 0);
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            int numValidConnections = 0;
+            for (int j = cells.connectionOffsets[i]; j < cells.connectionOffsets[i + 1]; ++j) {
+                if (isConnectionValid(i, j)) {
+                    ++numValidConnections;
+                }
+            }
+            newConnectionOffsets[i + 1] = numValidConnections;
         }
+    });
+    for (int i = 0; i < numCells; ++i) {
+        newConnectionOffsets[i + 1] += newConnectionOffsets[i];
     }
-    for (auto& cluster : data.clusters) {
-        for (auto& cell: cluster.cells) {
-            std::vector<ConnectionDescription> newConnections;
+
+    auto numNewConnections = newConnectionOffsets.back();
+    std::vector<int> newConnectionCellIndices(numNewConnections);
+    std::vector<float> newConnectionDistances(numNewConnections);
+    std::vector<float> newConnectionAnglesFromPrevious(numNewConnections);
+    ThreadPool::getInstance().parallelFor(0, numCells, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            auto newConnectionIndex = newConnectionOffsets[i];
             float angleToAdd = 0;
-            for (auto connection : cell.connections) {
-                auto& connectingCell = cellById.at(connection.cellId);
-                if (/*spaceCalculator.distance*/Math::length(cell.pos - connectingCell.pos) > threshold) {
-                    angleToAdd += connection.angleFromPrevious;
-                } else {
-                    connection.angleFromPrevious += angleToAdd;
+            for (int j = cells.connectionOffsets[i]; j < cells.connectionOffsets[i + 1]; ++j) {
+                if (isConnectionValid(i, j)) {
+                    newConnectionCellIndices[newConnectionIndex] = cells.connectionCellIndices[j];
+                    newConnectionDistances[newConnectionIndex] = cells.connectionDistances[j];
+                    newConnectionAnglesFromPrevious[newConnectionIndex] = cells.connectionAnglesFromPrevious[j] + angleToAdd;
                     angleToAdd = 0;
-                    newConnections.emplace_back(connection);
+                    ++newConnectionIndex;
+                } else {
+                    angleToAdd += cells.connectionAnglesFromPrevious[j];
                 }
             }
-            cell.connections = newConnections;
         }
-    }
+    });
+    cells.connectionOffsets = std::move(newConnectionOffsets);
+    cells.connectionCellIndices = std::move(newConnectionCellIndices);
+    cells.connectionDistances = std::move(newConnectionDistances);
+    cells.connectionAnglesFromPrevious = std::move(newConnectionAnglesFromPrevious);
 }
 
-void DescriptionHelper::colorize(ClusteredDataDescription& data, std::vector<int> const& colorCodes)
+void DescriptionHelper::colorize(BulkDataDescription& data, std::vector<int> const& colorCodes)
 {
-    for (auto& cluster : data.clusters) {
-        auto color = colorCodes[NumberGenerator::getInstance().getRandomInt(toInt(colorCodes.size()))];
-        for (auto& cell : cluster.cells) {
-            cell.metadata.color = color;
-        }
+    int numClusters = 0;
+    auto clusterIndices = data.calcClusterIndices(numClusters);
+    std::vector<unsigned char> clusterColors(numClusters);
+    for (auto& color : clusterColors) {
+        color = static_cast<unsigned char>(colorCodes[NumberGenerator::getInstance().getRandomInt(toInt(colorCodes.size()))]);
+    }
+    auto& colors = data.cells.colors;
+    for (int i = 0; i < data.cells.size(); ++i) {
+        colors[i] = clusterColors[clusterIndices[i]];
     }
 }
 
@@ -336,24 +576,6 @@ void DescriptionHelper::makeValid(DataDescription& data)
     }
 }
 
-void DescriptionHelper::makeValid(ClusterDescription& cluster)
-{
-    auto& numberGen = NumberGenerator::getInstance();
-    cluster.id = numberGen.getId();
-    std::unordered_map<uint64_t, uint64_t> newByOldIds;
-    for (auto& cell : cluster.cells) {
-        uint64_t newId = numberGen.getId();
-        newByOldIds.insert_or_assign(cell.id, newId);
-        cell.id = newId;
-    }
-
-    for (auto& cell : cluster.cells) {
-        for (auto& connection : cell.connections) {
-            connection.cellId = newByOldIds.at(connection.cellId);
-        }
-    }
-}
-
 void DescriptionHelper::removeMetadata(DataDescription& data)
 {
     for(auto& cell : data.cells) {
@@ -368,42 +590,6 @@ void DescriptionHelper::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionHelper::isCellPresent(
-    DataDescription const& data,
-    std::unordered_map<IntVector2D, std::vector<int>> const& cellIndicesByPos,
-    SpaceCalculator const& spaceCalculator,
-    RealVector2D const& posToCheck)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingCellIndices = [&cellIndicesByPos](IntVector2D const& intPos) {
-        auto findResult = cellIndicesByPos.find(intPos);
-        if (findResult != cellIndicesByPos.end()) {
-            return findResult->second;
-        }
-        return std::vector<int>{};
-    };
-
-    auto checkCells = [&](std::vector<int> const& cellIndices) {
-        for (auto const& cellIndex : cellIndices) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(data.cells.at(cellIndex).pos);
-            if (Math::length(posToCheck - otherPos) < 2.0f) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            if (checkCells(getMatchingCellIndices({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionHelper::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "Base/Definitions.h"
 #include "Descriptions.h"
 
@@ -20,7 +22,12 @@ public:
     };
     static DataDescription createRect(CreateRectParameters const& parameters);
 
-    static void duplicate(ClusteredDataDescription& data, IntVector2D const& origWorldSize, IntVector2D const& worldSize);
+    //progressCallback is called on the calling thread with the fraction of processed tiles
+    static void duplicate(
+        BulkDataDescription& data,
+        IntVector2D const& origWorldSize,
+        IntVector2D const& worldSize,
+        std::function<void(float)> const& progressCallback = nullptr);
 
     struct GridMultiplyParameters
     {
@@ -51,6 +58,7 @@ public:
         MEMBER_DECLARATION(RandomMultiplyParameters, float, minAngularVel, 0);
         MEMBER_DECLARATION(RandomMultiplyParameters, float, maxAngularVel, 0);
         MEMBER_DECLARATION(RandomMultiplyParameters, bool, overlappingCheck, false);
+        MEMBER_DECLARATION(RandomMultiplyParameters, std::optional<uint32_t>, seed, std::nullopt);  //random seed if not set
     };
     static DataDescription randomMultiply(
         DataDescription const& input,
@@ -61,9 +69,9 @@ public:
 
     static void reconnectCells(DataDescription& data, float maxdistance);
     static void removeStickiness(DataDescription& data);
-    static void correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize);
+    static void correctConnections(BulkDataDescription& data, IntVector2D const& worldSize);
 
-    static void colorize(ClusteredDataDescription& data, std::vector<int> const& colorCodes);
+    static void colorize(BulkDataDescription& data, std::vector<int> const& colorCodes);
 
     static void generateBranchNumbers(DataDescription& data, std::unordered_set<uint64_t> const& cellIds, int maxBranchNumbers);
 
@@ -75,11 +83,5 @@ public:
 
 private:
     static void makeValid(DataDescription& data);
-    static void makeValid(ClusterDescription& cluster);
     static void removeMetadata(CellDescription& cell);
-    static bool isCellPresent(
-        DataDescription const& data,
-        std::unordered_map<IntVector2D, std::vector<int>> const& cellIndicesByPos,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck);
 };
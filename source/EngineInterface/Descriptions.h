@@ -2,15 +2,19 @@
 
 #include <variant>
 
+#include <boost/container/static_vector.hpp>
+
 #include "Base/Definitions.h"
+#include "Base/InternedString.h"
+#include "Base/OutOfLineVector.h"
 
 #include "Definitions.h"
 #include "Metadata.h"
 
 struct CellFeatureDescription
 {
-	std::string volatileData;
-    std::string constData;
+	InternedString volatileData;
+    InternedString constData;
 
     Enums::CellFunction getType() const
     {
@@ -75,6 +79,13 @@ struct ConnectionDescription
     float angleFromPrevious = 0;
 };
 
+namespace Const
+{
+    int const MaxCellBonds = 6;  //corresponds to MAX_CELL_BONDS in the engine
+}
+
+using ConnectionDescriptions = boost::container::static_vector<ConnectionDescription, Const::MaxCellBonds>;
+
 struct CellDescription
 {
     uint64_t id = 0;
@@ -83,12 +94,12 @@ struct CellDescription
     RealVector2D vel;
     double energy;
     int maxConnections;
-    std::vector<ConnectionDescription> connections;
+    ConnectionDescriptions connections;
     bool tokenBlocked;
     int tokenBranchNumber;
     CellMetadata metadata;
     CellFeatureDescription cellFeature;
-    std::vector<TokenDescription> tokens;
+    OutOfLineVector<TokenDescription> tokens;  //most cells have no tokens
     int cellFunctionInvocations;
     bool barrier;
 
@@ -123,7 +134,7 @@ struct CellDescription
         maxConnections = value;
         return *this;
     }
-    CellDescription& setConnectingCells(std::vector<ConnectionDescription> const& value)
+    CellDescription& setConnectingCells(ConnectionDescriptions const& value)
     {
         connections = value;
         return *this;
@@ -310,3 +321,15 @@ private:
 };
 
 using CellOrParticleDescription = std::variant<CellDescription, ParticleDescription>;
+
+/**
+ * Result of an incremental data request.
+ * Pass epoch to the next request in order to obtain only the entities changed in between.
+ */
+struct DataDescriptionDelta
+{
+    uint64_t epoch = 0;
+    bool complete = false;  //true: changedData contains all requested entities and previously received data should be discarded
+    DataDescription changedData;
+    std::vector<uint64_t> removedIds;
+};
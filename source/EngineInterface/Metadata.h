@@ -2,13 +2,15 @@
 
 #include <string>
 
+#include "Base/InternedString.h"
+
 #include "Definitions.h"
 
 struct CellMetadata
 {
-	std::string computerSourcecode;
-    std::string name;
-    std::string description;
+	InternedString computerSourcecode;
+    InternedString name;
+    InternedString description;
     unsigned char color = 0;
 
 	bool operator==(CellMetadata const& other) const {
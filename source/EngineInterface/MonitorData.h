@@ -1,5 +1,28 @@
 #pragma once
 
+#include <cstdint>
+
+#include "Enums.h"
+
+#if defined(__CUDACC__)
+#define MONITOR_DATA_FUNC __inline__ __host__ __device__
+#else
+#define MONITOR_DATA_FUNC inline
+#endif
+
+//histograms use logarithmic bins: bin 0 counts values below 1, bin i > 0 counts values in [2^(i-1), 2^i), the last bin is unbounded
+int constexpr MonitorHistogramSize = 16;
+
+MONITOR_DATA_FUNC int calcMonitorHistogramBin(float value)
+{
+    int result = 0;
+    while (result < MonitorHistogramSize - 1 && value >= 1.0f) {
+        value *= 0.5f;
+        ++result;
+    }
+    return result;
+}
+
 struct MonitorData
 {
     uint64_t timeStep = 0;
@@ -9,11 +32,40 @@ struct MonitorData
     int numConnections = 0;
     int numParticles = 0;
     int numTokens = 0;
-    double totalInternalEnergy = 0.0;
+    double totalInternalEnergy = 0.0;  //cells, particles and tokens
 
     //processes
     int numCreatedCells = 0;
     int numSuccessfulAttacks = 0;
     int numFailedAttacks = 0;
     int numMuscleActivities = 0;
+
+    //entities (collected together with the entity metrics above)
+    double cellEnergyByColor[7] = {0, 0, 0, 0, 0, 0, 0};
+    int numCellsByFunction[Enums::CellFunction_Count] = {0, 0, 0, 0, 0, 0, 0};
+    int tokenEnergyHistogram[MonitorHistogramSize] = {};
+
+    //clusters: the CUDA backend approximates the connected cells with a few label propagation iterations (large elongated
+    //clusters may be counted more than once), the CPU backend determines them exactly
+    int numClusters = 0;
+    int clusterSizeHistogram[MonitorHistogramSize] = {};
+
+    //processes (collected together with the process metrics above)
+    double garbageCollectionTime = 0.0;  //mean duration of the garbage collection per time step since the last update in microseconds
+};
+
+struct MonitorSettings
+{
+    //minimal durations between two updates of the metrics during running simulation in milliseconds, 0 = update after each time step
+    int entitiesUpdateInterval = 30;    //numbers of cells, connections, particles and tokens, energies, cell functions
+    int processesUpdateInterval = 30;   //created cells, attacks and muscle activities
+    int clustersUpdateInterval = 1000;  //cluster size histogram, requires a search for connected cells
+
+    bool operator==(MonitorSettings const& other) const
+    {
+        return entitiesUpdateInterval == other.entitiesUpdateInterval && processesUpdateInterval == other.processesUpdateInterval
+            && clustersUpdateInterval == other.clustersUpdateInterval;
+    }
+
+    bool operator!=(MonitorSettings const& other) const { return !operator==(other); }
 };
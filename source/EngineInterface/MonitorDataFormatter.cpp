@@ -0,0 +1,77 @@
+#include "MonitorDataFormatter.h"
+
+#include <sstream>
+
+namespace
+{
+    std::string const CellFunctionNames[Enums::CellFunction_Count] =
+        {"computation", "communication", "scanner", "digestion", "constructor", "sensor", "muscle"};
+
+    std::string getHistogramBinName(int bin)
+    {
+        if (bin == 0) {
+            return "below 1";
+        }
+        auto lowerBound = 1 << (bin - 1);
+        if (bin == MonitorHistogramSize - 1) {
+            return std::to_string(lowerBound) + " or more";
+        }
+        return std::to_string(lowerBound) + " to " + std::to_string(lowerBound * 2);
+    }
+}
+
+std::string MonitorDataFormatter::getCsvHeader()
+{
+    std::stringstream stream;
+    stream << "time step, cells";
+    for (int i = 0; i < 7; ++i) {
+        stream << ", cells (color " << i << ")";
+    }
+    stream << ", cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities, internal energy";
+    for (int i = 0; i < 7; ++i) {
+        stream << ", cell energy (color " << i << ")";
+    }
+    for (auto const& name : CellFunctionNames) {
+        stream << ", cells (" << name << ")";
+    }
+    for (int i = 0; i < MonitorHistogramSize; ++i) {
+        stream << ", tokens (energy " << getHistogramBinName(i) << ")";
+    }
+    stream << ", clusters";
+    for (int i = 1; i < MonitorHistogramSize; ++i) {
+        stream << ", clusters (size " << getHistogramBinName(i) << ")";
+    }
+    stream << ", garbage collection time [us]";
+    return stream.str();
+}
+
+std::string MonitorDataFormatter::getCsvRow(MonitorData const& data)
+{
+    int numCells = 0;
+    for (auto const& numCellsOfColor : data.numCellsByColor) {
+        numCells += numCellsOfColor;
+    }
+
+    std::stringstream stream;
+    stream << data.timeStep << ", " << numCells;
+    for (auto const& numCellsOfColor : data.numCellsByColor) {
+        stream << ", " << numCellsOfColor;
+    }
+    stream << ", " << data.numConnections << ", " << data.numParticles << ", " << data.numTokens << ", " << data.numCreatedCells << ", "
+           << data.numSuccessfulAttacks << ", " << data.numFailedAttacks << ", " << data.numMuscleActivities << ", " << data.totalInternalEnergy;
+    for (auto const& energy : data.cellEnergyByColor) {
+        stream << ", " << energy;
+    }
+    for (auto const& numCellsOfFunction : data.numCellsByFunction) {
+        stream << ", " << numCellsOfFunction;
+    }
+    for (auto const& numTokens : data.tokenEnergyHistogram) {
+        stream << ", " << numTokens;
+    }
+    stream << ", " << data.numClusters;
+    for (int i = 1; i < MonitorHistogramSize; ++i) {
+        stream << ", " << data.clusterSizeHistogram[i];
+    }
+    stream << ", " << data.garbageCollectionTime;
+    return stream.str();
+}
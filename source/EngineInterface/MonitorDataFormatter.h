@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+#include "MonitorData.h"
+
+class MonitorDataFormatter
+{
+public:
+    //comma-separated values without line break, the columns of the row match the header
+    static std::string getCsvHeader();
+    static std::string getCsvRow(MonitorData const& data);
+};
@@ -0,0 +1,113 @@
+#include "PatternAnalysis.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include <boost/range/adaptor/indexed.hpp>
+
+#include "Base/ThreadPool.h"
+
+namespace
+{
+    void combineHash(uint64_t& hash, uint64_t value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+}
+
+bool PatternAnalysis::CellLabel::operator==(CellLabel const& other) const
+{
+    return maxConnections == other.maxConnections && numConnections == other.numConnections && tokenBlocked == other.tokenBlocked
+        && tokenBranchNumber == other.tokenBranchNumber && cellFunction == other.cellFunction;
+}
+
+bool PatternAnalysis::CellLabel::operator<(CellLabel const& other) const
+{
+    return std::tie(maxConnections, numConnections, tokenBlocked, tokenBranchNumber, cellFunction)
+        < std::tie(other.maxConnections, other.numConnections, other.tokenBlocked, other.tokenBranchNumber, other.cellFunction);
+}
+
+bool PatternAnalysis::CanonicalForm::operator==(CanonicalForm const& other) const
+{
+    return hasToken == other.hasToken && cells == other.cells && connectedCells == other.connectedCells;
+}
+
+auto PatternAnalysis::calcPartitionClasses(std::vector<ClusterDescription> const& clusters) -> std::vector<PartitionClass>
+{
+    auto numClusters = toInt(clusters.size());
+
+    //canonical forms and their hashes are calculated in parallel
+    std::vector<CanonicalForm> canonicalForms(numClusters);
+    std::vector<uint64_t> hashes(numClusters);
+    ThreadPool::getInstance().parallelFor(0, numClusters, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            canonicalForms[i] = calcCanonicalForm(clusters[i]);
+            hashes[i] = calcHash(canonicalForms[i]);
+        }
+    });
+
+    //group by hash, canonical forms are only compared for equal hashes
+    std::vector<PartitionClass> result;
+    std::unordered_map<uint64_t, std::vector<int>> classIndicesByHash;
+    for (int i = 0; i < numClusters; ++i) {
+        auto& classIndices = classIndicesByHash[hashes[i]];
+        auto findResult = std::find_if(classIndices.begin(), classIndices.end(), [&](int classIndex) {
+            return canonicalForms[result[classIndex].representantIndex] == canonicalForms[i];
+        });
+        if (findResult != classIndices.end()) {
+            ++result[*findResult].numberOfElements;
+        } else {
+            classIndices.emplace_back(toInt(result.size()));
+            result.emplace_back(PartitionClass{1, canonicalForms[i].hasToken, i});
+        }
+    }
+    return result;
+}
+
+auto PatternAnalysis::calcCanonicalForm(ClusterDescription const& cluster) -> CanonicalForm
+{
+    CanonicalForm result;
+
+    std::unordered_map<uint64_t, int> cellIndexById;
+    cellIndexById.reserve(cluster.cells.size());
+    std::vector<CellLabel> labels;
+    labels.reserve(cluster.cells.size());
+    for (auto const& cell : cluster.cells) {
+        cellIndexById.emplace(cell.id, toInt(labels.size()));
+        labels.emplace_back(
+            CellLabel{cell.maxConnections, toInt(cell.connections.size()), cell.tokenBlocked, cell.tokenBranchNumber, cell.cellFeature.getType()});
+        if (!cell.tokens.empty()) {
+            result.hasToken = true;
+        }
+    }
+
+    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
+        auto const& label = labels[index];
+        for (auto const& connection : cell.connections) {
+            auto const& connectingLabel = labels[cellIndexById.at(connection.cellId)];
+            result.connectedCells.emplace_back(std::min(label, connectingLabel), std::max(label, connectingLabel));
+        }
+    }
+    std::sort(result.connectedCells.begin(), result.connectedCells.end());
+    std::sort(labels.begin(), labels.end());
+    result.cells = std::move(labels);
+    return result;
+}
+
+uint64_t PatternAnalysis::calcHash(CanonicalForm const& canonicalForm)
+{
+    uint64_t result = canonicalForm.hasToken ? 1 : 0;
+    auto combineLabel = [&](CellLabel const& label) {
+        combineHash(result, uint64_t(uint32_t(label.maxConnections)) | (uint64_t(uint32_t(label.numConnections)) << 32));
+        combineHash(result, uint64_t(uint32_t(label.tokenBranchNumber)) | (uint64_t(uint32_t(label.cellFunction)) << 32));
+        combineHash(result, label.tokenBlocked ? 1 : 0);
+    };
+    for (auto const& label : canonicalForm.cells) {
+        combineLabel(label);
+    }
+    for (auto const& [label1, label2] : canonicalForm.connectedCells) {
+        combineLabel(label1);
+        combineLabel(label2);
+    }
+    return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Descriptions.h"
+
+/**
+ * Partitions clusters into classes of structurally equal clusters.
+ * Two clusters are equal if they agree in having tokens, in the multiset of cells and in the multiset of connected cell pairs,
+ * where cells are compared by their connection numbers, token properties and cell function (ids, positions, energies and colors are ignored).
+ * Clusters are grouped by a hash of this canonical form and the forms themselves are only compared for equal hashes.
+ */
+class PatternAnalysis
+{
+public:
+    struct PartitionClass
+    {
+        int numberOfElements = 0;
+        bool hasToken = false;
+        int representantIndex = 0;  //index of the first cluster of the class
+    };
+    static std::vector<PartitionClass> calcPartitionClasses(std::vector<ClusterDescription> const& clusters);
+
+private:
+    struct CellLabel
+    {
+        int maxConnections;
+        int numConnections;
+        bool tokenBlocked;
+        int tokenBranchNumber;
+        int cellFunction;
+
+        bool operator==(CellLabel const& other) const;
+        bool operator<(CellLabel const& other) const;
+    };
+    struct CanonicalForm
+    {
+        bool hasToken = false;
+        std::vector<CellLabel> cells;                                 //sorted
+        std::vector<std::pair<CellLabel, CellLabel>> connectedCells;  //sorted, first <= second
+
+        bool operator==(CanonicalForm const& other) const;
+    };
+    static CanonicalForm calcCanonicalForm(ClusterDescription const& cluster);
+    static uint64_t calcHash(CanonicalForm const& canonicalForm);
+};
@@ -1,5 +1,7 @@
 #include "Serializer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <stdexcept>
 #include <filesystem>
@@ -17,7 +19,10 @@
 #include <boost/range/adaptors.hpp>
 #include <zstr.hpp>
 
+#include "Base/BlockCompression.h"
+#include "Base/NumberGenerator.h"
 #include "Base/Resources.h"
+#include "BulkDataDescription.h"
 #include "Descriptions.h"
 #include "SimulationParameters.h"
 #include "SettingsParser.h"
@@ -36,6 +41,58 @@ namespace cereal
         ar(data.x, data.y);
     }
 
+    template <class Archive>
+    inline void save(Archive& ar, InternedString const& data)
+    {
+        ar(data.str());
+    }
+    template <class Archive>
+    inline void load(Archive& ar, InternedString& data)
+    {
+        std::string value;
+        ar(value);
+        data = value;
+    }
+
+    //connections and tokens are stored in the same format as std::vector
+    template <class Archive>
+    inline void save(Archive& ar, ConnectionDescriptions const& data)
+    {
+        ar(make_size_tag(static_cast<size_type>(data.size())));
+        for (auto const& connection : data) {
+            ar(connection);
+        }
+    }
+    template <class Archive>
+    inline void load(Archive& ar, ConnectionDescriptions& data)
+    {
+        size_type size;
+        ar(make_size_tag(size));
+        data.resize(static_cast<size_t>(size));
+        for (auto& connection : data) {
+            ar(connection);
+        }
+    }
+    template <class Archive, typename T>
+    inline void save(Archive& ar, OutOfLineVector<T> const& data)
+    {
+        ar(make_size_tag(static_cast<size_type>(data.size())));
+        for (auto const& element : data) {
+            ar(element);
+        }
+    }
+    template <class Archive, typename T>
+    inline void load(Archive& ar, OutOfLineVector<T>& data)
+    {
+        size_type size;
+        ar(make_size_tag(size));
+        std::vector<T> elements(static_cast<size_t>(size));
+        for (auto& element : elements) {
+            ar(element);
+        }
+        data = elements;
+    }
+
     template <class Archive>
     inline void save(Archive& ar, CellFeatureDescription const& data)
     {
@@ -102,6 +159,16 @@ namespace cereal
     {
         ar(data.clusters, data.particles);
     }
+    template <class Archive>
+    inline void serialize(Archive& ar, RealRect& data)
+    {
+        ar(data.topLeft, data.bottomRight);
+    }
+    template <class Archive>
+    inline void serialize(Archive& ar, ChunkInfo& data)
+    {
+        ar(data.type, data.tile, data.offset, data.size, data.numEntities, data.numCells, data.boundingBox);
+    }
 }
 
 /**
@@ -133,7 +200,7 @@ namespace
             result.vel = vel;
             result.energy = energy;
             result.maxConnections = maxConnections;
-            result.connections = connections;
+            result.connections.assign(connections.begin(), connections.end());
             result.tokenBlocked = tokenBlocked;
             result.tokenBranchNumber = tokenBranchNumber;
             result.metadata = metadata;
@@ -212,20 +279,44 @@ namespace cereal
 bool Serializer::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data)
 {
     try {
+        serializeDataDescription(data.content, filename);
+        return serializeSimulationMetadataToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool Serializer::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data, BulkDataDescription const& content)
+{
+    try {
+        serializeDataDescription(content, filename);
+        return serializeSimulationMetadataToFiles(filename, data);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool Serializer::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+{
+    try {
+        if (!deserializeDataDescription(data.content, filename)) {
+            return false;
+        }
+        return deserializeSimulationMetadataFromFiles(data, filename);
+    } catch (...) {
+        return false;
+    }
+}
 
+bool Serializer::serializeSimulationMetadataToFiles(std::string const& filename, DeserializedSimulation const& data)
+{
+    try {
         std::filesystem::path settingsFilename(filename);
         settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
 
         std::filesystem::path symbolsFilename(filename);
         symbolsFilename.replace_extension(std::filesystem::path(".symbols.json"));
 
-        {
-            zstr::ofstream stream(filename, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(data.content, stream);
-        }
         {
             std::ofstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
@@ -248,7 +339,7 @@ bool Serializer::serializeSimulationToFiles(std::string const& filename, Deseria
     }
 }
 
-bool Serializer::deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename)
+bool Serializer::deserializeSimulationMetadataFromFiles(DeserializedSimulation& data, std::string const& filename)
 {
     try {
         std::filesystem::path settingsFilename(filename);
@@ -257,9 +348,6 @@ bool Serializer::deserializeSimulationFromFiles(DeserializedSimulation& data, st
         std::filesystem::path symbolsFilename(filename);
         symbolsFilename.replace_extension(std::filesystem::path(".symbols.json"));
 
-        if (!deserializeDataDescription(data.content, filename)) {
-            return false;
-        }
         {
             std::ifstream stream(settingsFilename.string(), std::ios::binary);
             if (!stream) {
@@ -290,14 +378,9 @@ bool Serializer::serializeSimulationToStrings(
 {
     try {
         {
-            std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
+            std::stringstream stream;
             serializeDataDescription(data.content, stream);
-            stream.flush();
-            content = stdStream.str();
+            content = BlockCompression::compress(stream.str());
         }
         {
             std::stringstream stream;
@@ -323,11 +406,7 @@ bool Serializer::deserializeSimulationFromStrings(
 {
     try {
         {
-            std::stringstream stdStream(content);
-            zstr::istream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
+            std::stringstream stream(BlockCompression::decompress(content));
             deserializeDataDescription(data.content, stream);
         }
         {
@@ -406,12 +485,7 @@ bool Serializer::deserializeSimulationFromSingleString(DeserializedSimulation& d
 bool Serializer::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
 {
     try {
-        zstr::ofstream fileStream(filename, std::ios::binary);
-        if (!fileStream) {
-            return false;
-        }
-        serializeDataDescription(content, fileStream);
-
+        serializeDataDescription(content, filename);
         return true;
     } catch (...) {
         return false;
@@ -430,6 +504,30 @@ bool Serializer::deserializeContentFromFile(ClusteredDataDescription& content, s
     }
 }
 
+namespace
+{
+    bool isInside(RealVector2D const& pos, RealRect const& region)
+    {
+        return pos.x >= region.topLeft.x && pos.x <= region.bottomRight.x && pos.y >= region.topLeft.y && pos.y <= region.bottomRight.y;
+    }
+
+    bool isOverlapping(RealRect const& rect1, RealRect const& rect2)
+    {
+        return rect1.topLeft.x <= rect2.bottomRight.x && rect2.topLeft.x <= rect1.bottomRight.x && rect1.topLeft.y <= rect2.bottomRight.y
+            && rect2.topLeft.y <= rect1.bottomRight.y;
+    }
+
+    bool isClusterInside(ClusterDescription const& cluster, RealRect const& region)
+    {
+        for (auto const& cell : cluster.cells) {
+            if (isInside(cell.pos, region)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
 bool Serializer::serializeSymbolsToFile(std::string const& filename, SymbolMap const& symbolMap)
 {
     try {
@@ -460,6 +558,18 @@ bool Serializer::deserializeSymbolsFromFile(SymbolMap& symbolMap, std::string co
     }
 }
 
+void Serializer::serializeDataDescription(ClusteredDataDescription const& data, std::string const& filename)
+{
+    ChunkedContentWriter writer(filename);
+    for (auto const& cluster : data.clusters) {
+        writer.add(cluster);
+    }
+    for (auto const& particle : data.particles) {
+        writer.add(particle);
+    }
+    writer.finish();
+}
+
 void Serializer::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
 {
     cereal::PortableBinaryOutputArchive archive(stream);
@@ -467,6 +577,41 @@ void Serializer::serializeDataDescription(ClusteredDataDescription const& data,
     archive(data);
 }
 
+void Serializer::serializeDataDescription(BulkDataDescription const& data, std::string const& filename)
+{
+    int numClusters;
+    auto clusterIndices = data.calcClusterIndices(numClusters);
+
+    //cell indices grouped by cluster
+    std::vector<int> clusterOffsets(numClusters + 1, 0);
+    for (auto const& clusterIndex : clusterIndices) {
+        ++clusterOffsets[clusterIndex + 1];
+    }
+    for (int i = 0; i < numClusters; ++i) {
+        clusterOffsets[i + 1] += clusterOffsets[i];
+    }
+    std::vector<int> cellIndices(clusterIndices.size());
+    auto insertPositions = clusterOffsets;
+    for (int i = 0; i < data.cells.size(); ++i) {
+        cellIndices[insertPositions[clusterIndices[i]]++] = i;
+    }
+
+    ChunkedContentWriter writer(filename);
+    for (int i = 0; i < numClusters; ++i) {
+        ClusterDescription cluster;
+        cluster.id = NumberGenerator::getInstance().getId();
+        cluster.cells.reserve(clusterOffsets[i + 1] - clusterOffsets[i]);
+        for (int j = clusterOffsets[i]; j < clusterOffsets[i + 1]; ++j) {
+            cluster.cells.emplace_back(data.getCellDescription(cellIndices[j]));
+        }
+        writer.add(cluster);
+    }
+    for (int i = 0; i < data.particles.size(); ++i) {
+        writer.add(data.getParticleDescription(i));
+    }
+    writer.finish();
+}
+
 void Serializer::serializeTimestepAndSettings(uint64_t timestep, Settings const& generalSettings, std::ostream& stream)
 {
     boost::property_tree::json_parser::write_json(stream, SettingsParser::encode(timestep, generalSettings));
@@ -484,6 +629,11 @@ void Serializer::serializeSymbolMap(SymbolMap const symbols, std::ostream& strea
 
 bool Serializer::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
+    if (ChunkedContentReader::isChunkedFile(filename)) {
+        ChunkedContentReader reader(filename);
+        data = reader.readAll();
+        return true;
+    }
     try {
         zstr::ifstream stream(filename, std::ios::binary);
         if (!stream) {
@@ -547,3 +697,313 @@ void Serializer::deserializeSymbolMap(SymbolMap& symbolMap, std::istream& stream
         symbolMap.emplace(key.data(), value.data());
     }
 }
+
+namespace
+{
+    char const ChunkedFileMagic[] = "ALIENCHK";
+    char const ChunkedIndexMagic[] = "ALIENIDX";
+    int const MagicSize = 8;
+    int const TrailerSize = 8 + MagicSize;
+    uint32_t const ChunkedFormatVersion = 1;
+
+    float const TileSize = 256.0f;
+    int const MaxEntitiesPerChunk = 50000;  //cells or particles
+    int const MaxBufferedEntities = 1000000;
+
+    template <typename T>
+    std::string compress(std::vector<T> const& entities)
+    {
+        std::stringstream stream;
+        {
+            cereal::PortableBinaryOutputArchive archive(stream);
+            archive(entities);
+        }
+        return BlockCompression::compress(stream.str());
+    }
+
+    template <typename T>
+    std::vector<T> decompress(std::string const& data)
+    {
+        std::vector<T> result;
+        std::stringstream stream(BlockCompression::decompress(data));
+        cereal::PortableBinaryInputArchive archive(stream);
+        archive(result);
+        return result;
+    }
+
+    void extendBoundingBox(std::optional<RealRect>& boundingBox, RealVector2D const& pos)
+    {
+        if (!boundingBox) {
+            boundingBox = RealRect{pos, pos};
+            return;
+        }
+        boundingBox->topLeft.x = std::min(boundingBox->topLeft.x, pos.x);
+        boundingBox->topLeft.y = std::min(boundingBox->topLeft.y, pos.y);
+        boundingBox->bottomRight.x = std::max(boundingBox->bottomRight.x, pos.x);
+        boundingBox->bottomRight.y = std::max(boundingBox->bottomRight.y, pos.y);
+    }
+
+    void writeUint64(std::ostream& stream, uint64_t value)
+    {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>((value >> (i * 8)) & 0xff);
+        }
+        stream.write(bytes, 8);
+    }
+
+    uint64_t readUint64(std::istream& stream)
+    {
+        unsigned char bytes[8];
+        stream.read(reinterpret_cast<char*>(bytes), 8);
+        uint64_t result = 0;
+        for (int i = 0; i < 8; ++i) {
+            result |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+        }
+        return result;
+    }
+}
+
+ChunkedContentWriter::ChunkedContentWriter(std::string const& filename)
+    : _stream(filename, std::ios::binary)
+{
+    if (!_stream) {
+        throw std::runtime_error("Could not create file " + filename + ".");
+    }
+    _stream.write(ChunkedFileMagic, MagicSize);
+    cereal::PortableBinaryOutputArchive archive(_stream);
+    archive(ChunkedFormatVersion, Const::ProgramVersion);
+}
+
+ChunkedContentWriter::~ChunkedContentWriter()
+{
+    try {
+        finish();
+    } catch (...) {
+    }
+}
+
+void ChunkedContentWriter::add(ClusterDescription const& cluster)
+{
+    auto key = getTileKey(cluster.getClusterPosFromCells());
+    auto& buffer = _tileBuffers[key];
+    buffer.clusters.emplace_back(cluster);
+    buffer.numCells += toInt(cluster.cells.size());
+    _numBufferedEntities += toInt(cluster.cells.size());
+
+    if (buffer.numCells >= MaxEntitiesPerChunk) {
+        flushClusters(key, buffer);
+    }
+    if (_numBufferedEntities >= MaxBufferedEntities) {
+        flushAll();
+    }
+}
+
+void ChunkedContentWriter::add(ParticleDescription const& particle)
+{
+    auto key = getTileKey(particle.pos);
+    auto& buffer = _tileBuffers[key];
+    buffer.particles.emplace_back(particle);
+    ++_numBufferedEntities;
+
+    if (toInt(buffer.particles.size()) >= MaxEntitiesPerChunk) {
+        flushParticles(key, buffer);
+    }
+    if (_numBufferedEntities >= MaxBufferedEntities) {
+        flushAll();
+    }
+}
+
+void ChunkedContentWriter::finish()
+{
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+    flushAll();
+
+    auto indexOffset = static_cast<uint64_t>(_stream.tellp());
+    {
+        cereal::PortableBinaryOutputArchive archive(_stream);
+        archive(_index);
+    }
+    writeUint64(_stream, indexOffset);
+    _stream.write(ChunkedIndexMagic, MagicSize);
+    _stream.close();
+    if (!_stream) {
+        throw std::runtime_error("Could not write file.");
+    }
+}
+
+auto ChunkedContentWriter::getTileKey(RealVector2D const& pos) const -> TileKey
+{
+    return {toInt(std::floor(pos.x / TileSize)), toInt(std::floor(pos.y / TileSize))};
+}
+
+void ChunkedContentWriter::flushClusters(TileKey const& key, TileBuffer& buffer)
+{
+    if (buffer.clusters.empty()) {
+        return;
+    }
+    ChunkInfo info;
+    info.type = ChunkType::Clusters;
+    info.tile = {key.first, key.second};
+    info.numEntities = toInt(buffer.clusters.size());
+    info.numCells = buffer.numCells;
+
+    std::optional<RealRect> boundingBox;
+    for (auto const& cluster : buffer.clusters) {
+        for (auto const& cell : cluster.cells) {
+            extendBoundingBox(boundingBox, cell.pos);
+        }
+    }
+    info.boundingBox = boundingBox.value_or(RealRect());
+    writeChunk(info, compress(buffer.clusters));
+
+    _numBufferedEntities -= buffer.numCells;
+    buffer.clusters = {};
+    buffer.numCells = 0;
+}
+
+void ChunkedContentWriter::flushParticles(TileKey const& key, TileBuffer& buffer)
+{
+    if (buffer.particles.empty()) {
+        return;
+    }
+    ChunkInfo info;
+    info.type = ChunkType::Particles;
+    info.tile = {key.first, key.second};
+    info.numEntities = toInt(buffer.particles.size());
+
+    std::optional<RealRect> boundingBox;
+    for (auto const& particle : buffer.particles) {
+        extendBoundingBox(boundingBox, particle.pos);
+    }
+    info.boundingBox = boundingBox.value_or(RealRect());
+    writeChunk(info, compress(buffer.particles));
+
+    _numBufferedEntities -= info.numEntities;
+    buffer.particles = {};
+}
+
+void ChunkedContentWriter::flushAll()
+{
+    for (auto& [key, buffer] : _tileBuffers) {
+        flushClusters(key, buffer);
+        flushParticles(key, buffer);
+    }
+    _tileBuffers.clear();
+}
+
+void ChunkedContentWriter::writeChunk(ChunkInfo& info, std::string const& compressedData)
+{
+    info.offset = static_cast<uint64_t>(_stream.tellp());
+    info.size = compressedData.size();
+    _stream.write(compressedData.data(), compressedData.size());
+    if (!_stream) {
+        throw std::runtime_error("Could not write chunk.");
+    }
+    _index.emplace_back(info);
+}
+
+bool ChunkedContentReader::isChunkedFile(std::string const& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[MagicSize];
+    if (!stream.read(magic, MagicSize)) {
+        return false;
+    }
+    return std::equal(magic, magic + MagicSize, ChunkedFileMagic);
+}
+
+ChunkedContentReader::ChunkedContentReader(std::string const& filename)
+    : _stream(filename, std::ios::binary)
+{
+    if (!isChunkedFile(filename) || !_stream) {
+        throw std::runtime_error("File " + filename + " is not in chunked format.");
+    }
+    _stream.seekg(MagicSize);
+    {
+        cereal::PortableBinaryInputArchive archive(_stream);
+        uint32_t formatVersion;
+        std::string programVersion;
+        archive(formatVersion, programVersion);
+        if (formatVersion > ChunkedFormatVersion) {
+            throw std::runtime_error("Unsupported chunked format version.");
+        }
+    }
+
+    _stream.seekg(0, std::ios::end);
+    auto fileSize = static_cast<uint64_t>(_stream.tellg());
+    if (fileSize < TrailerSize) {
+        throw std::runtime_error("Index not found.");
+    }
+    _stream.seekg(fileSize - TrailerSize);
+    auto indexOffset = readUint64(_stream);
+    char magic[MagicSize];
+    _stream.read(magic, MagicSize);
+    if (!_stream || !std::equal(magic, magic + MagicSize, ChunkedIndexMagic) || indexOffset >= fileSize - TrailerSize) {
+        throw std::runtime_error("Index not found.");
+    }
+    _stream.seekg(indexOffset);
+    cereal::PortableBinaryInputArchive archive(_stream);
+    archive(_index);
+
+    //chunks have to lie between header and index
+    for (auto const& info : _index) {
+        if (info.offset < MagicSize || info.size > indexOffset || info.offset > indexOffset - info.size) {
+            throw std::runtime_error("Index is corrupted.");
+        }
+    }
+}
+
+std::vector<ChunkInfo> const& ChunkedContentReader::getIndex() const
+{
+    return _index;
+}
+
+ClusteredDataDescription ChunkedContentReader::readAll()
+{
+    ClusteredDataDescription result;
+    for (auto const& info : _index) {
+        readChunk(result, info, std::nullopt);
+    }
+    return result;
+}
+
+ClusteredDataDescription ChunkedContentReader::readRegion(RealRect const& region)
+{
+    ClusteredDataDescription result;
+    for (auto const& info : _index) {
+        if (isOverlapping(info.boundingBox, region)) {
+            readChunk(result, info, region);
+        }
+    }
+    return result;
+}
+
+void ChunkedContentReader::readChunk(ClusteredDataDescription& result, ChunkInfo const& info, std::optional<RealRect> const& region)
+{
+    std::string data(info.size, '\0');
+    _stream.seekg(info.offset);
+    if (!_stream.read(data.data(), info.size)) {
+        throw std::runtime_error("Could not read chunk.");
+    }
+
+    if (info.type == ChunkType::Clusters) {
+        auto clusters = decompress<ClusterDescription>(data);
+        for (auto& cluster : clusters) {
+            if (!region || isClusterInside(cluster, *region)) {
+                result.clusters.emplace_back(std::move(cluster));
+            }
+        }
+    }
+    if (info.type == ChunkType::Particles) {
+        auto particles = decompress<ParticleDescription>(data);
+        for (auto& particle : particles) {
+            if (!region || isInside(particle.pos, *region)) {
+                result.particles.emplace_back(std::move(particle));
+            }
+        }
+    }
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <fstream>
+#include <map>
+#include <optional>
+
 #include "Base/Definitions.h"
 
 #include "Definitions.h"
@@ -21,8 +25,15 @@ class Serializer
 {
 public:
     static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data);
+
+    //content is taken from the bulk data instead of data.content, clusters are built and written one at a time
+    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data, BulkDataDescription const& content);
     static bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename);
 
+    //only timestep, settings and symbols are processed, stored in the files accompanying the given simulation file
+    static bool serializeSimulationMetadataToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool deserializeSimulationMetadataFromFiles(DeserializedSimulation& data, std::string const& filename);
+
     static bool serializeSimulationToStrings(
         std::string& content,
         std::string& timestepAndSettings,
@@ -46,7 +57,9 @@ public:
     static bool deserializeSymbolsFromFile(SymbolMap& symbolMap, std::string const& filename);
 
 private:
+    static void serializeDataDescription(ClusteredDataDescription const& data, std::string const& filename);
     static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void serializeDataDescription(BulkDataDescription const& data, std::string const& filename);
     static void serializeTimestepAndSettings(uint64_t timestep, Settings const& generalSettings, std::ostream& stream);
     static void serializeSymbolMap(SymbolMap const symbols, std::ostream& stream);
 
@@ -56,3 +69,79 @@ private:
     static void deserializeTimestepAndSettings(uint64_t& timestep, Settings& settings, std::istream& stream);
     static void deserializeSymbolMap(SymbolMap& symbolMap, std::istream& stream);
 };
+
+/**
+ * Chunked content format:
+ * header | compressed chunk | ... | compressed chunk | index | index offset (8 bytes) | index magic
+ * Each chunk contains either clusters or particles of one spatial tile and is compressed independently.
+ */
+enum class ChunkType : uint8_t
+{
+    Clusters,
+    Particles
+};
+
+struct ChunkInfo
+{
+    ChunkType type = ChunkType::Clusters;
+    IntVector2D tile;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    int numEntities = 0;
+    int numCells = 0;
+    RealRect boundingBox;   //of all contained cell or particle positions
+};
+
+class ChunkedContentWriter
+{
+public:
+    ChunkedContentWriter(std::string const& filename);  //throws std::runtime_error if file cannot be created
+    ~ChunkedContentWriter();
+
+    void add(ClusterDescription const& cluster);
+    void add(ParticleDescription const& particle);
+
+    void finish();  //writes remaining chunks and index
+
+private:
+    struct TileBuffer
+    {
+        std::vector<ClusterDescription> clusters;
+        std::vector<ParticleDescription> particles;
+        int numCells = 0;
+    };
+    using TileKey = std::pair<int, int>;
+
+    TileKey getTileKey(RealVector2D const& pos) const;
+    void flushClusters(TileKey const& key, TileBuffer& buffer);
+    void flushParticles(TileKey const& key, TileBuffer& buffer);
+    void flushAll();
+    void writeChunk(ChunkInfo& info, std::string const& compressedData);
+
+    std::ofstream _stream;
+    std::map<TileKey, TileBuffer> _tileBuffers;
+    int _numBufferedEntities = 0;
+    std::vector<ChunkInfo> _index;
+    bool _finished = false;
+};
+
+class ChunkedContentReader
+{
+public:
+    static bool isChunkedFile(std::string const& filename);
+
+    ChunkedContentReader(std::string const& filename);  //throws std::runtime_error if file is not in chunked format
+
+    std::vector<ChunkInfo> const& getIndex() const;
+
+    ClusteredDataDescription readAll();
+
+    //loads clusters with at least one cell inside the region and particles inside the region, only the affected chunks are decompressed
+    ClusteredDataDescription readRegion(RealRect const& region);
+
+private:
+    void readChunk(ClusteredDataDescription& result, ChunkInfo const& info, std::optional<RealRect> const& region);
+
+    std::ifstream _stream;
+    std::vector<ChunkInfo> _index;
+};
@@ -6,6 +6,12 @@
 #include "GeneralSettings.h"
 #include "FlowFieldSettings.h"
 
+enum class SimulationBackend
+{
+    Cuda,
+    Cpu,  //multithreaded host reference implementation (physics only)
+};
+
 struct Settings
 {
     GeneralSettings generalSettings;
@@ -13,4 +19,5 @@ struct Settings
     SimulationParametersSpots simulationParametersSpots;
     FlowFieldSettings flowFieldSettings;
     GpuSettings gpuSettings;
+    SimulationBackend backend = SimulationBackend::Cuda;
 };
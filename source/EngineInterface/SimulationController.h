@@ -1,11 +1,17 @@
 #pragma once
+
+#include "Base/LatencyHistogram.h"
+
 #include "Definitions.h"
+#include "MonitorData.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
 #include "ShallowUpdateSelectionData.h"
 #include "SimulationController.h"
 #include "SymbolMap.h"
+#include "SymbolTable.h"
+#include "TimestepProfile.h"
 
 class _SimulationController
 {
@@ -27,13 +33,21 @@ public:
 
     virtual ClusteredDataDescription getClusteredSimulationData() = 0;
     virtual DataDescription getSimulationData() = 0;
+    virtual BulkDataDescription getBulkSimulationData() = 0;
     virtual ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) = 0;
     virtual DataDescription getSelectedSimulationData(bool includeClusters) = 0;
     virtual DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds) = 0;
 
+    /**
+     * Incremental variant: only entities changed since the epoch of a previous result are returned (sinceEpoch = 0: all entities).
+     * Changes are tracked for a single client (the editor model), the entities are still copied from the device in full.
+     */
+    virtual DataDescriptionDelta getInspectedSimulationDataDelta(std::vector<uint64_t> entityIds, uint64_t sinceEpoch) = 0;
+
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
+    virtual void setBulkSimulationData(BulkDataDescription const& dataToUpdate) = 0;
     virtual void removeSelectedEntities(bool includeClusters) = 0;
     virtual void relaxSelectedEntities(bool includeClusters) = 0;
     virtual void uniformVelocitiesForSelectedEntities(bool includeClusters) = 0;
@@ -45,8 +59,16 @@ public:
     virtual void changeCell(CellDescription const& changedCell) = 0;
     virtual void changeParticle(ParticleDescription const& changedParticle) = 0;
 
+    /**
+     * Writes or reads the entire simulation content directly in its transfer layout (without descriptions).
+     * Settings and symbols are not included.
+     */
+    virtual bool serializeSimulationDataToFile(std::string const& filename) = 0;
+    virtual bool deserializeSimulationDataFromFile(std::string const& filename) = 0;
+
     virtual void calcSingleTimestep() = 0;
     virtual void runSimulation() = 0;
+    virtual void runSimulationUntil(uint64_t timestep) = 0;  //simulation pauses after the given time step has been reached
     virtual void pauseSimulation() = 0;
 
     virtual bool isSimulationRunning() const = 0;
@@ -89,11 +111,27 @@ public:
     virtual Settings getSettings() const = 0;
     virtual SymbolMap const& getSymbolMap() const = 0;
     virtual SymbolMap const& getOriginalSymbolMap() const = 0;
+    virtual SymbolTable const& getSymbolTable() const = 0;  //built from the current symbol map for compilation
     virtual void setSymbolMap(SymbolMap const& symbolMap) = 0;
-    virtual MonitorData getStatistics() const = 0;
+    virtual MonitorData getStatistics() const = 0;  //does not block the simulation, suitable for polling with high frequency
+    virtual MonitorSettings getMonitorSettings() const = 0;
+    virtual void setMonitorSettings_async(MonitorSettings const& monitorSettings) = 0;
+
+    //all monitor data samples are appended to a log file which can be read with StatisticsLogReader, each newSimulation starts a new session
+    virtual void enableStatisticsLog(std::string const& filename) = 0;  //has to be called before newSimulation
+    virtual void flushStatisticsLog() = 0;  //makes buffered samples visible to StatisticsLogReader
+
+    //when enabled, the stages of the last time steps are measured and kept in a ring buffer (disabled by default)
+    virtual void setTimestepProfilingEnabled(bool value) = 0;
+    virtual bool isTimestepProfilingEnabled() const = 0;
+    virtual std::vector<TimestepProfile> getTimestepProfiles() const = 0;  //oldest first
 
     virtual std::optional<int> getTpsRestriction() const = 0;
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
     virtual float getTps() const = 0;
+
+    //latencies of requests to the simulation thread
+    virtual LatencyHistogramData getCommandRoundTripLatencies() const = 0;
+    virtual LatencyHistogramData getCommandQueueingLatencies() const = 0;
 };
@@ -0,0 +1,157 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Math.h"
+
+namespace
+{
+    int const MinMaxNumSlots = 1024;
+    int const MaxNumSlotsPerEntry = 4;
+}
+
+SpatialGrid::SpatialGrid(std::vector<RealVector2D> const& positions, float slotSize)
+    : _desiredSlotSize(slotSize)
+    , _positions(positions)
+{
+    build();
+}
+
+SpatialGrid::SpatialGrid(std::vector<RealVector2D> const& positions, float slotSize, IntVector2D const& worldSize)
+    : _spaceCalculator(SpaceCalculator(worldSize))
+    , _worldSize(worldSize)
+    , _desiredSlotSize(slotSize)
+{
+    _positions.reserve(positions.size());
+    for (auto const& pos : positions) {
+        _positions.emplace_back(_spaceCalculator->getCorrectedPosition(pos));
+    }
+    build();
+}
+
+int SpatialGrid::add(RealVector2D const& pos)
+{
+    auto index = toInt(_positions.size());
+    _positions.emplace_back(_spaceCalculator ? _spaceCalculator->getCorrectedPosition(pos) : pos);
+
+    //rebuild when the added entries outnumber the sorted ones (keeps the costs amortized linear)
+    if (index >= 2 * _numSortedEntries + MinMaxNumSlots) {
+        build();
+        return index;
+    }
+    auto slot = getSlotIndex(_positions.back());
+    _addedNextByIndex.emplace_back(_addedHeadBySlot[slot]);
+    _addedHeadBySlot[slot] = index;
+    return index;
+}
+
+int SpatialGrid::getNumEntries() const
+{
+    return toInt(_positions.size());
+}
+
+std::vector<int> SpatialGrid::getIndicesWithinRadius(RealVector2D const& pos, float radius) const
+{
+    std::vector<std::pair<float, int>> distancesAndIndices;
+    forEachWithinRadius(pos, radius, [&](int index, float distance) { distancesAndIndices.emplace_back(distance, index); });
+    std::sort(distancesAndIndices.begin(), distancesAndIndices.end());
+
+    std::vector<int> result;
+    result.reserve(distancesAndIndices.size());
+    for (auto const& [distance, index] : distancesAndIndices) {
+        result.emplace_back(index);
+    }
+    return result;
+}
+
+bool SpatialGrid::isEntryCloserThan(RealVector2D const& pos, float distance) const
+{
+    auto result = false;
+    forEachWithinRadius(pos, distance, [&](int, float entryDistance) { result |= entryDistance < distance; });
+    return result;
+}
+
+void SpatialGrid::build()
+{
+    auto numEntries = toInt(_positions.size());
+
+    //determine geometry
+    RealVector2D extent;
+    if (_spaceCalculator) {
+        _origin = RealVector2D{0, 0};
+        extent = RealVector2D{toFloat(_worldSize.x), toFloat(_worldSize.y)};
+    } else if (numEntries > 0) {
+        _origin = _positions.front();
+        auto lowerRight = _positions.front();
+        for (auto const& pos : _positions) {
+            _origin = RealVector2D{std::min(_origin.x, pos.x), std::min(_origin.y, pos.y)};
+            lowerRight = RealVector2D{std::max(lowerRight.x, pos.x), std::max(lowerRight.y, pos.y)};
+        }
+        extent = lowerRight - _origin;
+    } else {
+        _origin = RealVector2D{0, 0};
+    }
+    auto slotSize = std::max(_desiredSlotSize, toFloat(FLOATINGPOINT_MEDIUM_PRECISION));
+    auto maxNumSlots = std::max(MinMaxNumSlots, numEntries * MaxNumSlotsPerEntry);
+    auto calcNumSlots = [&](float extent) {
+        auto numSlots = _spaceCalculator ? std::floor(extent / slotSize) : std::floor(extent / slotSize) + 1;
+        return std::max(1.0, std::min(double(maxNumSlots), double(numSlots)));
+    };
+    while (calcNumSlots(extent.x) * calcNumSlots(extent.y) > maxNumSlots) {
+        slotSize *= toFloat(std::max(1.1, std::sqrt(calcNumSlots(extent.x) * calcNumSlots(extent.y) / maxNumSlots)));
+    }
+    _numSlots = {toInt(calcNumSlots(extent.x)), toInt(calcNumSlots(extent.y))};
+
+    //in torus mode the slots exactly partition the world in order to support wrapping
+    if (_spaceCalculator) {
+        _slotSize = RealVector2D{extent.x / toFloat(_numSlots.x), extent.y / toFloat(_numSlots.y)};
+    } else {
+        _slotSize = RealVector2D{slotSize, slotSize};
+    }
+
+    //counting sort
+    auto numSlots = _numSlots.x * _numSlots.y;
+    std::vector<int> slotByIndex(numEntries);
+    _slotOffsets.assign(numSlots + 1, 0);
+    for (int index = 0; index < numEntries; ++index) {
+        auto slot = getSlotIndex(_positions[index]);
+        slotByIndex[index] = slot;
+        ++_slotOffsets[slot + 1];
+    }
+    for (int slot = 0; slot < numSlots; ++slot) {
+        _slotOffsets[slot + 1] += _slotOffsets[slot];
+    }
+    _sortedIndices.resize(numEntries);
+    _sortedPositions.resize(numEntries);
+    std::vector<int> insertPositions(_slotOffsets.begin(), _slotOffsets.end() - 1);
+    for (int index = 0; index < numEntries; ++index) {
+        auto insertPos = insertPositions[slotByIndex[index]]++;
+        _sortedIndices[insertPos] = index;
+        _sortedPositions[insertPos] = _positions[index];
+    }
+
+    _addedHeadBySlot.assign(numSlots, -1);
+    _addedNextByIndex.clear();
+    _numSortedEntries = numEntries;
+}
+
+int SpatialGrid::getSlotIndex(RealVector2D const& pos) const
+{
+    auto x = clampSlot((pos.x - _origin.x) / _slotSize.x, _numSlots.x);
+    auto y = clampSlot((pos.y - _origin.y) / _slotSize.y, _numSlots.y);
+    return x + y * _numSlots.x;
+}
+
+int SpatialGrid::clampSlot(float slot, int numSlots)
+{
+    return toInt(std::max(0.0f, std::min(toFloat(numSlots - 1), std::floor(slot))));
+}
+
+float SpatialGrid::calcDistance(RealVector2D const& a, RealVector2D const& b) const
+{
+    if (_spaceCalculator) {
+        return _spaceCalculator->distance(a, b);
+    }
+    return Math::length(a - b);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cmath>
+#include <optional>
+
+#include "Base/Definitions.h"
+#include "SpaceCalculator.h"
+
+/**
+ * Uniform grid for neighbor queries on positions. Entries are bucketed by counting sort into contiguous arrays.
+ * Entries added afterwards are kept in per-slot lists until the grid is rebuilt.
+ * If a world size is given, positions and distances are calculated on the torus (consistent with SpaceCalculator).
+ * Otherwise the grid covers the bounding box of the initial positions and outer positions are assigned to the border slots.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid(std::vector<RealVector2D> const& positions, float slotSize);
+    SpatialGrid(std::vector<RealVector2D> const& positions, float slotSize, IntVector2D const& worldSize);
+
+    int add(RealVector2D const& pos);  //returns index of new entry
+    int getNumEntries() const;
+
+    //func(int index, float distance) is called for all entries with distance <= radius in unspecified order
+    template <typename Func>
+    void forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const;
+
+    std::vector<int> getIndicesWithinRadius(RealVector2D const& pos, float radius) const;  //sorted by distance
+    bool isEntryCloserThan(RealVector2D const& pos, float distance) const;
+
+private:
+    void build();
+    int getSlotIndex(RealVector2D const& pos) const;
+    static int clampSlot(float slot, int numSlots);
+    float calcDistance(RealVector2D const& a, RealVector2D const& b) const;
+
+    std::optional<SpaceCalculator> _spaceCalculator;
+    IntVector2D _worldSize;
+    float _desiredSlotSize;
+
+    RealVector2D _origin;
+    RealVector2D _slotSize;
+    IntVector2D _numSlots;
+
+    std::vector<RealVector2D> _positions;  //by index
+
+    //entries sorted by slot
+    std::vector<int> _slotOffsets;
+    std::vector<int> _sortedIndices;
+    std::vector<RealVector2D> _sortedPositions;
+
+    //entries added after the last build
+    std::vector<int> _addedHeadBySlot;
+    std::vector<int> _addedNextByIndex;
+    int _numSortedEntries = 0;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+
+template <typename Func>
+void SpatialGrid::forEachWithinRadius(RealVector2D const& pos, float radius, Func const& func) const
+{
+    auto queryPos = _spaceCalculator ? _spaceCalculator->getCorrectedPosition(pos) : pos;
+    int minSlotX, maxSlotX, minSlotY, maxSlotY;
+    if (_spaceCalculator) {
+
+        //slots outside the world are wrapped, each slot is visited at most once
+        auto slotRadiusX = std::min(toFloat(_numSlots.x), std::ceil(radius / _slotSize.x));
+        auto slotRadiusY = std::min(toFloat(_numSlots.y), std::ceil(radius / _slotSize.y));
+        minSlotX = toInt(std::floor((queryPos.x - _origin.x) / _slotSize.x) - slotRadiusX);
+        minSlotY = toInt(std::floor((queryPos.y - _origin.y) / _slotSize.y) - slotRadiusY);
+        maxSlotX = std::min(minSlotX + toInt(2 * slotRadiusX), minSlotX + _numSlots.x - 1);
+        maxSlotY = std::min(minSlotY + toInt(2 * slotRadiusY), minSlotY + _numSlots.y - 1);
+    } else {
+        minSlotX = clampSlot((queryPos.x - radius - _origin.x) / _slotSize.x, _numSlots.x);
+        maxSlotX = clampSlot((queryPos.x + radius - _origin.x) / _slotSize.x, _numSlots.x);
+        minSlotY = clampSlot((queryPos.y - radius - _origin.y) / _slotSize.y, _numSlots.y);
+        maxSlotY = clampSlot((queryPos.y + radius - _origin.y) / _slotSize.y, _numSlots.y);
+    }
+
+    auto processEntry = [&](int index, RealVector2D const& entryPos) {
+        auto distance = calcDistance(queryPos, entryPos);
+        if (distance <= radius) {
+            func(index, distance);
+        }
+    };
+    for (int y = minSlotY; y <= maxSlotY; ++y) {
+        auto slotY = (y % _numSlots.y + _numSlots.y) % _numSlots.y;
+        for (int x = minSlotX; x <= maxSlotX; ++x) {
+            auto slotX = (x % _numSlots.x + _numSlots.x) % _numSlots.x;
+            auto slot = slotX + slotY * _numSlots.x;
+            for (int i = _slotOffsets[slot]; i < _slotOffsets[slot + 1]; ++i) {
+                processEntry(_sortedIndices[i], _sortedPositions[i]);
+            }
+            for (int index = _addedHeadBySlot[slot]; index != -1; index = _addedNextByIndex[index - _numSortedEntries]) {
+                processEntry(index, _positions[index]);
+            }
+        }
+    }
+}
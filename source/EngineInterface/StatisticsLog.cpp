@@ -0,0 +1,446 @@
+#include "StatisticsLog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "Base/BlockCompression.h"
+#include "Base/Definitions.h"
+#include "Base/LoggingService.h"
+
+namespace
+{
+    uint32_t const FileMagic = 0x4c534c41;       //"ALSL"
+    uint32_t const SegmentMagic = 0x47455341;    //"ASEG"
+    uint32_t const FileVersion = 1;
+    int const FileHeaderSize = 12;               //magic, version, number of columns
+    int const SegmentHeaderSize = 32;            //magic, number of samples, payload size, flags, min time step, max time step
+    uint32_t const SegmentFlagIncreasing = 1;    //time steps are strictly increasing within the segment
+    uint32_t const SegmentFlagSessionStart = 2;  //first segment of a session, may contain no samples
+
+    enum class ColumnType
+    {
+        Uint64,
+        Int,
+        Double
+    };
+    struct Column
+    {
+        ColumnType type;
+        size_t offset;
+    };
+
+    //the order of the columns defines the file format => new columns have to be appended
+    std::vector<Column> const& getColumns()
+    {
+        static std::vector<Column> const result = [] {
+            std::vector<Column> columns;
+            auto addColumns = [&](ColumnType type, size_t offset, int count = 1) {
+                auto size = type == ColumnType::Int ? sizeof(int) : sizeof(uint64_t);
+                for (int i = 0; i < count; ++i) {
+                    columns.emplace_back(Column{type, offset + size * i});
+                }
+            };
+            addColumns(ColumnType::Uint64, offsetof(MonitorData, timeStep));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numCellsByColor), 7);
+            addColumns(ColumnType::Int, offsetof(MonitorData, numConnections));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numParticles));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numTokens));
+            addColumns(ColumnType::Double, offsetof(MonitorData, totalInternalEnergy));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numCreatedCells));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numSuccessfulAttacks));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numFailedAttacks));
+            addColumns(ColumnType::Int, offsetof(MonitorData, numMuscleActivities));
+            addColumns(ColumnType::Double, offsetof(MonitorData, cellEnergyByColor), 7);
+            addColumns(ColumnType::Int, offsetof(MonitorData, numCellsByFunction), Enums::CellFunction_Count);
+            addColumns(ColumnType::Int, offsetof(MonitorData, tokenEnergyHistogram), MonitorHistogramSize);
+            addColumns(ColumnType::Int, offsetof(MonitorData, numClusters));
+            addColumns(ColumnType::Int, offsetof(MonitorData, clusterSizeHistogram), MonitorHistogramSize);
+            addColumns(ColumnType::Double, offsetof(MonitorData, garbageCollectionTime));
+            return columns;
+        }();
+        return result;
+    }
+
+    uint64_t getColumnValue(MonitorData const& sample, Column const& column)
+    {
+        auto source = reinterpret_cast<char const*>(&sample) + column.offset;
+        if (column.type == ColumnType::Int) {
+            int value;
+            std::memcpy(&value, source, sizeof(value));
+            return static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+        uint64_t value;
+        std::memcpy(&value, source, sizeof(value));
+        return value;
+    }
+
+    void setColumnValue(MonitorData& sample, Column const& column, uint64_t value)
+    {
+        auto target = reinterpret_cast<char*>(&sample) + column.offset;
+        if (column.type == ColumnType::Int) {
+            auto intValue = static_cast<int>(static_cast<int64_t>(value));
+            std::memcpy(target, &intValue, sizeof(intValue));
+        } else {
+            std::memcpy(target, &value, sizeof(value));
+        }
+    }
+
+    //counts change slowly => deltas of successive values are small and zigzag encoded into few varint bytes
+    //energies are doubles => their bits are xored with the previous ones to obtain leading zeros instead
+    uint64_t encodeValue(Column const& column, uint64_t value, uint64_t prevValue)
+    {
+        if (column.type == ColumnType::Double) {
+            return value ^ prevValue;
+        }
+        auto delta = static_cast<int64_t>(value - prevValue);
+        return (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    }
+
+    uint64_t decodeValue(Column const& column, uint64_t encodedValue, uint64_t prevValue)
+    {
+        if (column.type == ColumnType::Double) {
+            return encodedValue ^ prevValue;
+        }
+        auto delta = (encodedValue >> 1) ^ (~(encodedValue & 1) + 1);
+        return prevValue + delta;
+    }
+
+    void appendVarint(std::string& target, uint64_t value)
+    {
+        while (value >= 0x80) {
+            target.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        target.push_back(static_cast<char>(value));
+    }
+
+    uint64_t readVarint(std::string const& source, size_t& pos)
+    {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= source.size()) {
+                throw std::runtime_error("Statistics log segment is corrupt.");
+            }
+            auto byte = static_cast<unsigned char>(source[pos++]);
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return result;
+            }
+        }
+        throw std::runtime_error("Statistics log segment is corrupt.");
+    }
+
+    void appendUint32(std::string& target, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) {
+            target.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+    }
+
+    void appendUint64(std::string& target, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i) {
+            target.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+    }
+
+    uint32_t readUint32(char const* source)
+    {
+        auto bytes = reinterpret_cast<unsigned char const*>(source);
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16)
+            | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    uint64_t readUint64(char const* source)
+    {
+        return static_cast<uint64_t>(readUint32(source)) | (static_cast<uint64_t>(readUint32(source + 4)) << 32);
+    }
+}
+
+StatisticsLogWriter::StatisticsLogWriter(std::string const& filename, StatisticsLogParameters const& parameters)
+    : _filename(filename)
+    , _parameters(parameters)
+{
+    //each writer starts a new file in order to never append to a file which may end with an incomplete segment
+    auto fileIndices = StatisticsLogHelper::getFileIndices(filename);
+    _fileIndex = fileIndices.empty() ? -1 : fileIndices.back();
+    _samples.reserve(parameters.samplesPerSegment);
+}
+
+StatisticsLogWriter::~StatisticsLogWriter()
+{
+    flush();
+}
+
+void StatisticsLogWriter::add(MonitorData const& sample)
+{
+    _samples.emplace_back(sample);
+    if (toInt(_samples.size()) >= _parameters.samplesPerSegment) {
+        flush();
+    }
+}
+
+void StatisticsLogWriter::flush()
+{
+    if (_samples.empty() && !_isSessionStart) {
+        return;
+    }
+    std::string columns;
+    columns.reserve(_samples.size() * getColumns().size() * 2);
+    for (auto const& column : getColumns()) {
+        uint64_t prevValue = 0;
+        for (auto const& sample : _samples) {
+            auto value = getColumnValue(sample, column);
+            appendVarint(columns, encodeValue(column, value, prevValue));
+            prevValue = value;
+        }
+    }
+
+    auto minTimestep = std::numeric_limits<uint64_t>::max();
+    uint64_t maxTimestep = 0;
+    uint32_t flags = SegmentFlagIncreasing | (_isSessionStart ? SegmentFlagSessionStart : 0);
+    for (size_t i = 0; i < _samples.size(); ++i) {
+        auto timestep = _samples[i].timeStep;
+        minTimestep = std::min(minTimestep, timestep);
+        maxTimestep = std::max(maxTimestep, timestep);
+        if (i > 0 && timestep <= _samples[i - 1].timeStep) {
+            flags &= ~SegmentFlagIncreasing;
+        }
+    }
+
+    try {
+        auto payload = BlockCompression::compress(columns);
+        std::string segment;
+        appendUint32(segment, SegmentMagic);
+        appendUint32(segment, static_cast<uint32_t>(_samples.size()));
+        appendUint32(segment, static_cast<uint32_t>(payload.size()));
+        appendUint32(segment, flags);
+        appendUint64(segment, minTimestep);
+        appendUint64(segment, maxTimestep);
+        segment += payload;
+
+        if (!_file.is_open() || _fileSize >= _parameters.maxFileSize) {
+            openNextFile();
+        }
+        _file.write(segment.data(), segment.size());
+        _file.flush();
+        if (!_file) {
+            throw std::runtime_error("Could not write to " + StatisticsLogHelper::getFilename(_filename, _fileIndex) + ".");
+        }
+        _fileSize += segment.size();
+    } catch (std::exception const& e) {
+        log(Priority::Important, std::string("Statistics log: ") + e.what());
+        _file.close();
+    }
+    _samples.clear();
+    _isSessionStart = false;
+}
+
+void StatisticsLogWriter::startSession()
+{
+    flush();
+    _isSessionStart = true;
+}
+
+void StatisticsLogWriter::openNextFile()
+{
+    _file.close();
+    ++_fileIndex;
+    auto filename = StatisticsLogHelper::getFilename(_filename, _fileIndex);
+    _file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!_file) {
+        throw std::runtime_error("Could not create " + filename + ".");
+    }
+    std::string header;
+    appendUint32(header, FileMagic);
+    appendUint32(header, FileVersion);
+    appendUint32(header, static_cast<uint32_t>(getColumns().size()));
+    _file.write(header.data(), header.size());
+    _fileSize = header.size();
+
+    removeOldFiles();
+}
+
+void StatisticsLogWriter::removeOldFiles()
+{
+    auto fileIndices = StatisticsLogHelper::getFileIndices(_filename);
+    auto numFilesToRemove = toInt(fileIndices.size()) - _parameters.maxNumFiles;
+    for (int i = 0; i < numFilesToRemove; ++i) {
+        std::error_code error;
+        std::filesystem::remove(StatisticsLogHelper::getFilename(_filename, fileIndices.at(i)), error);
+    }
+}
+
+struct StatisticsLogReader::MappedFile
+{
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+StatisticsLogReader::StatisticsLogReader(std::string const& filename)
+{
+    for (auto const& fileIndex : StatisticsLogHelper::getFileIndices(filename)) {
+        auto fileFilename = StatisticsLogHelper::getFilename(filename, fileIndex);
+        std::error_code error;
+        auto fileSize = std::filesystem::file_size(fileFilename, error);
+        if (error || fileSize < FileHeaderSize) {
+            continue;
+        }
+        auto mappedFile = std::make_unique<MappedFile>();
+        try {
+            mappedFile->mapping = boost::interprocess::file_mapping(fileFilename.c_str(), boost::interprocess::read_only);
+            mappedFile->region = boost::interprocess::mapped_region(mappedFile->mapping, boost::interprocess::read_only);
+        } catch (boost::interprocess::interprocess_exception const&) {
+            continue;
+        }
+
+        auto data = static_cast<char const*>(mappedFile->region.get_address());
+        auto size = mappedFile->region.get_size();
+        //files written by older versions contain fewer columns
+        auto numColumns = toInt(readUint32(data + 8));
+        if (readUint32(data) != FileMagic || readUint32(data + 4) != FileVersion || numColumns > toInt(getColumns().size())) {
+            continue;
+        }
+        size_t pos = FileHeaderSize;
+        while (pos + SegmentHeaderSize <= size && readUint32(data + pos) == SegmentMagic) {
+            Segment segment;
+            segment.numSamples = toInt(readUint32(data + pos + 4));
+            segment.payloadSize = toInt(readUint32(data + pos + 8));
+            auto flags = readUint32(data + pos + 12);
+            segment.increasing = (flags & SegmentFlagIncreasing) != 0;
+            segment.minTimestep = readUint64(data + pos + 16);
+            segment.maxTimestep = readUint64(data + pos + 24);
+            segment.data = data + pos + SegmentHeaderSize;
+            segment.numColumns = numColumns;
+            pos += SegmentHeaderSize + segment.payloadSize;
+            if (pos > size) {
+                break;
+            }
+            if (flags & SegmentFlagSessionStart) {
+                _lastSessionSegmentIndex = toInt(_segments.size());
+            }
+            if (segment.numSamples > 0) {
+                _segments.emplace_back(segment);
+            }
+        }
+        _mappedFiles.emplace_back(std::move(mappedFile));
+    }
+}
+
+StatisticsLogReader::~StatisticsLogReader() = default;
+
+uint64_t StatisticsLogReader::getNumSamples() const
+{
+    uint64_t result = 0;
+    for (auto const& segment : _segments) {
+        result += segment.numSamples;
+    }
+    return result;
+}
+
+void StatisticsLogReader::forEachSample(std::function<void(MonitorData const&)> const& func) const
+{
+    for (auto const& segment : _segments) {
+        for (auto const& sample : decodeSegment(segment)) {
+            func(sample);
+        }
+    }
+}
+
+void StatisticsLogReader::forEachSampleInHistory(std::function<void(MonitorData const&)> const& func) const
+{
+    //backward pass: a sample belongs to the history if its time step is smaller than all later ones
+    //only segments overlapping a later time step have to be decoded for this
+    enum class Inclusion
+    {
+        All,
+        None,
+        Partial
+    };
+    auto numSegments = toInt(_segments.size());
+    std::vector<Inclusion> inclusions(numSegments, Inclusion::None);
+    std::vector<std::vector<bool>> partialInclusions(numSegments);
+    auto minLaterTimestep = std::numeric_limits<uint64_t>::max();
+    for (int i = numSegments - 1; i >= _lastSessionSegmentIndex; --i) {
+        auto const& segment = _segments.at(i);
+        if (segment.increasing && segment.maxTimestep < minLaterTimestep) {
+            inclusions.at(i) = Inclusion::All;
+            minLaterTimestep = segment.minTimestep;
+        } else if (segment.minTimestep >= minLaterTimestep) {
+            inclusions.at(i) = Inclusion::None;
+        } else {
+            inclusions.at(i) = Inclusion::Partial;
+            auto samples = decodeSegment(segment);
+            auto& partialInclusion = partialInclusions.at(i);
+            partialInclusion.resize(samples.size());
+            for (int j = toInt(samples.size()) - 1; j >= 0; --j) {
+                partialInclusion.at(j) = samples.at(j).timeStep < minLaterTimestep;
+                minLaterTimestep = std::min(minLaterTimestep, samples.at(j).timeStep);
+            }
+        }
+    }
+
+    for (int i = _lastSessionSegmentIndex; i < numSegments; ++i) {
+        if (inclusions.at(i) == Inclusion::None) {
+            continue;
+        }
+        auto samples = decodeSegment(_segments.at(i));
+        for (int j = 0; j < toInt(samples.size()); ++j) {
+            if (inclusions.at(i) == Inclusion::All || partialInclusions.at(i).at(j)) {
+                func(samples.at(j));
+            }
+        }
+    }
+}
+
+std::vector<MonitorData> StatisticsLogReader::decodeSegment(Segment const& segment) const
+{
+    auto columns = BlockCompression::decompress(std::string(segment.data, segment.payloadSize));
+    std::vector<MonitorData> result(segment.numSamples);
+    size_t pos = 0;
+    for (int i = 0; i < segment.numColumns; ++i) {
+        auto const& column = getColumns().at(i);
+        uint64_t prevValue = 0;
+        for (auto& sample : result) {
+            auto value = decodeValue(column, readVarint(columns, pos), prevValue);
+            setColumnValue(sample, column, value);
+            prevValue = value;
+        }
+    }
+    return result;
+}
+
+std::vector<int> StatisticsLogHelper::getFileIndices(std::string const& filename)
+{
+    std::filesystem::path path(filename);
+    auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+    auto prefix = path.filename().string() + ".";
+
+    std::vector<int> result;
+    std::error_code error;
+    for (auto const& entry : std::filesystem::directory_iterator(directory, error)) {
+        auto name = entry.path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        auto suffix = name.substr(prefix.size());
+        if (suffix.size() > 9 || !std::all_of(suffix.begin(), suffix.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        result.emplace_back(std::stoi(suffix));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::string StatisticsLogHelper::getFilename(std::string const& filename, int fileIndex)
+{
+    return filename + "." + std::to_string(fileIndex);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MonitorData.h"
+
+struct StatisticsLogParameters
+{
+    int samplesPerSegment = 4096;               //samples are buffered in memory until a segment is full or flush is called
+    uint64_t maxFileSize = 16 * 1024 * 1024;    //a new file is started when the current file exceeds this size
+    int maxNumFiles = 64;                       //oldest files are removed beyond this number
+};
+
+/**
+ * Appends monitor data samples to a rotating log consisting of the files <filename>.0, <filename>.1, ...
+ * Samples are written in segments: each segment stores its samples column by column (delta and varint encoded)
+ * and is compressed independently. Since segments are only appended, a crash loses at most the buffered samples.
+ * The log is divided into sessions (e.g. one per simulation) by markers at the first segment of each session.
+ */
+class StatisticsLogWriter
+{
+public:
+    StatisticsLogWriter(std::string const& filename, StatisticsLogParameters const& parameters = StatisticsLogParameters());
+    ~StatisticsLogWriter();
+
+    void add(MonitorData const& sample);
+    void flush();
+
+    //samples added afterwards belong to a new session, the marker is written with the next flush
+    void startSession();
+
+    std::string getFilename() const { return _filename; }
+
+private:
+    void openNextFile();
+    void removeOldFiles();
+
+    std::string _filename;
+    StatisticsLogParameters _parameters;
+    std::vector<MonitorData> _samples;
+    std::ofstream _file;
+    uint64_t _fileSize = 0;
+    int _fileIndex = -1;
+    bool _isSessionStart = false;
+};
+
+/**
+ * Reads all files of a statistics log written by StatisticsLogWriter via memory mapping.
+ * Samples which have been written after the reader was created are not visible. Incomplete segments at the end of
+ * a file (e.g. due to a crash) are ignored.
+ */
+class StatisticsLogReader
+{
+public:
+    explicit StatisticsLogReader(std::string const& filename);
+    ~StatisticsLogReader();
+
+    int getNumSegments() const { return static_cast<int>(_segments.size()); }
+    uint64_t getNumSamples() const;
+
+    //calls func for all samples in the order of writing
+    void forEachSample(std::function<void(MonitorData const&)> const& func) const;
+
+    //calls func only for samples of the last session which belong to the history of the last sample:
+    //a sample is skipped if a later sample has the same or a smaller time step (e.g. after restoring a snapshot)
+    void forEachSampleInHistory(std::function<void(MonitorData const&)> const& func) const;
+
+private:
+    struct Segment
+    {
+        char const* data;
+        int numColumns;
+        int payloadSize;
+        int numSamples;
+        bool increasing;
+        uint64_t minTimestep;
+        uint64_t maxTimestep;
+    };
+    std::vector<MonitorData> decodeSegment(Segment const& segment) const;
+
+    struct MappedFile;
+    std::vector<std::unique_ptr<MappedFile>> _mappedFiles;
+    std::vector<Segment> _segments;
+    int _lastSessionSegmentIndex = 0;   //index of the first segment of the last session
+};
+
+class StatisticsLogHelper
+{
+public:
+    //returns the indices of the existing files of a log in ascending order
+    static std::vector<int> getFileIndices(std::string const& filename);
+    static std::string getFilename(std::string const& filename, int fileIndex);
+};
@@ -0,0 +1,56 @@
+#include "SymbolTable.h"
+
+namespace
+{
+    void hashCombine(size_t& seed, size_t value) { seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+}
+
+SymbolTable::SymbolTable(SymbolMap const& symbols)
+{
+    int numSlots = 1;
+    while (numSlots < toInt(symbols.size()) * 2) {
+        numSlots *= 2;
+    }
+    _slots.resize(numSlots, -1);
+    _entries.reserve(symbols.size());
+
+    std::hash<std::string_view> stringHash;
+    size_t hash = symbols.size();
+    for (auto const& [key, value] : symbols) {
+        Entry entry;
+        entry.keyHash = stringHash(key);
+        entry.keyOffset = toInt(_buffer.size());
+        entry.keySize = toInt(key.size());
+        _buffer += key;
+        entry.valueOffset = toInt(_buffer.size());
+        entry.valueSize = toInt(value.size());
+        _buffer += value;
+
+        auto slot = entry.keyHash & (numSlots - 1);
+        while (_slots[slot] != -1) {
+            slot = (slot + 1) & (numSlots - 1);
+        }
+        _slots[slot] = toInt(_entries.size());
+        _entries.emplace_back(entry);
+
+        hashCombine(hash, entry.keyHash);
+        hashCombine(hash, stringHash(value));
+    }
+    _hash = hash;
+}
+
+std::optional<std::string_view> SymbolTable::find(std::string_view const& key) const
+{
+    if (_entries.empty()) {
+        return std::nullopt;
+    }
+    auto keyHash = std::hash<std::string_view>()(key);
+    auto numSlots = _slots.size();
+    for (auto slot = keyHash & (numSlots - 1); _slots[slot] != -1; slot = (slot + 1) & (numSlots - 1)) {
+        auto const& entry = _entries[_slots[slot]];
+        if (entry.keyHash == keyHash && std::string_view(_buffer).substr(entry.keyOffset, entry.keySize) == key) {
+            return std::string_view(_buffer).substr(entry.valueOffset, entry.valueSize);
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include "SymbolMap.h"
+
+/**
+ * Immutable lookup structure for symbols built once from a SymbolMap.
+ * Keys and values are stored in a single buffer and are found via open addressing with precomputed hashes.
+ */
+class SymbolTable
+{
+public:
+    SymbolTable() = default;
+    explicit SymbolTable(SymbolMap const& symbols);
+
+    std::optional<std::string_view> find(std::string_view const& key) const;
+
+    int size() const { return toInt(_entries.size()); }
+
+    //equal symbol maps yield equal hashes
+    uint64_t getHash() const { return _hash; }
+
+private:
+    struct Entry
+    {
+        size_t keyHash;
+        int keyOffset;
+        int keySize;
+        int valueOffset;
+        int valueSize;
+    };
+    std::string _buffer;
+    std::vector<Entry> _entries;
+    std::vector<int> _slots;  //entry indices or -1, size is a power of two
+    uint64_t _hash = 0;
+};
@@ -0,0 +1,129 @@
+#include "TimestepProfile.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include "Base/Definitions.h"
+
+namespace
+{
+    int const TimestepThreadId = 1;
+    int const StageThreadId = 2;
+
+    void writeEscaped(std::ostream& stream, char const* text)
+    {
+        stream << '"';
+        for (auto c = text; *c != 0; ++c) {
+            if (*c == '"' || *c == '\\') {
+                stream << '\\';
+            }
+            stream << *c;
+        }
+        stream << '"';
+    }
+
+    void writeThreadName(std::ostream& stream, int threadId, char const* name)
+    {
+        stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << threadId << R"(,"args":{"name":)";
+        writeEscaped(stream, name);
+        stream << "}}";
+    }
+}
+
+TimestepProfileBuffer::TimestepProfileBuffer(int capacity)
+    : _profiles(std::max(1, capacity))
+{}
+
+void TimestepProfileBuffer::add(TimestepProfile const& profile)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    //copy assignment reuses the memory of the stages of the overwritten profile
+    _profiles[_nextIndex] = profile;
+    _nextIndex = (_nextIndex + 1) % getCapacity();
+    _numProfiles = std::min(_numProfiles + 1, getCapacity());
+}
+
+std::vector<TimestepProfile> TimestepProfileBuffer::getProfiles() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<TimestepProfile> result;
+    result.reserve(_numProfiles);
+    auto index = (_nextIndex - _numProfiles + getCapacity()) % getCapacity();
+    for (int i = 0; i < _numProfiles; ++i) {
+        result.emplace_back(_profiles[index]);
+        index = (index + 1) % getCapacity();
+    }
+    return result;
+}
+
+void TimestepProfileBuffer::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _nextIndex = 0;
+    _numProfiles = 0;
+}
+
+std::vector<TimestepStageSummary> TimestepProfileHelper::calcStageSummaries(std::vector<TimestepProfile> const& profiles)
+{
+    std::vector<TimestepStageSummary> result;
+    if (profiles.empty()) {
+        return result;
+    }
+    std::vector<double> totalDurations;
+    std::unordered_map<std::string, int> indexByName;
+    double totalTimestepDuration = 0;
+    for (auto const& profile : profiles) {
+        totalTimestepDuration += profile.duration;
+        for (auto const& stage : profile.stages) {
+            auto [iter, inserted] = indexByName.emplace(stage.name, static_cast<int>(result.size()));
+            if (inserted) {
+                TimestepStageSummary summary;
+                summary.name = stage.name;
+                result.emplace_back(summary);
+                totalDurations.emplace_back(0.0);
+            }
+            auto& summary = result.at(iter->second);
+            summary.maxDuration = std::max(summary.maxDuration, stage.duration);
+            totalDurations.at(iter->second) += stage.duration;
+        }
+    }
+    for (int i = 0; i < toInt(result.size()); ++i) {
+        result[i].meanDuration = static_cast<float>(totalDurations[i] / profiles.size());
+        result[i].share = totalTimestepDuration > 0 ? static_cast<float>(totalDurations[i] / totalTimestepDuration) : 0.0f;
+    }
+    return result;
+}
+
+std::string TimestepProfileHelper::toChromeTrace(std::vector<TimestepProfile> const& profiles)
+{
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << R"({"displayTimeUnit":"ms","traceEvents":[)" << std::endl;
+    writeThreadName(stream, TimestepThreadId, "time steps");
+    stream << "," << std::endl;
+    writeThreadName(stream, StageThreadId, "stages");
+
+    //time stamps are relative to the first time step
+    auto origin = profiles.empty() ? 0.0 : profiles.front().startTime;
+    for (auto const& profile : profiles) {
+        auto startTime = profile.startTime - origin;
+        stream << "," << std::endl
+               << R"({"name":"time step","cat":"timestep","ph":"X","pid":1,"tid":)" << TimestepThreadId << R"(,"ts":)" << startTime << R"(,"dur":)"
+               << profile.duration << R"(,"args":{"timestep":)" << profile.timestep << "}}";
+        for (auto const& stage : profile.stages) {
+            stream << "," << std::endl << R"({"name":)";
+            writeEscaped(stream, stage.name);
+            stream << R"(,"cat":"stage","ph":"X","pid":1,"tid":)" << StageThreadId << R"(,"ts":)" << startTime + stage.startTime << R"(,"dur":)"
+                   << stage.duration << "}";
+        }
+        stream << "," << std::endl
+               << R"({"name":"entities","ph":"C","pid":1,"ts":)" << startTime << R"(,"args":{"cells":)" << profile.numCells << R"(,"particles":)"
+               << profile.numParticles << R"(,"tokens":)" << profile.numTokens << "}}";
+    }
+    stream << std::endl << "]}" << std::endl;
+    return stream.str();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct TimestepStage
+{
+    char const* name = nullptr;  //string literal, stages of different time steps are identified by their names
+    float startTime = 0;         //in microseconds relative to the start of the first stage
+    float duration = 0;          //in microseconds
+};
+
+struct TimestepProfile
+{
+    uint64_t timestep = 0;
+    double startTime = 0;  //in microseconds, only differences between profiles are meaningful
+    float duration = 0;    //in microseconds, wall time of the whole time step including synchronization
+    int numCells = 0;
+    int numParticles = 0;
+    int numTokens = 0;
+    std::vector<TimestepStage> stages;
+};
+
+struct TimestepStageSummary
+{
+    std::string name;
+    float meanDuration = 0;  //in microseconds per time step, time steps in which the stage was not executed count as 0
+    float maxDuration = 0;
+    float share = 0;  //fraction of the total duration of all time steps
+};
+
+/**
+ * Ring buffer for the profiles of the last time steps. It is written by the simulation thread and can be read from any thread.
+ */
+class TimestepProfileBuffer
+{
+public:
+    explicit TimestepProfileBuffer(int capacity = 1000);
+
+    void add(TimestepProfile const& profile);  //overwrites the oldest profile if the buffer is full
+    std::vector<TimestepProfile> getProfiles() const;  //oldest first
+    void clear();
+
+    int getCapacity() const { return static_cast<int>(_profiles.size()); }
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<TimestepProfile> _profiles;
+    int _nextIndex = 0;
+    int _numProfiles = 0;
+};
+
+class TimestepProfileHelper
+{
+public:
+    //stages are summarized by name in the order of their first occurrence
+    static std::vector<TimestepStageSummary> calcStageSummaries(std::vector<TimestepProfile> const& profiles);
+
+    //trace event format (JSON) which can be opened in chrome://tracing or Perfetto
+    static std::string toChromeTrace(std::vector<TimestepProfile> const& profiles);
+};
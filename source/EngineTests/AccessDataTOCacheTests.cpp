@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/AccessDataTOCache.h"
+
+class AccessDataTOCacheTests : public ::testing::Test
+{
+public:
+    AccessDataTOCacheTests() = default;
+    ~AccessDataTOCacheTests() = default;
+
+protected:
+    _AccessDataTOCache _cache{GpuSettings()};
+};
+
+TEST_F(AccessDataTOCacheTests, buffersAreReused)
+{
+    auto dataTO = _cache.getDataTO({100000, 1000, 10000});
+    EXPECT_EQ(0, *dataTO.numCells);
+    *dataTO.numCells = 5;
+    _cache.releaseDataTO(dataTO);
+    EXPECT_EQ(0, _cache.getStatistics().hits);
+    EXPECT_EQ(5, _cache.getStatistics().misses);
+    EXPECT_EQ(0, _cache.getStatistics().usedBytes);
+
+    //slightly grown sizes fall into the same size classes
+    auto grownDataTO = _cache.getDataTO({100500, 1010, 10050});
+    EXPECT_EQ(dataTO, grownDataTO);
+    EXPECT_EQ(0, *grownDataTO.numCells);
+    EXPECT_EQ(5, _cache.getStatistics().hits);
+    _cache.releaseDataTO(grownDataTO);
+}
+
+TEST_F(AccessDataTOCacheTests, smallRequestsObtainSmallBuffers)
+{
+    auto dataTO = _cache.getDataTO({1000000, 1000000, 1000000});
+    _cache.releaseDataTO(dataTO);
+
+    auto smallDataTO = _cache.getDataTO({20, 20, 0});
+    EXPECT_NE(dataTO.cells, smallDataTO.cells);
+    EXPECT_NE(dataTO.particles, smallDataTO.particles);
+    EXPECT_NE(dataTO.tokens, smallDataTO.tokens);
+    EXPECT_EQ(dataTO.stringBytes, smallDataTO.stringBytes);
+
+    auto largeDataTO = _cache.getDataTO({1000000, 1000000, 1000000});
+    EXPECT_EQ(dataTO.cells, largeDataTO.cells);
+    _cache.releaseDataTO(largeDataTO);
+    _cache.releaseDataTO(smallDataTO);
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/AutosaveHelper.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class AutosaveHelperTests : public IntegrationTestFramework
+{
+public:
+    AutosaveHelperTests()
+        : IntegrationTestFramework({1000, 1000})
+    {
+        _directory = std::filesystem::temp_directory_path() / ("alien_autosave_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(_directory);
+        _snapshotFilename = (_directory / "autosave-snapshot.bin").string();
+        _filename = (_directory / "autosave.sim").string();
+    }
+
+    ~AutosaveHelperTests() { std::filesystem::remove_all(_directory); }
+
+protected:
+    void createAndSaveSimulation(bool portable) const;
+    void loadSimulation() const;
+
+    //simulates a snapshot written by a version with a different layout of the cell access TO
+    void changeSnapshotLayout() const;
+
+    std::filesystem::path _directory;
+    std::string _snapshotFilename;
+    std::string _filename;
+};
+
+void AutosaveHelperTests::createAndSaveSimulation(bool portable) const
+{
+    _simController->setSimulationData(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).center({500, 500})));
+    ASSERT_TRUE(AutosaveHelper::save(_simController, _snapshotFilename, _filename, portable));
+}
+
+void AutosaveHelperTests::loadSimulation() const
+{
+    _simController->closeSimulation();
+    DeserializedSimulation data;
+    ASSERT_TRUE(AutosaveHelper::load(_simController, _snapshotFilename, _filename, data));
+    EXPECT_EQ(1000, data.settings.generalSettings.worldSizeX);
+}
+
+void AutosaveHelperTests::changeSnapshotLayout() const
+{
+    //the size of the cell access TO is stored after magic and version
+    std::fstream stream(_snapshotFilename, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekg(12);
+    uint32_t cellSize;
+    stream.read(reinterpret_cast<char*>(&cellSize), sizeof(cellSize));
+    cellSize += 8;
+    stream.seekp(12);
+    stream.write(reinterpret_cast<char const*>(&cellSize), sizeof(cellSize));
+}
+
+TEST_F(AutosaveHelperTests, loadSnapshot)
+{
+    createAndSaveSimulation(false);
+    EXPECT_FALSE(std::filesystem::exists(_filename));
+
+    loadSimulation();
+    EXPECT_EQ(100, _simController->getSimulationData().cells.size());
+}
+
+TEST_F(AutosaveHelperTests, snapshotWithDifferentLayout)
+{
+    createAndSaveSimulation(true);
+    changeSnapshotLayout();
+
+    loadSimulation();
+    EXPECT_EQ(100, _simController->getSimulationData().cells.size());
+}
+
+TEST_F(AutosaveHelperTests, outdatedSnapshotIgnored)
+{
+    createAndSaveSimulation(false);
+    _simController->setSimulationData(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(5).height(5).center({500, 500})));
+    DeserializedSimulation sim;
+    sim.timestep = _simController->getCurrentTimestep();
+    sim.settings = _simController->getSettings();
+    sim.symbolMap = _simController->getSymbolMap();
+    sim.content = _simController->getClusteredSimulationData();
+    ASSERT_TRUE(Serializer::serializeSimulationToFiles(_filename, sim));
+    std::filesystem::last_write_time(_filename, std::filesystem::last_write_time(_snapshotFilename) + std::chrono::seconds(1));
+
+    loadSimulation();
+    EXPECT_EQ(25, _simController->getSimulationData().cells.size());
+}
+
+TEST_F(AutosaveHelperTests, noAutosave)
+{
+    _simController->closeSimulation();
+    DeserializedSimulation data;
+    EXPECT_FALSE(AutosaveHelper::load(_simController, _snapshotFilename, _filename, data));
+
+    //the test framework closes the simulation
+    _simController->newSimulation(0, Settings(), SymbolMap());
+}
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/BulkDataDescription.h"
+#include "EngineInterface/DescriptionHelper.h"
+
+class BulkDataDescriptionTests : public ::testing::Test
+{
+public:
+    BulkDataDescriptionTests() = default;
+    ~BulkDataDescriptionTests() = default;
+
+protected:
+    //rects of 3x2 cells in a grid with given spacing
+    DataDescription createRects(int numRectsX, int numRectsY, float spacing) const;
+};
+
+DataDescription BulkDataDescriptionTests::createRects(int numRectsX, int numRectsY, float spacing) const
+{
+    DataDescription result;
+    for (int i = 0; i < numRectsX; ++i) {
+        for (int j = 0; j < numRectsY; ++j) {
+            result.add(DescriptionHelper::createRect(
+                DescriptionHelper::CreateRectParameters().width(3).height(2).center({toFloat(i) * spacing + 5.0f, toFloat(j) * spacing + 5.0f})));
+        }
+    }
+    return result;
+}
+
+TEST_F(BulkDataDescriptionTests, conversion)
+{
+    auto data = createRects(2, 2, 10.0f);
+    data.cells.front().metadata.setName("cell");
+    data.cells.front().addToken(TokenDescription().setEnergy(10).setData("token"));
+    data.addParticle(ParticleDescription().setId(1).setPos({1, 2}).setEnergy(5));
+
+    BulkDataDescription bulkData(data);
+    EXPECT_EQ(data.cells.size(), bulkData.cells.size());
+    EXPECT_EQ(1, bulkData.cells.getNumTokens());
+    EXPECT_EQ(1, bulkData.particles.size());
+
+    int numClusters = 0;
+    bulkData.calcClusterIndices(numClusters);
+    EXPECT_EQ(4, numClusters);
+
+    auto convertedData = bulkData.toDataDescription();
+    ASSERT_EQ(data.cells.size(), convertedData.cells.size());
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        auto const& cell = data.cells.at(i);
+        auto const& convertedCell = convertedData.cells.at(i);
+        EXPECT_EQ(cell.id, convertedCell.id);
+        EXPECT_EQ(cell.pos, convertedCell.pos);
+        EXPECT_EQ(cell.metadata, convertedCell.metadata);
+        EXPECT_EQ(cell.tokens.size(), convertedCell.tokens.size());
+        ASSERT_EQ(cell.connections.size(), convertedCell.connections.size());
+        for (int j = 0; j < toInt(cell.connections.size()); ++j) {
+            EXPECT_EQ(cell.connections.at(j).cellId, convertedCell.connections.at(j).cellId);
+        }
+    }
+}
+
+TEST_F(BulkDataDescriptionTests, duplicate)
+{
+    BulkDataDescription data(createRects(2, 2, 10.0f));
+    data.cells.names.front() = "cell";
+    DescriptionHelper::duplicate(data, {20, 20}, {40, 30});
+
+    //rects with center y >= 30 are not copied
+    EXPECT_EQ(6 * 4 * 3, data.cells.size());
+    int numClusters = 0;
+    auto clusterIndices = data.calcClusterIndices(numClusters);
+    EXPECT_EQ(4 * 3, numClusters);
+
+    std::unordered_set<uint64_t> ids(data.cells.ids.begin(), data.cells.ids.end());
+    EXPECT_EQ(data.cells.size(), ids.size());
+
+    int numNames = 0;
+    for (int i = 0; i < data.cells.size(); ++i) {
+        numNames += data.cells.names.at(i).empty() ? 0 : 1;
+        for (int j = data.cells.connectionOffsets.at(i); j < data.cells.connectionOffsets.at(i + 1); ++j) {
+            EXPECT_EQ(clusterIndices.at(i), clusterIndices.at(data.cells.connectionCellIndices.at(j)));
+        }
+    }
+    EXPECT_EQ(1, numNames);
+}
+
+TEST_F(BulkDataDescriptionTests, duplicateParticlesAndProgress)
+{
+    auto origData = createRects(1, 1, 10.0f);
+    origData.addParticle(ParticleDescription().setId(1).setPos({1, 1}));
+    origData.addParticle(ParticleDescription().setId(2).setPos({15, 1}));
+    BulkDataDescription data(origData);
+
+    std::vector<float> progresses;
+    DescriptionHelper::duplicate(data, {20, 20}, {50, 40}, [&](float progress) { progresses.emplace_back(progress); });
+
+    //3x2 tiles, particles at x = 55 are outside
+    EXPECT_EQ(6 * 6, data.cells.size());
+    EXPECT_EQ(2 * 4 + 2, data.particles.size());
+    EXPECT_EQ(1, data.particles.ids.at(0));
+    std::unordered_set<uint64_t> ids(data.particles.ids.begin(), data.particles.ids.end());
+    ids.insert(data.cells.ids.begin(), data.cells.ids.end());
+    EXPECT_EQ(data.cells.size() + data.particles.size(), ids.size());
+
+    ASSERT_EQ(6, progresses.size());
+    EXPECT_TRUE(std::is_sorted(progresses.begin(), progresses.end()));
+    EXPECT_EQ(1.0f, progresses.back());
+}
+
+TEST_F(BulkDataDescriptionTests, correctConnections)
+{
+    BulkDataDescription data(createRects(1, 1, 10.0f));
+    auto numConnections = data.cells.getNumConnections();
+
+    //moving one cell far away breaks its connections
+    data.cells.positions.front() = {100.0f, 100.0f};
+    DescriptionHelper::correctConnections(data, {60, 60});
+
+    EXPECT_EQ(0, data.cells.connectionOffsets.at(1));
+    EXPECT_EQ(numConnections - 4, data.cells.getNumConnections());
+    for (auto const& connectedCellIndex : data.cells.connectionCellIndices) {
+        EXPECT_NE(0, connectedCellIndex);
+    }
+}
+
+TEST_F(BulkDataDescriptionTests, colorize)
+{
+    BulkDataDescription data(createRects(10, 10, 10.0f));
+    DescriptionHelper::colorize(data, {1, 2, 3});
+
+    int numClusters = 0;
+    auto clusterIndices = data.calcClusterIndices(numClusters);
+    std::vector<int> clusterColors(numClusters, -1);
+    for (int i = 0; i < data.cells.size(); ++i) {
+        auto color = data.cells.colors.at(i);
+        EXPECT_TRUE(color >= 1 && color <= 3);
+        auto& clusterColor = clusterColors.at(clusterIndices.at(i));
+        if (clusterColor == -1) {
+            clusterColor = color;
+        }
+        EXPECT_EQ(clusterColor, color);
+    }
+}
+
+TEST_F(BulkDataDescriptionTests, DISABLED_benchmark)
+{
+    //about one million cells after duplication
+    BulkDataDescription data(createRects(200, 200, 4.9f));
+    auto startTimepoint = std::chrono::steady_clock::now();
+    DescriptionHelper::correctConnections(data, {2000, 2000});
+    DescriptionHelper::duplicate(data, {1000, 1000}, {2000, 2000});
+    DescriptionHelper::colorize(data, {0, 1, 2});
+    data.shift({1.0f, 1.0f});
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(4 * 6 * 200 * 200, data.cells.size());
+    std::cout << data.cells.size() << " cells processed in " << duration.count() << "ms" << std::endl;
+}
@@ -0,0 +1,207 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/CellComputationCompiler.h"
+#include "EngineInterface/DescriptionHelper.h"
+
+class CellComputationCompilerTests : public ::testing::Test
+{
+public:
+    CellComputationCompilerTests() = default;
+    ~CellComputationCompilerTests() = default;
+
+protected:
+    void SetUp() override { CellComputationCompiler::clearCache(); }
+
+    //computation cells with numPrograms different programs
+    DataDescription createComputationCells(int numCells, int numPrograms) const;
+    std::string createProgram(int index) const;
+
+    //symbol map with some hundred entries
+    SymbolMap createLargeSymbolMap() const;
+
+    SymbolMap _symbols = SymbolMapHelper::getDefaultSymbolMap();
+    SymbolTable _symbolTable = SymbolTable(_symbols);
+    SimulationParameters _parameters;
+};
+
+DataDescription CellComputationCompilerTests::createComputationCells(int numCells, int numPrograms) const
+{
+    auto result = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(numCells).height(1));
+    for (int i = 0; i < numCells; ++i) {
+        auto& cell = result.cells.at(i);
+        cell.cellFeature.setType(Enums::CellFunction_Computation);
+        cell.metadata.setSourceCode(createProgram(i % numPrograms));
+    }
+    return result;
+}
+
+SymbolMap CellComputationCompilerTests::createLargeSymbolMap() const
+{
+    auto result = _symbols;
+    for (int i = 0; i < 500; ++i) {
+        result.emplace("VAR_" + std::to_string(i), "[" + std::to_string(i % 256) + "]");
+        result.emplace("CONST_" + std::to_string(i), std::to_string(i % 256));
+    }
+    return result;
+}
+
+std::string CellComputationCompilerTests::createProgram(int index) const
+{
+    return "mov i, " + std::to_string(index % 256) + "\nif i > 3\nadd [2], BRANCH_NUMBER\nelse\nmov [[1]], j\nendif\nmov [" + std::to_string(index / 256)
+        + "], 7";
+}
+
+TEST_F(CellComputationCompilerTests, cachedCompilation)
+{
+    auto program = createProgram(1);
+    auto result1 = CellComputationCompiler::compileSourceCode(program, _symbolTable, _parameters);
+    auto result2 = CellComputationCompiler::compileSourceCode(program, _symbols, _parameters);
+    ASSERT_TRUE(result1.compilationOk);
+    EXPECT_EQ(result1.compilation, result2.compilation);
+
+    //changed symbols and parameters are taken into account
+    auto symbols = _symbols;
+    symbols["i"] = "[100]";
+    auto result3 = CellComputationCompiler::compileSourceCode(program, symbols, _parameters);
+    ASSERT_TRUE(result3.compilationOk);
+    EXPECT_NE(result1.compilation, result3.compilation);
+
+    auto parameters = _parameters;
+    parameters.cellFunctionComputerMaxInstructions = 2;
+    EXPECT_FALSE(CellComputationCompiler::compileSourceCode(program, _symbols, parameters).compilationOk);
+    EXPECT_TRUE(CellComputationCompiler::compileSourceCode(program, _symbols, _parameters).compilationOk);
+
+    auto text = CellComputationCompiler::decompileSourceCode(result1.compilation, _symbols, _parameters);
+    EXPECT_EQ(text, CellComputationCompiler::decompileSourceCode(result1.compilation, _symbols, _parameters));
+    EXPECT_EQ(result1.compilation, CellComputationCompiler::compileSourceCode(text, _symbols, _parameters).compilation);
+}
+
+TEST_F(CellComputationCompilerTests, symbolTable)
+{
+    auto symbols = createLargeSymbolMap();
+    SymbolTable symbolTable(symbols);
+    EXPECT_EQ(symbols.size(), symbolTable.size());
+    for (auto const& [key, value] : symbols) {
+        auto findResult = symbolTable.find(key);
+        ASSERT_TRUE(findResult.has_value());
+        EXPECT_EQ(value, *findResult);
+    }
+    EXPECT_FALSE(symbolTable.find("VAR_").has_value());
+    EXPECT_FALSE(symbolTable.find("").has_value());
+    EXPECT_FALSE(SymbolTable().find("i").has_value());
+
+    EXPECT_EQ(SymbolTable(symbols).getHash(), symbolTable.getHash());
+    symbols["i"] = "[1]";
+    EXPECT_NE(SymbolTable(symbols).getHash(), symbolTable.getHash());
+}
+
+TEST_F(CellComputationCompilerTests, compileSourceCodes)
+{
+    auto data = createComputationCells(100, 10);
+    data.cells.at(0).metadata.setSourceCode("mov [1],");
+    data.cells.at(1).cellFeature.setType(Enums::CellFunction_Scanner);
+
+    EXPECT_EQ(1, CellComputationCompiler::compileSourceCodes(data, _symbolTable, _parameters));
+    EXPECT_TRUE(data.cells.at(0).cellFeature.constData.empty());
+    EXPECT_TRUE(data.cells.at(1).cellFeature.constData.empty());
+    for (int i = 2; i < 100; ++i) {
+        auto const& cell = data.cells.at(i);
+        EXPECT_EQ(CellComputationCompiler::compileSourceCode(createProgram(i % 10), _symbols, _parameters).compilation, cell.cellFeature.constData.str());
+    }
+}
+
+TEST_F(CellComputationCompilerTests, decompileSourceCodes)
+{
+    auto data = createComputationCells(100, 10);
+    CellComputationCompiler::compileSourceCodes(data, _symbolTable, _parameters);
+    auto compiledData = data;
+    for (auto& cell : data.cells) {
+        cell.metadata.computerSourcecode.clear();
+    }
+    data.cells.at(0).metadata.setSourceCode("mov [1], 1");
+
+    CellComputationCompiler::decompileSourceCodes(data, _symbols, _parameters);
+    EXPECT_EQ(std::string("mov [1], 1"), data.cells.at(0).metadata.computerSourcecode.str());
+    for (int i = 1; i < 100; ++i) {
+        auto const& sourceCode = data.cells.at(i).metadata.computerSourcecode.str();
+        EXPECT_FALSE(sourceCode.empty());
+        EXPECT_EQ(compiledData.cells.at(i).cellFeature.constData.str(), CellComputationCompiler::compileSourceCode(sourceCode, _symbols, _parameters).compilation);
+    }
+}
+
+TEST_F(CellComputationCompilerTests, DISABLED_benchmark)
+{
+    //many cells sharing few programs as found in typical patterns
+    auto data = createComputationCells(100000, 500);
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    for (auto& cell : data.cells) {
+        auto result = CellComputationCompiler::compileSourceCode(cell.metadata.computerSourcecode, _symbolTable, _parameters);
+        cell.cellFeature.constData = result.compilation;
+    }
+    auto cachedDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+    CellComputationCompiler::clearCache();
+    startTimepoint = std::chrono::steady_clock::now();
+    EXPECT_EQ(0, CellComputationCompiler::compileSourceCodes(data, _symbolTable, _parameters));
+    CellComputationCompiler::decompileSourceCodes(data, _symbols, _parameters);
+    auto batchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+    std::cout << data.cells.size() << " cells compiled one by one with cache in " << cachedDuration.count() << "ms, compiled in batch in "
+              << batchDuration.count() << "ms" << std::endl;
+}
+
+TEST_F(CellComputationCompilerTests, DISABLED_compileThroughput)
+{
+    auto symbols = createLargeSymbolMap();
+    SymbolTable symbolTable(symbols);
+    std::vector<std::string> programs;
+    for (int i = 0; i < 20000; ++i) {
+        programs.emplace_back(
+            "mov VAR_" + std::to_string(i % 500) + ", CONST_" + std::to_string(i % 499) + "\nif [[CONST_" + std::to_string(i % 7)
+            + "]] > ENERGY_GUIDANCE_IN::BALANCE_CELL\nadd i, (CONST_" + std::to_string(i % 8) + ")\nelse\nmov [j], VAR_" + std::to_string(i % 13)
+            + "\nendif\nxor BRANCH_NUMBER, " + std::to_string(i));
+    }
+
+    //compilations are not found in the cache because all programs are different
+    auto startTimepoint = std::chrono::steady_clock::now();
+    for (auto const& program : programs) {
+        ASSERT_TRUE(CellComputationCompiler::compileSourceCode(program, symbolTable, _parameters).compilationOk);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+    //symbol lookups before (SymbolMap) and after (SymbolTable) the introduction of the frozen table, including missing symbols
+    std::vector<std::string> tokens;
+    for (auto const& [key, value] : symbols) {
+        tokens.emplace_back(key);
+        tokens.emplace_back(value);
+    }
+    int const NumLookupRounds = 1000;
+    size_t mapChecksum = 0;
+    startTimepoint = std::chrono::steady_clock::now();
+    for (int i = 0; i < NumLookupRounds; ++i) {
+        for (auto const& token : tokens) {
+            auto findResult = symbols.find(token);
+            mapChecksum += findResult != symbols.end() ? findResult->second.size() : 1;
+        }
+    }
+    auto mapDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+    size_t tableChecksum = 0;
+    startTimepoint = std::chrono::steady_clock::now();
+    for (int i = 0; i < NumLookupRounds; ++i) {
+        for (auto const& token : tokens) {
+            auto findResult = symbolTable.find(token);
+            tableChecksum += findResult ? findResult->size() : 1;
+        }
+    }
+    auto tableDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(mapChecksum, tableChecksum);
+
+    std::cout << programs.size() << " programs with " << symbols.size() << " symbols compiled in " << duration.count() << "ms" << std::endl
+              << tokens.size() * NumLookupRounds << " symbol lookups: SymbolMap " << mapDuration.count() << "ms, SymbolTable " << tableDuration.count()
+              << "ms" << std::endl;
+}
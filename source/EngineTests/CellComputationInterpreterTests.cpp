@@ -0,0 +1,143 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "Base/RandomStream.h"
+#include "EngineInterface/CellComputationCompiler.h"
+#include "EngineInterface/CellComputationExecutor.h"
+#include "EngineInterface/CellComputationInterpreter.h"
+
+class CellComputationInterpreterTests : public ::testing::Test
+{
+public:
+    CellComputationInterpreterTests() = default;
+    ~CellComputationInterpreterTests() = default;
+
+protected:
+    //random machine code, memories and program assignments as produced by mutations
+    struct Batch
+    {
+        std::vector<std::string> programs;
+        std::vector<int> programIndices;
+        std::vector<std::string> tokenMemories;
+        std::vector<std::string> cellMemories;
+    };
+    Batch createRandomBatch(int numPrograms, int numRuns, bool indirectAddressing = true) const;
+    std::string createRandomBytes(RandomStream& randomStream, int size) const;
+
+    SimulationParameters _parameters;
+};
+
+CellComputationInterpreterTests::Batch CellComputationInterpreterTests::createRandomBatch(int numPrograms, int numRuns, bool indirectAddressing) const
+{
+    RandomStream randomStream(42);
+    Batch result;
+    for (int i = 0; i < numPrograms; ++i) {
+        auto program = createRandomBytes(randomStream, _parameters.cellFunctionComputerMaxInstructions * 3);
+        if (!indirectAddressing) {
+            for (int j = 0; j < toInt(program.size()); j += 3) {
+                auto& opCode = program[j];
+                if (((opCode >> 2) & 0x3) % 3 == Enums::ComputationOpType_MemMem) {
+                    opCode &= ~0xc;
+                }
+                if ((opCode & 0x3) == Enums::ComputationOpType_MemMem) {
+                    opCode &= ~0x3;
+                }
+            }
+        }
+        result.programs.emplace_back(program);
+    }
+    //each program is run on consecutive memories as in offline evaluations
+    for (int i = 0; i < numRuns; ++i) {
+        result.programIndices.emplace_back(i * numPrograms / numRuns);
+        result.tokenMemories.emplace_back(createRandomBytes(randomStream, _parameters.tokenMemorySize));
+        result.cellMemories.emplace_back(createRandomBytes(randomStream, _parameters.cellFunctionComputerCellMemorySize));
+    }
+    return result;
+}
+
+std::string CellComputationInterpreterTests::createRandomBytes(RandomStream& randomStream, int size) const
+{
+    std::string result(size, 0);
+    for (auto& byte : result) {
+        byte = static_cast<char>(randomStream.getRandomInt(256));
+    }
+    return result;
+}
+
+namespace
+{
+    //mov [1], 3; add [1], 4
+    constexpr int8_t calcAtCompileTime()
+    {
+        std::array<char, 6> program = {0x03, 1, 3, 0x13, 1, 4};
+        std::array<char, 256> tokenMemory = {};
+        std::array<char, 8> cellMemory = {};
+        CellComputationExecutor::execute<48>(program.data(), 6, tokenMemory.data(), 256, cellMemory.data(), 8);
+        return tokenMemory[1];
+    }
+    static_assert(calcAtCompileTime() == 7);
+}
+
+TEST_F(CellComputationInterpreterTests, run)
+{
+    SymbolMap symbols;
+    auto program = CellComputationCompiler::compileSourceCode(
+        "mov [1], 3\nif [1] > 2\nmov [2], 5\nmov [[3]], 1\nelse\nmov [2], 6\nendif\nmov [4], [2]\nmul [4], 2\ndiv [4], 0\nmov (1), 9\nsub (1), [1]",
+        symbols,
+        _parameters);
+    ASSERT_TRUE(program.compilationOk);
+
+    std::string tokenMemory;
+    std::string cellMemory;
+    CellComputationInterpreter::run(program.compilation, tokenMemory, cellMemory, _parameters);
+    EXPECT_EQ(_parameters.tokenMemorySize, tokenMemory.size());
+    EXPECT_EQ(3, tokenMemory[1]);
+    EXPECT_EQ(5, tokenMemory[2]);
+    EXPECT_EQ(0, tokenMemory[4]);
+    EXPECT_EQ(1, tokenMemory[0]);
+    EXPECT_EQ(6, cellMemory[1]);
+}
+
+TEST_F(CellComputationInterpreterTests, batchMatchesSingleRuns)
+{
+    for (auto indirectAddressing : {true, false}) {
+        auto batch = createRandomBatch(20, 1000, indirectAddressing);
+        auto expectedTokenMemories = batch.tokenMemories;
+        auto expectedCellMemories = batch.cellMemories;
+        for (int i = 0; i < 1000; ++i) {
+            CellComputationInterpreter::run(
+                batch.programs.at(batch.programIndices.at(i)), expectedTokenMemories.at(i), expectedCellMemories.at(i), _parameters);
+        }
+
+        CellComputationInterpreter::runBatch(batch.programs, batch.programIndices, batch.tokenMemories, batch.cellMemories, _parameters);
+        EXPECT_EQ(expectedTokenMemories, batch.tokenMemories);
+        EXPECT_EQ(expectedCellMemories, batch.cellMemories);
+    }
+}
+
+TEST_F(CellComputationInterpreterTests, DISABLED_benchmark)
+{
+    int const NumRuns = 1000000;
+    for (auto indirectAddressing : {true, false}) {
+        auto batch = createRandomBatch(1000, NumRuns, indirectAddressing);
+        auto tokenMemories = batch.tokenMemories;
+        auto cellMemories = batch.cellMemories;
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumRuns; ++i) {
+            CellComputationInterpreter::run(batch.programs[batch.programIndices[i]], tokenMemories[i], cellMemories[i], _parameters);
+        }
+        auto singleDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+        startTimepoint = std::chrono::steady_clock::now();
+        CellComputationInterpreter::runBatch(batch.programs, batch.programIndices, batch.tokenMemories, batch.cellMemories, _parameters);
+        auto batchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+        EXPECT_EQ(tokenMemories, batch.tokenMemories);
+        std::cout << NumRuns << " program runs" << (indirectAddressing ? " with" : " without") << " indirect addressing: single runs in "
+                  << singleDuration.count() << "ms, batch in " << batchDuration.count() << "ms" << std::endl;
+    }
+}
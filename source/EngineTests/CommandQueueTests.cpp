@@ -0,0 +1,186 @@
+#include <iostream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/CommandQueue.h"
+
+class CommandQueueTests : public ::testing::Test
+{
+public:
+    CommandQueueTests() = default;
+    ~CommandQueueTests() = default;
+
+protected:
+    //emulates the simulation thread: time steps of given duration, commands are processed in between
+    void startConsumer(std::chrono::microseconds const& timestepDuration);
+    void stopConsumer();
+
+    void printLatencies(std::string const& name, LatencyHistogramData const& data) const;
+
+    CommandQueue _queue;
+    std::atomic<bool> _isShutdown{false};
+    std::thread _consumer;
+};
+
+void CommandQueueTests::startConsumer(std::chrono::microseconds const& timestepDuration)
+{
+    _consumer = std::thread([this, timestepDuration] {
+        while (!_isShutdown.load()) {
+            auto timestepEnd = std::chrono::steady_clock::now() + timestepDuration;
+            while (std::chrono::steady_clock::now() < timestepEnd) {
+            }
+            _queue.processCommands();
+        }
+    });
+}
+
+void CommandQueueTests::stopConsumer()
+{
+    _isShutdown = true;
+    _consumer.join();
+}
+
+void CommandQueueTests::printLatencies(std::string const& name, LatencyHistogramData const& data) const
+{
+    std::cout << name << ": " << data.numSamples << " samples, mean " << data.meanMicroseconds << "us, p50 " << data.getPercentileMicroseconds(50)
+              << "us, p99 " << data.getPercentileMicroseconds(99) << "us, max " << data.maxMicroseconds << "us" << std::endl;
+}
+
+TEST_F(CommandQueueTests, postedCommandsAreExecutedInOrder)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 100; ++i) {
+        _queue.post([&values, i] { values.emplace_back(i); });
+    }
+    EXPECT_EQ(100, _queue.processCommands());
+    EXPECT_EQ(0, _queue.processCommands());
+
+    ASSERT_EQ(100, values.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, values.at(i));
+    }
+    EXPECT_EQ(100, _queue.getQueueingLatencies().numSamples);
+}
+
+TEST_F(CommandQueueTests, execute)
+{
+    startConsumer(std::chrono::microseconds(100));
+
+    auto consumerId = _consumer.get_id();
+    std::thread::id executionId;
+    EXPECT_TRUE(_queue.execute([&] { executionId = std::this_thread::get_id(); }, std::chrono::seconds(5)));
+    EXPECT_EQ(consumerId, executionId);
+
+    EXPECT_THROW(_queue.execute([] { throw std::runtime_error("error"); }, std::chrono::seconds(5)), std::runtime_error);
+
+    bool isBlocked = false;
+    EXPECT_TRUE(_queue.executeExclusively([&] { isBlocked = _queue.getQueueingLatencies().numSamples > 0; }, std::chrono::seconds(5)));
+    EXPECT_TRUE(isBlocked);
+
+    stopConsumer();
+    EXPECT_EQ(3, _queue.getRoundTripLatencies().numSamples);
+}
+
+TEST_F(CommandQueueTests, timeout)
+{
+    bool isExecuted = false;
+    EXPECT_FALSE(_queue.execute([&] { isExecuted = true; }, std::chrono::milliseconds(1)));
+    EXPECT_FALSE(_queue.executeExclusively([&] { isExecuted = true; }, std::chrono::milliseconds(1)));
+
+    //cancelled commands are skipped
+    _queue.processCommands();
+    EXPECT_FALSE(isExecuted);
+}
+
+TEST_F(CommandQueueTests, multipleProducers)
+{
+    startConsumer(std::chrono::microseconds(10));
+
+    int counter = 0;  //only accessed by the consumer thread
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j) {
+                if (j % 2 == 0) {
+                    _queue.post([&] { ++counter; });
+                } else {
+                    _queue.execute([&] { ++counter; }, std::chrono::seconds(5));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    int result = 0;
+    _queue.execute([&] { result = counter; }, std::chrono::seconds(5));
+    stopConsumer();
+
+    EXPECT_EQ(4000, result);
+}
+
+namespace
+{
+    //access handshake formerly used by the engine worker
+    struct AccessHandshake
+    {
+        std::atomic<int> accessState{0};  //0 = consumer has access, 1 = access required, 2 = access granted
+
+        void requireAccess()
+        {
+            accessState = 1;
+            while (accessState == 1) {
+            }
+        }
+        void releaseAccess() { accessState = 0; }
+        void allowAccess()
+        {
+            if (accessState == 1) {
+                accessState = 2;
+            }
+        }
+    };
+}
+
+TEST_F(CommandQueueTests, DISABLED_benchmark)
+{
+    auto const timestepDuration = std::chrono::microseconds(2000);
+    int const numRequests = 200;
+
+    //old handshake
+    {
+        AccessHandshake handshake;
+        std::atomic<bool> isShutdown{false};
+        std::thread consumer([&] {
+            while (!isShutdown.load()) {
+                if (handshake.accessState == 0) {
+                    auto timestepEnd = std::chrono::steady_clock::now() + timestepDuration;
+                    while (std::chrono::steady_clock::now() < timestepEnd) {
+                    }
+                }
+                handshake.allowAccess();
+            }
+        });
+        LatencyHistogram latencies;
+        for (int i = 0; i < numRequests; ++i) {
+            auto startTimepoint = std::chrono::steady_clock::now();
+            handshake.requireAccess();
+            handshake.releaseAccess();
+            latencies.record(std::chrono::steady_clock::now() - startTimepoint);
+            std::this_thread::sleep_for(std::chrono::microseconds(300));
+        }
+        isShutdown = true;
+        consumer.join();
+        printLatencies("access handshake", latencies.getData());
+    }
+
+    //command queue
+    startConsumer(timestepDuration);
+    for (int i = 0; i < numRequests; ++i) {
+        _queue.execute([] {}, std::chrono::seconds(5));
+        std::this_thread::sleep_for(std::chrono::microseconds(300));
+    }
+    stopConsumer();
+    printLatencies("command queue", _queue.getRoundTripLatencies());
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "Base/InternedString.h"
+#include "Base/OutOfLineVector.h"
+#include "EngineInterface/DescriptionHelper.h"
+
+class CompactDescriptionsTests : public ::testing::Test
+{
+public:
+    CompactDescriptionsTests() = default;
+    ~CompactDescriptionsTests() = default;
+};
+
+TEST_F(CompactDescriptionsTests, internedStringsShareValues)
+{
+    auto numInternedValues = InternedString::getNumInternedValues();
+    {
+        InternedString string1(std::string("interned value"));
+        InternedString string2("interned value");
+        InternedString string3("other value");
+        EXPECT_EQ(string1, string2);
+        EXPECT_EQ(&string1.str(), &string2.str());
+        EXPECT_NE(string1, string3);
+        EXPECT_EQ(std::string("interned value"), string1.str());
+        EXPECT_EQ(numInternedValues + 2, InternedString::getNumInternedValues());
+    }
+    EXPECT_EQ(numInternedValues, InternedString::getNumInternedValues());
+}
+
+TEST_F(CompactDescriptionsTests, internedStringsEmpty)
+{
+    InternedString string1;
+    InternedString string2("");
+    EXPECT_TRUE(string1.empty());
+    EXPECT_EQ(string1, string2);
+    EXPECT_EQ(0, string2.size());
+
+    string1 = std::string("\0\1\2", 3);
+    EXPECT_EQ(3, string1.size());
+    string1.clear();
+    EXPECT_EQ(string1, string2);
+}
+
+TEST_F(CompactDescriptionsTests, outOfLineVector)
+{
+    OutOfLineVector<int> values;
+    EXPECT_TRUE(values.empty());
+    EXPECT_EQ(values.begin(), values.end());
+    EXPECT_THROW(values.at(0), std::out_of_range);
+
+    values.push_back(1);
+    values.emplace_back(3);
+    values.insert(values.begin() + 1, 2);
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), values.toVector());
+
+    auto copy = values;
+    copy.erase(copy.begin());
+    EXPECT_EQ((std::vector<int>{2, 3}), copy.toVector());
+    EXPECT_EQ(3, values.size());
+    EXPECT_NE(values, copy);
+
+    copy.clear();
+    EXPECT_EQ(OutOfLineVector<int>(), copy);
+}
+
+TEST_F(CompactDescriptionsTests, DISABLED_benchmark)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(1000).height(1000));
+    for (auto& cell : data.cells) {
+        cell.metadata.name = "cell";
+    }
+    std::cout << "sizeof(CellDescription) = " << sizeof(CellDescription) << " bytes" << std::endl;
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    auto copy = data;
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(data.cells.size(), copy.cells.size());
+    std::cout << copy.cells.size() << " cells copied in " << duration.count() << "ms" << std::endl;
+}
@@ -0,0 +1,130 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "Base/BlockCompression.h"
+#include "Base/ThreadPool.h"
+
+class CompressionTests : public ::testing::Test
+{
+public:
+    CompressionTests() = default;
+    ~CompressionTests() = default;
+
+protected:
+    //mixture of repeating patterns and noise resembling serialized simulation content
+    std::string createTestData(size_t size) const;
+
+    //single gzip stream as written by zstr
+    std::string compressSequentially(std::string const& data) const;
+    std::string decompressSequentially(std::string const& data, size_t size) const;
+
+    template <typename Func>
+    double measureSeconds(Func const& func) const
+    {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimepoint).count();
+    }
+};
+
+std::string CompressionTests::createTestData(size_t size) const
+{
+    std::mt19937 randomEngine(0);
+    std::string result(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        result[i] = randomEngine() % 4 == 0 ? static_cast<char>(randomEngine()) : static_cast<char>('a' + i % 13);
+    }
+    return result;
+}
+
+std::string CompressionTests::compressSequentially(std::string const& data) const
+{
+    z_stream stream = {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string result(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+    deflate(&stream, Z_FINISH);
+    result.resize(result.size() - stream.avail_out);
+    deflateEnd(&stream);
+    return result;
+}
+
+std::string CompressionTests::decompressSequentially(std::string const& data, size_t size) const
+{
+    z_stream stream = {};
+    inflateInit2(&stream, MAX_WBITS + 32);
+    std::string result(size, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+    auto inflateResult = inflate(&stream, Z_FINISH);
+    result.resize(result.size() - stream.avail_out);
+    inflateEnd(&stream);
+    return inflateResult == Z_STREAM_END ? result : std::string();
+}
+
+TEST_F(CompressionTests, zlib_roundTrip)
+{
+    for (auto size : {0, 1, 1000, BlockCompression::DefaultBlockSize, BlockCompression::DefaultBlockSize * 3 + 17}) {
+        auto data = createTestData(size);
+        auto compressedData = BlockCompression::compress(data, CompressionCodec::Zlib, 1 << 16);
+        EXPECT_EQ(data, BlockCompression::decompress(compressedData));
+    }
+}
+
+TEST_F(CompressionTests, zlib_readableAsStandardGzip)
+{
+    auto data = createTestData(BlockCompression::DefaultBlockSize * 2 + 5);
+    auto compressedData = BlockCompression::compress(data);
+    EXPECT_EQ(data, decompressSequentially(compressedData, data.size()));
+}
+
+TEST_F(CompressionTests, zlib_decompressStandardGzip)
+{
+    auto data = createTestData(100000);
+    EXPECT_EQ(data, BlockCompression::decompress(compressSequentially(data)));
+}
+
+TEST_F(CompressionTests, zstd_roundTrip)
+{
+    if (!BlockCompression::isCodecAvailable(CompressionCodec::Zstd)) {
+        GTEST_SKIP();
+    }
+    for (auto size : {0, 1000, BlockCompression::DefaultBlockSize * 3 + 17}) {
+        auto data = createTestData(size);
+        auto compressedData = BlockCompression::compress(data, CompressionCodec::Zstd, 1 << 16);
+        EXPECT_EQ(data, BlockCompression::decompress(compressedData));
+    }
+}
+
+TEST_F(CompressionTests, DISABLED_benchmark)
+{
+    auto data = createTestData(64 << 20);
+
+    std::string compressedData;
+    auto sequentialCompressTime = measureSeconds([&] { compressedData = compressSequentially(data); });
+    auto sequentialDecompressTime = measureSeconds([&] { decompressSequentially(compressedData, data.size()); });
+    std::cout << "threads: " << ThreadPool::getInstance().getNumThreads() << std::endl;
+    std::cout << "single stream zlib: compress " << sequentialCompressTime << "s, decompress " << sequentialDecompressTime << "s, size "
+              << compressedData.size() << std::endl;
+
+    for (auto codec : {CompressionCodec::Zlib, CompressionCodec::Zstd}) {
+        if (!BlockCompression::isCodecAvailable(codec)) {
+            continue;
+        }
+        std::string decompressedData;
+        auto compressTime = measureSeconds([&] { compressedData = BlockCompression::compress(data, codec); });
+        auto decompressTime = measureSeconds([&] { decompressedData = BlockCompression::decompress(compressedData); });
+        std::cout << (codec == CompressionCodec::Zlib ? "block zlib" : "block zstd") << ": compress " << compressTime << "s, decompress "
+                  << decompressTime << "s, size " << compressedData.size() << std::endl;
+        EXPECT_EQ(data.size(), decompressedData.size());
+    }
+}
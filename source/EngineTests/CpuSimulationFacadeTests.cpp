@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "IntegrationTestFramework.h"
+
+class CpuSimulationFacadeTests : public IntegrationTestFramework
+{
+public:
+    CpuSimulationFacadeTests()
+        : IntegrationTestFramework({1000, 1000}, SimulationBackend::Cpu)
+    {}
+
+    ~CpuSimulationFacadeTests() = default;
+
+protected:
+    bool isInsideWorld(RealVector2D const& pos) const { return pos.x >= 0 && pos.x < 1000.0f && pos.y >= 0 && pos.y < 1000.0f; }
+};
+
+TEST_F(CpuSimulationFacadeTests, particleMovement)
+{
+    DataDescription data;
+    data.addParticles({ParticleDescription().setId(1).setPos({100, 100}).setVel({0.5f, -0.25f}).setEnergy(10)});
+    data.addParticles({ParticleDescription().setId(2).setPos({999.5f, 0.5f}).setVel({1.0f, -1.0f}).setEnergy(10)});
+    _simController->setSimulationData(data);
+
+    auto timestepSize = _simController->getSimulationParameters().timestepSize;
+    _simController->calcSingleTimestep();
+    EXPECT_EQ(1, _simController->getCurrentTimestep());
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(2, actualData.particles.size());
+    for (auto const& particle : actualData.particles) {
+        EXPECT_TRUE(isInsideWorld(particle.pos));
+        if (particle.id == 1) {
+            EXPECT_NEAR(100.0f + 0.5f * timestepSize, particle.pos.x, 0.01f);
+            EXPECT_NEAR(100.0f - 0.25f * timestepSize, particle.pos.y, 0.01f);
+        }
+    }
+}
+
+TEST_F(CpuSimulationFacadeTests, timestepWithCells)
+{
+    _simController->setSimulationData(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).center({500, 500})));
+
+    for (int i = 0; i < 100; ++i) {
+        _simController->calcSingleTimestep();
+    }
+    EXPECT_EQ(100, _simController->getCurrentTimestep());
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(100, actualData.cells.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_TRUE(isInsideWorld(cell.pos));
+        EXPECT_FALSE(cell.connections.empty());
+    }
+}
+
+TEST_F(CpuSimulationFacadeTests, dataRoundtrip)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(3).height(2).energy(50).color(3).center({100, 200}));
+    data.cells.at(0).setVel({0.1f, 0.2f});
+    data.cells.at(1).addToken(createSimpleToken());
+    data.cells.at(2).metadata.name = "cell name";
+    data.cells.at(2).metadata.description = "cell description";
+    data.addParticles({ParticleDescription().setId(1000).setPos({300, 400}).setEnergy(20)});
+    _simController->setSimulationData(data);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(data.cells.size(), actualData.cells.size());
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_EQ(1000, actualData.particles.front().id);
+
+    auto actualCellById = getCellById(actualData);
+    for (auto const& cell : data.cells) {
+        auto const& actualCell = actualCellById.at(cell.id);
+        EXPECT_NEAR(cell.pos.x, actualCell.pos.x, 0.01f);
+        EXPECT_NEAR(cell.pos.y, actualCell.pos.y, 0.01f);
+        EXPECT_NEAR(cell.vel.x, actualCell.vel.x, 0.01f);
+        EXPECT_NEAR(cell.vel.y, actualCell.vel.y, 0.01f);
+        EXPECT_NEAR(cell.energy, actualCell.energy, 0.01);
+        EXPECT_TRUE(cell.metadata == actualCell.metadata);
+        EXPECT_EQ(cell.connections.size(), actualCell.connections.size());
+        EXPECT_EQ(cell.tokens.size(), actualCell.tokens.size());
+    }
+}
+
+TEST_F(CpuSimulationFacadeTests, shiftSelectionAcrossBorder)
+{
+    _simController->setSimulationData(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(4).height(4).center({10, 10})));
+    _simController->setSelection({0, 0}, {20, 20});
+
+    ShallowUpdateSelectionData updateData;
+    updateData.posDeltaX = -30;
+    updateData.posDeltaY = -25;
+    _simController->shallowUpdateSelectedEntities(updateData);
+
+    auto actualData = _simController->getSimulationData();
+    ASSERT_EQ(16, actualData.cells.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_TRUE(isInsideWorld(cell.pos));
+        EXPECT_GT(cell.pos.x, 900.0f);
+        EXPECT_GT(cell.pos.y, 900.0f);
+    }
+
+    //the cell grid has to cope with the shifted cells
+    for (int i = 0; i < 10; ++i) {
+        _simController->calcSingleTimestep();
+    }
+    actualData = _simController->getSimulationData();
+    ASSERT_EQ(16, actualData.cells.size());
+    for (auto const& cell : actualData.cells) {
+        EXPECT_TRUE(isInsideWorld(cell.pos));
+    }
+}
+
+TEST_F(CpuSimulationFacadeTests, monitorData)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(3).height(2).energy(100).color(1).center({100, 100}));
+    data.add(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(4).height(4).energy(50).color(2).center({500, 500})));
+    data.addParticles({ParticleDescription().setId(1000).setPos({300, 400}).setEnergy(20)});
+    _simController->setSimulationData(data);
+
+    int numConnections = 0;
+    for (auto const& cell : data.cells) {
+        numConnections += toInt(cell.connections.size());
+    }
+
+    auto statistics = _simController->getStatistics();
+    EXPECT_EQ(6, statistics.numCellsByColor[1]);
+    EXPECT_EQ(16, statistics.numCellsByColor[2]);
+    EXPECT_EQ(numConnections / 2, statistics.numConnections);
+    EXPECT_EQ(1, statistics.numParticles);
+    EXPECT_NEAR(600.0, statistics.cellEnergyByColor[1], 0.1);
+    EXPECT_NEAR(800.0, statistics.cellEnergyByColor[2], 0.1);
+    EXPECT_EQ(2, statistics.numClusters);
+    EXPECT_EQ(1, statistics.clusterSizeHistogram[calcMonitorHistogramBin(6.0f)]);
+    EXPECT_EQ(1, statistics.clusterSizeHistogram[calcMonitorHistogramBin(16.0f)]);
+    EXPECT_EQ(0, statistics.garbageCollectionTime);
+}
@@ -0,0 +1,170 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineImpl/DataConverter.h"
+
+class DataConverterTests : public ::testing::Test
+{
+public:
+    DataConverterTests() = default;
+    ~DataConverterTests() = default;
+
+protected:
+    //creates ring-shaped clusters of given sizes, each cell carries a token if withTokens is set
+    void createRings(std::vector<int> const& ringSizes, bool withTokens);
+    DataAccessTO getDataTO();
+
+    std::vector<CellAccessTO> _cells;
+    std::vector<ParticleAccessTO> _particles;
+    std::vector<TokenAccessTO> _tokens;
+    std::vector<char> _stringBytes;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    int _numStringBytes = 0;
+};
+
+void DataConverterTests::createRings(std::vector<int> const& ringSizes, bool withTokens)
+{
+    _cells.clear();
+    _tokens.clear();
+    for (auto const& ringSize : ringSizes) {
+        auto startIndex = toInt(_cells.size());
+        for (int i = 0; i < ringSize; ++i) {
+            CellAccessTO cell;
+            std::memset(&cell, 0, sizeof(cell));
+            cell.id = _cells.size() + 1;
+            cell.pos = {toFloat(i), toFloat(startIndex)};
+            cell.maxConnections = 2;
+            if (ringSize > 1) {
+                cell.numConnections = ringSize > 2 ? 2 : 1;
+                cell.connections[0].cellIndex = startIndex + (i + 1) % ringSize;
+                cell.connections[0].distance = 1.0f;
+                cell.connections[1].cellIndex = startIndex + (i + ringSize - 1) % ringSize;
+                cell.connections[1].distance = 1.0f;
+            }
+            if (withTokens) {
+                TokenAccessTO token;
+                std::memset(&token, 0, sizeof(token));
+                token.energy = toFloat(cell.id);
+                token.cellIndex = toInt(_cells.size());
+                _tokens.emplace_back(token);
+            }
+            _cells.emplace_back(cell);
+        }
+    }
+    _numCells = toInt(_cells.size());
+    _numTokens = toInt(_tokens.size());
+}
+
+DataAccessTO DataConverterTests::getDataTO()
+{
+    DataAccessTO result;
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    result.numStringBytes = &_numStringBytes;
+    result.stringBytes = _stringBytes.data();
+    return result;
+}
+
+TEST_F(DataConverterTests, clusterReconstruction)
+{
+    createRings({1, 2, 3, 10, 100}, true);
+    DataConverter converter(SimulationParameters{});
+
+    for (auto parallelization : {DataConverter::Parallelization::No, DataConverter::Parallelization::Yes}) {
+        auto data = converter.convertAccessTOtoClusteredDataDescription(getDataTO(), DataConverter::SortTokens::No, parallelization);
+        ASSERT_EQ(5, data.clusters.size());
+
+        std::unordered_map<uint64_t, int> clusterIndexByCellId;
+        for (int i = 0; i < toInt(data.clusters.size()); ++i) {
+            for (auto const& cell : data.clusters.at(i).cells) {
+                clusterIndexByCellId.emplace(cell.id, i);
+            }
+        }
+        EXPECT_EQ(_numCells, clusterIndexByCellId.size());
+
+        for (int i = 0; i < toInt(data.clusters.size()); ++i) {
+            for (auto const& cell : data.clusters.at(i).cells) {
+                for (auto const& connection : cell.connections) {
+                    EXPECT_EQ(i, clusterIndexByCellId.at(connection.cellId));
+                }
+                ASSERT_EQ(1, cell.tokens.size());
+                EXPECT_EQ(toFloat(cell.id), cell.tokens.front().energy);
+            }
+        }
+    }
+}
+
+TEST_F(DataConverterTests, bulkConversion)
+{
+    createRings({1, 2, 3, 10}, true);
+    DataConverter converter(SimulationParameters{});
+
+    auto data = converter.convertAccessTOtoBulkDataDescription(getDataTO());
+    ASSERT_EQ(_numCells, data.cells.size());
+    ASSERT_EQ(_numTokens, data.cells.getNumTokens());
+    for (int i = 0; i < _numCells; ++i) {
+        EXPECT_EQ(_cells.at(i).id, data.cells.ids.at(i));
+        ASSERT_EQ(_cells.at(i).numConnections, data.cells.connectionOffsets.at(i + 1) - data.cells.connectionOffsets.at(i));
+        for (int j = 0; j < _cells.at(i).numConnections; ++j) {
+            EXPECT_EQ(_cells.at(i).connections[j].cellIndex, data.cells.connectionCellIndices.at(data.cells.connectionOffsets.at(i) + j));
+        }
+        ASSERT_EQ(1, data.cells.tokenOffsets.at(i + 1) - data.cells.tokenOffsets.at(i));
+        EXPECT_EQ(toFloat(_cells.at(i).id), data.cells.tokenEnergies.at(data.cells.tokenOffsets.at(i)));
+    }
+
+    auto origCells = _cells;
+    std::memset(_cells.data(), 0, sizeof(CellAccessTO) * _cells.size());
+    _numCells = 0;
+    _numTokens = 0;
+    auto dataTO = getDataTO();
+    converter.convertBulkDataDescriptionToAccessTO(dataTO, data);
+    ASSERT_EQ(toInt(origCells.size()), _numCells);
+    for (int i = 0; i < _numCells; ++i) {
+        EXPECT_EQ(origCells.at(i).id, _cells.at(i).id);
+        EXPECT_EQ(origCells.at(i).pos.y, _cells.at(i).pos.y);
+        ASSERT_EQ(origCells.at(i).numConnections, _cells.at(i).numConnections);
+        for (int j = 0; j < _cells.at(i).numConnections; ++j) {
+            EXPECT_EQ(origCells.at(i).connections[j].cellIndex, _cells.at(i).connections[j].cellIndex);
+        }
+        EXPECT_EQ(i, _tokens.at(i).cellIndex);
+    }
+}
+
+TEST_F(DataConverterTests, DISABLED_benchmark)
+{
+    std::vector<int> ringSizes;
+    for (int i = 0; ringSizes.size() < 40000; ++i) {
+        ringSizes.emplace_back(1 + i % 50);
+    }
+    ringSizes.emplace_back(100000);
+    createRings(ringSizes, false);
+    DataConverter converter(SimulationParameters{});
+
+    for (auto parallelization : {DataConverter::Parallelization::No, DataConverter::Parallelization::Yes}) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        auto data = converter.convertAccessTOtoClusteredDataDescription(getDataTO(), DataConverter::SortTokens::No, parallelization);
+        auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+        std::cout << (parallelization == DataConverter::Parallelization::Yes ? "parallel" : "sequential") << " ("
+                  << ThreadPool::getInstance().getNumThreads() << " threads): " << _numCells << " cells in " << duration << "s" << std::endl;
+        EXPECT_EQ(ringSizes.size(), data.clusters.size());
+    }
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    auto data = converter.convertAccessTOtoBulkDataDescription(getDataTO());
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTimepoint).count();
+    std::cout << "bulk: " << _numCells << " cells in " << duration << "s" << std::endl;
+    EXPECT_EQ(_numCells, data.cells.size());
+}
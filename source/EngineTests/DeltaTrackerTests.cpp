@@ -0,0 +1,87 @@
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "EngineImpl/DeltaTracker.h"
+
+class DeltaTrackerTests : public ::testing::Test
+{
+public:
+    DeltaTrackerTests() = default;
+    ~DeltaTrackerTests() = default;
+
+protected:
+    void addCell(uint64_t id, float2 const& pos);
+    DataAccessTO getDataTO();
+
+    std::vector<CellAccessTO> _cells;
+    std::vector<ParticleAccessTO> _particles;
+    std::vector<TokenAccessTO> _tokens;
+    std::vector<char> _stringBytes;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    int _numStringBytes = 0;
+};
+
+void DeltaTrackerTests::addCell(uint64_t id, float2 const& pos)
+{
+    CellAccessTO cell;
+    std::memset(&cell, 0, sizeof(cell));
+    cell.id = id;
+    cell.pos = pos;
+    _cells.emplace_back(cell);
+}
+
+DataAccessTO DeltaTrackerTests::getDataTO()
+{
+    _numCells = toInt(_cells.size());
+    DataAccessTO result;
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    result.numStringBytes = &_numStringBytes;
+    result.stringBytes = _stringBytes.data();
+    return result;
+}
+
+TEST_F(DeltaTrackerTests, changesSinceEpoch)
+{
+    DeltaTracker tracker;
+    addCell(1, {0, 0});
+    addCell(2, {1, 0});
+
+    auto changes = tracker.update(getDataTO(), 0);
+    EXPECT_TRUE(changes.complete);
+    EXPECT_EQ((std::vector<bool>{true, true}), changes.changedCells);
+
+    changes = tracker.update(getDataTO(), changes.epoch);
+    EXPECT_FALSE(changes.complete);
+    EXPECT_EQ((std::vector<bool>{false, false}), changes.changedCells);
+
+    _cells.at(1).pos = {2, 0};
+    changes = tracker.update(getDataTO(), changes.epoch);
+    EXPECT_EQ((std::vector<bool>{false, true}), changes.changedCells);
+
+    _cells.erase(_cells.begin());
+    addCell(3, {5, 5});
+    changes = tracker.update(getDataTO(), changes.epoch);
+    EXPECT_EQ((std::vector<bool>{false, true}), changes.changedCells);
+    EXPECT_EQ((std::vector<uint64_t>{1}), changes.removedIds);
+}
+
+TEST_F(DeltaTrackerTests, reset)
+{
+    DeltaTracker tracker;
+    addCell(1, {0, 0});
+
+    auto changes = tracker.update(getDataTO(), 0);
+    tracker.reset();
+    changes = tracker.update(getDataTO(), changes.epoch);
+    EXPECT_TRUE(changes.complete);
+    EXPECT_EQ((std::vector<bool>{true}), changes.changedCells);
+}
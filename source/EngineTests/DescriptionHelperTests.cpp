@@ -0,0 +1,104 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/SpaceCalculator.h"
+
+class DescriptionHelperTests : public ::testing::Test
+{
+public:
+    DescriptionHelperTests() = default;
+    ~DescriptionHelperTests() = default;
+
+protected:
+    DataDescription randomMultiply(DataDescription const& input, DescriptionHelper::RandomMultiplyParameters const& parameters, bool& successful)
+        const;
+    float calcMinDistanceBetweenCopies(DataDescription const& data, int numCellsPerCopy) const;
+
+    IntVector2D _worldSize{400, 300};
+};
+
+DataDescription DescriptionHelperTests::randomMultiply(
+    DataDescription const& input,
+    DescriptionHelper::RandomMultiplyParameters const& parameters,
+    bool& successful) const
+{
+    return DescriptionHelper::randomMultiply(input, parameters, _worldSize, DataDescription(), successful);
+}
+
+float DescriptionHelperTests::calcMinDistanceBetweenCopies(DataDescription const& data, int numCellsPerCopy) const
+{
+    SpaceCalculator spaceCalculator(_worldSize);
+    auto result = std::numeric_limits<float>::max();
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        for (int j = i + 1; j < toInt(data.cells.size()); ++j) {
+            if (i / numCellsPerCopy != j / numCellsPerCopy) {
+                result = std::min(result, spaceCalculator.distance(data.cells.at(i).pos, data.cells.at(j).pos));
+            }
+        }
+    }
+    return result;
+}
+
+TEST_F(DescriptionHelperTests, randomMultiply_deterministicForSeed)
+{
+    auto input = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(4).height(3));
+    auto parameters = DescriptionHelper::RandomMultiplyParameters().number(50).maxVelX(1.0f).maxAngularVel(2.0f).overlappingCheck(true).seed(123);
+
+    bool successful1, successful2;
+    auto data1 = randomMultiply(input, parameters, successful1);
+    auto data2 = randomMultiply(input, parameters, successful2);
+    EXPECT_TRUE(successful1);
+    EXPECT_TRUE(successful2);
+
+    ASSERT_EQ(51 * 12, data1.cells.size());
+    ASSERT_EQ(data1.cells.size(), data2.cells.size());
+    for (int i = 0; i < toInt(data1.cells.size()); ++i) {
+        EXPECT_EQ(data1.cells.at(i).pos, data2.cells.at(i).pos);
+        EXPECT_EQ(data1.cells.at(i).vel, data2.cells.at(i).vel);
+    }
+
+    auto data3 = randomMultiply(input, parameters.seed(124), successful1);
+    EXPECT_NE(data1.cells.back().pos, data3.cells.back().pos);
+}
+
+TEST_F(DescriptionHelperTests, randomMultiply_overlappingCheck)
+{
+    auto input = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(5).height(5));
+    auto parameters = DescriptionHelper::RandomMultiplyParameters().number(200).overlappingCheck(true).seed(1);
+
+    bool successful;
+    auto data = randomMultiply(input, parameters, successful);
+    ASSERT_TRUE(successful);
+
+    //the original input is not checked, hence only the copies are compared
+    data.cells.erase(data.cells.begin(), data.cells.begin() + 25);
+    EXPECT_LE(2.0f, calcMinDistanceBetweenCopies(data, 25));
+}
+
+TEST_F(DescriptionHelperTests, randomMultiply_overlappingCheckFails)
+{
+    auto input = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(30).height(30));
+    auto parameters = DescriptionHelper::RandomMultiplyParameters().number(1000).overlappingCheck(true).seed(1);
+
+    bool successful;
+    auto data = randomMultiply(input, parameters, successful);
+    EXPECT_FALSE(successful);
+    EXPECT_EQ(1001 * 900, data.cells.size());
+}
+
+TEST_F(DescriptionHelperTests, DISABLED_benchmark)
+{
+    auto input = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(6).height(6));
+    for (auto const& overlappingCheck : {false, true}) {
+        auto parameters = DescriptionHelper::RandomMultiplyParameters().number(2000).overlappingCheck(overlappingCheck).seed(1);
+        auto startTimepoint = std::chrono::steady_clock::now();
+        bool successful;
+        auto data = DescriptionHelper::randomMultiply(input, parameters, {1000, 1000}, DataDescription(), successful);
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        std::cout << "randomMultiply " << (overlappingCheck ? "with" : "without") << " overlapping check: " << parameters._number << " copies in "
+                  << duration.count() << "ms" << std::endl;
+    }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/GarbageCollectionPolicy.h"
+
+class GarbageCollectionPolicyTests : public ::testing::Test
+{
+public:
+    GarbageCollectionPolicyTests()
+        : _policy(GarbageCollectionParameters{0.5f, 0.5f, 0.1f, 1})
+    {}
+
+    ~GarbageCollectionPolicyTests() = default;
+
+protected:
+    GarbageCollectionPolicy _policy;
+};
+
+TEST_F(GarbageCollectionPolicyTests, noCompaction)
+{
+    ArrayUsages usages;
+    usages.particles = ArrayUsage{400, 300, 1000};
+    usages.cells = ArrayUsage{300, 300, 1000};
+    usages.tokens = ArrayUsage{0, 0, 1000};
+    usages.stringBytes = ArrayUsage{0, 0, 0};
+
+    EXPECT_FALSE(_policy.calcCompactions(usages).any());
+}
+
+TEST_F(GarbageCollectionPolicyTests, fillLevelExceeded)
+{
+    ArrayUsages usages;
+    usages.particles = ArrayUsage{600, 590, 1000};
+    usages.cells = ArrayUsage{700, 700, 1000};
+    usages.tokens = ArrayUsage{100, 100, 1000};
+
+    auto compactions = _policy.calcCompactions(usages);
+    EXPECT_TRUE(compactions.particles);
+    EXPECT_TRUE(compactions.cells);
+    EXPECT_FALSE(compactions.tokens);
+    EXPECT_FALSE(compactions.stringBytes);
+}
+
+TEST_F(GarbageCollectionPolicyTests, mostFragmentedArrayFirst)
+{
+    ArrayUsages usages;
+    usages.particles = ArrayUsage{400, 150, 1000};
+    usages.cells = ArrayUsage{400, 50, 1000};
+    usages.tokens = ArrayUsage{400, 100, 1000};
+
+    auto compactions = _policy.calcCompactions(usages);
+    EXPECT_FALSE(compactions.particles);
+    EXPECT_TRUE(compactions.cells);
+    EXPECT_FALSE(compactions.tokens);
+
+    //the remaining fragmented arrays are compacted in the following time steps
+    usages.cells = ArrayUsage{50, 50, 1000};
+    compactions = _policy.calcCompactions(usages);
+    EXPECT_FALSE(compactions.particles);
+    EXPECT_FALSE(compactions.cells);
+    EXPECT_TRUE(compactions.tokens);
+}
+
+TEST_F(GarbageCollectionPolicyTests, fillLevelBeforeFragmentation)
+{
+    ArrayUsages usages;
+    usages.cells = ArrayUsage{400, 50, 1000};
+    usages.stringBytes = ArrayUsage{600, 500, 1000};
+
+    auto compactions = _policy.calcCompactions(usages);
+    EXPECT_TRUE(compactions.cells);
+    EXPECT_TRUE(compactions.stringBytes);
+}
+
+TEST_F(GarbageCollectionPolicyTests, smallDeadLevelIgnored)
+{
+    ArrayUsages usages;
+    usages.tokens = ArrayUsage{50, 0, 1000};
+
+    EXPECT_FALSE(_policy.calcCompactions(usages).any());
+}
+
+TEST_F(GarbageCollectionPolicyTests, liveEntriesCountNeeded)
+{
+    EXPECT_FALSE(_policy.isLiveEntriesCountNeeded(ArrayUsage{50, 0, 1000}));
+    EXPECT_TRUE(_policy.isLiveEntriesCountNeeded(ArrayUsage{100, 0, 1000}));
+    EXPECT_FALSE(_policy.isLiveEntriesCountNeeded(ArrayUsage{0, 0, 0}));
+}
@@ -4,12 +4,13 @@
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
-IntegrationTestFramework::IntegrationTestFramework(IntVector2D const& universeSize)
+IntegrationTestFramework::IntegrationTestFramework(IntVector2D const& universeSize, SimulationBackend backend)
 {
     _simController = std::make_shared<_SimulationControllerImpl>();
     Settings settings;
     settings.generalSettings.worldSizeX = universeSize.x;
     settings.generalSettings.worldSizeY = universeSize.y;
+    settings.backend = backend;
     SymbolMap symbolMap;
     _simController->newSimulation(0, settings, symbolMap);
 }
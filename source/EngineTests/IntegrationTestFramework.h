@@ -5,11 +5,12 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Settings.h"
 
 class IntegrationTestFramework : public ::testing::Test
 {
 public:
-    IntegrationTestFramework(IntVector2D const& universeSize);
+    IntegrationTestFramework(IntVector2D const& universeSize, SimulationBackend backend = SimulationBackend::Cuda);
     virtual ~IntegrationTestFramework();
 
 protected:
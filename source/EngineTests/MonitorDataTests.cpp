@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/MonitorDataFormatter.h"
+#include "EngineInterface/SimulationController.h"
+#include "IntegrationTestFramework.h"
+
+class MonitorDataTests : public IntegrationTestFramework
+{
+public:
+    MonitorDataTests()
+        : IntegrationTestFramework({1000, 1000})
+    {}
+
+    ~MonitorDataTests() = default;
+
+protected:
+    double measureTps(MonitorSettings const& monitorSettings, int numTimesteps);
+};
+
+double MonitorDataTests::measureTps(MonitorSettings const& monitorSettings, int numTimesteps)
+{
+    _simController->setMonitorSettings_async(monitorSettings);
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _simController->runSimulationUntil(_simController->getCurrentTimestep() + numTimesteps);
+    while (_simController->isSimulationRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    return numTimesteps * 1e6 / static_cast<double>(duration.count());
+}
+
+TEST_F(MonitorDataTests, histogramBins)
+{
+    EXPECT_EQ(0, calcMonitorHistogramBin(0.0f));
+    EXPECT_EQ(0, calcMonitorHistogramBin(0.9f));
+    EXPECT_EQ(1, calcMonitorHistogramBin(1.0f));
+    EXPECT_EQ(2, calcMonitorHistogramBin(2.0f));
+    EXPECT_EQ(2, calcMonitorHistogramBin(3.9f));
+    EXPECT_EQ(6, calcMonitorHistogramBin(60.0f));
+    EXPECT_EQ(MonitorHistogramSize - 1, calcMonitorHistogramBin(1e9f));
+}
+
+TEST_F(MonitorDataTests, csvRowMatchesHeader)
+{
+    auto header = MonitorDataFormatter::getCsvHeader();
+    auto row = MonitorDataFormatter::getCsvRow(MonitorData());
+    EXPECT_EQ(std::count(header.begin(), header.end(), ','), std::count(row.begin(), row.end(), ','));
+}
+
+TEST_F(MonitorDataTests, extendedMetrics)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(3).height(2).energy(100).color(1).center({10, 10}));
+    data.cells.at(0).cellFeature = CellFeatureDescription().setType(Enums::CellFunction_Scanner);
+    data.cells.at(1).addToken(TokenDescription().setEnergy(60).setData(std::string(_simController->getSimulationParameters().tokenMemorySize, 0)));
+    data.add(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(4).height(4).energy(50).color(2).center({50, 50})));
+    _simController->setSimulationData(data);
+
+    auto statistics = _simController->getStatistics();
+    EXPECT_EQ(6, statistics.numCellsByColor[1]);
+    EXPECT_EQ(16, statistics.numCellsByColor[2]);
+    EXPECT_NEAR(600.0, statistics.cellEnergyByColor[1], 0.1);
+    EXPECT_NEAR(800.0, statistics.cellEnergyByColor[2], 0.1);
+    EXPECT_NEAR(1460.0, statistics.totalInternalEnergy, 0.1);
+    EXPECT_EQ(1, statistics.numCellsByFunction[Enums::CellFunction_Scanner]);
+    EXPECT_EQ(21, statistics.numCellsByFunction[Enums::CellFunction_Computation]);
+    EXPECT_EQ(1, statistics.tokenEnergyHistogram[calcMonitorHistogramBin(60.0f)]);
+    EXPECT_EQ(2, statistics.numClusters);
+    EXPECT_EQ(1, statistics.clusterSizeHistogram[calcMonitorHistogramBin(6.0f)]);
+    EXPECT_EQ(1, statistics.clusterSizeHistogram[calcMonitorHistogramBin(16.0f)]);
+}
+
+TEST_F(MonitorDataTests, DISABLED_benchmark)
+{
+    DataDescription data;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            auto center = RealVector2D{toFloat(i) * 90.0f + 50.0f, toFloat(j) * 90.0f + 50.0f};
+            data.add(DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(20).height(20).color((i + j) % 7).center(center)));
+        }
+    }
+    _simController->setSimulationData(data);
+
+    int const NumTimesteps = 1000;
+    int const Disabled = 1000000000;
+    auto disabledTps = measureTps(MonitorSettings{Disabled, Disabled, Disabled}, NumTimesteps);
+    auto defaultTps = measureTps(MonitorSettings(), NumTimesteps);
+    auto entitiesTps = measureTps(MonitorSettings{0, 0, Disabled}, NumTimesteps);
+    auto allTps = measureTps(MonitorSettings{0, 0, 0}, NumTimesteps);
+
+    auto overhead = [&](double tps) { return (1.0 - tps / disabledTps) * 100.0; };
+    std::cout << data.cells.size() << " cells, time steps per second without monitoring: " << disabledTps << std::endl
+              << "default intervals: " << defaultTps << " (" << overhead(defaultTps) << "% overhead)" << std::endl
+              << "entities and processes after each time step: " << entitiesTps << " (" << overhead(entitiesTps) << "% overhead)" << std::endl
+              << "all metrics after each time step: " << allTps << " (" << overhead(allTps) << "% overhead)" << std::endl;
+
+    EXPECT_LT(overhead(defaultTps), 5.0);
+}
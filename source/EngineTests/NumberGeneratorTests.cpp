@@ -0,0 +1,98 @@
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+#include "Base/RandomStream.h"
+#include "Base/ThreadPool.h"
+
+class NumberGeneratorTests : public ::testing::Test
+{
+public:
+    NumberGeneratorTests() = default;
+    ~NumberGeneratorTests() = default;
+};
+
+TEST_F(NumberGeneratorTests, uniqueIdsAcrossThreads)
+{
+    auto& numberGenerator = NumberGenerator::getInstance();
+    auto& threadPool = ThreadPool::getInstance();
+
+    std::mutex mutex;
+    std::unordered_set<uint64_t> ids;
+    threadPool.parallelFor(0, 64, [&](int startIndex, int endIndex) {
+        std::vector<uint64_t> threadIds;
+        for (int i = startIndex; i < endIndex; ++i) {
+            for (int j = 0; j < 1000; ++j) {
+                threadIds.emplace_back(numberGenerator.getId());
+            }
+            auto firstId = numberGenerator.reserveIds(100);
+            for (int j = 0; j < 100; ++j) {
+                threadIds.emplace_back(firstId + j);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.insert(threadIds.begin(), threadIds.end());
+    }, 1);
+    EXPECT_EQ(64 * 1100, ids.size());
+}
+
+TEST_F(NumberGeneratorTests, randomStreamReproducible)
+{
+    RandomStream stream1(42, 1);
+    RandomStream stream2(42, 1);
+    RandomStream stream3(42, 2);
+    int numEqualValues = 0;
+    for (int i = 0; i < 1000; ++i) {
+        auto value = stream1.getRandomInt();
+        EXPECT_EQ(value, stream2.getRandomInt());
+        numEqualValues += value == stream3.getRandomInt() ? 1 : 0;
+    }
+    EXPECT_GT(2, numEqualValues);
+}
+
+TEST_F(NumberGeneratorTests, randomRanges)
+{
+    auto& numberGenerator = NumberGenerator::getInstance();
+    std::vector<int> counts(10, 0);
+    for (int i = 0; i < 10000; ++i) {
+        auto value = numberGenerator.getRandomInt(10);
+        ASSERT_LT(value, 10);
+        ++counts.at(value);
+
+        auto intValue = numberGenerator.getRandomInt(3, 5);
+        EXPECT_TRUE(intValue >= 3 && intValue <= 5);
+
+        auto realValue = numberGenerator.getRandomReal(-1.0, 1.0);
+        EXPECT_TRUE(realValue >= -1.0 && realValue < 1.0);
+    }
+    for (auto const& count : counts) {
+        EXPECT_GT(count, 800);
+    }
+}
+
+TEST_F(NumberGeneratorTests, DISABLED_benchmark)
+{
+    auto& numberGenerator = NumberGenerator::getInstance();
+    auto& threadPool = ThreadPool::getInstance();
+    int const NumValuesPerChunk = 1000000;
+    auto numChunks = threadPool.getNumThreads() * 4;
+
+    std::atomic<uint64_t> checksum{0};
+    auto startTimepoint = std::chrono::steady_clock::now();
+    threadPool.parallelFor(0, numChunks, [&](int startIndex, int endIndex) {
+        uint64_t sum = 0;
+        for (int i = startIndex; i < endIndex; ++i) {
+            for (int j = 0; j < NumValuesPerChunk; ++j) {
+                sum += numberGenerator.getId() + numberGenerator.getRandomInt();
+            }
+        }
+        checksum += sum;
+    }, 1);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_NE(0, checksum.load());
+    std::cout << numChunks * NumValuesPerChunk << " ids and random numbers on " << threadPool.getNumThreads() << " threads in "
+              << duration.count() << "ms" << std::endl;
+}
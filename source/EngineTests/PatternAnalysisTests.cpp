@@ -0,0 +1,79 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/PatternAnalysis.h"
+
+class PatternAnalysisTests : public ::testing::Test
+{
+public:
+    PatternAnalysisTests() = default;
+    ~PatternAnalysisTests() = default;
+
+protected:
+    ClusterDescription createCluster(int width, int height, bool withToken = true) const;
+};
+
+ClusterDescription PatternAnalysisTests::createCluster(int width, int height, bool withToken) const
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(width).height(height));
+    if (withToken) {
+        data.cells.front().addToken(TokenDescription());
+    }
+    ClusterDescription result;
+    result.addCells(data.cells);
+    return result;
+}
+
+TEST_F(PatternAnalysisTests, equalClusters)
+{
+    auto cluster1 = createCluster(3, 2);
+    auto cluster2 = createCluster(3, 2);
+    std::reverse(cluster2.cells.begin(), cluster2.cells.end());
+    for (auto& cell : cluster2.cells) {
+        cell.pos += RealVector2D{100, 100};
+        cell.energy = 50;
+    }
+
+    auto partitionClasses = PatternAnalysis::calcPartitionClasses({cluster1, cluster2});
+    ASSERT_EQ(1, partitionClasses.size());
+    EXPECT_EQ(2, partitionClasses.front().numberOfElements);
+    EXPECT_TRUE(partitionClasses.front().hasToken);
+    EXPECT_EQ(0, partitionClasses.front().representantIndex);
+}
+
+TEST_F(PatternAnalysisTests, differentClusters)
+{
+    auto cluster = createCluster(3, 2);
+
+    auto differentBranchNumber = cluster;
+    differentBranchNumber.cells.back().tokenBranchNumber = 1;
+
+    auto differentCellFunction = cluster;
+    differentCellFunction.cells.back().cellFeature.setType(Enums::CellFunction_Constructor);
+
+    auto withoutToken = createCluster(3, 2, false);
+
+    auto partitionClasses = PatternAnalysis::calcPartitionClasses({cluster, differentBranchNumber, differentCellFunction, withoutToken, cluster});
+    ASSERT_EQ(4, partitionClasses.size());
+    EXPECT_EQ(2, partitionClasses.at(0).numberOfElements);
+    EXPECT_EQ(1, partitionClasses.at(1).representantIndex);
+    EXPECT_EQ(2, partitionClasses.at(2).representantIndex);
+    EXPECT_FALSE(partitionClasses.at(3).hasToken);
+}
+
+TEST_F(PatternAnalysisTests, DISABLED_benchmark)
+{
+    //about one million cells in clusters of 30 different shapes
+    std::vector<ClusterDescription> clusters;
+    for (int i = 0; i < 20000; ++i) {
+        clusters.emplace_back(createCluster(5 + i % 10, 5 + i % 3));
+    }
+    auto startTimepoint = std::chrono::steady_clock::now();
+    auto partitionClasses = PatternAnalysis::calcPartitionClasses(clusters);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(27, partitionClasses.size());  //30 shapes, 3 of them are transposed versions of others
+    std::cout << clusters.size() << " clusters analyzed in " << duration.count() << "ms" << std::endl;
+}
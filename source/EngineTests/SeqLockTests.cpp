@@ -0,0 +1,57 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/SeqLock.h"
+#include "EngineInterface/MonitorData.h"
+
+class SeqLockTests : public ::testing::Test
+{
+public:
+    SeqLockTests() = default;
+    ~SeqLockTests() = default;
+};
+
+TEST_F(SeqLockTests, readersObtainConsistentSnapshots)
+{
+    SeqLock<MonitorData> seqLock;
+    EXPECT_EQ(0, seqLock.load().timeStep);
+
+    std::atomic<bool> isFinished{false};
+    std::thread writer([&] {
+        for (int i = 1; i <= 100000; ++i) {
+            MonitorData data;
+            data.timeStep = i;
+            for (auto& numCells : data.numCellsByColor) {
+                numCells = i;
+            }
+            data.numParticles = i;
+            data.numMuscleActivities = i;
+            seqLock.store(data);
+        }
+        isFinished = true;
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<int> numInconsistentReads{0};
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&] {
+            uint64_t lastTimestep = 0;
+            while (!isFinished.load()) {
+                auto data = seqLock.load();
+                auto value = toInt(data.timeStep);
+                if (data.timeStep < lastTimestep || data.numParticles != value || data.numMuscleActivities != value
+                    || data.numCellsByColor[6] != value) {
+                    ++numInconsistentReads;
+                }
+                lastTimestep = data.timeStep;
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0, numInconsistentReads.load());
+    EXPECT_EQ(100000, seqLock.load().timeStep);
+}
@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/DataAccessTOSerializer.h"
+#include "EngineInterface/BulkDataDescription.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Serializer.h"
+
+class SerializerTests : public ::testing::Test
+{
+public:
+    SerializerTests()
+    {
+        _directory = std::filesystem::temp_directory_path() / ("alien_serializer_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(_directory);
+        _filename = (_directory / "content.sim").string();
+    }
+    ~SerializerTests() { std::filesystem::remove_all(_directory); }
+
+protected:
+    //clusters and particles spread over several tiles
+    ClusteredDataDescription createContent() const;
+
+    std::vector<uint64_t> getClusterIds(ClusteredDataDescription const& data) const;
+    std::vector<uint64_t> getParticleIds(ClusteredDataDescription const& data) const;
+    void overwriteBytes(uint64_t offset, int numBytes) const;
+
+    //host memory for a DataAccessTO
+    struct DataAccessTOBuffers
+    {
+        DataAccessTOBuffers(int numCells, int numParticles, int numTokens, int numStringBytes);
+        DataAccessTO getDataTO();
+
+        int numCells;
+        int numParticles;
+        int numTokens;
+        int numStringBytes;
+        std::vector<CellAccessTO> cells;
+        std::vector<ParticleAccessTO> particles;
+        std::vector<TokenAccessTO> tokens;
+        std::vector<char> stringBytes;
+    };
+    DataAccessTOBuffers createDataAccessTOBuffers(int numCells, int numParticles, int numTokens, int numStringBytes) const;
+
+    std::filesystem::path _directory;
+    std::string _filename;
+};
+
+ClusteredDataDescription SerializerTests::createContent() const
+{
+    ClusteredDataDescription result;
+    uint64_t id = 0;
+    for (int i = 0; i < 20; ++i) {
+        auto pos = RealVector2D{toFloat(i % 5) * 200.0f + 10.0f, toFloat(i / 5) * 200.0f + 10.0f};
+        ClusterDescription cluster;
+        cluster.setId(++id);
+        for (int j = 0; j < 3; ++j) {
+            cluster.addCell(CellDescription().setId(++id).setPos({pos.x + toFloat(j), pos.y}).setEnergy(100.0 + j));
+        }
+        result.addCluster(cluster);
+    }
+    for (int i = 0; i < 50; ++i) {
+        result.addParticle(ParticleDescription().setId(++id).setPos({toFloat(i) * 19.0f, toFloat(i) * 13.0f}).setEnergy(10.0));
+    }
+    return result;
+}
+
+std::vector<uint64_t> SerializerTests::getClusterIds(ClusteredDataDescription const& data) const
+{
+    std::vector<uint64_t> result;
+    for (auto const& cluster : data.clusters) {
+        result.emplace_back(cluster.id);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<uint64_t> SerializerTests::getParticleIds(ClusteredDataDescription const& data) const
+{
+    std::vector<uint64_t> result;
+    for (auto const& particle : data.particles) {
+        result.emplace_back(particle.id);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void SerializerTests::overwriteBytes(uint64_t offset, int numBytes) const
+{
+    std::fstream stream(_filename, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekp(offset);
+    for (int i = 0; i < numBytes; ++i) {
+        stream.put(static_cast<char>(0x55 + i));
+    }
+}
+
+SerializerTests::DataAccessTOBuffers::DataAccessTOBuffers(int numCells, int numParticles, int numTokens, int numStringBytes)
+    : numCells(numCells)
+    , numParticles(numParticles)
+    , numTokens(numTokens)
+    , numStringBytes(numStringBytes)
+    , cells(std::max(1, numCells))
+    , particles(std::max(1, numParticles))
+    , tokens(std::max(1, numTokens))
+    , stringBytes(std::max(1, numStringBytes))
+{}
+
+DataAccessTO SerializerTests::DataAccessTOBuffers::getDataTO()
+{
+    DataAccessTO result;
+    result.numCells = &numCells;
+    result.cells = cells.data();
+    result.numParticles = &numParticles;
+    result.particles = particles.data();
+    result.numTokens = &numTokens;
+    result.tokens = tokens.data();
+    result.numStringBytes = &numStringBytes;
+    result.stringBytes = stringBytes.data();
+    return result;
+}
+
+auto SerializerTests::createDataAccessTOBuffers(int numCells, int numParticles, int numTokens, int numStringBytes) const -> DataAccessTOBuffers
+{
+    DataAccessTOBuffers result(numCells, numParticles, numTokens, numStringBytes);
+    for (int i = 0; i < numCells; ++i) {
+        auto& cell = result.cells[i];
+        cell.id = i + 1;
+        cell.pos = {toFloat(i), toFloat(i) * 0.5f};
+        cell.energy = 100.0f + toFloat(i);
+        cell.numConnections = 1;
+        cell.connections[0] = {(i + 1) % numCells, 1.0f, 0.0f};
+        cell.staticData[i % MAX_CELL_STATIC_BYTES] = static_cast<char>(i);
+        cell.metadata.nameLen = numStringBytes > 0 ? 1 : 0;
+        cell.metadata.nameStringIndex = numStringBytes > 0 ? i % numStringBytes : 0;
+    }
+    for (int i = 0; i < numParticles; ++i) {
+        auto& particle = result.particles[i];
+        particle.id = numCells + i + 1;
+        particle.pos = {toFloat(i) * 2.0f, 3.0f};
+        particle.energy = 5.0f;
+    }
+    for (int i = 0; i < numTokens; ++i) {
+        auto& token = result.tokens[i];
+        token.energy = 30.0f;
+        token.memory[i % MAX_TOKEN_MEM_SIZE] = static_cast<char>(i + 1);
+        token.cellIndex = numCells > 0 ? i % numCells : 0;
+    }
+    for (int i = 0; i < numStringBytes; ++i) {
+        result.stringBytes[i] = static_cast<char>('a' + i % 26);
+    }
+    return result;
+}
+
+TEST_F(SerializerTests, chunkedRoundtrip)
+{
+    auto content = createContent();
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, content));
+    EXPECT_TRUE(ChunkedContentReader::isChunkedFile(_filename));
+
+    ClusteredDataDescription actualContent;
+    ASSERT_TRUE(Serializer::deserializeContentFromFile(actualContent, _filename));
+    EXPECT_EQ(getClusterIds(content), getClusterIds(actualContent));
+    EXPECT_EQ(getParticleIds(content), getParticleIds(actualContent));
+
+    for (auto const& cluster : actualContent.clusters) {
+        auto origCluster = std::find_if(content.clusters.begin(), content.clusters.end(), [&](auto const& other) { return other.id == cluster.id; });
+        ASSERT_EQ(origCluster->cells.size(), cluster.cells.size());
+        for (int i = 0; i < toInt(cluster.cells.size()); ++i) {
+            EXPECT_EQ(origCluster->cells[i].id, cluster.cells[i].id);
+            EXPECT_EQ(origCluster->cells[i].pos.x, cluster.cells[i].pos.x);
+            EXPECT_EQ(origCluster->cells[i].pos.y, cluster.cells[i].pos.y);
+            EXPECT_EQ(origCluster->cells[i].energy, cluster.cells[i].energy);
+        }
+    }
+}
+
+TEST_F(SerializerTests, chunkedRoundtripWithoutContent)
+{
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, ClusteredDataDescription()));
+
+    ClusteredDataDescription actualContent;
+    ASSERT_TRUE(Serializer::deserializeContentFromFile(actualContent, _filename));
+    EXPECT_TRUE(actualContent.clusters.empty());
+    EXPECT_TRUE(actualContent.particles.empty());
+}
+
+TEST_F(SerializerTests, bulkRoundtrip)
+{
+    //10 chains of 3 connected cells and some particles
+    DataDescription data;
+    std::unordered_map<uint64_t, int> cache;
+    uint64_t id = 0;
+    for (int i = 0; i < 10; ++i) {
+        auto pos = RealVector2D{toFloat(i) * 150.0f + 10.0f, toFloat(i) * 70.0f + 10.0f};
+        for (int j = 0; j < 3; ++j) {
+            data.addCell(CellDescription().setId(++id).setPos({pos.x + toFloat(j), pos.y}).setEnergy(100.0 + j).setMaxConnections(2));
+        }
+        data.addConnection(id - 2, id - 1, cache);
+        data.addConnection(id - 1, id, cache);
+    }
+    data.cells.front().addToken(TokenDescription().setEnergy(30.0).setData(std::string(4, 'x')));
+    for (int i = 0; i < 5; ++i) {
+        data.addParticle(ParticleDescription().setId(++id).setPos({toFloat(i) * 100.0f, 5.0f}).setEnergy(10.0));
+    }
+
+    DeserializedSimulation sim;
+    sim.timestep = 42;
+    ASSERT_TRUE(Serializer::serializeSimulationToFiles(_filename, sim, BulkDataDescription(data)));
+
+    DeserializedSimulation actualSim;
+    ASSERT_TRUE(Serializer::deserializeSimulationFromFiles(actualSim, _filename));
+    EXPECT_EQ(42, actualSim.timestep);
+    ASSERT_EQ(10, toInt(actualSim.content.clusters.size()));
+    EXPECT_EQ(5, toInt(actualSim.content.particles.size()));
+
+    std::map<uint64_t, CellDescription> actualCellById;
+    for (auto const& cluster : actualSim.content.clusters) {
+        ASSERT_EQ(3, toInt(cluster.cells.size()));
+        for (int i = 1; i < 3; ++i) {
+            EXPECT_EQ(cluster.cells[i - 1].id + 1, cluster.cells[i].id);
+        }
+        for (auto const& cell : cluster.cells) {
+            actualCellById.emplace(cell.id, cell);
+        }
+    }
+    for (auto const& cell : data.cells) {
+        auto const& actualCell = actualCellById.at(cell.id);
+        EXPECT_EQ(cell.pos.x, actualCell.pos.x);
+        EXPECT_EQ(cell.energy, actualCell.energy);
+        ASSERT_EQ(cell.connections.size(), actualCell.connections.size());
+        for (int i = 0; i < toInt(cell.connections.size()); ++i) {
+            EXPECT_EQ(cell.connections[i].cellId, actualCell.connections[i].cellId);
+        }
+        EXPECT_EQ(cell.tokens.size(), actualCell.tokens.size());
+    }
+}
+
+TEST_F(SerializerTests, chunkIndex)
+{
+    auto content = createContent();
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, content));
+
+    ChunkedContentReader reader(_filename);
+    auto const& index = reader.getIndex();
+    EXPECT_GT(index.size(), 2);
+
+    int numClusters = 0;
+    int numCells = 0;
+    int numParticles = 0;
+    for (auto const& info : index) {
+        if (info.type == ChunkType::Clusters) {
+            numClusters += info.numEntities;
+            numCells += info.numCells;
+        } else {
+            numParticles += info.numEntities;
+        }
+    }
+    EXPECT_EQ(20, numClusters);
+    EXPECT_EQ(60, numCells);
+    EXPECT_EQ(50, numParticles);
+}
+
+TEST_F(SerializerTests, regionQuery)
+{
+    auto content = createContent();
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, content));
+
+    RealRect region{{0, 0}, {300, 300}};
+    ClusteredDataDescription expectedContent;
+    for (auto const& cluster : content.clusters) {
+        if (std::any_of(cluster.cells.begin(), cluster.cells.end(), [&](auto const& cell) {
+                return cell.pos.x >= 0 && cell.pos.x <= 300 && cell.pos.y >= 0 && cell.pos.y <= 300;
+            })) {
+            expectedContent.addCluster(cluster);
+        }
+    }
+    for (auto const& particle : content.particles) {
+        if (particle.pos.x >= 0 && particle.pos.x <= 300 && particle.pos.y >= 0 && particle.pos.y <= 300) {
+            expectedContent.addParticle(particle);
+        }
+    }
+    ASSERT_FALSE(expectedContent.clusters.empty());
+    ASSERT_FALSE(expectedContent.particles.empty());
+
+    ChunkedContentReader reader(_filename);
+    auto actualContent = reader.readRegion(region);
+    EXPECT_EQ(getClusterIds(expectedContent), getClusterIds(actualContent));
+    EXPECT_EQ(getParticleIds(expectedContent), getParticleIds(actualContent));
+
+    EXPECT_TRUE(reader.readRegion(RealRect{{5000, 5000}, {6000, 6000}}).clusters.empty());
+}
+
+TEST_F(SerializerTests, truncatedFile)
+{
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, createContent()));
+    std::filesystem::resize_file(_filename, std::filesystem::file_size(_filename) / 2);
+
+    EXPECT_THROW(ChunkedContentReader reader(_filename), std::runtime_error);
+    ClusteredDataDescription actualContent;
+    EXPECT_FALSE(Serializer::deserializeContentFromFile(actualContent, _filename));
+}
+
+TEST_F(SerializerTests, corruptedChunk)
+{
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, createContent()));
+    ChunkInfo info;
+    {
+        ChunkedContentReader reader(_filename);
+        info = reader.getIndex().front();
+    }
+    overwriteBytes(info.offset + info.size / 2, std::min(16, toInt(info.size / 2)));
+
+    ChunkedContentReader reader(_filename);
+    EXPECT_ANY_THROW(reader.readAll());
+    ClusteredDataDescription actualContent;
+    EXPECT_FALSE(Serializer::deserializeContentFromFile(actualContent, _filename));
+}
+
+TEST_F(SerializerTests, corruptedIndex)
+{
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, createContent()));
+
+    //index offset is stored in the 16 bytes trailer
+    overwriteBytes(std::filesystem::file_size(_filename) - 16, 8);
+
+    EXPECT_THROW(ChunkedContentReader reader(_filename), std::runtime_error);
+    ClusteredDataDescription actualContent;
+    EXPECT_FALSE(Serializer::deserializeContentFromFile(actualContent, _filename));
+}
+
+TEST_F(SerializerTests, dataAccessTORoundtrip)
+{
+    auto buffers = createDataAccessTOBuffers(100, 50, 20, 1000);
+    DataAccessTOSerializer::serialize(_filename, buffers.getDataTO());
+    EXPECT_TRUE(DataAccessTOSerializer::isSnapshotFile(_filename));
+
+    auto arraySizes = DataAccessTOSerializer::getArraySizes(_filename);
+    EXPECT_EQ(100, arraySizes.cellArraySize);
+    EXPECT_EQ(50, arraySizes.particleArraySize);
+    EXPECT_EQ(20, arraySizes.tokenArraySize);
+
+    DataAccessTOBuffers actualBuffers(arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize, 1000);
+    DataAccessTOSerializer::deserialize(actualBuffers.getDataTO(), _filename);
+    ASSERT_EQ(100, actualBuffers.numCells);
+    ASSERT_EQ(50, actualBuffers.numParticles);
+    ASSERT_EQ(20, actualBuffers.numTokens);
+    ASSERT_EQ(1000, actualBuffers.numStringBytes);
+    EXPECT_EQ(0, std::memcmp(buffers.cells.data(), actualBuffers.cells.data(), sizeof(CellAccessTO) * 100));
+    EXPECT_EQ(0, std::memcmp(buffers.particles.data(), actualBuffers.particles.data(), sizeof(ParticleAccessTO) * 50));
+    EXPECT_EQ(0, std::memcmp(buffers.tokens.data(), actualBuffers.tokens.data(), sizeof(TokenAccessTO) * 20));
+    EXPECT_EQ(0, std::memcmp(buffers.stringBytes.data(), actualBuffers.stringBytes.data(), 1000));
+}
+
+TEST_F(SerializerTests, dataAccessTORoundtripWithEmptyArrays)
+{
+    auto buffers = createDataAccessTOBuffers(0, 10, 0, 0);
+    DataAccessTOSerializer::serialize(_filename, buffers.getDataTO());
+
+    auto arraySizes = DataAccessTOSerializer::getArraySizes(_filename);
+    EXPECT_EQ(0, arraySizes.cellArraySize);
+    EXPECT_EQ(10, arraySizes.particleArraySize);
+    EXPECT_EQ(0, arraySizes.tokenArraySize);
+
+    DataAccessTOBuffers actualBuffers(1, 10, 1, 1);
+    actualBuffers.numCells = actualBuffers.numTokens = actualBuffers.numStringBytes = -1;
+    DataAccessTOSerializer::deserialize(actualBuffers.getDataTO(), _filename);
+    EXPECT_EQ(0, actualBuffers.numCells);
+    EXPECT_EQ(10, actualBuffers.numParticles);
+    EXPECT_EQ(0, actualBuffers.numTokens);
+    EXPECT_EQ(0, actualBuffers.numStringBytes);
+    EXPECT_EQ(0, std::memcmp(buffers.particles.data(), actualBuffers.particles.data(), sizeof(ParticleAccessTO) * 10));
+}
+
+TEST_F(SerializerTests, dataAccessTOTruncatedFile)
+{
+    auto buffers = createDataAccessTOBuffers(100, 50, 20, 1000);
+    DataAccessTOSerializer::serialize(_filename, buffers.getDataTO());
+    std::filesystem::resize_file(_filename, std::filesystem::file_size(_filename) / 2);
+
+    DataAccessTOBuffers actualBuffers(100, 50, 20, 1000);
+    EXPECT_THROW(DataAccessTOSerializer::deserialize(actualBuffers.getDataTO(), _filename), std::runtime_error);
+}
+
+TEST_F(SerializerTests, dataAccessTOFileTypes)
+{
+    ASSERT_TRUE(Serializer::serializeContentToFile(_filename, createContent()));
+    EXPECT_FALSE(DataAccessTOSerializer::isSnapshotFile(_filename));
+    EXPECT_THROW(DataAccessTOSerializer::getArraySizes(_filename), std::runtime_error);
+}
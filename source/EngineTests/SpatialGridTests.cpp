@@ -0,0 +1,144 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineInterface/SpatialGrid.h"
+
+class SpatialGridTests : public ::testing::Test
+{
+public:
+    SpatialGridTests() = default;
+    ~SpatialGridTests() = default;
+
+protected:
+    std::vector<RealVector2D> createRandomPositions(int number, RealVector2D const& min, RealVector2D const& max);
+    std::vector<int> getIndicesWithinRadius(
+        std::vector<RealVector2D> const& positions,
+        RealVector2D const& pos,
+        float radius,
+        std::optional<IntVector2D> const& worldSize = std::nullopt) const;
+
+    std::mt19937 _randomEngine{42};
+};
+
+std::vector<RealVector2D> SpatialGridTests::createRandomPositions(int number, RealVector2D const& min, RealVector2D const& max)
+{
+    std::uniform_real_distribution<float> distX(min.x, max.x);
+    std::uniform_real_distribution<float> distY(min.y, max.y);
+    std::vector<RealVector2D> result;
+    result.reserve(number);
+    for (int i = 0; i < number; ++i) {
+        result.emplace_back(distX(_randomEngine), distY(_randomEngine));
+    }
+    return result;
+}
+
+//brute force reference
+std::vector<int> SpatialGridTests::getIndicesWithinRadius(
+    std::vector<RealVector2D> const& positions,
+    RealVector2D const& pos,
+    float radius,
+    std::optional<IntVector2D> const& worldSize) const
+{
+    std::vector<int> result;
+    for (int i = 0; i < toInt(positions.size()); ++i) {
+        auto distance = worldSize ? SpaceCalculator(*worldSize).distance(pos, positions.at(i)) : Math::length(positions.at(i) - pos);
+        if (distance <= radius) {
+            result.emplace_back(i);
+        }
+    }
+    return result;
+}
+
+TEST_F(SpatialGridTests, plane)
+{
+    auto positions = createRandomPositions(2000, {-50, -20}, {50, 30});
+    SpatialGrid grid(positions, 1.5f);
+
+    for (auto const& pos : createRandomPositions(200, {-60, -30}, {60, 40})) {
+        for (auto const& radius : {0.5f, 1.5f, 7.0f}) {
+            auto indices = grid.getIndicesWithinRadius(pos, radius);
+            for (int i = 1; i < toInt(indices.size()); ++i) {
+                EXPECT_LE(Math::length(positions.at(indices.at(i - 1)) - pos), Math::length(positions.at(indices.at(i)) - pos));
+            }
+            std::sort(indices.begin(), indices.end());
+            EXPECT_EQ(getIndicesWithinRadius(positions, pos, radius), indices);
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, torus)
+{
+    IntVector2D worldSize{100, 70};
+    auto positions = createRandomPositions(2000, {-100, -70}, {200, 140});
+    SpatialGrid grid(positions, 3.0f, worldSize);
+
+    auto queryPositions = createRandomPositions(200, {0, 0}, {100, 70});
+    queryPositions.emplace_back(0.5f, 0.5f);
+    queryPositions.emplace_back(99.5f, 69.5f);
+    for (auto const& pos : queryPositions) {
+        for (auto const& radius : {1.0f, 3.0f, 20.0f, 60.0f}) {
+            auto indices = grid.getIndicesWithinRadius(pos, radius);
+            std::sort(indices.begin(), indices.end());
+            EXPECT_EQ(getIndicesWithinRadius(positions, pos, radius, worldSize), indices);
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, torusOverlappingAtBorder)
+{
+    SpatialGrid grid({{99.5f, 10.0f}}, 2.0f, {100, 100});
+    EXPECT_TRUE(grid.isEntryCloserThan({0.5f, 10.0f}, 2.0f));
+    EXPECT_TRUE(grid.isEntryCloserThan({-0.5f, 10.0f}, 2.0f));
+    EXPECT_FALSE(grid.isEntryCloserThan({1.5f, 10.0f}, 2.0f));
+}
+
+TEST_F(SpatialGridTests, addEntries)
+{
+    auto positions = createRandomPositions(100, {0, 0}, {30, 30});
+    SpatialGrid grid(positions, 1.0f);
+
+    //added entries may lie outside the initial bounding box and trigger rebuilds
+    for (auto const& pos : createRandomPositions(5000, {-10, -10}, {40, 40})) {
+        EXPECT_EQ(toInt(positions.size()), grid.add(pos));
+        positions.emplace_back(pos);
+    }
+    EXPECT_EQ(toInt(positions.size()), grid.getNumEntries());
+    for (auto const& pos : createRandomPositions(200, {-15, -15}, {45, 45})) {
+        auto indices = grid.getIndicesWithinRadius(pos, 2.0f);
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(getIndicesWithinRadius(positions, pos, 2.0f), indices);
+    }
+}
+
+TEST_F(SpatialGridTests, DISABLED_benchmark)
+{
+    for (auto const& numCells : {100000, 1000000}) {
+        auto size = std::sqrt(toFloat(numCells));
+        auto positions = createRandomPositions(numCells, {0, 0}, {size, size});
+        auto const radius = 1.5f;
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        int64_t numNeighborsGrid = 0;
+        {
+            SpatialGrid grid(positions, radius);
+            for (auto const& pos : positions) {
+                grid.forEachWithinRadius(pos, radius, [&](int, float) { ++numNeighborsGrid; });
+            }
+        }
+        auto gridDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+        startTimepoint = std::chrono::steady_clock::now();
+        auto sideLength = toInt(size);
+        auto rect = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(sideLength).height(sideLength));
+        auto reconnectDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+        std::cout << numCells << " cells: spatial grid " << gridDuration.count() << "ms (" << numNeighborsGrid << " neighbors), "
+                  << "createRect (incl. reconnectCells) " << reconnectDuration.count() << "ms" << std::endl;
+    }
+}
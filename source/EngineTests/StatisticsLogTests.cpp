@@ -0,0 +1,245 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/StatisticsLog.h"
+
+class StatisticsLogTests : public ::testing::Test
+{
+public:
+    StatisticsLogTests()
+    {
+        _directory = std::filesystem::temp_directory_path() / ("alien_statistics_log_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(_directory);
+        _filename = (_directory / "statistics.log").string();
+    }
+    ~StatisticsLogTests() { std::filesystem::remove_all(_directory); }
+
+protected:
+    MonitorData createSample(uint64_t timestep) const;
+    std::vector<MonitorData> readSamples(bool onlyHistory) const;
+
+    std::filesystem::path _directory;
+    std::string _filename;
+};
+
+MonitorData StatisticsLogTests::createSample(uint64_t timestep) const
+{
+    MonitorData result;
+    result.timeStep = timestep;
+    for (int i = 0; i < 7; ++i) {
+        result.numCellsByColor[i] = static_cast<int>(timestep % 1000) * (i + 1);
+    }
+    result.numConnections = static_cast<int>(timestep * 3);
+    result.numParticles = 1000 - static_cast<int>(timestep % 1000);
+    result.numTokens = static_cast<int>(timestep % 7);
+    result.totalInternalEnergy = 1e6 + static_cast<double>(timestep) * 0.1;
+    result.numCreatedCells = static_cast<int>(timestep % 5);
+    result.numSuccessfulAttacks = -1;
+    result.numFailedAttacks = static_cast<int>(timestep % 3);
+    result.numMuscleActivities = static_cast<int>(timestep / 2);
+    result.garbageCollectionTime = static_cast<double>(timestep % 11) * 0.25;
+    return result;
+}
+
+std::vector<MonitorData> StatisticsLogTests::readSamples(bool onlyHistory) const
+{
+    std::vector<MonitorData> result;
+    StatisticsLogReader reader(_filename);
+    auto func = [&](MonitorData const& sample) { result.emplace_back(sample); };
+    if (onlyHistory) {
+        reader.forEachSampleInHistory(func);
+    } else {
+        reader.forEachSample(func);
+    }
+    return result;
+}
+
+namespace
+{
+    bool operator==(MonitorData const& data1, MonitorData const& data2)
+    {
+        for (int i = 0; i < 7; ++i) {
+            if (data1.numCellsByColor[i] != data2.numCellsByColor[i]) {
+                return false;
+            }
+        }
+        return data1.timeStep == data2.timeStep && data1.numConnections == data2.numConnections && data1.numParticles == data2.numParticles
+            && data1.numTokens == data2.numTokens && data1.totalInternalEnergy == data2.totalInternalEnergy && data1.numCreatedCells == data2.numCreatedCells
+            && data1.numSuccessfulAttacks == data2.numSuccessfulAttacks && data1.numFailedAttacks == data2.numFailedAttacks
+            && data1.numMuscleActivities == data2.numMuscleActivities && data1.garbageCollectionTime == data2.garbageCollectionTime;
+    }
+}
+
+TEST_F(StatisticsLogTests, writeAndRead)
+{
+    {
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{100});
+        for (uint64_t i = 0; i < 1050; ++i) {
+            writer.add(createSample(i * 10));
+        }
+    }
+    StatisticsLogReader reader(_filename);
+    EXPECT_EQ(11, reader.getNumSegments());
+    EXPECT_EQ(1050, reader.getNumSamples());
+
+    auto samples = readSamples(false);
+    ASSERT_EQ(1050, samples.size());
+    for (uint64_t i = 0; i < 1050; ++i) {
+        EXPECT_TRUE(createSample(i * 10) == samples.at(i));
+    }
+}
+
+TEST_F(StatisticsLogTests, bufferedSamplesVisibleAfterFlush)
+{
+    StatisticsLogWriter writer(_filename);
+    writer.add(createSample(1));
+    EXPECT_EQ(0, readSamples(false).size());
+
+    writer.flush();
+    writer.add(createSample(2));
+    writer.flush();
+    auto samples = readSamples(false);
+    ASSERT_EQ(2, samples.size());
+    EXPECT_EQ(2, samples.back().timeStep);
+}
+
+TEST_F(StatisticsLogTests, history)
+{
+    {
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+        for (uint64_t i = 0; i < 100; ++i) {
+            writer.add(createSample(i));
+        }
+
+        //restore of a snapshot at time step 55 within a segment
+        for (uint64_t i = 55; i < 62; ++i) {
+            writer.add(createSample(i));
+        }
+    }
+    {
+        //new writer after a restart, the simulation is loaded at time step 30
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+        for (uint64_t i = 30; i < 40; ++i) {
+            writer.add(createSample(i));
+        }
+    }
+    EXPECT_EQ(117, readSamples(false).size());
+
+    auto samples = readSamples(true);
+    ASSERT_EQ(40, samples.size());
+    for (uint64_t i = 0; i < 40; ++i) {
+        EXPECT_EQ(i, samples.at(i).timeStep);
+    }
+}
+
+TEST_F(StatisticsLogTests, rotation)
+{
+    StatisticsLogParameters parameters;
+    parameters.samplesPerSegment = 10;
+    parameters.maxFileSize = 1;
+    parameters.maxNumFiles = 3;
+    {
+        StatisticsLogWriter writer(_filename, parameters);
+        for (uint64_t i = 0; i < 100; ++i) {
+            writer.add(createSample(i));
+        }
+    }
+    EXPECT_EQ((std::vector<int>{7, 8, 9}), StatisticsLogHelper::getFileIndices(_filename));
+
+    auto samples = readSamples(true);
+    ASSERT_EQ(30, samples.size());
+    EXPECT_EQ(70, samples.front().timeStep);
+}
+
+TEST_F(StatisticsLogTests, incompleteSegmentIgnored)
+{
+    {
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+        for (uint64_t i = 0; i < 20; ++i) {
+            writer.add(createSample(i));
+        }
+    }
+    auto filename = StatisticsLogHelper::getFilename(_filename, 0);
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 5);
+
+    auto samples = readSamples(true);
+    ASSERT_EQ(10, samples.size());
+    EXPECT_EQ(9, samples.back().timeStep);
+
+    //the next writer does not append to the damaged file
+    {
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+        writer.add(createSample(10));
+    }
+    EXPECT_EQ(11, readSamples(true).size());
+}
+
+TEST_F(StatisticsLogTests, sessions)
+{
+    {
+        StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+        writer.startSession();
+        for (uint64_t i = 0; i < 55; ++i) {
+            writer.add(createSample(i));
+        }
+
+        //new simulation starting at a time step which lies beyond the previous one
+        writer.startSession();
+        for (uint64_t i = 100; i < 125; ++i) {
+            writer.add(createSample(i));
+        }
+    }
+    EXPECT_EQ(80, readSamples(false).size());
+
+    auto samples = readSamples(true);
+    ASSERT_EQ(25, samples.size());
+    EXPECT_EQ(100, samples.front().timeStep);
+    EXPECT_EQ(124, samples.back().timeStep);
+}
+
+TEST_F(StatisticsLogTests, sessionWithoutSamples)
+{
+    StatisticsLogWriter writer(_filename, StatisticsLogParameters{10});
+    writer.startSession();
+    for (uint64_t i = 0; i < 20; ++i) {
+        writer.add(createSample(i));
+    }
+    writer.startSession();
+    writer.flush();
+
+    EXPECT_EQ(20, readSamples(false).size());
+    EXPECT_EQ(0, readSamples(true).size());
+}
+
+TEST_F(StatisticsLogTests, DISABLED_benchmark)
+{
+    //one day of samples at the default monitor update interval of 30 ms
+    int const NumSamples = 24 * 60 * 60 * 1000 / 30;
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    {
+        StatisticsLogWriter writer(_filename);
+        for (int i = 0; i < NumSamples; ++i) {
+            writer.add(createSample(i * 3));
+        }
+    }
+    auto writeDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+    startTimepoint = std::chrono::steady_clock::now();
+    uint64_t numSamples = 0;
+    StatisticsLogReader reader(_filename);
+    reader.forEachSampleInHistory([&](MonitorData const&) { ++numSamples; });
+    auto readDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(NumSamples, numSamples);
+
+    uint64_t fileSize = 0;
+    for (auto const& fileIndex : StatisticsLogHelper::getFileIndices(_filename)) {
+        fileSize += std::filesystem::file_size(StatisticsLogHelper::getFilename(_filename, fileIndex));
+    }
+    std::cout << NumSamples << " samples written in " << writeDuration.count() << "ms, read in " << readDuration.count() << "ms, "
+              << fileSize / 1024 << " KB on disk (" << NumSamples * sizeof(MonitorData) / 1024 << " KB in memory)" << std::endl;
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+
+class ThreadPoolTests : public ::testing::Test
+{
+public:
+    ThreadPoolTests() = default;
+    ~ThreadPoolTests() = default;
+
+protected:
+    std::vector<std::pair<int, int>> getChunks(int begin, int end, int grainSize) const;
+};
+
+std::vector<std::pair<int, int>> ThreadPoolTests::getChunks(int begin, int end, int grainSize) const
+{
+    std::mutex mutex;
+    std::vector<std::pair<int, int>> result;
+    ThreadPool::getInstance().parallelFor(
+        begin,
+        end,
+        [&](int startIndex, int endIndex) {
+            std::lock_guard<std::mutex> lock(mutex);
+            result.emplace_back(startIndex, endIndex);
+        },
+        grainSize);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+TEST_F(ThreadPoolTests, emptyRange)
+{
+    EXPECT_TRUE(getChunks(0, 0, 0).empty());
+    EXPECT_TRUE(getChunks(5, 5, 1).empty());
+    EXPECT_TRUE(getChunks(10, 3, 0).empty());
+}
+
+TEST_F(ThreadPoolTests, rangeSplitting)
+{
+    //without worker threads the whole range is processed by the calling thread at once
+    auto isSplit = ThreadPool::getInstance().getNumThreads() > 1;
+
+    auto chunks = getChunks(3, 103, 7);
+    ASSERT_EQ(isSplit ? 15 : 1, toInt(chunks.size()));
+    EXPECT_EQ(3, chunks.front().first);
+    EXPECT_EQ(103, chunks.back().second);
+    for (int i = 0; i < toInt(chunks.size()); ++i) {
+        EXPECT_LT(chunks[i].first, chunks[i].second);
+        if (isSplit) {
+            EXPECT_LE(chunks[i].second - chunks[i].first, 7);
+        }
+        if (i > 0) {
+            EXPECT_EQ(chunks[i - 1].second, chunks[i].first);
+        }
+    }
+}
+
+TEST_F(ThreadPoolTests, automaticGrainSize)
+{
+    int const NumElements = 100000;
+    std::vector<std::atomic<int>> numCalls(NumElements);
+    ThreadPool::getInstance().parallelFor(0, NumElements, [&](int startIndex, int endIndex) {
+        for (int i = startIndex; i < endIndex; ++i) {
+            ++numCalls[i];
+        }
+    });
+    EXPECT_TRUE(std::all_of(numCalls.begin(), numCalls.end(), [](auto const& value) { return value.load() == 1; }));
+}
+
+TEST_F(ThreadPoolTests, singleChunk)
+{
+    auto chunks = getChunks(0, 5, 10);
+    ASSERT_EQ(1, toInt(chunks.size()));
+    EXPECT_EQ(std::make_pair(0, 5), chunks.front());
+}
+
+TEST_F(ThreadPoolTests, nestedCalls)
+{
+    std::atomic<int> sum{0};
+    ThreadPool::getInstance().parallelFor(
+        0,
+        10,
+        [&](int startIndex, int endIndex) {
+            for (int i = startIndex; i < endIndex; ++i) {
+                ThreadPool::getInstance().parallelFor(
+                    0,
+                    100,
+                    [&](int innerStartIndex, int innerEndIndex) { sum += innerEndIndex - innerStartIndex; },
+                    10);
+            }
+        },
+        1);
+    EXPECT_EQ(1000, sum.load());
+}
+
+TEST_F(ThreadPoolTests, exceptionIsRethrown)
+{
+    EXPECT_THROW(
+        ThreadPool::getInstance().parallelFor(
+            0,
+            100,
+            [](int startIndex, int endIndex) {
+                if (startIndex <= 50 && 50 < endIndex) {
+                    throw std::runtime_error("error");
+                }
+            },
+            10),
+        std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests, parallelForThreads)
+{
+    auto numThreads = ThreadPool::getInstance().getNumThreads();
+    std::vector<std::atomic<int>> numCalls(numThreads);
+    ThreadPool::getInstance().parallelForThreads([&](int threadIndex) { ++numCalls.at(threadIndex); });
+    EXPECT_TRUE(std::all_of(numCalls.begin(), numCalls.end(), [](auto const& value) { return value.load() == 1; }));
+}
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/TimeSeries.h"
+
+class TimeSeriesTests : public ::testing::Test
+{
+public:
+    TimeSeriesTests() = default;
+    ~TimeSeriesTests() = default;
+};
+
+TEST_F(TimeSeriesTests, ringBufferIsContiguous)
+{
+    TimeSeriesRingBuffer buffer(2, 4);
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(0.0f, buffer.getLastTime());
+
+    for (int i = 0; i < 10; ++i) {
+        float values[] = {toFloat(i), toFloat(-i)};
+        buffer.add(toFloat(i) * 0.5f, values);
+
+        auto expectedSize = std::min(i + 1, 4);
+        ASSERT_EQ(expectedSize, buffer.getSize());
+        auto firstIndex = i + 1 - expectedSize;
+        for (int j = 0; j < expectedSize; ++j) {
+            EXPECT_EQ(toFloat(firstIndex + j) * 0.5f, buffer.getTimes()[j]);
+            EXPECT_EQ(toFloat(firstIndex + j), buffer.getValues(0)[j]);
+            EXPECT_EQ(toFloat(-firstIndex - j), buffer.getValues(1)[j]);
+        }
+        EXPECT_EQ(toFloat(-i), buffer.getLastValue(1));
+    }
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST_F(TimeSeriesTests, downsampling)
+{
+    DownsampledTimeSeries series(1, 4);
+    for (int i = 0; i < 4; ++i) {
+        float value = toFloat(i);
+        series.add(toFloat(i), &value);
+    }
+    EXPECT_EQ(4, series.getSize());
+    EXPECT_EQ(1, series.getSamplesPerBucket());
+
+    //buckets are merged pairwise when full
+    float value = 4.0f;
+    series.add(4.0f, &value);
+    ASSERT_EQ(3, series.getSize());
+    EXPECT_EQ(2, series.getSamplesPerBucket());
+    EXPECT_EQ(0.0f, series.getTimes()[0]);
+    EXPECT_EQ(2.0f, series.getTimes()[1]);
+    EXPECT_EQ(0.5f, series.getMeans(0)[0]);
+    EXPECT_EQ(0.0f, series.getMins(0)[0]);
+    EXPECT_EQ(1.0f, series.getMaxs(0)[0]);
+    EXPECT_EQ(4.0f, series.getMeans(0)[2]);
+
+    value = 7.0f;
+    series.add(5.0f, &value);
+    EXPECT_EQ(3, series.getSize());
+    EXPECT_EQ(5.5f, series.getMeans(0)[2]);
+    EXPECT_EQ(4.0f, series.getMins(0)[2]);
+    EXPECT_EQ(7.0f, series.getMaxs(0)[2]);
+}
+
+TEST_F(TimeSeriesTests, downsamplingKeepsTotals)
+{
+    DownsampledTimeSeries series(1, 100);
+    int const NumValues = 100000;
+    double sum = 0;
+    for (int i = 0; i < NumValues; ++i) {
+        float value = toFloat(i % 1000);
+        series.add(toFloat(i), &value);
+        sum += value;
+    }
+    EXPECT_LE(series.getSize(), 100);
+    EXPECT_GT(series.getSize(), 50);
+
+    //all buckets except the last one contain getSamplesPerBucket() values
+    auto numValuesInLastBucket = NumValues - (series.getSize() - 1) * series.getSamplesPerBucket();
+    double seriesSum = 0;
+    for (int i = 0; i < series.getSize(); ++i) {
+        auto numValues = i < series.getSize() - 1 ? series.getSamplesPerBucket() : numValuesInLastBucket;
+        seriesSum += series.getMeans(0)[i] * numValues;
+        EXPECT_LE(series.getMins(0)[i], series.getMeans(0)[i]);
+        EXPECT_GE(series.getMaxs(0)[i], series.getMeans(0)[i]);
+    }
+    EXPECT_NEAR(sum, seriesSum, sum * 1e-4);
+}
+
+TEST_F(TimeSeriesTests, DISABLED_benchmark)
+{
+    //a day at 60 frames per second for the live data and one sample per 1000 time steps at 1000 time steps per second for the long-term data
+    int const NumFrames = 60 * 60 * 24 * 60;
+    int const NumColumns = 15;
+    TimeSeriesRingBuffer liveData(NumColumns, 16384);
+    DownsampledTimeSeries longtermData(NumColumns, 2048);
+    float values[NumColumns] = {};
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    for (int i = 0; i < NumFrames; ++i) {
+        values[0] = toFloat(i);
+        liveData.add(toFloat(i) / 60, values);
+        if (i % 60 == 0) {
+            longtermData.add(toFloat(i) * 1000 / 60, values);
+        }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    EXPECT_EQ(16384, liveData.getSize());
+    EXPECT_LE(longtermData.getSize(), 2048);
+    std::cout << NumFrames << " frames added in " << duration.count() << "ms, long-term buckets: " << longtermData.getSize() << " with "
+              << longtermData.getSamplesPerBucket() << " samples each" << std::endl;
+}
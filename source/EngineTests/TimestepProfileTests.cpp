@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <thread>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/TimestepProfile.h"
+#include "IntegrationTestFramework.h"
+
+class TimestepProfileTests : public IntegrationTestFramework
+{
+public:
+    TimestepProfileTests()
+        : IntegrationTestFramework({1000, 1000})
+    {}
+
+    ~TimestepProfileTests() = default;
+
+protected:
+    TimestepProfile createProfile(uint64_t timestep) const;
+};
+
+TimestepProfile TimestepProfileTests::createProfile(uint64_t timestep) const
+{
+    TimestepProfile result;
+    result.timestep = timestep;
+    result.startTime = 1e6 + static_cast<double>(timestep) * 100;
+    result.duration = 100;
+    result.numCells = static_cast<int>(timestep);
+    result.stages = {TimestepStage{"stage 1", 0, 30}, TimestepStage{"stage \"2\"", 30, 60}};
+    if (timestep % 2 == 0) {
+        result.stages.emplace_back(TimestepStage{"stage 3", 90, 10});
+    }
+    return result;
+}
+
+TEST_F(TimestepProfileTests, ringBuffer)
+{
+    TimestepProfileBuffer buffer(10);
+    EXPECT_TRUE(buffer.getProfiles().empty());
+
+    for (uint64_t i = 0; i < 25; ++i) {
+        buffer.add(createProfile(i));
+    }
+    auto profiles = buffer.getProfiles();
+    ASSERT_EQ(10, profiles.size());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(15 + i, profiles.at(i).timestep);
+        EXPECT_EQ(i % 2 == 0 ? 2 : 3, profiles.at(i).stages.size());
+    }
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.getProfiles().empty());
+}
+
+TEST_F(TimestepProfileTests, stageSummaries)
+{
+    std::vector<TimestepProfile> profiles;
+    for (uint64_t i = 0; i < 4; ++i) {
+        profiles.emplace_back(createProfile(i));
+    }
+    profiles.at(1).stages.at(0).duration = 50;
+
+    auto summaries = TimestepProfileHelper::calcStageSummaries(profiles);
+    ASSERT_EQ(3, summaries.size());
+    EXPECT_EQ("stage 1", summaries.at(0).name);
+    EXPECT_FLOAT_EQ(35.0f, summaries.at(0).meanDuration);
+    EXPECT_FLOAT_EQ(50.0f, summaries.at(0).maxDuration);
+    EXPECT_FLOAT_EQ(0.35f, summaries.at(0).share);
+    EXPECT_EQ("stage 3", summaries.at(2).name);
+    EXPECT_FLOAT_EQ(5.0f, summaries.at(2).meanDuration);
+}
+
+TEST_F(TimestepProfileTests, chromeTrace)
+{
+    std::vector<TimestepProfile> profiles;
+    for (uint64_t i = 0; i < 3; ++i) {
+        profiles.emplace_back(createProfile(i));
+    }
+    std::stringstream stream(TimestepProfileHelper::toChromeTrace(profiles));
+    boost::property_tree::ptree tree;
+    ASSERT_NO_THROW(boost::property_tree::read_json(stream, tree));
+
+    int numTimesteps = 0;
+    int numStages = 0;
+    int numCounters = 0;
+    for (auto const& [key, event] : tree.get_child("traceEvents")) {
+        auto phase = event.get<std::string>("ph");
+        if (phase == "X" && event.get<std::string>("cat") == "timestep") {
+            EXPECT_DOUBLE_EQ(numTimesteps * 100.0, event.get<double>("ts"));
+            ++numTimesteps;
+        }
+        if (phase == "X" && event.get<std::string>("cat") == "stage") {
+            ++numStages;
+        }
+        if (phase == "C") {
+            ++numCounters;
+        }
+    }
+    EXPECT_EQ(3, numTimesteps);
+    EXPECT_EQ(8, numStages);
+    EXPECT_EQ(3, numCounters);
+}
+
+TEST_F(TimestepProfileTests, recordTimesteps)
+{
+    auto data = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(10).height(10).center({100, 100}));
+    data.addParticle(ParticleDescription().setPos({500, 500}).setEnergy(10));
+    _simController->setSimulationData(data);
+
+    EXPECT_FALSE(_simController->isTimestepProfilingEnabled());
+    _simController->calcSingleTimestep();
+    EXPECT_TRUE(_simController->getTimestepProfiles().empty());
+
+    _simController->setTimestepProfilingEnabled(true);
+    auto startTimestep = _simController->getCurrentTimestep();
+    for (int i = 0; i < 6; ++i) {
+        _simController->calcSingleTimestep();
+    }
+    _simController->setTimestepProfilingEnabled(false);
+
+    auto profiles = _simController->getTimestepProfiles();
+    ASSERT_EQ(6, profiles.size());
+    for (int i = 0; i < 6; ++i) {
+        auto const& profile = profiles.at(i);
+        EXPECT_EQ(startTimestep + i, profile.timestep);
+        EXPECT_EQ(100, profile.numCells);
+        EXPECT_EQ(1, profile.numParticles);
+        ASSERT_FALSE(profile.stages.empty());
+
+        float sumOfStages = 0;
+        for (auto const& stage : profile.stages) {
+            EXPECT_GE(stage.duration, 0.0f);
+            sumOfStages += stage.duration;
+        }
+        EXPECT_LE(sumOfStages, profile.duration * 1.01f);
+    }
+    auto summaries = TimestepProfileHelper::calcStageSummaries(profiles);
+    EXPECT_TRUE(std::any_of(summaries.begin(), summaries.end(), [](auto const& summary) { return summary.name == "garbage collection"; }));
+}
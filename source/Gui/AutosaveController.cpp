@@ -3,7 +3,7 @@
 #include <imgui.h>
 
 #include "Base/Resources.h"
-#include "EngineInterface/Serializer.h"
+#include "EngineInterface/AutosaveHelper.h"
 #include "GlobalSettings.h"
 
 _AutosaveController::_AutosaveController(SimulationController const& simController)
@@ -23,7 +23,7 @@ void _AutosaveController::shutdown()
     if (!_on) {
         return;
     }
-    onSave();
+    onSave(true);
 }
 
 bool _AutosaveController::isOn() const
@@ -44,7 +44,7 @@ void _AutosaveController::process()
 
     auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
     if (durationSinceStart > 0 && durationSinceStart % 20 == 0 && !_alreadySaved) {
-        onSave();
+        onSave(false);
         _alreadySaved = true;
     }
     if (durationSinceStart > 0 && durationSinceStart % 20 == 1 && _alreadySaved) {
@@ -52,12 +52,7 @@ void _AutosaveController::process()
     }
 }
 
-void _AutosaveController::onSave()
+void _AutosaveController::onSave(bool portable)
 {
-    DeserializedSimulation sim;
-    sim.timestep = _simController->getCurrentTimestep();
-    sim.settings = _simController->getSettings();
-    sim.symbolMap = _simController->getSymbolMap();
-    sim.content = _simController->getClusteredSimulationData();
-    Serializer::serializeSimulationToFiles(Const::AutosaveFile, sim);
+    AutosaveHelper::save(_simController, Const::AutosaveSnapshotFile, Const::AutosaveFile, portable);
 }
@@ -19,7 +19,7 @@ public:
     void process();
 
 private:
-    void onSave();
+    void onSave(bool portable);  //the portable simulation file is only written on shutdown
 
     SimulationController _simController;
 
@@ -5,6 +5,7 @@
 #include "Base/Definitions.h"
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SimulationController.h"
 
@@ -91,7 +92,7 @@ void _ColorizeDialog::onColorize()
     auto timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
     auto settings = _simController->getSettings();
     auto symbolMap = _simController->getSymbolMap();
-    auto content = _simController->getClusteredSimulationData();
+    auto content = _simController->getBulkSimulationData();
 
     std::vector<int> colorCodes;
     for (int i = 0; i < 7; ++i) {
@@ -103,5 +104,5 @@ void _ColorizeDialog::onColorize()
 
     _simController->closeSimulation();
     _simController->newSimulation(timestep, settings, symbolMap);
-    _simController->setClusteredSimulationData(content);
+    _simController->setBulkSimulationData(content);
 }
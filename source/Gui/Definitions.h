@@ -58,6 +58,9 @@ using ColorizeDialog = std::shared_ptr<_ColorizeDialog>;
 class _LogWindow;
 using LogWindow = std::shared_ptr<_LogWindow>;
 
+class _ProfilerWindow;
+using ProfilerWindow = std::shared_ptr<_ProfilerWindow>;
+
 class _SimpleLogger;
 using SimpleLogger = std::shared_ptr<_SimpleLogger>;
 
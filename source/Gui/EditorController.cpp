@@ -231,9 +231,8 @@ void _EditorController::processInspectorWindows()
     for (auto const& entity : inspectedEntities) {
         entityIds.emplace_back(DescriptionHelper::getId(entity));
     }
-    auto inspectedData = _simController->getInspectedSimulationData(entityIds);
-    auto newInspectedEntities = DescriptionHelper::getEntities(inspectedData);
-    _editorModel->setInspectedEntities(newInspectedEntities);
+    auto inspectedDataDelta = _simController->getInspectedSimulationDataDelta(entityIds, _editorModel->getInspectedEntitiesEpoch());
+    _editorModel->updateInspectedEntities(inspectedDataDelta);
 
     inspectorWindows.clear();
     for (auto const& inspectorWindow : _inspectorWindows) {
@@ -70,6 +70,25 @@ void _EditorModel::setInspectedEntities(std::vector<CellOrParticleDescription> c
     }
 }
 
+void _EditorModel::updateInspectedEntities(DataDescriptionDelta const& inspectedEntitiesDelta)
+{
+    _inspectedEntitiesEpoch = inspectedEntitiesDelta.epoch;
+    if (inspectedEntitiesDelta.complete) {
+        _inspectedEntityById.clear();
+    }
+    for (auto const& id : inspectedEntitiesDelta.removedIds) {
+        _inspectedEntityById.erase(id);
+    }
+    for (auto const& entity : DescriptionHelper::getEntities(inspectedEntitiesDelta.changedData)) {
+        _inspectedEntityById.insert_or_assign(DescriptionHelper::getId(entity), entity);
+    }
+}
+
+uint64_t _EditorModel::getInspectedEntitiesEpoch() const
+{
+    return _inspectedEntitiesEpoch;
+}
+
 bool _EditorModel::areEntitiesInspected() const
 {
     return !_inspectedEntityById.empty();
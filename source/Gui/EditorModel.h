@@ -25,6 +25,8 @@ public:
     CellOrParticleDescription getInspectedEntity(uint64_t id) const;
     void addInspectedEntity(CellOrParticleDescription const& entity);
     void setInspectedEntities(std::vector<CellOrParticleDescription> const& inspectedEntities);
+    void updateInspectedEntities(DataDescriptionDelta const& inspectedEntitiesDelta);
+    uint64_t getInspectedEntitiesEpoch() const;
     bool areEntitiesInspected() const;
 
     void setDrawMode(bool value);
@@ -44,6 +46,7 @@ private:
 
     std::vector<CellOrParticleDescription> _entitiesToInspect;
     std::unordered_map<uint64_t, CellOrParticleDescription> _inspectedEntityById;
+    uint64_t _inspectedEntitiesEpoch = 0;
     bool _drawMode = false;
     int _defaultColorCode = 0;
     bool _rolloutToClusters = true;
@@ -4,11 +4,16 @@
 #include <ImFileDialog.h>
 
 #include "Base/Definitions.h"
+#include "Base/Resources.h"
+#include "EngineInterface/MonitorDataFormatter.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineInterface/StatisticsLog.h"
 
 #include "GlobalSettings.h"
 #include "MessageDialog.h"
 
-_ExportStatisticsDialog::_ExportStatisticsDialog()
+_ExportStatisticsDialog::_ExportStatisticsDialog(SimulationController const& simController)
+    : _simController(simController)
 {
     auto path = std::filesystem::current_path();
     if (path.has_parent_path()) {
@@ -24,6 +29,8 @@ _ExportStatisticsDialog::~_ExportStatisticsDialog()
 
 void _ExportStatisticsDialog::process()
 {
+    processExportResult();
+
     if (!ifd::FileDialog::Instance().IsDone("ExportStatisticsDialog")) {
         return;
     }
@@ -38,34 +45,46 @@ void _ExportStatisticsDialog::process()
     ifd::FileDialog::Instance().Close();
 }
 
-void _ExportStatisticsDialog::show(LongtermStatistics const& longtermStatistics)
+void _ExportStatisticsDialog::show()
 {
-    _statistics = longtermStatistics;
     ifd::FileDialog::Instance().Save("ExportStatisticsDialog", "Export statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
 }
 
 void _ExportStatisticsDialog::onSaveStatistics(std::string const& filename)
 {
-    for (auto const& data : _statistics.datas) {
-        CHECK(_statistics.timestepHistory.size() == _statistics.datas[0].size());
-    }
-
-    std::ofstream file;
-    file.open(filename, std::ios_base::out);
-    if (!file) {
-        MessageDialog::getInstance().show("Export statistics", "The statistics could not be saved to the specified file.");
+    if (_exportTask.valid()) {
+        MessageDialog::getInstance().show("Export statistics", "The previous export has not been finished yet.");
         return;
     }
+    _simController->flushStatisticsLog();
+
+    _exportTask = std::async(std::launch::async, [filename]() -> std::string {
+        std::ofstream file;
+        file.open(filename, std::ios_base::out);
+        if (!file) {
+            return "The statistics could not be saved to the specified file.";
+        }
+
+        file << MonitorDataFormatter::getCsvHeader() << std::endl;
 
-    file << "time step, cells, cells (color 0), cells (color 1), cells (color 2), cells (color 3), cells (color 4), cells (color 5), cells (color 6), "
-         << "cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities"
-         << std::endl;
-    for (int i = 0; i < _statistics.timestepHistory.size(); ++i) {
-        file << static_cast<uint64_t>(_statistics.timestepHistory.at(i));
-        for (int j = 0; j <= 14; ++j) {
-            file << ", " << static_cast<uint64_t>(_statistics.datas[j].at(i));
+        //all samples of the current history are exported in full resolution
+        try {
+            StatisticsLogReader reader(Const::StatisticsLogFile);
+            reader.forEachSampleInHistory([&](MonitorData const& sample) { file << MonitorDataFormatter::getCsvRow(sample) << "\n"; });
+        } catch (std::exception const& e) {
+            return std::string("The statistics log could not be read: ") + e.what();
         }
-        file << std::endl;
+        return "";
+    });
+}
+
+void _ExportStatisticsDialog::processExportResult()
+{
+    if (!_exportTask.valid() || _exportTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    auto errorMessage = _exportTask.get();
+    if (!errorMessage.empty()) {
+        MessageDialog::getInstance().show("Export statistics", errorMessage);
     }
-    file.close();
 }
@@ -1,23 +1,26 @@
 #pragma once
 
+#include <future>
+
 #include "EngineInterface/Definitions.h"
 
-#include "StatisticsHistory.h"
 #include "Definitions.h"
 
 class _ExportStatisticsDialog
 {
 public:
-    _ExportStatisticsDialog();
+    _ExportStatisticsDialog(SimulationController const& simController);
     ~_ExportStatisticsDialog();
 
     void process();
 
-    void show(LongtermStatistics const& longtermStatistics);
+    void show();
 
 private:
     void onSaveStatistics(std::string const& filename);
+    void processExportResult();
 
+    SimulationController _simController;
     std::string _startingPath;
-    LongtermStatistics _statistics;
+    std::future<std::string> _exportTask;  //the statistics log is decoded in the background, returns an error message on failure
 };
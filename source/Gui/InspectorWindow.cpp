@@ -181,10 +181,10 @@ void _InspectorWindow::processCell(CellDescription cell)
         //fill up with zeros
         auto constDataMaxSize = CellComputationCompiler::getMaxBytes(parameters);
         if (constDataMaxSize > cell.cellFeature.constData.size()) {
-            cell.cellFeature.constData.append(constDataMaxSize - cell.cellFeature.constData.size(), 0);
+            cell.cellFeature.constData = cell.cellFeature.constData.str() + std::string(constDataMaxSize - cell.cellFeature.constData.size(), 0);
         }
         if (constDataMaxSize > origCell.cellFeature.constData.size()) {
-            origCell.cellFeature.constData.append(constDataMaxSize - origCell.cellFeature.constData.size(), 0);
+            origCell.cellFeature.constData = origCell.cellFeature.constData.str() + std::string(constDataMaxSize - origCell.cellFeature.constData.size(), 0);
         }
 
         if (hasChanges(cell, origCell)) {
@@ -234,10 +234,14 @@ void _InspectorWindow::showCellGeneralTab(CellDescription& cell)
 
         AlienImGui::Group("Metadata");
 
-        AlienImGui::InputText(AlienImGui::InputTextParameters().name("Name").textWidth(MaxCellContentTextWidth), cell.metadata.name);
+        auto name = cell.metadata.name.str();
+        AlienImGui::InputText(AlienImGui::InputTextParameters().name("Name").textWidth(MaxCellContentTextWidth), name);
+        cell.metadata.name = name;
 
+        auto description = cell.metadata.description.str();
         AlienImGui::InputTextMultiline(
-            AlienImGui::InputTextMultilineParameters().name("Notes").textWidth(MaxCellContentTextWidth).height(0), cell.metadata.description);
+            AlienImGui::InputTextMultilineParameters().name("Notes").textWidth(MaxCellContentTextWidth).height(0), description);
+        cell.metadata.description = description;
 
         ImGui::EndTabItem();
     }
@@ -257,7 +261,7 @@ void _InspectorWindow::showCellCodeTab(CellDescription& cell)
                     _simController->getSymbolMap(),
                     _simController->getSimulationParameters());
             }
-            return cell.metadata.computerSourcecode;
+            return cell.metadata.computerSourcecode.str();
         }();
         StringHelper::copy(_cellCode, IM_ARRAYSIZE(_cellCode), origSourcecode);
         ImGui::PushFont(StyleRepository::getInstance().getMonospaceFont());
@@ -275,7 +279,7 @@ void _InspectorWindow::showCellCodeTab(CellDescription& cell)
         if (sourcecode != origSourcecode || !_lastCompilationResult) {
             _lastCompilationResult =
                 std::make_shared<CompilationResult>(
-                CellComputationCompiler::compileSourceCode(sourcecode, _simController->getSymbolMap(), _simController->getSimulationParameters()));
+                CellComputationCompiler::compileSourceCode(sourcecode, _simController->getSymbolTable(), _simController->getSimulationParameters()));
             if (_lastCompilationResult->compilationOk) {
                 cell.cellFeature.constData = _lastCompilationResult->compilation;
             }
@@ -299,7 +303,7 @@ void _InspectorWindow::showCellMemoryTab(CellDescription& cell)
             ImGui::PushFont(StyleRepository::getInstance().getMonospaceFont());
 
             auto dataSize = cell.cellFeature.constData.size();
-            cell.cellFeature.constData.copy(_cellMemory, dataSize);
+            cell.cellFeature.constData.str().copy(_cellMemory, dataSize);
             auto maxDataSize = CellComputationCompiler::getMaxBytes(parameters);
             for (int i = dataSize; i < maxDataSize; ++i) {
                 _cellMemory[i] = 0;
@@ -314,7 +318,7 @@ void _InspectorWindow::showCellMemoryTab(CellDescription& cell)
             AlienImGui::Group("Data section");
             ImGui::PushFont(StyleRepository::getInstance().getMonospaceFont());
             auto dataSize = cell.cellFeature.volatileData.size();
-            cell.cellFeature.volatileData.copy(_cellMemory, dataSize);
+            cell.cellFeature.volatileData.str().copy(_cellMemory, dataSize);
             _cellInstructionMemoryEdit->DrawContents(reinterpret_cast<void*>(_cellMemory), dataSize);
             cell.cellFeature.volatileData = std::string(_cellMemory, dataSize);
             ImGui::PopFont();
@@ -19,6 +19,7 @@ int main(int, char**)
 
     try {
         simController = std::make_shared<_SimulationControllerImpl>();
+        simController->enableStatisticsLog(Const::StatisticsLogFile);
         mainWindow = std::make_shared<_MainWindow>(simController, logger);
 
         simController->initCuda();
@@ -40,6 +40,7 @@
 #include "AboutDialog.h"
 #include "ColorizeDialog.h"
 #include "LogWindow.h"
+#include "ProfilerWindow.h"
 #include "SimpleLogger.h"
 #include "UiController.h"
 #include "GlobalSettings.h"
@@ -141,6 +142,7 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
     _aboutDialog = std::make_shared<_AboutDialog>();
     _colorizeDialog = std::make_shared<_ColorizeDialog>(_simController);
     _logWindow = std::make_shared<_LogWindow>(_logger);
+    _profilerWindow = std::make_shared<_ProfilerWindow>(_simController);
     _gettingStartedWindow = std::make_shared<_GettingStartedWindow>();
     _newSimulationDialog = std::make_shared<_NewSimulationDialog>(_simController, _temporalControlWindow, _viewport, _statisticsWindow);
     _openSimulationDialog = std::make_shared<_OpenSimulationDialog>(_simController, _temporalControlWindow, _statisticsWindow, _viewport);
@@ -444,6 +446,9 @@ void _MainWindow::processMenubar()
             if (ImGui::MenuItem("Log", "ALT+6", _logWindow->isOn())) {
                 _logWindow->setOn(!_logWindow->isOn());
             }
+            if (ImGui::MenuItem("Profiler", "ALT+7", _profilerWindow->isOn())) {
+                _profilerWindow->setOn(!_profilerWindow->isOn());
+            }
             AlienImGui::EndMenuButton();
         }
 
@@ -611,6 +616,9 @@ void _MainWindow::processMenubar()
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_6)) {
             _logWindow->setOn(!_logWindow->isOn());
         }
+        if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_7)) {
+            _profilerWindow->setOn(!_profilerWindow->isOn());
+        }
 
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_E)) {
             _modeController->setMode(
@@ -709,6 +717,7 @@ void _MainWindow::processWindows()
     _simulationParametersWindow->process();
     _flowGeneratorWindow->process();
     _logWindow->process();
+    _profilerWindow->process();
     _browserWindow->process();
     _gettingStartedWindow->process();
 }
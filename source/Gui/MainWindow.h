@@ -44,6 +44,7 @@ private:
     StatisticsWindow _statisticsWindow;
     FlowGeneratorWindow _flowGeneratorWindow;
     LogWindow _logWindow;
+    ProfilerWindow _profilerWindow;
     GettingStartedWindow _gettingStartedWindow;
     BrowserWindow _browserWindow;
 
@@ -8,6 +8,7 @@
 #include <ImFileDialog.h>
 
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/PatternAnalysis.h"
 #include "EngineInterface/Serializer.h"
 #include "EngineInterface/SimulationController.h"
 #include "GlobalSettings.h"
@@ -51,7 +52,7 @@ void _PatternAnalysisDialog::show()
 
 void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename)
 {
-    auto const partitionClassDataByDescription = calcPartitionData();
+    auto partitionData = calcRepetitiveActiveClusters();
 
     std::ofstream file;
     file.open(filename, std::ios_base::out);
@@ -60,13 +61,6 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
         return;
     }
 
-    int sum = 0;
-    std::vector<PartitionClassData> partitionData;
-    for (auto const& [analysisDesc, partitionClassData] : partitionClassDataByDescription) {
-        if (partitionClassData.numberOfElements > 1 && analysisDesc.hasToken) {
-            partitionData.emplace_back(partitionClassData);
-        }
-    }
     std::sort(partitionData.begin(), partitionData.end());
 
     file << "number of repetitive active clusters: " << partitionData.size() << std::endl << std::endl;
@@ -97,59 +91,14 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
     MessageDialog::getInstance().show("Analysis result", messageStream.str());
 }
 
-auto _PatternAnalysisDialog::calcPartitionData() const -> std::map<ClusterAnalysisDescription, PartitionClassData>
+auto _PatternAnalysisDialog::calcRepetitiveActiveClusters() const -> std::vector<PartitionClassData>
 {
     auto data = _simController->getClusteredSimulationData();
 
-    std::map<ClusterAnalysisDescription, PartitionClassData> result;
-
-    for (auto const& cluster : data.clusters) {
-        auto const clusterAnalysisData = getAnalysisDescription(cluster);
-        auto& partitionData = result[clusterAnalysisData];
-        if (1 == ++partitionData.numberOfElements) {
-            partitionData.representant = cluster;
-        }
-    }
-    return result;
-}
-
-auto _PatternAnalysisDialog::getAnalysisDescription(ClusterDescription const& cluster) const -> ClusterAnalysisDescription
-{
-    ClusterAnalysisDescription result;
-    result.hasToken = false;
-
-    std::map<uint64_t, CellAnalysisDescription> cellAnalysisDescById;
-    auto insertCellAnalysisDescription = [&cellAnalysisDescById](CellDescription const& cell) {
-        if (cellAnalysisDescById.find(cell.id) == cellAnalysisDescById.end()) {
-            CellAnalysisDescription result;
-            result.maxConnections = cell.maxConnections;
-            result.numConnections = cell.connections.size();
-            result.tokenBlocked = cell.tokenBlocked;
-            result.tokenBranchNumber = cell.tokenBranchNumber;
-            //            result.color = cell.metadata.color;
-
-            CellFeatureAnalysisDescription featureAnalysisData;
-            featureAnalysisData.cellFunction = cell.cellFeature.getType();
-            result.feature = featureAnalysisData;
-
-            cellAnalysisDescById.insert_or_assign(cell.id, result);
-        }
-    };
-
-    std::map<uint64_t, int> cellDescIndexById;
-    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
-        cellDescIndexById.insert_or_assign(cell.id, toInt(index));
-    }
-
-    for (auto const& cell : cluster.cells) {
-        insertCellAnalysisDescription(cell);
-        for (auto const& connection : cell.connections) {
-            auto connectingCellId = connection.cellId;
-            insertCellAnalysisDescription(cluster.cells.at(cellDescIndexById.at(connectingCellId)));
-            result.connectedCells.insert(std::set<CellAnalysisDescription>{cellAnalysisDescById.at(cell.id), cellAnalysisDescById.at(connectingCellId)});
-        }
-        if (cell.tokens.size() > 0) {
-            result.hasToken = true;
+    std::vector<PartitionClassData> result;
+    for (auto const& partitionClass : PatternAnalysis::calcPartitionClasses(data.clusters)) {
+        if (partitionClass.numberOfElements > 1 && partitionClass.hasToken) {
+            result.emplace_back(PartitionClassData{partitionClass.numberOfElements, data.clusters.at(partitionClass.representantIndex)});
         }
     }
     return result;
@@ -0,0 +1,139 @@
+#include "ProfilerWindow.h"
+
+#include <fstream>
+
+#include <imgui.h>
+#include <ImFileDialog.h>
+
+#include "Base/StringHelper.h"
+#include "EngineInterface/SimulationController.h"
+
+#include "AlienImGui.h"
+#include "GlobalSettings.h"
+#include "MessageDialog.h"
+#include "StyleRepository.h"
+
+namespace
+{
+    auto const UpdateInterval = std::chrono::milliseconds(500);
+}
+
+_ProfilerWindow::_ProfilerWindow(SimulationController const& simController)
+    : _AlienWindow("Profiler", "windows.profiler", false)
+    , _simController(simController)
+{
+    auto path = std::filesystem::current_path();
+    if (path.has_parent_path()) {
+        path = path.parent_path();
+    }
+    _startingPath = GlobalSettings::getInstance().getStringState("windows.profiler.starting path", path.string());
+}
+
+_ProfilerWindow::~_ProfilerWindow()
+{
+    GlobalSettings::getInstance().setStringState("windows.profiler.starting path", _startingPath);
+}
+
+void _ProfilerWindow::processIntern()
+{
+    auto recording = _simController->isTimestepProfilingEnabled();
+    if (AlienImGui::ToggleButton(
+            AlienImGui::ToggleButtonParameters().name("Record").tooltip("Measures the stages of the last time steps. The measurement slows down the simulation."),
+            recording)) {
+        _simController->setTimestepProfilingEnabled(recording);
+        _lastUpdateTimepoint.reset();
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(_numProfiles == 0);
+    if (AlienImGui::Button("Export")) {
+        ifd::FileDialog::Instance().Save("ExportTimestepProfilesDialog", "Export time step profiles", "Trace event format (*.json){.json},.*", _startingPath);
+    }
+    ImGui::EndDisabled();
+
+    updateSummaries();
+
+    ImGui::Spacing();
+    AlienImGui::Text(
+        std::to_string(_numProfiles) + " time steps, mean duration: " + StringHelper::format(_meanDuration / 1000.0f, 2) + " ms, cells: "
+        + StringHelper::format(static_cast<uint64_t>(_lastProfile.numCells)) + ", particles: " + StringHelper::format(static_cast<uint64_t>(_lastProfile.numParticles))
+        + ", tokens: " + StringHelper::format(static_cast<uint64_t>(_lastProfile.numTokens)));
+    ImGui::Spacing();
+
+    if (ImGui::BeginTable("##", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_ScrollY, ImVec2(-1, -1))) {
+        auto const& styleRepository = StyleRepository::getInstance();
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Mean [us]", ImGuiTableColumnFlags_WidthFixed, styleRepository.scaleContent(80.0f));
+        ImGui::TableSetupColumn("Max [us]", ImGuiTableColumnFlags_WidthFixed, styleRepository.scaleContent(80.0f));
+        ImGui::TableSetupColumn("Share", ImGuiTableColumnFlags_WidthFixed, styleRepository.scaleContent(120.0f));
+        ImGui::TableHeadersRow();
+
+        for (auto const& summary : _stageSummaries) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            AlienImGui::Text(summary.name);
+            ImGui::TableSetColumnIndex(1);
+            AlienImGui::Text(StringHelper::format(summary.meanDuration, 1));
+            ImGui::TableSetColumnIndex(2);
+            AlienImGui::Text(StringHelper::format(summary.maxDuration, 1));
+            ImGui::TableSetColumnIndex(3);
+            ImGui::ProgressBar(summary.share, ImVec2(-1, 0), (StringHelper::format(summary.share * 100, 1) + "%").c_str());
+        }
+        ImGui::EndTable();
+    }
+}
+
+void _ProfilerWindow::processBackground()
+{
+    processExportDialog();
+
+    //profiling is only active as long as its results are visible
+    if (!_on && _simController->isTimestepProfilingEnabled()) {
+        _simController->setTimestepProfilingEnabled(false);
+    }
+}
+
+void _ProfilerWindow::processExportDialog()
+{
+    if (!ifd::FileDialog::Instance().IsDone("ExportTimestepProfilesDialog")) {
+        return;
+    }
+    if (ifd::FileDialog::Instance().HasResult()) {
+        auto firstFilename = ifd::FileDialog::Instance().GetResult();
+        auto firstFilenameCopy = firstFilename;
+        _startingPath = firstFilenameCopy.remove_filename().string();
+
+        onExport(firstFilename.string());
+    }
+    ifd::FileDialog::Instance().Close();
+}
+
+void _ProfilerWindow::onExport(std::string const& filename)
+{
+    std::ofstream file;
+    file.open(filename, std::ios_base::out);
+    if (!file) {
+        MessageDialog::getInstance().show("Export time step profiles", "The profiles could not be saved to the specified file.");
+        return;
+    }
+    file << TimestepProfileHelper::toChromeTrace(_simController->getTimestepProfiles());
+    file.close();
+}
+
+void _ProfilerWindow::updateSummaries()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (_lastUpdateTimepoint && now - *_lastUpdateTimepoint < UpdateInterval) {
+        return;
+    }
+    _lastUpdateTimepoint = now;
+
+    auto profiles = _simController->getTimestepProfiles();
+    _stageSummaries = TimestepProfileHelper::calcStageSummaries(profiles);
+    _numProfiles = toInt(profiles.size());
+    _meanDuration = 0;
+    for (auto const& profile : profiles) {
+        _meanDuration += profile.duration / profiles.size();
+    }
+    _lastProfile = profiles.empty() ? TimestepProfile() : profiles.back();
+}
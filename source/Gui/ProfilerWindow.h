@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/TimestepProfile.h"
+
+#include "Definitions.h"
+#include "AlienWindow.h"
+
+class _ProfilerWindow : public _AlienWindow
+{
+public:
+    _ProfilerWindow(SimulationController const& simController);
+    ~_ProfilerWindow();
+
+private:
+    void processIntern() override;
+    void processBackground() override;
+
+    void processExportDialog();
+    void onExport(std::string const& filename);
+    void updateSummaries();
+
+    SimulationController _simController;
+    std::string _startingPath;
+
+    //summaries of the recorded time steps, updated periodically
+    std::optional<std::chrono::steady_clock::time_point> _lastUpdateTimepoint;
+    std::vector<TimestepStageSummary> _stageSummaries;
+    int _numProfiles = 0;
+    float _meanDuration = 0;
+    TimestepProfile _lastProfile;
+};
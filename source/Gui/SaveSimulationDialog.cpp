@@ -3,6 +3,7 @@
 #include <imgui.h>
 #include <ImFileDialog.h>
 
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/SimulationController.h"
 #include "EngineInterface/Serializer.h"
 #include "GlobalSettings.h"
@@ -37,9 +38,8 @@ void _SaveSimulationDialog::process()
         sim.timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
         sim.settings = _simController->getSettings();
         sim.symbolMap = _simController->getSymbolMap();
-        sim.content = _simController->getClusteredSimulationData();
 
-        if (!Serializer::serializeSimulationToFiles(firstFilename.string(), sim)) {
+        if (!Serializer::serializeSimulationToFiles(firstFilename.string(), sim, _simController->getBulkSimulationData())) {
             MessageDialog::getInstance().show("Save simulation", "The simulation could not be saved to the specified file.");
         }
     }
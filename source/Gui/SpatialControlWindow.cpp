@@ -4,14 +4,17 @@
 
 #include "Fonts/IconsFontAwesome5.h"
 
+#include "Base/LoggingService.h"
 #include "Base/StringHelper.h"
 #include "Base/Resources.h"
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SimulationController.h"
 #include "StyleRepository.h"
 #include "Viewport.h"
 #include "GlobalSettings.h"
 #include "AlienImGui.h"
+#include "MessageDialog.h"
 
 _SpatialControlWindow::_SpatialControlWindow(SimulationController const& simController, Viewport const& viewport)
     : _AlienWindow("Spatial control", "windows.spatial control", true)
@@ -78,6 +81,7 @@ void _SpatialControlWindow::processIntern()
 void _SpatialControlWindow::processBackground()
 {
     processCenterOnSelection();
+    processResizeProgress();
 }
 
 void _SpatialControlWindow::processZoomInButton()
@@ -171,24 +175,63 @@ void _SpatialControlWindow::processCenterOnSelection()
     }
 }
 
-void _SpatialControlWindow::onResizing()
+void _SpatialControlWindow::processResizeProgress()
 {
-    auto timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
-    auto settings = _simController->getSettings();
-    auto symbolMap = _simController->getSymbolMap();
-    auto content = _simController->getClusteredSimulationData();
+    if (!_resizeTask.valid()) {
+        return;
+    }
+    auto isFinished = _resizeTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 
-    _simController->closeSimulation();
+    if (!isFinished) {
+        ImGui::OpenPopup("Resizing world");
+    }
+    ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    if (ImGui::BeginPopupModal("Resizing world", NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
+        auto progress = _resizeProgress.load();
+        ImGui::ProgressBar(progress, ImVec2(StyleRepository::getInstance().scaleContent(300.0f), 0), (StringHelper::format(progress * 100, 0) + "%").c_str());
+        if (isFinished) {
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
 
-    IntVector2D origWorldSize{settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY};
-    settings.generalSettings.worldSizeX = _width;
-    settings.generalSettings.worldSizeY = _height;
-    
-    _simController->newSimulation(timestep, settings, symbolMap);
-
-    DescriptionHelper::correctConnections(content, {_width, _height});
-    if (_scaleContent) {
-        DescriptionHelper::duplicate(content, origWorldSize, {_width, _height});
+    if (isFinished) {
+        try {
+            auto content = _resizeTask.get();
+
+            auto timestep = _simController->getCurrentTimestep();
+            auto settings = _simController->getSettings();
+            auto symbolMap = _simController->getSymbolMap();
+            settings.generalSettings.worldSizeX = _resizeWorldSize.x;
+            settings.generalSettings.worldSizeY = _resizeWorldSize.y;
+
+            _simController->closeSimulation();
+            _simController->newSimulation(timestep, settings, symbolMap);
+            _simController->setBulkSimulationData(content);
+        } catch (std::exception const& e) {
+            MessageDialog::getInstance().show("Resize world", std::string("The world could not be resized: ") + e.what());
+        }
     }
-    _simController->setClusteredSimulationData(content);
+}
+
+void _SpatialControlWindow::onResizing()
+{
+    //the old simulation is kept (paused) until the content of the resized world is computed,
+    //hence autosave and shutdown meanwhile persist the old world instead of an incomplete one
+    _simController->pauseSimulation();
+
+    auto settings = _simController->getSettings();
+    IntVector2D origWorldSize{settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY};
+    _resizeWorldSize = {_width, _height};
+    auto content = _simController->getBulkSimulationData();
+
+    _resizeProgress = 0.0f;
+    _resizeTask = std::async(
+        std::launch::async, [this, content = std::move(content), origWorldSize, worldSize = _resizeWorldSize, scaleContent = _scaleContent]() mutable {
+            DescriptionHelper::correctConnections(content, worldSize);
+            if (scaleContent) {
+                DescriptionHelper::duplicate(content, origWorldSize, worldSize, [this](float progress) { _resizeProgress = progress; });
+            }
+            return std::move(content);
+        });
 }
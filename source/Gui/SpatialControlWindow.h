@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <future>
+
+#include "EngineInterface/BulkDataDescription.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 
@@ -21,6 +25,7 @@ private:
 
     void processResizeDialog();
     void processCenterOnSelection();
+    void processResizeProgress();
 
     void onResizing();
 
@@ -32,4 +37,9 @@ private:
     bool _centerSelection = false;
     int _width = 0;
     int _height = 0;
+
+    //the content of the resized world is computed in the background while a progress bar is shown
+    std::future<BulkDataDescription> _resizeTask;
+    IntVector2D _resizeWorldSize;
+    std::atomic<float> _resizeProgress{0.0f};
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 #include "Base/Definitions.h"
 #include "Base/Resources.h"
-#include "EngineInterface/Serializer.h"
+#include "EngineInterface/AutosaveHelper.h"
 #include "EngineInterface/SimulationController.h"
 #include "OpenGLHelper.h"
 #include "Viewport.h"
@@ -43,14 +43,14 @@ void _StartupController::process()
 
     if (_state == State::RequestLoading) {
         DeserializedSimulation deserializedData;
-        if (!Serializer::deserializeSimulationFromFiles(deserializedData, Const::AutosaveFile)) {
+        if (!AutosaveHelper::load(_simController, Const::AutosaveSnapshotFile, Const::AutosaveFile, deserializedData)) {
             MessageDialog::getInstance().show("Error", "The default simulation file could not be read. An empty simulation will be created.");
+            deserializedData = DeserializedSimulation();
+            deserializedData.timestep = 0;
             deserializedData.settings.generalSettings.worldSizeX = 1000;
             deserializedData.settings.generalSettings.worldSizeY = 500;
+            _simController->newSimulation(deserializedData.timestep, deserializedData.settings, deserializedData.symbolMap);
         }
-
-        _simController->newSimulation(deserializedData.timestep, deserializedData.settings, deserializedData.symbolMap);
-        _simController->setClusteredSimulationData(deserializedData.content);
         _viewport->setCenterInWorldPos(
             {toFloat(deserializedData.settings.generalSettings.worldSizeX) / 2,
              toFloat(deserializedData.settings.generalSettings.worldSizeY) / 2});
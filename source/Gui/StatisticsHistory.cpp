@@ -4,57 +4,44 @@
 
 #include <imgui.h>
 
-void LiveStatistics::truncate()
+namespace
 {
-    if (!timepointsHistory.empty() && timepointsHistory.back() - timepointsHistory.front() > (MaxLiveHistory + 1.0f)) {
-        timepointsHistory.erase(timepointsHistory.begin());
-        for(auto& data : datas) {
-            data.erase(data.begin());
+    std::array<float, NumStatisticsColumns> getValues(MonitorData const& statistics)
+    {
+        std::array<float, NumStatisticsColumns> result;
+        int numCells = 0;
+        for (int i = 0; i < 7; ++i) {
+            numCells += statistics.numCellsByColor[i];
+        }
+        result[0] = toFloat(numCells);
+        for (int i = 0; i < 7; ++i) {
+            result[1 + i] = toFloat(statistics.numCellsByColor[i]);
         }
+        result[8] = toFloat(statistics.numConnections);
+        result[9] = toFloat(statistics.numParticles);
+        result[10] = toFloat(statistics.numTokens);
+        result[11] = toFloat(statistics.numCreatedCells);
+        result[12] = toFloat(statistics.numSuccessfulAttacks);
+        result[13] = toFloat(statistics.numFailedAttacks);
+        result[14] = toFloat(statistics.numMuscleActivities);
+        result[15] = toFloat(statistics.garbageCollectionTime);
+        return result;
     }
 }
 
 void LiveStatistics::add(MonitorData const& newStatistics)
 {
-    truncate();
-
     timepoint += ImGui::GetIO().DeltaTime;
-    timepointsHistory.emplace_back(timepoint);
-    int numCells = 0;
-    for (int i = 0; i < 7; ++i) {
-        numCells += newStatistics.numCellsByColor[i];
-    }
-    datas[0].emplace_back(toFloat(numCells));
-    for (int i = 0; i < 7; ++i) {
-        datas[1 + i].emplace_back(toFloat(newStatistics.numCellsByColor[i]));
+    if (!datas.isEmpty() && timepoint - datas.getLastTime() < MinSampleInterval) {
+        return;
     }
-    datas[8].emplace_back(toFloat(newStatistics.numConnections));
-    datas[9].emplace_back(toFloat(newStatistics.numParticles));
-    datas[10].emplace_back(toFloat(newStatistics.numTokens));
-    datas[11].emplace_back(toFloat(newStatistics.numCreatedCells));
-    datas[12].emplace_back(toFloat(newStatistics.numSuccessfulAttacks));
-    datas[13].emplace_back(toFloat(newStatistics.numFailedAttacks));
-    datas[14].emplace_back(toFloat(newStatistics.numMuscleActivities));
+    datas.add(timepoint, getValues(newStatistics).data());
 }
 
 void LongtermStatistics::add(MonitorData const& newStatistics)
 {
-    if (timestepHistory.empty() || newStatistics.timeStep - timestepHistory.back() > LongtermTimestepDelta) {
-        timestepHistory.emplace_back(toFloat(newStatistics.timeStep));
-        int numCells = 0;
-        for (int i = 0; i < 7; ++i) {
-            numCells += newStatistics.numCellsByColor[i];
-        }
-        datas[0].emplace_back(toFloat(numCells));
-        for (int i = 0; i < 7; ++i) {
-            datas[1 + i].emplace_back(toFloat(newStatistics.numCellsByColor[i]));
-        }
-        datas[8].emplace_back(toFloat(newStatistics.numConnections));
-        datas[9].emplace_back(toFloat(newStatistics.numParticles));
-        datas[10].emplace_back(toFloat(newStatistics.numTokens));
-        datas[11].emplace_back(toFloat(newStatistics.numCreatedCells));
-        datas[12].emplace_back(toFloat(newStatistics.numSuccessfulAttacks));
-        datas[13].emplace_back(toFloat(newStatistics.numFailedAttacks));
-        datas[14].emplace_back(toFloat(newStatistics.numMuscleActivities));
+    if (datas.isEmpty() || newStatistics.timeStep - lastTimestep > LongtermTimestepDelta) {
+        lastTimestep = toFloat(newStatistics.timeStep);
+        datas.add(lastTimestep, getValues(newStatistics).data());
     }
 }
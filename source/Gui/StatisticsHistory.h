@@ -1,31 +1,33 @@
 #pragma once
 
-#include <vector>
-
+#include "Base/TimeSeries.h"
 #include "EngineInterface/Definitions.h"
 
+//cells, cells by colors (7x), connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities,
+//garbage collection time
+int constexpr NumStatisticsColumns = 16;
+
 struct LiveStatistics
 {
     static float constexpr MaxLiveHistory = 120.0f;  //in seconds
+    static int constexpr Capacity = 16384;
+    static float constexpr MinSampleInterval = (MaxLiveHistory + 1.0f) / Capacity;  //the capacity covers the maximum history
 
     float timepoint = 0.0f;  //in seconds
     float history = 10.0f;   //in seconds
 
-    std::vector<float> timepointsHistory;
-    std::array<std::vector<float>, 15>
-        datas;  //cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities
+    TimeSeriesRingBuffer datas = TimeSeriesRingBuffer(NumStatisticsColumns, Capacity);
 
-    void truncate();
     void add(MonitorData const& statistics);
 };
 
 struct LongtermStatistics
 {
     static float constexpr LongtermTimestepDelta = 1000.0f;
+    static int constexpr MaxBuckets = 2048;
 
-    std::vector<float> timestepHistory;
-    std::array<std::vector<float>, 15>
-        datas;  //cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities
+    float lastTimestep = 0.0f;
+    DownsampledTimeSeries datas = DownsampledTimeSeries(NumStatisticsColumns, MaxBuckets);
 
     void add(MonitorData const& statistics);
 };
@@ -5,10 +5,13 @@
 
 #include "Fonts/IconsFontAwesome5.h"
 
+#include "Base/LoggingService.h"
+#include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/MonitorData.h"
 #include "EngineInterface/SimulationController.h"
+#include "EngineInterface/StatisticsLog.h"
 #include "StyleRepository.h"
 #include "GlobalSettings.h"
 #include "AlienImGui.h"
@@ -18,18 +21,18 @@ _StatisticsWindow::_StatisticsWindow(SimulationController const& simController)
     : _AlienWindow("Statistics", "windows.statistics", false)
     , _simController(simController)
 {
-    _exportStatisticsDialog = std::make_shared<_ExportStatisticsDialog>();
+    _exportStatisticsDialog = std::make_shared<_ExportStatisticsDialog>(simController);
 }
 
 namespace
 {
     template<typename T>
-    T getMax(std::vector<T> const& range)
+    T getMax(T const* values, int size)
     {
         T result = static_cast<T>(0);
-        for (auto const& element : range) {
-            if (element > result) {
-                result = element;
+        for (int i = 0; i < size; ++i) {
+            if (values[i] > result) {
+                result = values[i];
             }
         }
         return result;
@@ -40,6 +43,8 @@ void _StatisticsWindow::reset()
 {
     _liveStatistics = LiveStatistics();
     _longtermStatistics = LongtermStatistics();
+    _longtermStatisticsLoaded = false;
+    _samplesDuringLoading.clear();
 }
 
 void _StatisticsWindow::processIntern()
@@ -56,7 +61,7 @@ void _StatisticsWindow::processIntern()
 
     ImGui::SameLine();
     if (AlienImGui::Button("Export")) {
-        _exportStatisticsDialog->show(_longtermStatistics);
+        _exportStatisticsDialog->show();
     }
 
     if (_live) {
@@ -85,7 +90,7 @@ void _StatisticsWindow::processLiveStatistics()
         }
 
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(0, _liveStatistics.datas[0]);
+        processLivePlot(0, 0);
         if (_showCellsByColor) {
             processLivePlotForCellsByColor(1);
         }
@@ -94,19 +99,19 @@ void _StatisticsWindow::processLiveStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Cell connections");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(2, _liveStatistics.datas[8]);
+        processLivePlot(2, 8);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Energy particles");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(3, _liveStatistics.datas[9]);
+        processLivePlot(3, 9);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Tokens");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(4, _liveStatistics.datas[10]);
+        processLivePlot(4, 10);
 
         ImPlot::PopColormap();
 
@@ -125,25 +130,31 @@ void _StatisticsWindow::processLiveStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Created cells");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(5, _liveStatistics.datas[11]);
+        processLivePlot(5, 11);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Successful attacks");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(6, _liveStatistics.datas[12]);
+        processLivePlot(6, 12);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Failed attacks");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(7, _liveStatistics.datas[13]);
+        processLivePlot(7, 13);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Muscle activities");
         ImGui::TableSetColumnIndex(1);
-        processLivePlot(8, _liveStatistics.datas[14]);
+        processLivePlot(8, 14);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Garbage collection [us]");
+        ImGui::TableSetColumnIndex(1);
+        processLivePlot(9, 15);
 
         ImPlot::PopColormap();
         ImGui::EndTable();
@@ -172,7 +183,7 @@ void _StatisticsWindow::processLongtermStatistics()
         }
 
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(0, _longtermStatistics.datas[0]);
+        processLongtermPlot(0, 0);
         if (_showCellsByColor) {
             processLongtermPlotForCellsByColor(1);
         }
@@ -181,19 +192,19 @@ void _StatisticsWindow::processLongtermStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Cell connections");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(2, _longtermStatistics.datas[8]);
+        processLongtermPlot(2, 8);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Energy particles");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(3, _longtermStatistics.datas[9]);
+        processLongtermPlot(3, 9);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Tokens");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(4, _longtermStatistics.datas[10]);
+        processLongtermPlot(4, 10);
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
@@ -213,34 +224,42 @@ void _StatisticsWindow::processLongtermStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Created cells");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(5, _longtermStatistics.datas[11]);
+        processLongtermPlot(5, 11);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Successful attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(6, _longtermStatistics.datas[12]);
+        processLongtermPlot(6, 12);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Failed attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(7, _longtermStatistics.datas[13]);
+        processLongtermPlot(7, 13);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Muscle activities");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(8, _longtermStatistics.datas[14]);
+        processLongtermPlot(8, 14);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Garbage collection [us]");
+        ImGui::TableSetColumnIndex(1);
+        processLongtermPlot(9, 15);
 
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
 }
 
-void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& valueHistory)
+void _StatisticsWindow::processLivePlot(int row, int column)
 {
-    auto maxValue = getMax(valueHistory);
+    auto const& datas = _liveStatistics.datas;
+    auto values = datas.getValues(column);
+    auto maxValue = getMax(values, datas.getSize());
     
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -248,33 +267,28 @@ void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& value
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
 
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
-    ImPlot::SetNextPlotLimits(
-        _liveStatistics.timepointsHistory.back() - _liveStatistics.history,
-        _liveStatistics.timepointsHistory.back(),
-        0,
-        maxValue * 1.5,
-        ImGuiCond_Always);
+    ImPlot::SetNextPlotLimits(datas.getLastTime() - _liveStatistics.history, datas.getLastTime(), 0, maxValue * 1.5, ImGuiCond_Always);
     if (ImPlot::BeginPlot(
             "##", 0, 0, ImVec2(-1, StyleRepository::getInstance().scaleContent(80.0f)), 0, ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_NoTickLabels)) {
         auto color = ImPlot::GetColormapColor(row + 2);
 
         if (ImGui::GetStyle().Alpha == 1.0f) {
             ImPlot::AnnotateClamped(
-                _liveStatistics.timepointsHistory.back(),
-                valueHistory.back(),
+                datas.getLastTime(),
+                datas.getLastValue(column),
                 ImVec2(-10.0f, 10.0f),
                 color,
                 "%s",
-                StringHelper::format(toInt(valueHistory.back())).c_str());
+                StringHelper::format(toInt(datas.getLastValue(column))).c_str());
         }
 
 
         ImPlot::PushStyleColor(ImPlotCol_Line, color);
 
-        ImPlot::PlotLine("##", _liveStatistics.timepointsHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotLine("##", datas.getTimes(), values, datas.getSize());
 
         ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f * ImGui::GetStyle().Alpha);
-        ImPlot::PlotShaded("##", _liveStatistics.timepointsHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotShaded("##", datas.getTimes(), values, datas.getSize());
         ImPlot::PopStyleVar();
 
         ImPlot::PopStyleColor();
@@ -288,9 +302,10 @@ void _StatisticsWindow::processLivePlot(int row, std::vector<float> const& value
 
 void _StatisticsWindow::processLivePlotForCellsByColor(int row)
 {
+    auto const& datas = _liveStatistics.datas;
     auto maxValue = 0.0f;
     for (int i = 0; i < 7; ++i) {
-        maxValue = std::max(maxValue, getMax(_liveStatistics.datas[1 + i]));
+        maxValue = std::max(maxValue, getMax(datas.getValues(1 + i), datas.getSize()));
     }
 
     ImGui::PushID(row);
@@ -299,8 +314,7 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
 
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
-    ImPlot::SetNextPlotLimits(
-        _liveStatistics.timepointsHistory.back() - _liveStatistics.history, _liveStatistics.timepointsHistory.back(), 0, maxValue * 1.5, ImGuiCond_Always);
+    ImPlot::SetNextPlotLimits(datas.getLastTime() - _liveStatistics.history, datas.getLastTime(), 0, maxValue * 1.5, ImGuiCond_Always);
     if (ImPlot::BeginPlot(
             "##", 0, 0, ImVec2(-1, StyleRepository::getInstance().scaleContent(160)), 0, ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_NoTickLabels)) {
         for (int i = 0; i < 7; ++i) {
@@ -309,9 +323,8 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
             ImColor color(toInt((colorRaw >> 16) & 0xff), toInt((colorRaw >> 8) & 0xff), toInt(colorRaw & 0xff));
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
-            auto s = std::to_string(toInt(_liveStatistics.datas[1 + i].back()));
-            ImPlot::PlotLine(
-                s.c_str(), _liveStatistics.timepointsHistory.data(), _liveStatistics.datas[1 + i].data(), toInt(_liveStatistics.datas[1 + i].size()));
+            auto s = std::to_string(toInt(datas.getLastValue(1 + i)));
+            ImPlot::PlotLine(s.c_str(), datas.getTimes(), datas.getValues(1 + i), datas.getSize());
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -322,39 +335,36 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
     ImGui::PopID();
 }
 
-void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& valueHistory)
+void _StatisticsWindow::processLongtermPlot(int row, int column)
 {
-    auto maxValue = getMax(valueHistory);
+    auto const& datas = _longtermStatistics.datas;
+    auto size = datas.getSize();
+    auto maxValue = getMax(datas.getMaxs(column), size);
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleColor(ImPlotCol_PlotBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
-    ImPlot::SetNextPlotLimits(
-        _longtermStatistics.timestepHistory.front(),
-        _longtermStatistics.timestepHistory.back(),
-        0,
-        maxValue * 1.5,
-        ImGuiCond_Always);  
+    ImPlot::SetNextPlotLimits(datas.getTimes()[0], datas.getTimes()[size - 1], 0, maxValue * 1.5, ImGuiCond_Always);
     if (ImPlot::BeginPlot(
             "##", 0, 0, ImVec2(-1, StyleRepository::getInstance().scaleContent(80.0f)), 0, ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_NoTickLabels)) {
         auto color = ImPlot::GetColormapColor(row + 2);
         if (ImGui::GetStyle().Alpha == 1.0f) {
             ImPlot::AnnotateClamped(
-                _longtermStatistics.timestepHistory.back(),
-                valueHistory.back(),
+                datas.getTimes()[size - 1],
+                datas.getMeans(column)[size - 1],
                 ImVec2(-10.0f, 10.0f),
                 ImPlot::GetLastItemColor(),
                 "%s",
-                StringHelper::format(toInt(valueHistory.back())).c_str());
+                StringHelper::format(toInt(datas.getMeans(column)[size - 1])).c_str());
         }
         ImPlot::PushStyleColor(ImPlotCol_Line, color);
-        ImPlot::PlotLine(
-            "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotLine("##", datas.getTimes(), datas.getMeans(column), size);
+
+        //range of the values aggregated in each bucket
         ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f);
-        ImPlot::PlotShaded(
-            "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+        ImPlot::PlotShaded("##", datas.getTimes(), datas.getMins(column), datas.getMaxs(column), size);
         ImPlot::PopStyleVar();
         ImPlot::PopStyleColor();
         ImPlot::EndPlot();
@@ -366,9 +376,11 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
 
 void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
 {
+    auto const& datas = _longtermStatistics.datas;
+    auto size = datas.getSize();
     auto maxValue = 0.0f;
     for (int i = 0; i < 7; ++i) {
-        maxValue = std::max(maxValue, getMax(_longtermStatistics.datas[1 + i]));
+        maxValue = std::max(maxValue, getMax(datas.getMeans(1 + i), size));
     }
 
     ImGui::PushID(row);
@@ -376,7 +388,7 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
     ImPlot::PushStyleColor(ImPlotCol_PlotBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, (ImU32)ImColor(0.3f, 0.3f, 0.3f, ImGui::GetStyle().Alpha));
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
-    ImPlot::SetNextPlotLimits(_longtermStatistics.timestepHistory.front(), _longtermStatistics.timestepHistory.back(), 0, maxValue * 1.5, ImGuiCond_Always);
+    ImPlot::SetNextPlotLimits(datas.getTimes()[0], datas.getTimes()[size - 1], 0, maxValue * 1.5, ImGuiCond_Always);
     if (ImPlot::BeginPlot(
             "##", 0, 0, ImVec2(-1, StyleRepository::getInstance().scaleContent(160.0f)), 0, ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_NoTickLabels)) {
         for (int i = 0; i < 7; ++i) {
@@ -385,9 +397,8 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
             ImColor color(toInt((colorRaw >> 16) & 0xff), toInt((colorRaw >> 8) & 0xff), toInt(colorRaw & 0xff));
 
             ImPlot::PushStyleColor(ImPlotCol_Line, (ImU32)color);
-            auto s = std::to_string(toInt(_longtermStatistics.datas[1 + i].back()));
-            ImPlot::PlotLine(
-                s.c_str(), _longtermStatistics.timestepHistory.data(), _longtermStatistics.datas[1 + i].data(), toInt(_longtermStatistics.datas[1 + i].size()));
+            auto s = std::to_string(toInt(datas.getMeans(1 + i)[size - 1]));
+            ImPlot::PlotLine(s.c_str(), datas.getTimes(), datas.getMeans(1 + i), size);
             ImPlot::PopStyleColor();
             ImGui::PopID();
         }
@@ -404,7 +415,50 @@ void _StatisticsWindow::processBackground()
     auto newStatistics = _simController->getStatistics();
     _liveStatistics.add(newStatistics);
 
-    _longtermStatistics.add(newStatistics);
+    if (!_longtermStatisticsLoaded && !_longtermStatisticsTask.valid()) {
+        loadLongtermStatistics();
+    }
+    if (_longtermStatisticsTask.valid()) {
+        _samplesDuringLoading.emplace_back(newStatistics);
+        processLoadedLongtermStatistics();
+    } else {
+        _longtermStatistics.add(newStatistics);
+    }
+}
+
+void _StatisticsWindow::loadLongtermStatistics()
+{
+    _longtermStatistics = LongtermStatistics();
+    _longtermStatisticsLoaded = true;
+    _simController->flushStatisticsLog();
+
+    _longtermStatisticsTask = std::async(std::launch::async, [] {
+        LongtermStatistics result;
+        try {
+            StatisticsLogReader reader(Const::StatisticsLogFile);
+            reader.forEachSampleInHistory([&](MonitorData const& sample) { result.add(sample); });
+        } catch (std::exception const& e) {
+            log(Priority::Important, std::string("Statistics log could not be read: ") + e.what());
+        }
+        return result;
+    });
+}
+
+void _StatisticsWindow::processLoadedLongtermStatistics()
+{
+    if (_longtermStatisticsTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    auto longtermStatistics = _longtermStatisticsTask.get();
+
+    //a reset during loading requires to load the history of the new simulation
+    if (_longtermStatisticsLoaded) {
+        _longtermStatistics = std::move(longtermStatistics);
+        for (auto const& sample : _samplesDuringLoading) {
+            _longtermStatistics.add(sample);
+        }
+    }
+    _samplesDuringLoading.clear();
 }
 
 uint32_t _StatisticsWindow::getCellColor(int i) const
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <future>
+#include <vector>
+
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/MonitorData.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -17,10 +21,12 @@ private:
     void processIntern();
     void processLiveStatistics();
     void processLongtermStatistics();
+    void loadLongtermStatistics();
+    void processLoadedLongtermStatistics();
 
-    void processLivePlot(int row, std::vector<float> const& valueHistory);
+    void processLivePlot(int row, int column);
     void processLivePlotForCellsByColor(int row);
-    void processLongtermPlot(int row, std::vector<float> const& valueHistory);
+    void processLongtermPlot(int row, int column);
     void processLongtermPlotForCellsByColor(int row);
 
     void processBackground() override;
@@ -35,4 +41,9 @@ private:
 
     LiveStatistics _liveStatistics;
     LongtermStatistics _longtermStatistics;
+    bool _longtermStatisticsLoaded = false;  //the history is read from the statistics log when the first sample arrives
+
+    //the statistics log is decoded in the background, samples arriving meanwhile are appended afterwards
+    std::future<LongtermStatistics> _longtermStatisticsTask;
+    std::vector<MonitorData> _samplesDuringLoading;
 };